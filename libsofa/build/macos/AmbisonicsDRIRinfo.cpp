@@ -28,57 +28,6 @@ static void DisplayHelp(std::ostream & output = std::cout)
     output << "    syntax : ./AmbisonicsDRIRinfo [filename]" << std::endl;
 }
 
-/************************************************************************************/
-/*!
- *  @brief          Helper function to  access element [i][j][k][l] of a "4D array" of dimensions [dim1][dim2][dim3][dim4]
- *                  stored in a 1D data array
- *
- */
-/************************************************************************************/
-static inline const std::size_t array4DIndex(const unsigned long i,
-                                             const unsigned long j,
-                                             const unsigned long k,
-                                             const unsigned long l,
-                                             const unsigned long dim1,
-                                             const unsigned long dim2,
-                                             const unsigned long dim3,
-                                             const unsigned long dim4)
-{
-    return (dim2 * dim3 * dim4 * i) + (dim3 * dim4 * j) + (dim4 * k) + (l);
-}
-
-/************************************************************************************/
-/*!
- *  @brief          Helper function to  access element [i][j][k] of a "3D array" of dimensions [dim1][dim2][dim3]
- *                  stored in a 1D data array
- *
- */
-/************************************************************************************/
-static inline const std::size_t array3DIndex(const unsigned long i,
-                                             const unsigned long j,
-                                             const unsigned long k,
-                                             const unsigned long dim1,
-                                             const unsigned long dim2,
-                                             const unsigned long dim3)
-{
-    return dim2 * dim3 * i + dim3 * j + k;
-}
-
-/************************************************************************************/
-/*!
- *  @brief          Helper function to  access element [i][j] of a "2D array" of dimensions [dim1][dim2]
- *                  stored in a 1D data array
- *
- */
-/************************************************************************************/
-static inline const std::size_t array2DIndex(const unsigned long i,
-                                             const unsigned long j,
-                                             const unsigned long dim1,
-                                             const unsigned long dim2)
-{
-    return dim2 * i + j;
-}
-
 /************************************************************************************/
 /*!
  *  @brief          Prints Emitter informations
@@ -102,10 +51,9 @@ static void PrintEmitter(const sofa::File &theFile,
     
     SOFA_ASSERT( dims.size() == 3 );
     
-    std::vector< double > pos;
-    pos.resize( dims[0] * dims[1] * dims[2] );
+    sofa::Array< double > pos( dims );
     
-    theFile.GetEmitterPosition( &pos[0], dims[0], dims[1], dims[2] );
+    theFile.GetEmitterPosition( pos.GetData(), dims[0], dims[1], dims[2] );
     
     output << sofa::String::PadWith( "EmitterPosition" ) << " = " ;
     
@@ -115,8 +63,7 @@ static void PrintEmitter(const sofa::File &theFile,
         {
             for( std::size_t k = 0; k < dims[2]; k++ )
             {
-                const std::size_t index = array3DIndex( i, j, k, dims[0], dims[1], dims[2] );
-                output << pos[ index ] << " ";
+                output << pos( i, j, k ) << " ";
             }
         }
     }
@@ -139,10 +86,9 @@ static void PrintEmitter(const sofa::File &theFile,
         
         SOFA_ASSERT( dims.size() == 3 );
         
-        std::vector< double > pos;
-        pos.resize( dims[0] * dims[1] * dims[2] );
+        sofa::Array< double > pos( dims );
         
-        theFile.GetEmitterView( &pos[0], dims[0], dims[1], dims[2] );
+        theFile.GetEmitterView( pos.GetData(), dims[0], dims[1], dims[2] );
         
         output << sofa::String::PadWith( "EmitterView" ) << " = " ;
         
@@ -152,8 +98,7 @@ static void PrintEmitter(const sofa::File &theFile,
             {
                 for( std::size_t k = 0; k < dims[2]; k++ )
                 {
-                    const std::size_t index = array3DIndex( i, j, k, dims[0], dims[1], dims[2] );
-                    output << pos[ index ] << " ";
+                    output << pos( i, j, k ) << " ";
                 }
             }
         }
@@ -178,10 +123,9 @@ static void PrintEmitter(const sofa::File &theFile,
         
         SOFA_ASSERT( dims.size() == 3 );
         
-        std::vector< double > pos;
-        pos.resize( dims[0] * dims[1] * dims[2] );
+        sofa::Array< double > pos( dims );
         
-        theFile.GetEmitterUp( &pos[0], dims[0], dims[1], dims[2] );
+        theFile.GetEmitterUp( pos.GetData(), dims[0], dims[1], dims[2] );
         
         output << sofa::String::PadWith( "EmitterUp" ) << " = " ;
         
@@ -191,8 +135,7 @@ static void PrintEmitter(const sofa::File &theFile,
             {
                 for( std::size_t k = 0; k < dims[2]; k++ )
                 {
-                    const std::size_t index = array3DIndex(i,j,k, dims[0], dims[1], dims[2]);
-                    output << pos[ index ] << " ";
+                    output << pos( i, j, k ) << " ";
                 }
             }
         }
@@ -224,10 +167,9 @@ static void PrintReceiver(const sofa::File &theFile,
     
     SOFA_ASSERT( dims.size() == 3 );
     
-    std::vector< double > pos;
-    pos.resize( dims[0] * dims[1] * dims[2] );
+    sofa::Array< double > pos( dims );
     
-    theFile.GetReceiverPosition( &pos[0], dims[0], dims[1], dims[2] );
+    theFile.GetReceiverPosition( pos.GetData(), dims[0], dims[1], dims[2] );
     
     output << sofa::String::PadWith( "ReceiverPosition" ) << " = " ;
     
@@ -237,8 +179,7 @@ static void PrintReceiver(const sofa::File &theFile,
         {
             for( std::size_t k = 0; k < dims[2]; k++ )
             {
-                const std::size_t index = array3DIndex( i, j, k, dims[0], dims[1], dims[2] );
-                output << pos[ index ] << " ";
+                output << pos( i, j, k ) << " ";
             }
         }
     }
@@ -269,10 +210,9 @@ static void PrintListener(const sofa::File &theFile,
         
         SOFA_ASSERT( dims.size() == 2 );
         
-        std::vector< double > pos;
-        pos.resize( dims[0] * dims[1] );
+        sofa::Array< double > pos( dims );
         
-        theFile.GetListenerPosition( &pos[0], dims[0], dims[1] );
+        theFile.GetListenerPosition( pos.GetData(), dims[0], dims[1] );
         
         output << sofa::String::PadWith( "ListenerPosition" ) << " = " ;
         
@@ -280,8 +220,7 @@ static void PrintListener(const sofa::File &theFile,
         {
             for( std::size_t j = 0; j < dims[1]; j++ )
             {
-                const std::size_t index = array2DIndex(i, j, dims[0], dims[1] );
-                output << pos[ index ] << " ";
+                output << pos( i, j ) << " ";
             }
         }
         output << std::endl;
@@ -305,10 +244,9 @@ static void PrintListener(const sofa::File &theFile,
         
         SOFA_ASSERT( dims.size() == 2 );
         
-        std::vector< double > pos;
-        pos.resize( dims[0] * dims[1] );
+        sofa::Array< double > pos( dims );
         
-        theFile.GetListenerView( &pos[0], dims[0], dims[1] );
+        theFile.GetListenerView( pos.GetData(), dims[0], dims[1] );
         
         output << sofa::String::PadWith( "ListenerView" ) << " = " ;
         
@@ -316,8 +254,7 @@ static void PrintListener(const sofa::File &theFile,
         {
             for( std::size_t j = 0; j < dims[1]; j++ )
             {
-                const std::size_t index = array2DIndex( i, j, dims[0], dims[1] );
-                output << pos[ index ] << " ";
+                output << pos( i, j ) << " ";
             }
         }
         output << std::endl;
@@ -341,10 +278,9 @@ static void PrintListener(const sofa::File &theFile,
         
         SOFA_ASSERT( dims.size() == 2 );
         
-        std::vector< double > pos;
-        pos.resize( dims[0] * dims[1] );
+        sofa::Array< double > pos( dims );
         
-        theFile.GetListenerUp( &pos[0], dims[0], dims[1] );
+        theFile.GetListenerUp( pos.GetData(), dims[0], dims[1] );
         
         output << sofa::String::PadWith( "ListenerUp" ) << " = " ;
         
@@ -352,8 +288,7 @@ static void PrintListener(const sofa::File &theFile,
         {
             for( std::size_t j = 0; j < dims[1]; j++ )
             {
-                const std::size_t index = array2DIndex(i,j,dims[0], dims[1]);
-                output << pos[ index ] << " ";
+                output << pos( i, j ) << " ";
             }
         }
         output << std::endl;
@@ -384,10 +319,9 @@ static void PrintSource(const sofa::File &theFile,
     
     SOFA_ASSERT( dims.size() == 2 );
     
-    std::vector< double > pos;
-    pos.resize( dims[0] * dims[1] );
+    sofa::Array< double > pos( dims );
     
-    theFile.GetSourcePosition( &pos[0], dims[0], dims[1] );
+    theFile.GetSourcePosition( pos.GetData(), dims[0], dims[1] );
     
     output << sofa::String::PadWith( "SourcePosition" ) << " = " ;
     
@@ -395,8 +329,7 @@ static void PrintSource(const sofa::File &theFile,
     {
         for( std::size_t j = 0; j < dims[1]; j++ )
         {
-            const std::size_t index = array2DIndex( i, j, dims[0], dims[1] );
-            output << pos[ index ] << " ";
+            output << pos( i, j ) << " ";
         }
     }
     output << std::endl;
@@ -574,7 +507,7 @@ int main(int argc, char *argv[])
         
         if( printData == true )
         {
-            std::vector< double > data;
+            sofa::Array< double > data;
             
             adrir.GetDataIR( data );
             
@@ -586,8 +519,7 @@ int main(int argc, char *argv[])
                     {
                         for( std::size_t l = 0; l < N; l++ )
                         {
-                            const std::size_t index = array4DIndex( i, j, k, l, M, R, E, N );
-                            output << data[ index ] << std::endl;
+                            output << data( i, j, k, l ) << std::endl;
                         }
                     }
                 }
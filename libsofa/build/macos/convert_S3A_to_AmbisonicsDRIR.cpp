@@ -19,24 +19,6 @@
 #include "dr_wav.h"
 
 
-/************************************************************************************/
-/*!
- *  @brief          Helper function to  access element [i][j][k] of a "3D array" of dimensions [dim1][dim2][dim3]
- *                  stored in a 1D data array
- *
- */
-/************************************************************************************/
-static inline const std::size_t array3DIndex(const unsigned long i,
-                                             const unsigned long j,
-                                             const unsigned long k,
-                                             const unsigned long dim1,
-                                             const unsigned long dim2,
-                                             const unsigned long dim3)
-{
-    return dim2 * dim3 * i + dim3 * j + k;
-}
-
-
 /************************************************************************************/
 /*
  *                  UTILS
@@ -572,25 +554,27 @@ int main(int argc, char *argv[])
          *  and the SOFA specs defines FIRE data as (M)REN.
          *  Therefore, we whould swap dimmensions...
          */
-        float* audiodata_reordered = (float*)calloc(total_num_samples,sizeof(float));
+        const std::size_t dimsREN[3] = { numReceivers, numEmitters, numDataSamplesPerChannel };
+        
+        /* strides of the interleaved data ENR, for each dimension of REN */
+        const std::ptrdiff_t stridesENR[3] =
+        {
+            1,
+            (std::ptrdiff_t) ( numDataSamplesPerChannel * numReceivers ),
+            (std::ptrdiff_t) numReceivers
+        };
         
-        uint64_t index_ENR = 0;     //current
-        uint64_t index_REN = 0;     //reordered
+        const sofa::ArrayView< const float > audiodataREN( audiodata, 3, dimsREN, stridesENR );
         
-        uint64_t E = numEmitters;
-        uint64_t N = numDataSamplesPerChannel;
-        uint64_t R = numReceivers;
+        sofa::Array< float > audiodata_reordered( audiodataREN.GetDimensions() );
         
-        for( uint64_t e = 0; e < E; e++ )   // num speakers
+        for( std::size_t r = 0; r < numReceivers; r++ )   // num channels
         {
-            for( uint64_t n = 0; n < N; n++ )   // num samples
+            for( std::size_t e = 0; e < numEmitters; e++ )   // num speakers
             {
-                for( uint64_t r = 0; r < R; r++ )   // num channels
+                for( std::size_t n = 0; n < numDataSamplesPerChannel; n++ )   // num samples
                 {
-                    index_ENR = array3DIndex(e,n,r,E,N,R);
-                    index_REN = array3DIndex(r,e,n,R,E,N);
-//                    std::cerr << index_ENR << "\t -> \t" << index_REN << std::endl;
-                    audiodata_reordered[index_REN] = audiodata[index_ENR];
+                    audiodata_reordered( r, e, n ) = audiodataREN( r, e, n );
                 }
             }
         }
@@ -605,13 +589,12 @@ int main(int argc, char *argv[])
         /* actual data */
         try
         {
-            var.putVar(audiodata_reordered);
+            var.putVar(audiodata_reordered.GetData());
         } catch (netCDF::exceptions::NcException& e) {
             std::cerr << "ERROR: processing audio" << std::endl;
         }
         
         /* don't forget it */
-        free(audiodata_reordered);
         free(audiodata);
         
         
@@ -20,33 +20,11 @@
 #include <fstream>
 #include "SOFA.h"
 #include "SOFAString.h"
-#include "ncDim.h"
-#include "ncVar.h"
-#include "ncFile.h"
 
 #define DR_WAV_IMPLEMENTATION
 #include "dr_wav.h"
 
 
-/************************************************************************************/
-/*!
- *  @brief          Helper function to  access element [i][j][k] of a "3D array" of dimensions [dim1][dim2][dim3]
- *                  stored in a 1D data array
- *
- */
-/************************************************************************************/
-static inline const std::size_t array3DIndex(const unsigned long i,
-                                             const unsigned long j,
-                                             const unsigned long k,
-                                             const unsigned long dim1,
-                                             const unsigned long dim2,
-                                             const unsigned long dim3)
-{
-    return dim2 * dim3 * i + dim3 * j + k;
-}
-
-
-
 //==============================================================================
 // Data
 //==============================================================================
@@ -226,74 +204,15 @@ int main(int argc, char *argv[])
     std::string input_folder_path = argv[1];
     std::string output_folder_path = argv[2];
     
-    /// create the file
-    
-    /// for creating a new file
-    const netCDF::NcFile::FileMode mode = netCDF::NcFile::newFile;
-    
-    /// the file format that is used (netCDF4 / HDF5)
-    const netCDF::NcFile::FileFormat format = netCDF::NcFile::nc4;
-    
     /// the file shall not exist beforehand
     std::string file_name   = extractFolderName(input_folder_path);
     std::string slash       = "/";
     
     const std::string output_file_path = output_folder_path + slash + file_name + ".sofa";
     
-    const netCDF::NcFile theFile( output_file_path, mode, format );
-    
-    //==============================================================================
-    /// create the attributes
-    sofa::Attributes attributes;
-    attributes.ResetToDefault();
-    
-    /// fill the attributes as you want
-    {
-        
-        attributes.Set( sofa::Attributes::kSOFAConventions,         "AmbisonicsDRIR" );
-        attributes.Set( sofa::Attributes::kSOFAConventionsVersion,  "0.1" );
-        attributes.Set( sofa::Attributes::kDataType,                "FIRE" );
-        attributes.Set( sofa::Attributes::kTitle,                   file_name );
-        attributes.Set( sofa::Attributes::kApplicationName,         "convert_openAIR_to_AmbisonicsDRIR" );
-        attributes.Set( sofa::Attributes::kApplicationVersion,      "0.1" );
-        attributes.Set( sofa::Attributes::kReferences,              "Ambisonics Directional Room Impulse Response as a new Convention of the Spatially Oriented Format for Acoustics" );
-        attributes.Set( sofa::Attributes::kRoomType,                "reverberant" );
-        
-        /// etc.
-    }
-    
-    /// put all the attributes into the file
-    for( unsigned int k = 0; k < sofa::Attributes::kNumAttributes; k++ )
-    {
-        const sofa::Attributes::Type attType = static_cast< sofa::Attributes::Type >(k);
-        
-        const std::string attName  = sofa::Attributes::GetName( attType );
-        const std::string attValue = attributes.Get( attType );
-        
-        theFile.putAtt( attName, attValue );
-    }
-    
-    
-    /// add attribute specific to your convention (e.g. 'DatabaseName' for the 'SimpleFreeFieldHRIR' convention)
-    {
-        /* Ambisonics Order */
-        theFile.putAtt( "AmbisonicsOrder", "1" );
-        
-        /* Microphone Model */
-        theFile.putAtt( "AmbisonicsMicrophoneModel", "Soundfield ST450 MkII" );
-        
-        /* Ambisonics Conversion Method */
-        theFile.putAtt( "AmbisonicsConversionMethod", "Hardware" );
-        
-        /* Room Description */
-        theFile.putAtt( "RoomDesctiption", "York Guildhall Council Chamber" );
-    }
-    
-    //==============================================================================
-    
-    /// create the dimensions
-    const unsigned int numMeasurements  = M;    // same as number of microphone positions
-    const unsigned int numReceivers     = 4;    // Ambisonics First Order by default
+    /// the dimensions
+    const unsigned int ambisonicsOrder  = 1;    // Ambisonics First Order by default
+    const unsigned int numReceivers     = 4;
     const unsigned int numEmitters      = E;    // same as number of speakers
     /*
      *  All IRs must have the same length.
@@ -303,176 +222,47 @@ int main(int argc, char *argv[])
     unsigned long long num_max_samples = find_maximum_sample_length(input_folder_path, E, M);
     const unsigned int numDataSamplesPerChannel   = (const unsigned int)num_max_samples / numReceivers;
     
-    theFile.addDim( "C", 3 );   ///< this is required by the standard
-    theFile.addDim( "I", 1 );   ///< this is required by the standard
-    theFile.addDim( "M", numMeasurements );
-    theFile.addDim( "R", numReceivers );
-    
-    theFile.addDim( "E", numEmitters );
-    theFile.addDim( "N", numDataSamplesPerChannel );  // per channel!!
-    
-    //==============================================================================
-    /// create the variables
-    
-    /// Data.SamplingRate
-    {
-        const std::string varName  = "Data.SamplingRate";
-        const std::string typeName = "double";
-        const std::string dimName  = "I";
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimName );
-        
-        const double samplingRate = get_sample_rate(input_folder_path);
-        
-        var.putVar( &samplingRate );
-        var.putAtt( "Units", "hertz" );
-    }
-    
-    
-    /// Data.Delay
-    {
-        const std::string varName  = "Data.Delay";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("M");
-        dimNames.push_back("R");
-        dimNames.push_back("E");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        /* values: zeros by default */
-        double* delay = (double*)calloc(numMeasurements*numReceivers*numEmitters,
-                                        sizeof(double));
-        var.putVar((const double*)delay);
-        free(delay);
-    }
-    
-    /// -------------------------------------------------
-    /// ListenerPosition
-    
     /*
-     *      - r1 = [-6, 0, 1.6]
-     *      - r2 = [-2.5, 2.95, 1.6]
-     *      - r3 = [-2.5, -2.95, 1.6]
-     *      - r4 = [-1, 0, 1.6]
+     *  M is left unlimited (0): the measurements (one per microphone position) are appended
+     *  one at a time, so that only one measurement is kept in memory
      */
-    {
-        const std::string varName  = "ListenerPosition";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("M");
-        dimNames.push_back("C");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
-        
-        const double listenerPosition[numMeasurements*3] = {
-            -6,     0,      1.6,    \
-            -2.5,   2.95,   1.6,    \
-            -2.5,   -2.95,  1.6,    \
-            -1,     0,      1.6
-        };
-
-        var.putVar((const double*)listenerPosition);
-
-    }
+    sofa::AmbisonicsDRIRWriter writer( output_file_path,
+                                       0,
+                                       ambisonicsOrder,
+                                       numEmitters,
+                                       numDataSamplesPerChannel,
+                                       sofa::AmbisonicsChannelOrdering::kFuma,
+                                       sofa::AmbisonicsNormalization::kFuma );
     
-    /// ListenerUp
-    {
-        const std::string varName  = "ListenerUp";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("M");
-        dimNames.push_back("C");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
-        
-        /* values: [0 0 1] for each measurement position */
-        double* listenerUp = (double*)calloc(numMeasurements*3,
-                                             sizeof(double));
-        for (size_t i=0; i<numMeasurements; i++)
-        {
-            listenerUp[(i*3)+2] = 1;
-        }
-        var.putVar((const double*)listenerUp);
-        free(listenerUp);
-    }
+    /// the audio files are read as float : Data.IR is stored as float as well, with no loss
+    writer.SetVariableType( "Data.IR", netCDF::ncFloat );
     
-    /// ListenerView
+    //==============================================================================
+    /// fill the attributes as you want
     {
-        const std::string varName  = "ListenerView";
-        const std::string typeName = "double";
+        writer.SetGlobalAttribute( sofa::Attributes::kTitle,                   file_name );
+        writer.SetGlobalAttribute( sofa::Attributes::kApplicationName,         "convert_openAIR_to_AmbisonicsDRIR" );
+        writer.SetGlobalAttribute( sofa::Attributes::kApplicationVersion,      "0.1" );
+        writer.SetGlobalAttribute( sofa::Attributes::kReferences,              "Ambisonics Directional Room Impulse Response as a new Convention of the Spatially Oriented Format for Acoustics" );
+        writer.SetGlobalAttribute( sofa::Attributes::kRoomDescription,         "York Guildhall Council Chamber" );
         
-        std::vector< std::string > dimNames;
-        dimNames.push_back("M");
-        dimNames.push_back("C");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
+        /* Microphone Model */
+        writer.SetGlobalAttribute( "AmbisonicsMicrophoneModel", "Soundfield ST450 MkII" );
         
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
+        /* Ambisonics Conversion Method */
+        writer.SetGlobalAttribute( "AmbisonicsConversionMethod", "Hardware" );
         
-        /* values: [1 0 0] for each measurement position */
-        double* listenerView = (double*)calloc(numMeasurements*3,
-                                               sizeof(double));
-        for (size_t i=0; i<numMeasurements; i++)
-        {
-            listenerView[i*3] = 1;
-        }
-        var.putVar((const double*)listenerView);
-        free(listenerView);
+        /// etc.
     }
     
-    /// -------------------------------------------------
-    /// ReceiverPosition
-    {
-        const std::string varName  = "ReceiverPosition";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("R");
-        dimNames.push_back("C");
-        dimNames.push_back("I");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
-        
-        /* values: [0 0 0] by default */
-        double* receiverPosition = (double*)calloc(numReceivers*3*1,
-                                                   sizeof(double));
-        var.putVar((const double*)receiverPosition);
-        free(receiverPosition);
-    }
+    //==============================================================================
+    /// fill the variables
+    
+    /// Data.SamplingRate
+    writer.SetSamplingRate( get_sample_rate(input_folder_path) );
     
     /// -------------------------------------------------
-    /// SourcePosition
-    {
-        const std::string varName  = "SourcePosition";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("I");
-        dimNames.push_back("C");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
-        
-        /* let's locate it just at the reference center */
-        double sourcePosition[3] = {0, 0, 0};
-        var.putVar((const double*)sourcePosition);
-    }
+    /// SourcePosition : let's locate it just at the reference center (default)
     
     /// -------------------------------------------------
     /// EmitterPosition
@@ -482,106 +272,48 @@ int main(int argc, char *argv[])
      *      - s3 = [1.5, -2.59, 1.6]
      */
     {
-        const std::string varName  = "EmitterPosition";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("E");
-        dimNames.push_back("C");
-        dimNames.push_back("I");    // same emitter position for each receiver position, no need for M
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
-        
         const double emitterPosition[numEmitters*3] = {
             6,      0,      1.6,    \
             1.5,    2.59,   1.6,    \
             1.5,   -2.59,   1.6
         };
         
-        var.putVar((const double*)emitterPosition);
+        writer.SetPosition( "EmitterPosition", emitterPosition, numEmitters*3, sofa::Coordinates::kCartesian );
     }
     
-    /// EmitterUp
-    {
-        const std::string varName  = "EmitterUp";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("E");
-        dimNames.push_back("C");
-        dimNames.push_back("I");    // same emitter position for each receiver position, no need for M
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
-        
-        /* values: [0 0 1] for each speaker */
-        double* emitterUp = (double*)calloc(numEmitters*3,
-                                            sizeof(double));
-        for (size_t i=0; i<(numEmitters); i++)
-        {
-            emitterUp[(i*3)+2] = 1;
-        }
-        var.putVar((const double*)emitterUp);
-        free(emitterUp);
-    }
+    /// create the file : the measurements are then appended
+    writer.Write();
     
-    /// EmitterView
-    {
-        const std::string varName  = "EmitterView";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("E");
-        dimNames.push_back("C");
-        dimNames.push_back("I");    // same emitter position for each receiver position, no need for M
-        
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
-        
-        /* values: [1 0 0] for each measurement position */
-        double* emitterView = (double*)calloc(numEmitters*3,
-                                              sizeof(double));
-        for (size_t i=0; i<(numEmitters); i++)
-        {
-            emitterView[i*3] = 1;
-        }
-        var.putVar((const double*)emitterView);
-        free(emitterView);
-    }
+    /// -------------------------------------------------
+    /// ListenerPosition
+    
+    /*
+     *      - r1 = [-6, 0, 1.6]
+     *      - r2 = [-2.5, 2.95, 1.6]
+     *      - r3 = [-2.5, -2.95, 1.6]
+     *      - r4 = [-1, 0, 1.6]
+     */
+    const double listenerPosition[M*3] = {
+        -6,     0,      1.6,    \
+        -2.5,   2.95,   1.6,    \
+        -2.5,   -2.95,  1.6,    \
+        -1,     0,      1.6
+    };
     
     /// -------------------------------------------------
-    /// Data.IR
+    /// Data.IR : one measurement per microphone position (r), each one holding all the speakers (s)
     {
-        const std::string varName  = "Data.IR";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("M");
-        dimNames.push_back("R");
-        dimNames.push_back("E");
-        dimNames.push_back("N");
+        /* one file: N frames of R interleaved channels */
+        std::vector< float > audiodata( numDataSamplesPerChannel * numReceivers );
         
+        /* one measurement, in the order of the SOFA specs for FIRE data : R E N */
+        std::vector< float > measurement( numReceivers * numEmitters * numDataSamplesPerChannel );
         
-        /* let's open all audio files in a row, copy all the data in the same buffer, and put it into the var */
-        
-        // M * R * E * N
-        uint64_t total_num_samples = numDataSamplesPerChannel * numMeasurements * numEmitters * numReceivers;
-        
-        float* audiodata = (float*)calloc(total_num_samples,sizeof(float));
-        uint64_t total_num_samples_read = 0; // accumulated though all files
         std::string audio_file_name;
         
-        for (size_t s=0; s<E; s++)
+        for (size_t r=0; r<M; r++)
         {
-            for (size_t r=0; r<M; r++)
+            for (size_t s=0; s<E; s++)
             {
                 /* build file name */
                 audio_file_name = input_folder_path + "/" + filename_base;
@@ -596,85 +328,47 @@ int main(int argc, char *argv[])
                 if (pWav == NULL)
                 {
                     std::cerr << "ERROR: opening file :" + audio_file_name << std::endl;
-                    free(audiodata);
                     return -1;
                 }
                 
-                /* read as f32 anyway, and  */
-                uint64_t num_samples_read = drwav_read_f32(pWav,
-                                                           numDataSamplesPerChannel*numReceivers,
-                                                           audiodata+total_num_samples_read);
+                /* zero-padding of the shorter files */
+                std::fill( audiodata.begin(), audiodata.end(), 0.0f );
                 
-                /* we should have read the whole file */
-                if (num_samples_read != numDataSamplesPerChannel*numReceivers)
-                {
-                    std::cerr << "ACTHUNG!!!!!!" << std::endl;
-                }
-                total_num_samples_read += num_samples_read;
+                /* read as f32 anyway */
+                drwav_read_f32(pWav, audiodata.size(), &audiodata[0]);
                 
                 /* don't forget it */
                 drwav_close(pWav);
-            }
-        }
-        
-        /* estimated and real total num samples should match */
-        if (total_num_samples != total_num_samples_read)
-        {
-            std::cerr << "ACTHUNG!!!!!! num total samples not matching" << std::endl;
-        }
-        
-        /*
-         *  At this point, we have all audio data in interleaved form, but with order (M)ENR,
-         *  and the SOFA specs defines FIRE data as (M)REN.
-         *  Therefore, we whould swap dimmensions...
-         */
-        float* audiodata_reordered = (float*)calloc(total_num_samples,sizeof(float));
-        
-        uint64_t index_ENR = 0;     //current
-        uint64_t index_REN = 0;     //reordered
-        
-        uint64_t E = numEmitters;
-        uint64_t N = numDataSamplesPerChannel;
-        uint64_t R = numReceivers;
-        
-        for( uint64_t e = 0; e < E; e++ )   // num speakers
-        {
-            for( uint64_t n = 0; n < N; n++ )   // num samples
-            {
-                for( uint64_t r = 0; r < R; r++ )   // num channels
+                
+                /* deinterleave the channels, into emitter s */
+                for (size_t c=0; c<numReceivers; c++)
                 {
-                    index_ENR = array3DIndex(e,n,r,E,N,R);
-                    index_REN = array3DIndex(r,e,n,R,E,N);
-                    //                    std::cerr << index_ENR << "\t -> \t" << index_REN << std::endl;
-                    audiodata_reordered[index_REN] = audiodata[index_ENR];
+                    for (size_t n=0; n<numDataSamplesPerChannel; n++)
+                    {
+                        measurement[ ( c * numEmitters + s ) * numDataSamplesPerChannel + n ] = audiodata[ n * numReceivers + c ];
+                    }
                 }
             }
+            
+            try
+            {
+                writer.AppendMeasurement();
+                writer.PutMeasurement( "Data.IR", &measurement[0], measurement.size() );
+                writer.PutMeasurement( "ListenerPosition", &listenerPosition[r*3], 3 );
+            } catch (netCDF::exceptions::NcException& e) {
+                std::cerr << "ERROR: processing audio" << std::endl;
+                return -1;
+            }
         }
-        
-        /* now put all data at once in the variable */
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        /* attributes */
-        var.putAtt( "ChannelOrdering", "fuma" );
-        var.putAtt( "Normalization", "fuma" );
-        
-        /* actual data */
-        try
-        {
-            var.putVar(audiodata_reordered);
-        } catch (netCDF::exceptions::NcException& e) {
-            std::cerr << "ERROR: processing audio" << std::endl;
-        }
-        
-        /* don't forget it */
-        free(audiodata_reordered);
-        free(audiodata);
     }
     
-    return 0;
-}
-
-    
-    
+    /// close the file, and check it against the convention
+    sofa::ValidationReport report;
     
+    if( writer.Close( report ) == false )
+    {
+        report.Print( std::cerr );
+    }
     
+    return 0;
+}
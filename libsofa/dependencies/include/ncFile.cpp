@@ -2,6 +2,7 @@
 #include "ncCheck.h"
 #include "ncException.h"
 #include "ncByte.h"
+#include "netcdf_mem.h"
 #include<iostream>
 #include<string>
 #include<sstream>
@@ -75,6 +76,25 @@ void NcFile::open(const string& filePath, const FileMode fMode)
   nullObject=false;
 }
 
+// constructor from a file image held in memory
+NcFile::NcFile(const string& filePath, const void* memory, size_t size)
+{
+  open(filePath, memory, size);
+}
+
+// open, read-only, a file image held in memory
+void NcFile::open(const string& filePath, const void* memory, size_t size)
+{
+  if (!nullObject)
+    close();
+
+  ncCheck(nc_open_mem(filePath.c_str(), NC_NOWRITE, size, const_cast<void*>(memory), &myId),__FILE__,__LINE__);
+
+  g_ncid = myId;
+
+  nullObject=false;
+}
+
 // constructor with file type specified
 NcFile::NcFile(const string& filePath, const FileMode fMode, const FileFormat fFormat )
 {
@@ -60,6 +60,26 @@ namespace netCDF
       */
       void open(const std::string& filePath, FileMode fMode);
 
+      /*!
+      Opens, read-only, the image of a netCDF file held in memory.
+      \param filePath    Name identifying the file. netCDF-C prior to 4.5.0 reads the first
+                          bytes of the file with this name to detect the format.
+      \param memory      Start of the file image; it is not copied, and must remain
+                          valid and unchanged as long as the file is open.
+      \param size        Size of the file image, in bytes.
+      */
+      NcFile(const std::string& filePath, const void* memory, size_t size);
+      
+      /*!
+      Opens, read-only, the image of a netCDF file held in memory.
+      \param filePath    Name identifying the file. netCDF-C prior to 4.5.0 reads the first
+                          bytes of the file with this name to detect the format.
+      \param memory      Start of the file image; it is not copied, and must remain
+                          valid and unchanged as long as the file is open.
+      \param size        Size of the file image, in bytes.
+      */
+      void open(const std::string& filePath, const void* memory, size_t size);
+      
       /*!
 	Creates a netCDF file of a specified format.
 	\param filePath    Name of netCDF optional path.
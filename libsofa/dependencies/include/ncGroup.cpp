@@ -19,6 +19,7 @@
 #include "ncString.h"
 #include <ncException.h>
 #include "ncCheck.h"
+#include <algorithm>
 using namespace std;
 using namespace netCDF::exceptions;
 
@@ -386,6 +387,15 @@ set<NcVar> NcGroup::getVars(const string& name,NcGroup::Location location) const
 
 // Get the named NcVar object.
 NcVar NcGroup::getVar(const string& name,NcGroup::Location location) const {
+  // fast path : a variable of the current group always comes first in the multimap
+  // built below, so look it up directly by name instead of enumerating every variable.
+  if(!isNull() && location != Parents && location != Children) {
+    int varId;
+    if(nc_inq_varid(myId,name.c_str(),&varId) == NC_NOERR)
+      return NcVar(*this,varId);
+    if(location == Current)
+      return NcVar();
+  }
   multimap<std::string,NcVar> ncVars(getVars(location));
   pair<multimap<string,NcVar>::iterator,multimap<string,NcVar>::iterator> ret;
   ret = ncVars.equal_range(name);
@@ -591,6 +601,14 @@ multimap<std::string,NcGroupAtt> NcGroup::getAtts(NcGroup::Location location) co
 
 // Get the named NcGroupAtt object.
 NcGroupAtt NcGroup::getAtt(const std::string& name,NcGroup::Location location) const {
+  // fast path : direct lookup of the attribute number in the current group.
+  if(!isNull() && location != Parents && location != Children) {
+    int attNum;
+    if(nc_inq_attid(myId,NC_GLOBAL,name.c_str(),&attNum) == NC_NOERR)
+      return NcGroupAtt(*this,attNum);
+    if(location == Current)
+      return NcGroupAtt();
+  }
   multimap<std::string,NcGroupAtt> ncAtts(getAtts(location));
   pair<multimap<string,NcGroupAtt>::iterator,multimap<string,NcGroupAtt>::iterator> ret;
   ret = ncAtts.equal_range(name);
@@ -983,6 +1001,23 @@ multimap<string,NcDim> NcGroup::getDims(NcGroup::Location location) const {
 // Get the named NcDim object.
 NcDim NcGroup::getDim(const string& name,NcGroup::Location location) const {
   if(isNull()) throw NcNullGrp("Attempt to invoke NcGroup::getDim on a Null group",__FILE__,__LINE__);
+  // fast path : nc_inq_dimid also searches the parent groups, so only accept
+  // the id if the dimension is actually defined in the current group.
+  if(location != Parents && location != Children) {
+    int dimId;
+    if(nc_inq_dimid(myId,name.c_str(),&dimId) == NC_NOERR) {
+      int dimCount;
+      ncCheck(nc_inq_dimids(myId,&dimCount,NULL,0),__FILE__,__LINE__);
+      if(dimCount > 0) {
+        vector<int> dimIds(dimCount);
+        ncCheck(nc_inq_dimids(myId,&dimCount,&dimIds[0],0),__FILE__,__LINE__);
+        if(std::find(dimIds.begin(),dimIds.end(),dimId) != dimIds.end())
+          return NcDim(*this,dimId);
+      }
+    }
+    if(location == Current)
+      return NcDim();
+  }
   multimap<string,NcDim> ncDims(getDims(location));
   pair<multimap<string,NcDim>::iterator,multimap<string,NcDim>::iterator> ret;
   ret = ncDims.equal_range(name);
@@ -210,6 +210,10 @@ map<string,NcVarAtt> NcVar::getAtts() const
 // Gets attribute by name.
 NcVarAtt NcVar::getAtt(const string& name) const
 {
+  // fast path : direct lookup of the attribute number.
+  int attNum;
+  if(!isNull() && nc_inq_attid(groupId,myId,name.c_str(),&attNum) == NC_NOERR)
+    return NcVarAtt(getParentGroup(),*this,attNum);
   map<string,NcVarAtt> attributeList = getAtts();
   map<string,NcVarAtt>::iterator myIter;
   myIter = attributeList.find(name);
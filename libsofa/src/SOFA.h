@@ -62,11 +62,25 @@ http://www.sofaconventions.org
 /// public API
 //==============================================================================
 #include "../src/SOFAAPI.h"
+#include "../src/SOFAArray.h"
 #include "../src/SOFAAttributes.h"
+#include "../src/SOFAChunkReader.h"
+#include "../src/SOFAChunkWriter.h"
+#include "../src/SOFAConversionReport.h"
 #include "../src/SOFACoordinates.h"
+#include "../src/SOFADataLayout.h"
 #include "../src/SOFAFile.h"
+#include "../src/SOFAFileWatcher.h"
+#include "../src/SOFALazyFile.h"
+#include "../src/SOFAMappedVariable.h"
+#include "../src/SOFAMemoryBuffer.h"
 #include "../src/SOFANcFile.h"
+#include "../src/SOFANcMetadata.h"
+#include "../src/SOFAOpenOptions.h"
+#include "../src/SOFAPaddedLayout.h"
 #include "../src/SOFAPlatform.h"
+#include "../src/SOFAPrefetchReader.h"
+#include "../src/SOFAReadPlan.h"
 #include "../src/SOFASimpleFreeFieldHRIR.h"
 #include "../src/SOFASimpleFreeFieldSOS.h"
 #include "../src/SOFASimpleHeadphoneIR.h"
@@ -76,7 +90,10 @@ http://www.sofaconventions.org
 #include "../src/SOFAGeneralTF.h"
 #include "../src/SOFASingleRoomDRIR.h"
 #include "../src/SOFAUnits.h"
+#include "../src/SOFAValidationReport.h"
 #include "../src/SOFAVersion.h"
+#include "../src/SOFAWriteOptions.h"
+#include "../src/SOFAWriter.h"
 #include "../src/SOFAHelper.h"
 #include "../src/SOFAAmbisonicsDRIR.h"
 
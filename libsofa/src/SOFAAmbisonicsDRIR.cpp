@@ -80,49 +80,80 @@ std::string AmbisonicsDRIR::GetConventionVersion()
  *  @brief          Class constructor
  *  @param[in]      path : the file path
  *  @param[in]      mode : opening mode
+ *  @param[in]      options : chunk cache settings of the variables
  *
  */
 /************************************************************************************/
 AmbisonicsDRIR::AmbisonicsDRIR(const std::string &path,
-                               const netCDF::NcFile::FileMode &mode)
-: sofa::File( path, mode )
+                               const netCDF::NcFile::FileMode &mode,
+                               const sofa::OpenOptions &options)
+: sofa::File( path, mode, options )
 {
 }
 
-bool AmbisonicsDRIR::checkGlobalAttributes() const
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : opens, read-only, the image of a file held in memory
+ *  @param[in]      buffer : the file image; it is not copied, and must outlive this object
+ *  @param[in]      options : chunk cache settings of the variables
+ *
+ */
+/************************************************************************************/
+AmbisonicsDRIR::AmbisonicsDRIR(const sofa::MemoryBuffer &buffer,
+                               const sofa::OpenOptions &options)
+: sofa::File( buffer, options )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor sharing the handle of a sofa::File already opened,
+ *                  so that the AmbisonicsDRIR checks can be run without opening the file again
+ *  @param[in]      sharedFile : the file to share; it must outlive this object
+ *
+ */
+/************************************************************************************/
+AmbisonicsDRIR::AmbisonicsDRIR(const sofa::File &sharedFile)
+: sofa::File( &sharedFile )
+{
+}
+
+bool AmbisonicsDRIR::checkGlobalAttributes(sofa::ValidationReport &report) const
 {
     sofa::Attributes attributes;
     GetGlobalAttributes( attributes );
     
-    sofa::File::ensureSOFAConvention( "AmbisonicsDRIR" );
-    sofa::File::ensureDataType( "FIRE" );
+    const std::size_t numIssues = report.GetNumIssues();
+    
+    sofa::File::ensureSOFAConvention( "AmbisonicsDRIR", report );
+    sofa::File::ensureDataType( "FIRE", report );
     
     /* Convention-specific compulsory Global Attributes */
-    sofa::File::ensureGlobalAttribute( "AmbisonicsOrder" );
+    sofa::File::ensureGlobalAttribute( "AmbisonicsOrder", report );
     
-    return true;
+    return ( report.GetNumIssues() == numIssues );
 }
 
-bool AmbisonicsDRIR::checkListenerVariables() const
+bool AmbisonicsDRIR::checkListenerVariables(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );
     if( I != 1 )
     {
-        SOFA_THROW( "invalid SOFA dimension : I" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : I", "I" );
         return false;
     }
     
     const long C = GetDimension( "C" );
     if( C != 3 )
     {
-        SOFA_THROW( "invalid SOFA dimension : C" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : C", "C" );
         return false;
     }
     
     const long M = GetNumMeasurements();
     if( M <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : M" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : M", "M" );
         return false;
     }
     
@@ -130,14 +161,14 @@ bool AmbisonicsDRIR::checkListenerVariables() const
     
     if( R <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : R" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : R", "R" );
         return false;
     }
     
     const long E = GetDimension("E");
     if( M <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : E" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : E", "E" );
         return false;
     }
  
@@ -172,14 +203,14 @@ bool AmbisonicsDRIR::checkListenerVariables() const
     
     if( listener.IsValid() == false )
     {
-        SOFA_THROW( "invalid 'Listener' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Listener' variables", "Listener" );
         return false;
     }
     
     if( listener.ListenerPositionHasDimensions(  I,  C ) == false
        && listener.ListenerPositionHasDimensions(  M,  C ) == false )
     {
-        SOFA_THROW( "invalid 'ListenerPosition' dimensions" );
+        reportDimensions( report, "invalid 'ListenerPosition' dimensions", "ListenerPosition", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
         return false;
     }
     
@@ -189,13 +220,13 @@ bool AmbisonicsDRIR::checkListenerVariables() const
         if( listener.ListenerUpHasDimensions(  I,  C ) == false
            && listener.ListenerUpHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'ListenerUp' dimensions" );
+            reportDimensions( report, "invalid 'ListenerUp' dimensions", "ListenerUp", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
     else
     {
-        SOFA_THROW( "missing 'ListenerUp' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'ListenerUp' variable", "ListenerUp" );
         return false;
     }
     
@@ -205,13 +236,13 @@ bool AmbisonicsDRIR::checkListenerVariables() const
         if( listener.ListenerViewHasDimensions(  I,  C ) == false
            && listener.ListenerViewHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'ListenerView' dimensions" );
+            reportDimensions( report, "invalid 'ListenerView' dimensions", "ListenerView", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
     else
     {
-        SOFA_THROW( "missing 'ListenerView' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'ListenerView' variable", "ListenerView" );
         return false;
     }
     
@@ -225,14 +256,14 @@ bool AmbisonicsDRIR::checkListenerVariables() const
     
     if( source.IsValid() == false )
     {
-        SOFA_THROW( "invalid 'Source' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Source' variables", "Source" );
         return false;
     }
     
     if( source.SourcePositionHasDimensions(  I,  C ) == false
        && source.SourcePositionHasDimensions(  M,  C ) == false )
     {
-        SOFA_THROW( "invalid 'SourcePosition' dimensions" );
+        reportDimensions( report, "invalid 'SourcePosition' dimensions", "SourcePosition", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
         return false;
     }
     
@@ -242,13 +273,13 @@ bool AmbisonicsDRIR::checkListenerVariables() const
         if( source.SourceUpHasDimensions(  I,  C ) == false
            && source.SourceUpHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'SourceUp' dimensions" );
+            reportDimensions( report, "invalid 'SourceUp' dimensions", "SourceUp", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
     else
     {
-        SOFA_THROW( "missing 'SourceUp' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'SourceUp' variable", "SourceUp" );
         return false;
     }
     
@@ -258,13 +289,13 @@ bool AmbisonicsDRIR::checkListenerVariables() const
         if( source.SourceViewHasDimensions(  I,  C ) == false
            && source.SourceViewHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'SourceView' dimensions" );
+            reportDimensions( report, "invalid 'SourceView' dimensions", "SourceView", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
     else
     {
-        SOFA_THROW( "missing 'SourceView' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'SourceView' variable", "SourceView" );
         return false;
     }
     
@@ -278,14 +309,14 @@ bool AmbisonicsDRIR::checkListenerVariables() const
     
     if( receiver.IsValid() == false )
     {
-        SOFA_THROW( "invalid 'Receiver' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Receiver' variables", "Receiver" );
         return false;
     }
     
     if( receiver.ReceiverPositionHasDimensions(  R, C, I  ) == false
        && receiver.ReceiverPositionHasDimensions(  R, C, M  ) == false )
     {
-        SOFA_THROW( "invalid 'ReceiverPosition' dimensions" );
+        reportDimensions( report, "invalid 'ReceiverPosition' dimensions", "ReceiverPosition", sofa::ValidationReport::Dimensions( R, C, I ), sofa::ValidationReport::Dimensions( R, C, M ) );
         return false;
     }
     
@@ -298,14 +329,14 @@ bool AmbisonicsDRIR::checkListenerVariables() const
     
     if( emitter.IsValid() == false )
     {
-        SOFA_THROW( "invalid 'Emitter' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Emitter' variables", "Emitter" );
         return false;
     }
     
     if( emitter.EmitterPositionHasDimensions(  E, C, I  ) == false
        && emitter.EmitterPositionHasDimensions(  E, C, M  ) == false )
     {
-        SOFA_THROW( "invalid 'EmitterPosition' dimensions" );
+        reportDimensions( report, "invalid 'EmitterPosition' dimensions", "EmitterPosition", sofa::ValidationReport::Dimensions( E, C, I ), sofa::ValidationReport::Dimensions( E, C, M ) );
         return false;
     }
     
@@ -314,35 +345,35 @@ bool AmbisonicsDRIR::checkListenerVariables() const
 }
 
 
-bool AmbisonicsDRIR::checkEmitterVariables() const
+bool AmbisonicsDRIR::checkEmitterVariables(sofa::ValidationReport &report) const
 {
     /* Ensure Constants */
     
     const long I = GetDimension( "I" );
     if( I != 1 )
     {
-        SOFA_THROW( "invalid SOFA dimension : I" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : I", "I" );
         return false;
     }
     
     const long C = GetDimension( "C" );
     if( C != 3 )
     {
-        SOFA_THROW( "invalid SOFA dimension : C" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : C", "C" );
         return false;
     }
     
     const long M = GetNumMeasurements();
     if( M <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : M" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : M", "M" );
         return false;
     }
 
     const long E = GetNumEmitters();
     if( E <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : E" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : E", "E" );
         return false;
     }
     
@@ -357,13 +388,13 @@ bool AmbisonicsDRIR::checkEmitterVariables() const
     
     if( source.IsValid() == false )
     {
-        SOFA_THROW( "invalid 'Source' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Source' variables", "Source" );
         return false;
     }
     
     if( source.SourcePositionHasDimensions(  I,  C ) == false )
     {
-        SOFA_THROW( "invalid 'SourcePosition' dimensions" );
+        reportDimensions( report, "invalid 'SourcePosition' dimensions", "SourcePosition", sofa::ValidationReport::Dimensions( I, C ) );
         return false;
     }
     
@@ -376,14 +407,14 @@ bool AmbisonicsDRIR::checkEmitterVariables() const
     
     if( emitter.IsValid() == false )
     {
-        SOFA_THROW( "invalid 'Emitter' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Emitter' variables", "Emitter" );
         return false;
     }
     
     if( emitter.EmitterPositionHasDimensions( E, C, I ) == false
        && emitter.EmitterPositionHasDimensions( E, C, M ) == false )
     {
-        SOFA_THROW( "invalid 'EmitterPostion' dimensions" );
+        reportDimensions( report, "invalid 'EmitterPostion' dimensions", "EmitterPosition", sofa::ValidationReport::Dimensions( E, C, I ), sofa::ValidationReport::Dimensions( E, C, M ) );
         return false;
     }
     
@@ -393,13 +424,13 @@ bool AmbisonicsDRIR::checkEmitterVariables() const
         if( emitter.EmitterUpHasDimensions( E, C, I ) == false
            && emitter.EmitterUpHasDimensions( E, C, M ) == false )
         {
-            SOFA_THROW( "invalid 'EmitterUp' dimensions" );
+            reportDimensions( report, "invalid 'EmitterUp' dimensions", "EmitterUp", sofa::ValidationReport::Dimensions( E, C, I ), sofa::ValidationReport::Dimensions( E, C, M ) );
             return false;
         }
     }
     else
     {
-        SOFA_THROW( "missing 'EmitterUp' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'EmitterUp' variable", "EmitterUp" );
         return false;
     }
     
@@ -409,13 +440,13 @@ bool AmbisonicsDRIR::checkEmitterVariables() const
         if( emitter.EmitterViewHasDimensions( E, C, I ) == false
            && emitter.EmitterViewHasDimensions( E, C, M ) == false )
         {
-            SOFA_THROW( "invalid 'EmitterView' dimensions" );
+            reportDimensions( report, "invalid 'EmitterView' dimensions", "EmitterView", sofa::ValidationReport::Dimensions( E, C, I ), sofa::ValidationReport::Dimensions( E, C, M ) );
             return false;
         }
     }
     else
     {
-        SOFA_THROW( "missing 'EmitterView' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'EmitterView' variable", "EmitterView" );
         return false;
     }
     
@@ -423,7 +454,7 @@ bool AmbisonicsDRIR::checkEmitterVariables() const
     return true;
 }
 
-bool AmbisonicsDRIR::checkDataIRVariables() const
+bool AmbisonicsDRIR::checkDataIRVariables(sofa::ValidationReport &report) const
 {
     /* Ensure Channel Ordering and Normalization exist */
     
@@ -434,14 +465,14 @@ bool AmbisonicsDRIR::checkDataIRVariables() const
     result = GetDataIRChannelOrdering( channelOrdering );
     if( result == false )
     {
-        SOFA_THROW( "Attribute 'Data.IR:ChannelOrdering missing" );
+        report.Add( sofa::ValidationReport::kMissingAttribute, "Attribute 'Data.IR:ChannelOrdering missing", "Data.IR:ChannelOrdering" );
         return false;
     }
     
     result = GetDataIRNormalization( normalization );
     if( result == false )
     {
-        SOFA_THROW( "Attribute 'Data.IR:Normalization missing" );
+        report.Add( sofa::ValidationReport::kMissingAttribute, "Attribute 'Data.IR:Normalization missing", "Data.IR:Normalization" );
         return false;
     }
     
@@ -457,46 +488,60 @@ bool AmbisonicsDRIR::checkDataIRVariables() const
 /************************************************************************************/
 bool AmbisonicsDRIR::IsValid() const
 {
-    if( sofa::File::IsValid() == false )
-    {
-        return false;
-    }
+    sofa::ValidationReport report;
     
-    if( IsFIREDataType() == false )
+    if( AmbisonicsDRIR::Validate( report ) == true )
     {
-        SOFA_THROW( "'DataType' shall be FIRE" );
-        return false;
+        return true;
     }
     
-    if( checkGlobalAttributes() == false )
-    {
-        return false;
-    }
-    
-    if( checkListenerVariables() == false )
+    return raiseFirstIssue( report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the file against the AmbisonicsDRIR convention, and collects all
+ *                  the issues found into a report. Never throws an exception
+ *  @param[out]     report : the issues are appended to this report
+ *  @return         true if this is a valid SOFA file with AmbisonicsDRIR convention
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::Validate(sofa::ValidationReport &report) const
+{
+    return validateOnce( report, conventionValidation, *this, &AmbisonicsDRIR::checkValidity );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Runs all the checks of the AmbisonicsDRIR convention; called once by Validate()
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::checkValidity(sofa::ValidationReport &report) const
+{
+    if( sofa::File::Validate( report ) == false )
     {
         return false;
     }
     
-    if( checkSourceVariables() == false )
-    {
-        return false;
-    }
+    const std::size_t numIssues = report.GetNumIssues();
     
-    if( checkEmitterVariables() == false )
+    if( IsFIREDataType() == false )
     {
-        return false;
+        report.Add( sofa::ValidationReport::kInvalidDataType, "'DataType' shall be FIRE", "DataType" );
     }
     
-    if( checkDataIRVariables() == false )
-    {
-        return false;
-    }
+    checkGlobalAttributes( report );
+    checkListenerVariables( report );
+    checkSourceVariables( report );
+    checkEmitterVariables( report );
+    checkDataIRVariables( report );
     
     SOFA_ASSERT( GetDimension( "I" ) == 1 );
     SOFA_ASSERT( GetDimension( "C" ) == 3 );
     
-    return true;
+    return ( report.GetNumIssues() == numIssues );
 }
 
 /************************************************************************************/
@@ -550,6 +595,30 @@ bool AmbisonicsDRIR::GetDataIR(double *values,
     return NetCDFFile::GetValues( values, dim1, dim2, dim3, dim4, "Data.IR" );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough
+ *  @param[in]      dim1 : first dimension (M)
+ *  @param[in]      dim2 : second dimension (R)
+ *  @param[in]      dim3 : third dimension (N)
+ *  @param[in]      dim4 : fourth dimension (E)
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(float *values,
+                               const unsigned long dim1,
+                               const unsigned long dim2,
+                               const unsigned long dim3,
+                               const unsigned long dim4) const
+{
+    /// Data.IR is [ M R N E ]
+    
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, dim4, "Data.IR" );
+}
+
 
 
 /************************************************************************************/
@@ -593,6 +662,293 @@ bool AmbisonicsDRIR::GetDataIR(std::vector< double > &values) const
     return sofa::File::getDataIR( values );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array shaped like Data.IR
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(sofa::Array< double > &values) const
+{
+    /// Data.IR is [ M R N E ]
+    
+    return sofa::File::getDataIR( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, in a given layout
+ *                  (e.g. one planar block per receiver, or samples interleaved across receivers)
+ *  @param[in]      values : the array is resized if needed
+ *  @param[in]      layout : the requested layout
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(sofa::Array< double > &values,
+                               const sofa::DataLayout::Type &layout) const
+{
+    /// Data.IR is [ M R N E ]
+    
+    return sofa::File::getDataIR( values, layout );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, each impulse response being written at the
+ *                  beginning of its own (zero-padded) slot, e.g. ready for a FFT
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. the product of all the
+ *                  dimensions of Data.IR but the last one, times padding.GetSlotSize( N )
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(double *values,
+                               const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R E N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, each impulse
+ *                  response being written at the beginning of its own (zero-padded) slot
+ *  @param[in]      values : the array is resized if needed (the last dimension is the slot size)
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(sofa::Array< double > &values,
+                               const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R E N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(std::vector< float > &values) const
+{
+    /// Data.IR is [ M R N E ]
+    
+    return sofa::File::getDataIR( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array shaped like Data.IR, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(sofa::Array< float > &values) const
+{
+    /// Data.IR is [ M R N E ]
+    
+    return sofa::File::getDataIR( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, in a given layout, as float
+ *                  (e.g. one planar block per receiver, or samples interleaved across receivers)
+ *  @param[in]      values : the array is resized if needed
+ *  @param[in]      layout : the requested layout
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(sofa::Array< float > &values,
+                               const sofa::DataLayout::Type &layout) const
+{
+    /// Data.IR is [ M R N E ]
+    
+    return sofa::File::getDataIR( values, layout );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, each impulse response being written at the
+ *                  beginning of its own (zero-padded) slot, e.g. ready for a FFT, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. the product of all the
+ *                  dimensions of Data.IR but the last one, times padding.GetSlotSize( N )
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(float *values,
+                               const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R E N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, each impulse
+ *                  response being written at the beginning of its own (zero-padded) slot, as float
+ *  @param[in]      values : the array is resized if needed (the last dimension is the slot size)
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(sofa::Array< float > &values,
+                               const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R E N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a hyperslab of the Data.IR values.
+ *                  Only the requested elements are read from the file
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(double *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const
+{
+    /// Data.IR is [ M R E N ]
+    
+    return sofa::File::getDataIR( values, start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a hyperslab of the Data.IR values, as float.
+ *                  Only the requested elements are read from the file
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIR(float *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const
+{
+    /// Data.IR is [ M R E N ]
+    
+    return sofa::File::getDataIR( values, start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of consecutive measurements
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (numMeasurements x R x E x N)
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIRMeasurements(double *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    return sofa::File::getDataIRMeasurements( values, firstMeasurement, numMeasurements );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of consecutive measurements, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (numMeasurements x R x E x N)
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIRMeasurements(float *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    return sofa::File::getDataIRMeasurements( values, firstMeasurement, numMeasurements );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one receiver, for all measurements
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (M x E x N)
+ *  @param[in]      receiver : index of the receiver to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIRReceiver(double *values, const unsigned long receiver) const
+{
+    return sofa::File::getDataIRReceiver( values, receiver );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one receiver, for all measurements, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (M x E x N)
+ *  @param[in]      receiver : index of the receiver to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIRReceiver(float *values, const unsigned long receiver) const
+{
+    return sofa::File::getDataIRReceiver( values, receiver );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one emitter, for all measurements and receivers
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (M x R x N)
+ *  @param[in]      emitter : index of the emitter to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIREmitter(double *values, const unsigned long emitter) const
+{
+    return sofa::File::getDataIREmitter( values, emitter );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one emitter, for all measurements and receivers, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (M x R x N)
+ *  @param[in]      emitter : index of the emitter to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataIREmitter(float *values, const unsigned long emitter) const
+{
+    return sofa::File::getDataIREmitter( values, emitter );
+}
+
 
 bool AmbisonicsDRIR::GetDataDelay(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
 {
@@ -601,4 +957,41 @@ bool AmbisonicsDRIR::GetDataDelay(double *values, const unsigned long dim1, cons
     return sofa::File::getDataDelay( values, dim1, dim2, dim3 );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values into a N-dimensional array shaped like Data.Delay
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataDelay(sofa::Array< double > &values) const
+{
+    /// Data.Delay is [ I R E ] or [ M R E ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
+bool AmbisonicsDRIR::GetDataDelay(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    /// Data.Delay is [ I R E ] or [ M R E ]
+    
+    return sofa::File::getDataDelay( values, dim1, dim2, dim3 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values into a N-dimensional array shaped like Data.Delay, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicsDRIR::GetDataDelay(sofa::Array< float > &values) const
+{
+    /// Data.Delay is [ I R E ] or [ M R E ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
 
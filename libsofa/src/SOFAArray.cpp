@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAArray.cpp
+ *   @brief      N-dimensional arrays with aligned storage, and strided views
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAArray.h"
+#include <cstdlib>
+#include <stdint.h>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Allocates a block of memory aligned on kArrayAlignment bytes
+ *  @param[in]      numBytes : size of the block
+ *  @return         NULL if the allocation failed (or if numBytes is 0)
+ *
+ *  @details        The block is over-allocated, and the address returned by malloc
+ *                  is stored right before the aligned address (portable, unlike
+ *                  posix_memalign / _aligned_malloc)
+ */
+/************************************************************************************/
+void * sofa::AlignedMalloc(const std::size_t numBytes)
+{
+    if( numBytes == 0 )
+    {
+        return NULL;
+    }
+    
+    void *block = std::malloc( numBytes + kArrayAlignment + sizeof( void * ) );
+    
+    if( block == NULL )
+    {
+        return NULL;
+    }
+    
+    const uintptr_t start   = reinterpret_cast< uintptr_t >( block ) + sizeof( void * );
+    const uintptr_t aligned = ( start + kArrayAlignment - 1 ) & ~( (uintptr_t) kArrayAlignment - 1 );
+    
+    void **ptr = reinterpret_cast< void ** >( aligned );
+    ptr[-1] = block;
+    
+    return ptr;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Releases a block allocated by AlignedMalloc (NULL is ignored)
+ *
+ */
+/************************************************************************************/
+void sofa::AlignedFree(void *ptr)
+{
+    if( ptr != NULL )
+    {
+        std::free( static_cast< void ** >( ptr )[-1] );
+    }
+}
+
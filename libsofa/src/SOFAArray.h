@@ -0,0 +1,663 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAArray.h
+ *   @brief      N-dimensional arrays with aligned storage, and strided views
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_ARRAY_H__
+#define _SOFA_ARRAY_H__
+
+#include "../src/SOFAPlatform.h"
+#include <cstddef>
+
+namespace sofa
+{
+    /// alignment of the storage of sofa::Array, in bytes (a cache line, suitable for any SIMD instruction set)
+    static const std::size_t kArrayAlignment = 64;
+    
+    /// maximum number of dimensions of sofa::Array (SOFA variables have at most 4 dimensions, e.g. Data.IR [M R E N])
+    static const std::size_t kArrayMaxRank = 4;
+    
+    SOFA_API void * AlignedMalloc(const std::size_t numBytes);
+    SOFA_API void AlignedFree(void *ptr);
+    
+    /************************************************************************************/
+    /*!
+     *  @class          ArrayView
+     *  @brief          Non-owning view on a N-dimensional array (N <= 4)
+     *
+     *  @details        The view holds the shape of the array, and the stride (in elements)
+     *                  of each dimension : it may describe a contiguous array, or e.g. all the
+     *                  measurements of one receiver of a Data.IR [M R N].
+     *                  The element accessors only check the indices in debug builds.
+     *                  Use ArrayView< const T > for read-only views.
+     */
+    /************************************************************************************/
+    template< typename T >
+    class ArrayView
+    {
+    public:
+        ArrayView();
+        
+        ArrayView(T *data,
+                  const std::vector< std::size_t > &dims);
+        
+        ArrayView(T *data,
+                  const std::size_t rank,
+                  const std::size_t *dims,
+                  const std::ptrdiff_t *strides);
+        
+        template< typename U >
+        ArrayView(const ArrayView< U > &other);
+        
+        bool IsEmpty() const;
+        bool IsContiguous() const;
+        
+        T * GetData() const;
+        std::size_t GetRank() const;
+        std::size_t GetDimension(const std::size_t dimension) const;
+        std::ptrdiff_t GetStride(const std::size_t dimension) const;
+        std::vector< std::size_t > GetDimensions() const;
+        std::size_t GetNumElements() const;
+        
+        T & operator()(const std::size_t i) const;
+        T & operator()(const std::size_t i, const std::size_t j) const;
+        T & operator()(const std::size_t i, const std::size_t j, const std::size_t k) const;
+        T & operator()(const std::size_t i, const std::size_t j, const std::size_t k, const std::size_t l) const;
+        
+        ArrayView< T > Select(const std::size_t dimension, const std::size_t index) const;
+        ArrayView< T > operator[](const std::size_t index) const;
+    
+    private:
+        template< typename U > friend class ArrayView;
+        
+        T *data;
+        std::size_t rank;
+        std::size_t dims[ kArrayMaxRank ];
+        std::ptrdiff_t strides[ kArrayMaxRank ];    ///< in elements
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          Array
+     *  @brief          Owning, contiguous (row-major) N-dimensional array (N <= 4)
+     *
+     *  @details        The storage is aligned on kArrayAlignment bytes. It is reused when the
+     *                  array is resized to a smaller or equal number of elements, so that an
+     *                  array can be filled again and again without any allocation.
+     *                  T shall be an arithmetic type : the elements are not initialized.
+     *                  Select() returns strided views, e.g. one measurement, one receiver or
+     *                  one emitter of a Data.IR, without copying anything.
+     */
+    /************************************************************************************/
+    template< typename T >
+    class Array
+    {
+    public:
+        Array();
+        explicit Array(const std::vector< std::size_t > &dims);
+        ~Array();
+        
+        bool Resize(const std::vector< std::size_t > &dims);
+        void Clear();
+        
+        bool IsEmpty() const;
+        
+        T * GetData();
+        const T * GetData() const;
+        
+        std::size_t GetRank() const;
+        std::size_t GetDimension(const std::size_t dimension) const;
+        std::ptrdiff_t GetStride(const std::size_t dimension) const;
+        std::vector< std::size_t > GetDimensions() const;
+        std::size_t GetNumElements() const;
+        
+        const sofa::ArrayView< T > & GetView();
+        sofa::ArrayView< const T > GetView() const;
+        
+        T & operator()(const std::size_t i);
+        T & operator()(const std::size_t i, const std::size_t j);
+        T & operator()(const std::size_t i, const std::size_t j, const std::size_t k);
+        T & operator()(const std::size_t i, const std::size_t j, const std::size_t k, const std::size_t l);
+        
+        const T & operator()(const std::size_t i) const;
+        const T & operator()(const std::size_t i, const std::size_t j) const;
+        const T & operator()(const std::size_t i, const std::size_t j, const std::size_t k) const;
+        const T & operator()(const std::size_t i, const std::size_t j, const std::size_t k, const std::size_t l) const;
+        
+        sofa::ArrayView< T > Select(const std::size_t dimension, const std::size_t index);
+        sofa::ArrayView< const T > Select(const std::size_t dimension, const std::size_t index) const;
+        
+        sofa::ArrayView< T > operator[](const std::size_t index);
+        sofa::ArrayView< const T > operator[](const std::size_t index) const;
+    
+    private:
+        T *data;
+        std::size_t capacity;               ///< number of elements allocated
+        sofa::ArrayView< T > view;          ///< contiguous view on the whole array
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( Array );
+    };
+    
+    //==============================================================================
+    // ArrayView
+    //==============================================================================
+    template< typename T >
+    ArrayView< T >::ArrayView()
+    : data( NULL )
+    , rank( 0 )
+    {
+        for( std::size_t i = 0; i < kArrayMaxRank; i++ )
+        {
+            dims[i]    = 0;
+            strides[i] = 0;
+        }
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Contiguous (row-major) view
+     *  @param[in]      data : the first element
+     *  @param[in]      dims : size of each dimension (at most kArrayMaxRank dimensions)
+     *
+     */
+    /************************************************************************************/
+    template< typename T >
+    ArrayView< T >::ArrayView(T *data_,
+                              const std::vector< std::size_t > &dims_)
+    : data( data_ )
+    , rank( dims_.size() )
+    {
+        SOFA_ASSERT( rank <= kArrayMaxRank );
+        
+        std::ptrdiff_t stride = 1;
+        
+        for( std::size_t i = kArrayMaxRank; i > 0; i-- )
+        {
+            const std::size_t d = i - 1;
+            
+            if( d < rank )
+            {
+                dims[d]    = dims_[d];
+                strides[d] = stride;
+                stride    *= (std::ptrdiff_t) dims_[d];
+            }
+            else
+            {
+                dims[d]    = 0;
+                strides[d] = 0;
+            }
+        }
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Strided view
+     *  @param[in]      data : the first element
+     *  @param[in]      rank : number of dimensions (at most kArrayMaxRank)
+     *  @param[in]      dims : size of each dimension
+     *  @param[in]      strides : distance between two consecutive elements of each dimension, in elements
+     *
+     */
+    /************************************************************************************/
+    template< typename T >
+    ArrayView< T >::ArrayView(T *data_,
+                              const std::size_t rank_,
+                              const std::size_t *dims_,
+                              const std::ptrdiff_t *strides_)
+    : data( data_ )
+    , rank( rank_ )
+    {
+        SOFA_ASSERT( rank <= kArrayMaxRank );
+        
+        for( std::size_t i = 0; i < kArrayMaxRank; i++ )
+        {
+            dims[i]    = ( i < rank ) ? dims_[i] : 0;
+            strides[i] = ( i < rank ) ? strides_[i] : 0;
+        }
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Conversion constructor, e.g. from ArrayView< T > to ArrayView< const T >
+     *
+     */
+    /************************************************************************************/
+    template< typename T >
+    template< typename U >
+    ArrayView< T >::ArrayView(const ArrayView< U > &other)
+    : data( other.data )
+    , rank( other.rank )
+    {
+        for( std::size_t i = 0; i < kArrayMaxRank; i++ )
+        {
+            dims[i]    = other.dims[i];
+            strides[i] = other.strides[i];
+        }
+    }
+    
+    template< typename T >
+    bool ArrayView< T >::IsEmpty() const
+    {
+        return ( GetNumElements() == 0 );
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns true if the elements are stored contiguously, in row-major order
+     *
+     */
+    /************************************************************************************/
+    template< typename T >
+    bool ArrayView< T >::IsContiguous() const
+    {
+        std::ptrdiff_t stride = 1;
+        
+        for( std::size_t i = rank; i > 0; i-- )
+        {
+            if( dims[i - 1] > 1 && strides[i - 1] != stride )
+            {
+                return false;
+            }
+            
+            stride *= (std::ptrdiff_t) dims[i - 1];
+        }
+        
+        return true;
+    }
+    
+    template< typename T >
+    T * ArrayView< T >::GetData() const
+    {
+        return data;
+    }
+    
+    template< typename T >
+    std::size_t ArrayView< T >::GetRank() const
+    {
+        return rank;
+    }
+    
+    template< typename T >
+    std::size_t ArrayView< T >::GetDimension(const std::size_t dimension) const
+    {
+        return ( dimension < rank ) ? dims[dimension] : 0;
+    }
+    
+    template< typename T >
+    std::ptrdiff_t ArrayView< T >::GetStride(const std::size_t dimension) const
+    {
+        return ( dimension < rank ) ? strides[dimension] : 0;
+    }
+    
+    template< typename T >
+    std::vector< std::size_t > ArrayView< T >::GetDimensions() const
+    {
+        return std::vector< std::size_t >( dims, dims + rank );
+    }
+    
+    template< typename T >
+    std::size_t ArrayView< T >::GetNumElements() const
+    {
+        if( rank == 0 || data == NULL )
+        {
+            return 0;
+        }
+        
+        std::size_t numElements = 1;
+        
+        for( std::size_t i = 0; i < rank; i++ )
+        {
+            numElements *= dims[i];
+        }
+        
+        return numElements;
+    }
+    
+    template< typename T >
+    T & ArrayView< T >::operator()(const std::size_t i) const
+    {
+        SOFA_ASSERT( rank == 1 && i < dims[0] );
+        
+        return data[ i * strides[0] ];
+    }
+    
+    template< typename T >
+    T & ArrayView< T >::operator()(const std::size_t i, const std::size_t j) const
+    {
+        SOFA_ASSERT( rank == 2 && i < dims[0] && j < dims[1] );
+        
+        return data[ i * strides[0] + j * strides[1] ];
+    }
+    
+    template< typename T >
+    T & ArrayView< T >::operator()(const std::size_t i, const std::size_t j, const std::size_t k) const
+    {
+        SOFA_ASSERT( rank == 3 && i < dims[0] && j < dims[1] && k < dims[2] );
+        
+        return data[ i * strides[0] + j * strides[1] + k * strides[2] ];
+    }
+    
+    template< typename T >
+    T & ArrayView< T >::operator()(const std::size_t i, const std::size_t j, const std::size_t k, const std::size_t l) const
+    {
+        SOFA_ASSERT( rank == 4 && i < dims[0] && j < dims[1] && k < dims[2] && l < dims[3] );
+        
+        return data[ i * strides[0] + j * strides[1] + k * strides[2] + l * strides[3] ];
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns the view of rank N-1 obtained by fixing one dimension,
+     *                  e.g. Select( 1, r ) on a Data.IR [M R N] gives the [M N] view of receiver r
+     *  @param[in]      dimension : the dimension to fix
+     *  @param[in]      index : the index along this dimension
+     *  @return         an empty view if the dimension or the index is out of range
+     *
+     */
+    /************************************************************************************/
+    template< typename T >
+    ArrayView< T > ArrayView< T >::Select(const std::size_t dimension, const std::size_t index) const
+    {
+        if( dimension >= rank || index >= dims[dimension] )
+        {
+            return ArrayView< T >();
+        }
+        
+        std::size_t newDims[ kArrayMaxRank ];
+        std::ptrdiff_t newStrides[ kArrayMaxRank ];
+        
+        std::size_t n = 0;
+        
+        for( std::size_t i = 0; i < rank; i++ )
+        {
+            if( i != dimension )
+            {
+                newDims[n]    = dims[i];
+                newStrides[n] = strides[i];
+                n++;
+            }
+        }
+        
+        return ArrayView< T >( data + index * strides[dimension], rank - 1, newDims, newStrides );
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns the view of rank N-1 obtained by fixing the first dimension,
+     *                  e.g. one measurement of a Data.IR
+     *
+     */
+    /************************************************************************************/
+    template< typename T >
+    ArrayView< T > ArrayView< T >::operator[](const std::size_t index) const
+    {
+        return Select( 0, index );
+    }
+    
+    //==============================================================================
+    // Array
+    //==============================================================================
+    template< typename T >
+    Array< T >::Array()
+    : data( NULL )
+    , capacity( 0 )
+    , view()
+    {
+    }
+    
+    template< typename T >
+    Array< T >::Array(const std::vector< std::size_t > &dims)
+    : data( NULL )
+    , capacity( 0 )
+    , view()
+    {
+        Resize( dims );
+    }
+    
+    template< typename T >
+    Array< T >::~Array()
+    {
+        sofa::AlignedFree( data );
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Changes the shape of the array. The storage is only reallocated if
+     *                  it is too small; the values are undefined after a call to Resize
+     *  @param[in]      dims : size of each dimension (at most kArrayMaxRank dimensions)
+     *  @return         false if there are too many dimensions, or if the allocation failed
+     *
+     */
+    /************************************************************************************/
+    template< typename T >
+    bool Array< T >::Resize(const std::vector< std::size_t > &dims)
+    {
+        if( dims.size() > kArrayMaxRank )
+        {
+            return false;
+        }
+        
+        std::size_t numElements = ( dims.size() > 0 ) ? 1 : 0;
+        
+        for( std::size_t i = 0; i < dims.size(); i++ )
+        {
+            numElements *= dims[i];
+        }
+        
+        if( numElements > capacity )
+        {
+            sofa::AlignedFree( data );
+            
+            data     = static_cast< T * >( sofa::AlignedMalloc( numElements * sizeof( T ) ) );
+            capacity = ( data != NULL ) ? numElements : 0;
+            
+            if( data == NULL )
+            {
+                view = sofa::ArrayView< T >();
+                return false;
+            }
+        }
+        
+        view = sofa::ArrayView< T >( data, dims );
+        
+        return true;
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Releases the storage
+     *
+     */
+    /************************************************************************************/
+    template< typename T >
+    void Array< T >::Clear()
+    {
+        sofa::AlignedFree( data );
+        
+        data     = NULL;
+        capacity = 0;
+        view     = sofa::ArrayView< T >();
+    }
+    
+    template< typename T >
+    bool Array< T >::IsEmpty() const
+    {
+        return view.IsEmpty();
+    }
+    
+    template< typename T >
+    T * Array< T >::GetData()
+    {
+        return data;
+    }
+    
+    template< typename T >
+    const T * Array< T >::GetData() const
+    {
+        return data;
+    }
+    
+    template< typename T >
+    std::size_t Array< T >::GetRank() const
+    {
+        return view.GetRank();
+    }
+    
+    template< typename T >
+    std::size_t Array< T >::GetDimension(const std::size_t dimension) const
+    {
+        return view.GetDimension( dimension );
+    }
+    
+    template< typename T >
+    std::ptrdiff_t Array< T >::GetStride(const std::size_t dimension) const
+    {
+        return view.GetStride( dimension );
+    }
+    
+    template< typename T >
+    std::vector< std::size_t > Array< T >::GetDimensions() const
+    {
+        return view.GetDimensions();
+    }
+    
+    template< typename T >
+    std::size_t Array< T >::GetNumElements() const
+    {
+        return view.GetNumElements();
+    }
+    
+    template< typename T >
+    const sofa::ArrayView< T > & Array< T >::GetView()
+    {
+        return view;
+    }
+    
+    template< typename T >
+    sofa::ArrayView< const T > Array< T >::GetView() const
+    {
+        return sofa::ArrayView< const T >( view );
+    }
+    
+    template< typename T >
+    T & Array< T >::operator()(const std::size_t i)
+    {
+        return view( i );
+    }
+    
+    template< typename T >
+    T & Array< T >::operator()(const std::size_t i, const std::size_t j)
+    {
+        return view( i, j );
+    }
+    
+    template< typename T >
+    T & Array< T >::operator()(const std::size_t i, const std::size_t j, const std::size_t k)
+    {
+        return view( i, j, k );
+    }
+    
+    template< typename T >
+    T & Array< T >::operator()(const std::size_t i, const std::size_t j, const std::size_t k, const std::size_t l)
+    {
+        return view( i, j, k, l );
+    }
+    
+    template< typename T >
+    const T & Array< T >::operator()(const std::size_t i) const
+    {
+        return view( i );
+    }
+    
+    template< typename T >
+    const T & Array< T >::operator()(const std::size_t i, const std::size_t j) const
+    {
+        return view( i, j );
+    }
+    
+    template< typename T >
+    const T & Array< T >::operator()(const std::size_t i, const std::size_t j, const std::size_t k) const
+    {
+        return view( i, j, k );
+    }
+    
+    template< typename T >
+    const T & Array< T >::operator()(const std::size_t i, const std::size_t j, const std::size_t k, const std::size_t l) const
+    {
+        return view( i, j, k, l );
+    }
+    
+    template< typename T >
+    sofa::ArrayView< T > Array< T >::Select(const std::size_t dimension, const std::size_t index)
+    {
+        return view.Select( dimension, index );
+    }
+    
+    template< typename T >
+    sofa::ArrayView< const T > Array< T >::Select(const std::size_t dimension, const std::size_t index) const
+    {
+        return GetView().Select( dimension, index );
+    }
+    
+    template< typename T >
+    sofa::ArrayView< T > Array< T >::operator[](const std::size_t index)
+    {
+        return view.Select( 0, index );
+    }
+    
+    template< typename T >
+    sofa::ArrayView< const T > Array< T >::operator[](const std::size_t index) const
+    {
+        return GetView().Select( 0, index );
+    }
+
+}
+
+#endif /* _SOFA_ARRAY_H__ */
+
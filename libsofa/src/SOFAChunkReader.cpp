@@ -0,0 +1,680 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAChunkReader.cpp
+ *   @brief      Reads large chunked variables, decompressing the chunks in parallel
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAChunkReader.h"
+#include "../src/SOFANcUtils.h"
+#include "../src/SOFAUtils.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <stdint.h>
+
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+    #include "../src/SOFAHdf5Utils.h"
+    #include "zlib.h"
+    
+    #if ! H5_VERSION_GE( 1, 10, 3 )
+        /// H5Dread_chunk was added in HDF5 1.10.3
+        #undef SOFA_HDF5_DIRECT_CHUNK_READ
+    #endif
+#endif
+
+using namespace sofa;
+
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+
+namespace ChunkReaderHelper
+{
+    using sofa::Hdf5Utils::ScopedId;
+    using sofa::Hdf5Utils::ScopedErrorSilencer;
+    using sofa::Hdf5Utils::VariableLayout;
+    
+    struct RawChunk
+    {
+        std::vector< hsize_t > offset;
+        std::vector< unsigned char > data;
+        uint32_t filterMask;                    ///< bit i set : filter i was not applied to this chunk
+    };
+    
+    static bool inflate(std::vector< unsigned char > &dst,
+                        const std::vector< unsigned char > &src,
+                        const std::size_t expectedSize)
+    {
+        if( src.empty() == true )
+        {
+            return false;
+        }
+        
+        dst.resize( expectedSize );
+        
+        uLongf size = (uLongf) expectedSize;
+        
+        if( uncompress( &dst[0], &size, &src[0], (uLong) src.size() ) != Z_OK )
+        {
+            return false;
+        }
+        
+        return ( size == expectedSize );
+    }
+    
+    /// inverse of the HDF5 shuffle filter : the bytes of significance b of all the elements are stored contiguously
+    static void unshuffle(std::vector< unsigned char > &dst,
+                          const std::vector< unsigned char > &src,
+                          const std::size_t typeSize)
+    {
+        const std::size_t numElements = src.size() / typeSize;
+        
+        dst.resize( src.size() );
+        
+        for( std::size_t b = 0; b < typeSize; b++ )
+        {
+            const unsigned char *in = &src[0] + b * numElements;
+            
+            for( std::size_t i = 0; i < numElements; i++ )
+            {
+                dst[ i * typeSize + b ] = in[i];
+            }
+        }
+        
+        /// the trailing bytes (if any) are not shuffled
+        for( std::size_t i = numElements * typeSize; i < src.size(); i++ )
+        {
+            dst[i] = src[i];
+        }
+    }
+    
+    template< typename Stored >
+    static Stored readValue(const unsigned char *src, const bool swapBytes)
+    {
+        unsigned char bytes[ sizeof( Stored ) ];
+        
+        if( swapBytes == true )
+        {
+            for( std::size_t b = 0; b < sizeof( Stored ); b++ )
+            {
+                bytes[b] = src[ sizeof( Stored ) - 1 - b ];
+            }
+        }
+        else
+        {
+            std::memcpy( bytes, src, sizeof( Stored ) );
+        }
+        
+        Stored value;
+        std::memcpy( &value, bytes, sizeof( Stored ) );
+        
+        return value;
+    }
+    
+    /// same conversions as the netCDF library (i.e. C casts)
+    template< typename Stored, typename T >
+    static void convertRow(T *dst,
+                           const unsigned char *src,
+                           const std::size_t numElements,
+                           const bool swapBytes)
+    {
+        for( std::size_t i = 0; i < numElements; i++ )
+        {
+            dst[i] = (T) readValue< Stored >( src + i * sizeof( Stored ), swapBytes );
+        }
+    }
+    
+    /// copies the part of a decoded chunk lying inside the variable to the output
+    template< typename T >
+    static void scatter(T *values,
+                        const unsigned char *chunk,
+                        const std::vector< hsize_t > &offset,
+                        const VariableLayout &layout)
+    {
+        const std::size_t rank = layout.dims.size();
+        const std::size_t last = rank - 1;
+        
+        std::size_t numRows = 1;
+        
+        std::vector< std::size_t > extent( rank );
+        
+        for( std::size_t d = 0; d < rank; d++ )
+        {
+            extent[d] = (std::size_t) sofa::smin( layout.chunkDims[d], layout.dims[d] - offset[d] );
+            
+            if( d < last )
+            {
+                numRows *= extent[d];
+            }
+        }
+        
+        std::vector< std::size_t > position( rank, 0 );
+        
+        for( std::size_t row = 0; row < numRows; row++ )
+        {
+            /// position of the row inside the chunk
+            std::size_t r = row;
+            
+            for( std::size_t i = last; i > 0; i-- )
+            {
+                position[i - 1] = r % extent[i - 1];
+                r /= extent[i - 1];
+            }
+            
+            std::size_t srcIndex = 0;
+            std::size_t dstIndex = 0;
+            
+            for( std::size_t d = 0; d < rank; d++ )
+            {
+                srcIndex = srcIndex * layout.chunkDims[d] + position[d];
+                dstIndex = dstIndex * layout.dims[d] + offset[d] + position[d];
+            }
+            
+            if( layout.typeSize == 8 )
+            {
+                convertRow< double >( values + dstIndex, chunk + srcIndex * 8, extent[last], layout.swapBytes );
+            }
+            else
+            {
+                convertRow< float >( values + dstIndex, chunk + srcIndex * 4, extent[last], layout.swapBytes );
+            }
+        }
+    }
+    
+    /// undoes the filters (in the reverse order of the pipeline), then scatters the chunk
+    template< typename T >
+    static bool decodeChunk(T *values,
+                            RawChunk &chunk,
+                            const VariableLayout &layout,
+                            std::vector< unsigned char > &buffer1,
+                            std::vector< unsigned char > &buffer2)
+    {
+        const std::vector< unsigned char > *current = &chunk.data;
+        
+        for( std::size_t i = layout.filters.size(); i > 0; i-- )
+        {
+            if( ( chunk.filterMask & ( 1u << ( i - 1 ) ) ) != 0 )
+            {
+                continue;
+            }
+            
+            std::vector< unsigned char > &output = ( current == &buffer1 ) ? buffer2 : buffer1;
+            
+            if( layout.filters[i - 1] == H5Z_FILTER_DEFLATE )
+            {
+                if( inflate( output, *current, layout.chunkSize ) == false )
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                unshuffle( output, *current, layout.typeSize );
+            }
+            
+            current = &output;
+        }
+        
+        if( current->size() != layout.chunkSize )
+        {
+            return false;
+        }
+        
+        scatter( values, &(*current)[0], chunk.offset, layout );
+        
+        /// the raw chunk is no longer needed
+        std::vector< unsigned char >().swap( chunk.data );
+        
+        return true;
+    }
+    
+    /// packed variables (CF scale_factor and add_offset) are unpacked by sofa::NetCDFFile
+    static bool isPacked(const sofa::NetCDFFile &file,
+                         const std::string &variableName)
+    {
+        return ( file.VariableHasAttribute( "scale_factor", variableName ) == true
+                || file.VariableHasAttribute( "add_offset", variableName ) == true );
+    }
+    
+    /// the file and the dataset of a variable, opened through HDF5
+    class Dataset
+    {
+    public:
+        Dataset(const std::string &path,
+                const std::string &variableName)
+        : file( sofa::Hdf5Utils::OpenFile( path ), H5Fclose )
+        , dataset( ( file.id >= 0 ) ? H5Dopen2( file.id, variableName.c_str(), H5P_DEFAULT ) : -1, H5Dclose )
+        , valid( dataset.id >= 0 && sofa::Hdf5Utils::GetLayout( layout, dataset.id ) == true )
+        {
+        }
+        
+        bool IsValid() const
+        {
+            return valid;
+        }
+        
+        const ScopedId file;
+        const ScopedId dataset;
+        VariableLayout layout;
+    
+    private:
+        const bool valid;
+        
+        SOFA_AVOID_COPY_CONSTRUCTOR( Dataset );
+    };
+}
+
+#endif /* SOFA_HDF5_DIRECT_CHUNK_READ */
+
+const unsigned long long ChunkReader::kUnknownOffset = (unsigned long long) -1;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the file to read; it must outlive this object
+ *  @param[in]      numThreads : number of decompression threads (0 : one per hardware thread)
+ *
+ */
+/************************************************************************************/
+ChunkReader::ChunkReader(const sofa::NetCDFFile &file_,
+                         const unsigned int numThreads_)
+: file( file_ )
+, numThreads( ( numThreads_ > 0 ) ? numThreads_ : sofa::smax( std::thread::hardware_concurrency(), 1u ) )
+{
+}
+
+unsigned int ChunkReader::GetNumThreads() const
+{
+    return numThreads;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the variable can be read with the direct chunk read
+ *                  (otherwise the values are read through netCDF)
+ *
+ */
+/************************************************************************************/
+bool ChunkReader::CanReadDirectly(const std::string &variableName) const
+{
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+    if( file.IsInMemory() == true
+       || file.GetMetadata().IsLoaded() == false
+       || file.HasVariable( variableName ) == false
+       || ChunkReaderHelper::isPacked( file, variableName ) == true )
+    {
+        return false;
+    }
+    
+    const ChunkReaderHelper::ScopedErrorSilencer silencer;
+    
+    const ChunkReaderHelper::Dataset dataset( file.GetFilename(), variableName );
+    
+    return dataset.IsValid();
+#else
+    return false;
+#endif
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns where the data of some variables is located in the file (the
+ *                  contiguous storage, or the first chunk), e.g. to read them in storage order.
+ *                  The file is opened once for all the variables
+ *  @param[out]     offsets : one offset per variable, in bytes, or kUnknownOffset (variable
+ *                  not found or not written yet, compact storage, file opened in memory,
+ *                  or libsofa built without HDF5 headers)
+ *  @param[in]      variableNames : the variables to locate
+ *
+ */
+/************************************************************************************/
+void ChunkReader::GetStorageOffsets(std::vector< unsigned long long > &offsets,
+                                    const std::vector< std::string > &variableNames) const
+{
+    offsets.assign( variableNames.size(), kUnknownOffset );
+
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+    if( file.IsInMemory() == true || variableNames.empty() == true )
+    {
+        return;
+    }
+    
+    const ChunkReaderHelper::ScopedErrorSilencer silencer;
+    
+    const ChunkReaderHelper::ScopedId fileId( sofa::Hdf5Utils::OpenFile( file.GetFilename() ), H5Fclose );
+    
+    if( fileId.id < 0 )
+    {
+        return;
+    }
+    
+    for( std::size_t i = 0; i < variableNames.size(); i++ )
+    {
+        const ChunkReaderHelper::ScopedId dataset( H5Dopen2( fileId.id, variableNames[i].c_str(), H5P_DEFAULT ), H5Dclose );
+        
+        if( dataset.id >= 0 )
+        {
+            const haddr_t address = sofa::Hdf5Utils::GetStorageAddress( dataset.id );
+            
+            if( address != HADDR_UNDEF )
+            {
+                offsets[i] = (unsigned long long) address;
+            }
+        }
+    }
+#endif
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads all the chunks of a variable : the raw chunks are read on the
+ *                  calling thread, and inflated/scattered by the worker threads as soon
+ *                  as they are available
+ *  @param[out]     values : the output, large enough for the whole variable
+ *  @param[in]      dims : the dimensions of the variable
+ *  @param[in]      variableName : the variable to read
+ *  @return         false if the variable can not be read directly (nothing is then
+ *                  guaranteed about the content of values)
+ *
+ */
+/************************************************************************************/
+template< typename T >
+bool ChunkReader::readDirectly(T *values,
+                               const std::vector< std::size_t > &dims,
+                               const std::string &variableName) const
+{
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+    if( file.IsInMemory() == true
+       || file.GetMetadata().IsLoaded() == false
+       || ChunkReaderHelper::isPacked( file, variableName ) == true )
+    {
+        return false;
+    }
+    
+    const ChunkReaderHelper::ScopedErrorSilencer silencer;
+    
+    const ChunkReaderHelper::Dataset dataset( file.GetFilename(), variableName );
+    
+    if( dataset.IsValid() == false )
+    {
+        return false;
+    }
+    
+    const sofa::Hdf5Utils::VariableLayout &layout = dataset.layout;
+    
+    if( std::vector< std::size_t >( layout.dims.begin(), layout.dims.end() ) != dims )
+    {
+        return false;
+    }
+    
+    std::vector< ChunkReaderHelper::RawChunk > chunks( layout.numChunks );
+    
+    std::mutex mutex;
+    std::condition_variable chunkAvailable;
+    std::size_t numRead   = 0;      ///< number of raw chunks read
+    std::size_t nextChunk = 0;      ///< next chunk to decode
+    bool done             = false;  ///< all the raw chunks have been read
+    bool failed           = false;
+    
+    const std::size_t numWorkers = sofa::smax( sofa::smin( (std::size_t) numThreads, layout.numChunks ), (std::size_t) 1 );
+    
+    std::vector< std::thread > workers;
+    
+    for( std::size_t w = 0; w < numWorkers; w++ )
+    {
+        workers.push_back( std::thread( [&]()
+        {
+            std::vector< unsigned char > buffer1;
+            std::vector< unsigned char > buffer2;
+            
+            for( ;; )
+            {
+                std::size_t index = 0;
+                
+                {
+                    std::unique_lock< std::mutex > lock( mutex );
+                    
+                    chunkAvailable.wait( lock, [&]{ return nextChunk < numRead || done == true || failed == true; } );
+                    
+                    if( failed == true || nextChunk >= numRead )
+                    {
+                        return;
+                    }
+                    
+                    index = nextChunk++;
+                }
+                
+                if( ChunkReaderHelper::decodeChunk( values, chunks[index], layout, buffer1, buffer2 ) == false )
+                {
+                    std::lock_guard< std::mutex > lock( mutex );
+                    failed = true;
+                    chunkAvailable.notify_all();
+                    return;
+                }
+            }
+        } ) );
+    }
+    
+    for( std::size_t k = 0; k < layout.numChunks; k++ )
+    {
+        ChunkReaderHelper::RawChunk &chunk = chunks[k];
+        
+        sofa::Hdf5Utils::GetChunkOffset( chunk.offset, k, layout );
+        
+        hsize_t size = 0;
+        
+        /// a chunk not written holds fill values : left to netCDF
+        bool ok = ( H5Dget_chunk_storage_size( dataset.dataset.id, &chunk.offset[0], &size ) >= 0 && size > 0 );
+        
+        if( ok == true )
+        {
+            chunk.data.resize( (std::size_t) size );
+            
+            ok = ( H5Dread_chunk( dataset.dataset.id, H5P_DEFAULT, &chunk.offset[0], &chunk.filterMask, &chunk.data[0] ) >= 0 );
+        }
+        
+        std::lock_guard< std::mutex > lock( mutex );
+        
+        if( ok == false )
+        {
+            failed = true;
+        }
+        
+        if( failed == true )
+        {
+            break;
+        }
+        
+        numRead = k + 1;
+        chunkAvailable.notify_one();
+    }
+    
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        done = true;
+    }
+    
+    chunkAvailable.notify_all();
+    
+    for( std::size_t w = 0; w < workers.size(); w++ )
+    {
+        workers[w].join();
+    }
+    
+    return ( failed == false );
+#else
+    (void) values;
+    (void) dims;
+    (void) variableName;
+    return false;
+#endif
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads all the values of a floating-point variable
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      variableName : the variable to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool ChunkReader::GetValues(std::vector< double > &values,
+                            const std::string &variableName) const
+{
+    if( file.HasVariable( variableName ) == true )
+    {
+        std::vector< std::size_t > dims;
+        file.GetVariableDimensions( dims, variableName );
+        
+        const std::size_t numElements = sofa::NcUtils::GetNumElements( dims );
+        
+        if( dims.size() > 0 && numElements > 0 )
+        {
+            values.resize( numElements );
+            
+            if( readDirectly( &values[0], dims, variableName ) == true )
+            {
+                return true;
+            }
+        }
+    }
+    
+    return file.GetValues( values, variableName );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads all the values of a floating-point variable, as float
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      variableName : the variable to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool ChunkReader::GetValues(std::vector< float > &values,
+                            const std::string &variableName) const
+{
+    if( file.HasVariable( variableName ) == true )
+    {
+        std::vector< std::size_t > dims;
+        file.GetVariableDimensions( dims, variableName );
+        
+        const std::size_t numElements = sofa::NcUtils::GetNumElements( dims );
+        
+        if( dims.size() > 0 && numElements > 0 )
+        {
+            values.resize( numElements );
+            
+            if( readDirectly( &values[0], dims, variableName ) == true )
+            {
+                return true;
+            }
+        }
+    }
+    
+    return file.GetValues( values, variableName );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads all the values of a floating-point variable into a N-dimensional
+ *                  array shaped like the variable
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      variableName : the variable to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool ChunkReader::GetValues(sofa::Array< double > &values,
+                            const std::string &variableName) const
+{
+    if( file.HasVariable( variableName ) == true )
+    {
+        std::vector< std::size_t > dims;
+        file.GetVariableDimensions( dims, variableName );
+        
+        if( dims.size() > 0
+           && sofa::NcUtils::GetNumElements( dims ) > 0
+           && values.Resize( dims ) == true
+           && readDirectly( values.GetData(), dims, variableName ) == true )
+        {
+            return true;
+        }
+    }
+    
+    return file.GetValues( values, variableName );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads all the values of a floating-point variable into a N-dimensional
+ *                  array shaped like the variable, as float
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      variableName : the variable to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool ChunkReader::GetValues(sofa::Array< float > &values,
+                            const std::string &variableName) const
+{
+    if( file.HasVariable( variableName ) == true )
+    {
+        std::vector< std::size_t > dims;
+        file.GetVariableDimensions( dims, variableName );
+        
+        if( dims.size() > 0
+           && sofa::NcUtils::GetNumElements( dims ) > 0
+           && values.Resize( dims ) == true
+           && readDirectly( values.GetData(), dims, variableName ) == true )
+        {
+            return true;
+        }
+    }
+    
+    return file.GetValues( values, variableName );
+}
+
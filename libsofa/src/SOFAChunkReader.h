@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAChunkReader.h
+ *   @brief      Reads large chunked variables, decompressing the chunks in parallel
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_CHUNK_READER_H__
+#define _SOFA_CHUNK_READER_H__
+
+#include "../src/SOFANcFile.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          ChunkReader
+     *  @brief          Reads large chunked variables, decompressing the chunks in parallel
+     *
+     *  @details        The netCDF library decompresses the chunks of a variable one at a time,
+     *                  on the calling thread. For a (deflated) chunked variable, such as the
+     *                  Data.IR of large DRIR/BRIR files, the ChunkReader fetches the raw chunks
+     *                  with the HDF5 direct chunk read, while a pool of threads inflates them
+     *                  and scatters them into the output. The values are bit-identical to the
+     *                  ones read through netCDF.
+     *
+     *                  Only the shuffle and deflate filters are supported. For any other
+     *                  variable (contiguous, other filters, chunks not written, non floating
+     *                  point, packed) or file (opened in memory or in write mode), and if libsofa was
+     *                  built without HDF5 headers (SOFA_HDF5_DIRECT_CHUNK_READ not defined),
+     *                  the values are read through netCDF.
+     *
+     *                  The HDF5 library is not thread-safe : the raw chunks are read on the
+     *                  calling thread only, and the worker threads never call HDF5.
+     */
+    /************************************************************************************/
+    class SOFA_API ChunkReader
+    {
+    public:
+        /// storage offset of a variable whose data is not located (see GetStorageOffsets)
+        static const unsigned long long kUnknownOffset;
+    
+    public:
+        ChunkReader(const sofa::NetCDFFile &file,
+                    const unsigned int numThreads = 0);
+        
+        ~ChunkReader() {};
+        
+        unsigned int GetNumThreads() const;
+        
+        bool CanReadDirectly(const std::string &variableName) const;
+        
+        void GetStorageOffsets(std::vector< unsigned long long > &offsets,
+                               const std::vector< std::string > &variableNames) const;
+        
+        bool GetValues(std::vector< double > &values,
+                       const std::string &variableName) const;
+        
+        bool GetValues(std::vector< float > &values,
+                       const std::string &variableName) const;
+        
+        bool GetValues(sofa::Array< double > &values,
+                       const std::string &variableName) const;
+        
+        bool GetValues(sofa::Array< float > &values,
+                       const std::string &variableName) const;
+    
+    private:
+        //==============================================================================
+        template< typename T >
+        bool readDirectly(T *values,
+                          const std::vector< std::size_t > &dims,
+                          const std::string &variableName) const;
+    
+    private:
+        const sofa::NetCDFFile & file;
+        const unsigned int numThreads;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( ChunkReader );
+    };
+
+}
+
+#endif /* _SOFA_CHUNK_READER_H__ */
+
@@ -0,0 +1,639 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAChunkWriter.cpp
+ *   @brief      Writes large chunked variables, compressing the chunks in parallel
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAChunkWriter.h"
+#include "../src/SOFAUtils.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <stdint.h>
+
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+    #include "../src/SOFAHdf5Utils.h"
+    #include "zlib.h"
+    
+    #if ! H5_VERSION_GE( 1, 10, 3 )
+        /// H5Dwrite_chunk was added in HDF5 1.10.2 (and H5Dread_chunk, used by the ChunkReader, in 1.10.3)
+        #undef SOFA_HDF5_DIRECT_CHUNK_READ
+    #endif
+#endif
+
+using namespace sofa;
+
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+
+namespace ChunkWriterHelper
+{
+    using sofa::Hdf5Utils::ScopedId;
+    using sofa::Hdf5Utils::ScopedErrorSilencer;
+    using sofa::Hdf5Utils::VariableLayout;
+    
+    /// number of encoded chunks waiting to be written, per worker thread (bounds the memory)
+    static const std::size_t kChunksInFlightPerThread = 4;
+    
+    struct EncodedChunk
+    {
+        std::vector< hsize_t > offset;
+        std::vector< unsigned char > data;
+        bool ready;
+    };
+    
+    template< typename Stored >
+    static void writeValue(unsigned char *dst, const Stored value, const bool swapBytes)
+    {
+        unsigned char bytes[ sizeof( Stored ) ];
+        std::memcpy( bytes, &value, sizeof( Stored ) );
+        
+        if( swapBytes == true )
+        {
+            for( std::size_t b = 0; b < sizeof( Stored ); b++ )
+            {
+                dst[b] = bytes[ sizeof( Stored ) - 1 - b ];
+            }
+        }
+        else
+        {
+            std::memcpy( dst, bytes, sizeof( Stored ) );
+        }
+    }
+    
+    /// same conversions as the netCDF library (i.e. C casts)
+    template< typename Stored, typename T >
+    static void convertRow(unsigned char *dst,
+                           const T *src,
+                           const std::size_t numElements,
+                           const bool swapBytes)
+    {
+        for( std::size_t i = 0; i < numElements; i++ )
+        {
+            writeValue< Stored >( dst + i * sizeof( Stored ), (Stored) src[i], swapBytes );
+        }
+    }
+    
+    /// fills a chunk with the fill value of the variable, as HDF5 does for the partial chunks
+    static void fill(std::vector< unsigned char > &chunk,
+                     const std::vector< unsigned char > &fillValue)
+    {
+        for( std::size_t i = 0; i + fillValue.size() <= chunk.size(); i += fillValue.size() )
+        {
+            std::memcpy( &chunk[i], &fillValue[0], fillValue.size() );
+        }
+    }
+    
+    /// copies the values lying inside a chunk, from the slab [start, start + count[ given by the caller
+    template< typename T >
+    static void gather(unsigned char *chunk,
+                       const T *values,
+                       const std::vector< hsize_t > &offset,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const VariableLayout &layout)
+    {
+        const std::size_t rank = layout.dims.size();
+        const std::size_t last = rank - 1;
+        
+        std::size_t numRows = 1;
+        
+        std::vector< std::size_t > extent( rank );
+        
+        for( std::size_t d = 0; d < rank; d++ )
+        {
+            extent[d] = (std::size_t) sofa::smin( layout.chunkDims[d], layout.dims[d] - offset[d] );
+            
+            if( d < last )
+            {
+                numRows *= extent[d];
+            }
+        }
+        
+        std::vector< std::size_t > position( rank, 0 );
+        
+        for( std::size_t row = 0; row < numRows; row++ )
+        {
+            /// position of the row inside the chunk
+            std::size_t r = row;
+            
+            for( std::size_t i = last; i > 0; i-- )
+            {
+                position[i - 1] = r % extent[i - 1];
+                r /= extent[i - 1];
+            }
+            
+            std::size_t srcIndex = 0;
+            std::size_t dstIndex = 0;
+            
+            for( std::size_t d = 0; d < rank; d++ )
+            {
+                srcIndex = srcIndex * count[d] + ( offset[d] - start[d] ) + position[d];
+                dstIndex = dstIndex * layout.chunkDims[d] + position[d];
+            }
+            
+            if( layout.typeSize == 8 )
+            {
+                convertRow< double >( chunk + dstIndex * 8, values + srcIndex, extent[last], layout.swapBytes );
+            }
+            else
+            {
+                convertRow< float >( chunk + dstIndex * 4, values + srcIndex, extent[last], layout.swapBytes );
+            }
+        }
+    }
+    
+    /// the HDF5 shuffle filter : the bytes of significance b of all the elements are stored contiguously
+    static void shuffle(std::vector< unsigned char > &dst,
+                        const std::vector< unsigned char > &src,
+                        const std::size_t typeSize)
+    {
+        const std::size_t numElements = src.size() / typeSize;
+        
+        dst.resize( src.size() );
+        
+        for( std::size_t b = 0; b < typeSize; b++ )
+        {
+            unsigned char *out = &dst[0] + b * numElements;
+            
+            for( std::size_t i = 0; i < numElements; i++ )
+            {
+                out[i] = src[ i * typeSize + b ];
+            }
+        }
+        
+        /// the trailing bytes (if any) are not shuffled
+        for( std::size_t i = numElements * typeSize; i < src.size(); i++ )
+        {
+            dst[i] = src[i];
+        }
+    }
+    
+    /// the HDF5 deflate filter (compress2, i.e. a zlib stream)
+    static bool deflate(std::vector< unsigned char > &dst,
+                        const std::vector< unsigned char > &src,
+                        const unsigned int level)
+    {
+        uLongf size = compressBound( (uLong) src.size() );
+        
+        dst.resize( (std::size_t) size );
+        
+        if( compress2( &dst[0], &size, &src[0], (uLong) src.size(), (int) level ) != Z_OK )
+        {
+            return false;
+        }
+        
+        dst.resize( (std::size_t) size );
+        
+        return true;
+    }
+    
+    /// gathers the chunk, then applies the filters in the order of the pipeline
+    template< typename T >
+    static bool encodeChunk(EncodedChunk &chunk,
+                            const T *values,
+                            const std::vector< std::size_t > &start,
+                            const std::vector< std::size_t > &count,
+                            const VariableLayout &layout,
+                            const std::vector< unsigned char > &fillValue,
+                            std::vector< unsigned char > &buffer1,
+                            std::vector< unsigned char > &buffer2)
+    {
+        buffer1.resize( layout.chunkSize );
+        
+        fill( buffer1, fillValue );
+        gather( &buffer1[0], values, chunk.offset, start, count, layout );
+        
+        std::vector< unsigned char > *current = &buffer1;
+        
+        for( std::size_t i = 0; i < layout.filters.size(); i++ )
+        {
+            std::vector< unsigned char > &output = ( current == &buffer1 ) ? buffer2 : buffer1;
+            
+            if( layout.filters[i] == H5Z_FILTER_DEFLATE )
+            {
+                if( deflate( output, *current, layout.deflateLevel ) == false )
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                shuffle( output, *current, layout.typeSize );
+            }
+            
+            current = &output;
+        }
+        
+        chunk.data.assign( current->begin(), current->end() );
+        
+        return true;
+    }
+    
+    /// the fill value of the variable, in its stored type
+    static void getFillValue(std::vector< unsigned char > &fillValue,
+                             const hid_t dataset,
+                             const VariableLayout &layout)
+    {
+        const ScopedId plist( H5Dget_create_plist( dataset ), H5Pclose );
+        
+        double value = 0.0;
+        
+        H5D_fill_value_t status = H5D_FILL_VALUE_UNDEFINED;
+        
+        if( H5Pfill_value_defined( plist.id, &status ) < 0
+         || status == H5D_FILL_VALUE_UNDEFINED
+         || H5Pget_fill_value( plist.id, H5T_NATIVE_DOUBLE, &value ) < 0 )
+        {
+            value = 0.0;
+        }
+        
+        fillValue.resize( layout.typeSize );
+        
+        if( layout.typeSize == 8 )
+        {
+            writeValue< double >( &fillValue[0], value, layout.swapBytes );
+        }
+        else
+        {
+            writeValue< float >( &fillValue[0], (float) value, layout.swapBytes );
+        }
+    }
+    
+    /// the slab must cover whole chunks, or reach the end of the variable, along each dimension
+    static bool isAligned(const std::vector< std::size_t > &start,
+                          const std::vector< std::size_t > &count,
+                          const VariableLayout &layout)
+    {
+        if( start.size() != layout.dims.size() || count.size() != layout.dims.size() )
+        {
+            return false;
+        }
+        
+        for( std::size_t d = 0; d < layout.dims.size(); d++ )
+        {
+            const hsize_t end = (hsize_t) ( start[d] + count[d] );
+            
+            if( count[d] == 0
+             || end > layout.dims[d]
+             || start[d] % layout.chunkDims[d] != 0
+             || ( count[d] % layout.chunkDims[d] != 0 && end != layout.dims[d] ) )
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    /// the file (in write mode) and the dataset of a variable, opened through HDF5
+    class Dataset
+    {
+    public:
+        Dataset(const std::string &path,
+                const std::string &variableName)
+        : file( sofa::Hdf5Utils::OpenFile( path, H5F_ACC_RDWR ), H5Fclose )
+        , dataset( ( file.id >= 0 ) ? H5Dopen2( file.id, variableName.c_str(), H5P_DEFAULT ) : -1, H5Dclose )
+        , valid( dataset.id >= 0 && sofa::Hdf5Utils::GetLayout( layout, dataset.id ) == true && layout.filters.empty() == false )
+        {
+        }
+        
+        bool IsValid() const
+        {
+            return valid;
+        }
+        
+        const ScopedId file;
+        const ScopedId dataset;
+        VariableLayout layout;
+    
+    private:
+        const bool valid;
+        
+        SOFA_AVOID_COPY_CONSTRUCTOR( Dataset );
+    };
+}
+
+#endif /* SOFA_HDF5_DIRECT_CHUNK_READ */
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      path : the file to write, already created (e.g. by sofa::Writer)
+ *  @param[in]      numThreads : number of compression threads (0 : one per hardware thread)
+ *
+ */
+/************************************************************************************/
+ChunkWriter::ChunkWriter(const std::string &path_,
+                         const unsigned int numThreads_)
+: path( path_ )
+, numThreads( ( numThreads_ > 0 ) ? numThreads_ : sofa::smax( std::thread::hardware_concurrency(), 1u ) )
+{
+}
+
+unsigned int ChunkWriter::GetNumThreads() const
+{
+    return numThreads;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns false if libsofa was built without the HDF5 direct chunk write
+ *                  (PutValues() then always returns false)
+ *
+ */
+/************************************************************************************/
+bool ChunkWriter::IsAvailable()
+{
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+    return true;
+#else
+    return false;
+#endif
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the variable can be written with the direct chunk write
+ *                  (chunked, compressed with shuffle and deflate only, floating point)
+ *
+ */
+/************************************************************************************/
+bool ChunkWriter::CanWriteDirectly(const std::string &variableName) const
+{
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+    const ChunkWriterHelper::ScopedErrorSilencer silencer;
+    
+    const ChunkWriterHelper::Dataset dataset( path, variableName );
+    
+    return dataset.IsValid();
+#else
+    (void) variableName;
+    return false;
+#endif
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Encodes the chunks covered by a slab : the worker threads gather and
+ *                  compress them, and the calling thread writes them in order, as soon as
+ *                  they are ready
+ *  @param[in]      values : the values of the slab
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the variable to write
+ *  @return         false if the variable can not be written directly; nothing is written,
+ *                  unless writing a chunk fails
+ *
+ */
+/************************************************************************************/
+template< typename T >
+bool ChunkWriter::writeDirectly(const T *values,
+                                const std::vector< std::size_t > &start,
+                                const std::vector< std::size_t > &count,
+                                const std::string &variableName) const
+{
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+    if( values == NULL )
+    {
+        return false;
+    }
+    
+    const ChunkWriterHelper::ScopedErrorSilencer silencer;
+    
+    const ChunkWriterHelper::Dataset dataset( path, variableName );
+    
+    if( dataset.IsValid() == false )
+    {
+        return false;
+    }
+    
+    const sofa::Hdf5Utils::VariableLayout &layout = dataset.layout;
+    
+    if( ChunkWriterHelper::isAligned( start, count, layout ) == false )
+    {
+        return false;
+    }
+    
+    std::vector< unsigned char > fillValue;
+    ChunkWriterHelper::getFillValue( fillValue, dataset.dataset.id, layout );
+    
+    /// the chunks covered by the slab, numbered in row-major order
+    const std::size_t rank = layout.dims.size();
+    
+    std::vector< std::size_t > numChunksPerDim( rank );
+    std::size_t numChunks = 1;
+    
+    for( std::size_t d = 0; d < rank; d++ )
+    {
+        numChunksPerDim[d] = (std::size_t) ( ( count[d] + layout.chunkDims[d] - 1 ) / layout.chunkDims[d] );
+        numChunks *= numChunksPerDim[d];
+    }
+    
+    std::vector< ChunkWriterHelper::EncodedChunk > chunks( numChunks );
+    
+    for( std::size_t k = 0; k < numChunks; k++ )
+    {
+        ChunkWriterHelper::EncodedChunk &chunk = chunks[k];
+        
+        chunk.offset.resize( rank );
+        chunk.ready = false;
+        
+        std::size_t index = k;
+        
+        for( std::size_t i = rank; i > 0; i-- )
+        {
+            const std::size_t d = i - 1;
+            
+            chunk.offset[d] = (hsize_t) start[d] + ( index % numChunksPerDim[d] ) * layout.chunkDims[d];
+            index          /= numChunksPerDim[d];
+        }
+    }
+    
+    std::mutex mutex;
+    std::condition_variable chunkReady;     ///< signals the calling thread
+    std::condition_variable chunkWritten;   ///< signals the workers
+    std::size_t nextChunk   = 0;            ///< next chunk to encode
+    std::size_t numWritten  = 0;            ///< number of chunks written
+    bool failed             = false;
+    
+    const std::size_t numWorkers  = sofa::smax( sofa::smin( (std::size_t) numThreads, numChunks ), (std::size_t) 1 );
+    const std::size_t maxInFlight = numWorkers * ChunkWriterHelper::kChunksInFlightPerThread;
+    
+    std::vector< std::thread > workers;
+    
+    for( std::size_t w = 0; w < numWorkers; w++ )
+    {
+        workers.push_back( std::thread( [&]()
+        {
+            std::vector< unsigned char > buffer1;
+            std::vector< unsigned char > buffer2;
+            
+            for( ;; )
+            {
+                std::size_t index = 0;
+                
+                {
+                    std::unique_lock< std::mutex > lock( mutex );
+                    
+                    chunkWritten.wait( lock, [&]{ return nextChunk < numWritten + maxInFlight || failed == true; } );
+                    
+                    if( failed == true || nextChunk >= numChunks )
+                    {
+                        return;
+                    }
+                    
+                    index = nextChunk++;
+                }
+                
+                const bool ok = ChunkWriterHelper::encodeChunk( chunks[index], values, start, count, layout, fillValue, buffer1, buffer2 );
+                
+                std::lock_guard< std::mutex > lock( mutex );
+                
+                if( ok == false )
+                {
+                    failed = true;
+                }
+                
+                chunks[index].ready = true;
+                chunkReady.notify_all();
+                chunkWritten.notify_all();
+            }
+        } ) );
+    }
+    
+    for( std::size_t k = 0; k < numChunks; k++ )
+    {
+        ChunkWriterHelper::EncodedChunk &chunk = chunks[k];
+        
+        {
+            std::unique_lock< std::mutex > lock( mutex );
+            
+            chunkReady.wait( lock, [&]{ return chunk.ready == true || failed == true; } );
+            
+            if( failed == true )
+            {
+                break;
+            }
+        }
+        
+        /// filter mask 0 : all the filters of the pipeline were applied
+        const bool ok = ( H5Dwrite_chunk( dataset.dataset.id, H5P_DEFAULT, 0, &chunk.offset[0], chunk.data.size(), &chunk.data[0] ) >= 0 );
+        
+        /// the encoded chunk is no longer needed
+        std::vector< unsigned char >().swap( chunk.data );
+        
+        std::lock_guard< std::mutex > lock( mutex );
+        
+        if( ok == false )
+        {
+            failed = true;
+        }
+        
+        numWritten = k + 1;
+        chunkWritten.notify_all();
+        
+        if( failed == true )
+        {
+            break;
+        }
+    }
+    
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        
+        /// wakes up the workers waiting for room, if the loop was left early
+        if( numWritten < numChunks )
+        {
+            failed = true;
+        }
+    }
+    
+    chunkWritten.notify_all();
+    
+    for( std::size_t w = 0; w < workers.size(); w++ )
+    {
+        workers[w].join();
+    }
+    
+    return ( failed == false );
+#else
+    (void) values;
+    (void) start;
+    (void) count;
+    (void) variableName;
+    return false;
+#endif
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a slab of a floating-point variable, covering whole chunks
+ *  @param[in]      variableName : the variable to write
+ *  @param[in]      values : the values of the slab
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @return         false if the values can not be written directly (nothing is written)
+ *
+ */
+/************************************************************************************/
+bool ChunkWriter::PutValues(const std::string &variableName,
+                            const double *values,
+                            const std::vector< std::size_t > &start,
+                            const std::vector< std::size_t > &count) const
+{
+    return writeDirectly( values, start, count, variableName );
+}
+
+bool ChunkWriter::PutValues(const std::string &variableName,
+                            const float *values,
+                            const std::vector< std::size_t > &start,
+                            const std::vector< std::size_t > &count) const
+{
+    return writeDirectly( values, start, count, variableName );
+}
@@ -0,0 +1,132 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAChunkWriter.h
+ *   @brief      Writes large chunked variables, compressing the chunks in parallel
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_CHUNK_WRITER_H__
+#define _SOFA_CHUNK_WRITER_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          ChunkWriter
+     *  @brief          Writes large chunked variables, compressing the chunks in parallel
+     *
+     *  @details        The netCDF library compresses the chunks of a variable one at a time,
+     *                  on the calling thread. For a (deflated) chunked variable, such as the
+     *                  Data.IR of large DRIR/BRIR files, the ChunkWriter lets a pool of threads
+     *                  gather and compress the chunks (shuffle, deflate), while the calling
+     *                  thread commits them with the HDF5 direct chunk write. The chunks are
+     *                  encoded exactly as the HDF5 filter pipeline would : the compressed
+     *                  chunks are, byte for byte, those written by netCDF.
+     *
+     *                  This is the counterpart of the ChunkReader, used by sofa::Writer (see
+     *                  WriteOptions::SetNumThreads). The file must be created, and its schema
+     *                  defined, beforehand; it must also be closed by netCDF : opening it twice
+     *                  in write mode is only safe within a single HDF5 library, which is not
+     *                  the case with a netCDF library bundling its own (e.g. the Windows DLL).
+     *
+     *                  Only the shuffle and deflate filters are supported, and the values must
+     *                  cover whole chunks (or reach the end of the variable along each
+     *                  dimension), within the current extent of the variable. Otherwise, or
+     *                  if libsofa was built without HDF5 headers (SOFA_HDF5_DIRECT_CHUNK_READ
+     *                  not defined), PutValues() returns false and writes nothing.
+     *
+     *                  The HDF5 library is not thread-safe : the chunks are written on the
+     *                  calling thread only, and the worker threads never call HDF5.
+     */
+    /************************************************************************************/
+    class SOFA_API ChunkWriter
+    {
+    public:
+        ChunkWriter(const std::string &path,
+                    const unsigned int numThreads = 0);
+        
+        ~ChunkWriter() {};
+        
+        unsigned int GetNumThreads() const;
+        
+        static bool IsAvailable();
+        
+        bool CanWriteDirectly(const std::string &variableName) const;
+        
+        bool PutValues(const std::string &variableName,
+                       const double *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count) const;
+        
+        bool PutValues(const std::string &variableName,
+                       const float *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count) const;
+    
+    private:
+        //==============================================================================
+        template< typename T >
+        bool writeDirectly(const T *values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::string &variableName) const;
+    
+    private:
+        const std::string path;
+        const unsigned int numThreads;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( ChunkWriter );
+    };
+
+}
+
+#endif /* _SOFA_CHUNK_WRITER_H__ */
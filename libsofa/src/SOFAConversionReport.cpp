@@ -0,0 +1,262 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAConversionReport.cpp
+ *   @brief      Precision lost by the values stored with a narrower type than given
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAConversionReport.h"
+#include "../src/SOFAUtils.h"
+#include <cmath>
+#include <limits>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the signal-to-noise ratio, in dB (infinite if there is no noise)
+ *
+ */
+/************************************************************************************/
+double ConversionReport::GetSNR(const double signalEnergy, const double noiseEnergy)
+{
+    if( noiseEnergy <= 0.0 )
+    {
+        return std::numeric_limits< double >::infinity();
+    }
+    
+    if( signalEnergy <= 0.0 )
+    {
+        return -std::numeric_limits< double >::infinity();
+    }
+    
+    return 10.0 * std::log10( signalEnergy / noiseEnergy );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+ConversionReport::ConversionReport()
+{
+}
+
+void ConversionReport::Clear()
+{
+    variables.clear();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Accumulates the error of some values of a row
+ *  @param[in]      variableName : the variable written
+ *  @param[in]      row : index of the row along the last dimension (e.g. of the impulse response)
+ *  @param[in]      signalEnergy : sum of the squares of the given values
+ *  @param[in]      noiseEnergy : sum of the squares of the differences with the stored values
+ *  @param[in]      maxAbsError : largest difference with the stored values
+ *
+ *  @details        A row written several times (e.g. the default measurement, then the
+ *                  actual one) accumulates all its writes
+ */
+/************************************************************************************/
+void ConversionReport::Add(const std::string &variableName,
+                           const std::size_t row,
+                           const double signalEnergy,
+                           const double noiseEnergy,
+                           const double maxAbsError)
+{
+    Variable *variable = findVariable( variableName );
+    
+    if( variable == NULL )
+    {
+        Variable newVariable;
+        newVariable.name        = variableName;
+        newVariable.maxAbsError = 0.0;
+        
+        variables.push_back( newVariable );
+        variable = &variables.back();
+    }
+    
+    if( row >= variable->signalEnergy.size() )
+    {
+        variable->signalEnergy.resize( row + 1, 0.0 );
+        variable->noiseEnergy.resize( row + 1, 0.0 );
+    }
+    
+    variable->signalEnergy[row] += signalEnergy;
+    variable->noiseEnergy[row]  += noiseEnergy;
+    variable->maxAbsError        = sofa::smax( variable->maxAbsError, maxAbsError );
+}
+
+bool ConversionReport::IsEmpty() const
+{
+    return variables.empty();
+}
+
+const std::vector< ConversionReport::Variable > & ConversionReport::GetVariables() const
+{
+    return variables;
+}
+
+bool ConversionReport::HasVariable(const std::string &variableName) const
+{
+    return ( findVariable( variableName ) != NULL );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the largest absolute error of a variable (0 if it is not reported)
+ *
+ */
+/************************************************************************************/
+double ConversionReport::GetMaxAbsError(const std::string &variableName) const
+{
+    const Variable *variable = findVariable( variableName );
+    
+    return ( variable != NULL ) ? variable->maxAbsError : 0.0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the lowest signal-to-noise ratio of the rows of a variable, in dB
+ *                  (infinite if it is not reported, or stored exactly)
+ *
+ */
+/************************************************************************************/
+double ConversionReport::GetMinSNR(const std::string &variableName) const
+{
+    std::vector< double > snr;
+    
+    double minSNR = std::numeric_limits< double >::infinity();
+    
+    if( GetSNR( snr, variableName ) == true )
+    {
+        for( std::size_t i = 0; i < snr.size(); i++ )
+        {
+            minSNR = sofa::smin( minSNR, snr[i] );
+        }
+    }
+    
+    return minSNR;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Gets the signal-to-noise ratio of each row of a variable, in dB
+ *  @param[out]     values : one per row, e.g. per impulse response
+ *  @return         false if the variable is not reported
+ *
+ */
+/************************************************************************************/
+bool ConversionReport::GetSNR(std::vector< double > &values, const std::string &variableName) const
+{
+    values.clear();
+    
+    const Variable *variable = findVariable( variableName );
+    
+    if( variable == NULL )
+    {
+        return false;
+    }
+    
+    values.resize( variable->signalEnergy.size() );
+    
+    for( std::size_t i = 0; i < values.size(); i++ )
+    {
+        values[i] = ConversionReport::GetSNR( variable->signalEnergy[i], variable->noiseEnergy[i] );
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Prints the precision of each variable, one per line
+ *  @param[in]      output : output stream
+ *
+ */
+/************************************************************************************/
+void ConversionReport::Print(std::ostream & output) const
+{
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        const Variable & variable = variables[i];
+        
+        output << variable.name << " : ";
+        output << "max abs error = " << variable.maxAbsError << ", ";
+        output << "min SNR = " << GetMinSNR( variable.name ) << " dB ";
+        output << "(" << variable.signalEnergy.size() << " rows)" << std::endl;
+    }
+}
+
+ConversionReport::Variable * ConversionReport::findVariable(const std::string &variableName)
+{
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        if( variables[i].name == variableName )
+        {
+            return &variables[i];
+        }
+    }
+    
+    return NULL;
+}
+
+const ConversionReport::Variable * ConversionReport::findVariable(const std::string &variableName) const
+{
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        if( variables[i].name == variableName )
+        {
+            return &variables[i];
+        }
+    }
+    
+    return NULL;
+}
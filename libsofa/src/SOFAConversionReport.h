@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAConversionReport.h
+ *   @brief      Precision lost by the values stored with a narrower type than given
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_CONVERSION_REPORT_H__
+#define _SOFA_CONVERSION_REPORT_H__
+
+#include "../src/SOFAPlatform.h"
+#include <iostream>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          ConversionReport
+     *  @brief          Precision lost by the values stored with a narrower type than given
+     *
+     *  @details        Filled by sofa::Writer for the variables stored as float (see
+     *                  Writer::SetVariableType), as their values are written. The error is
+     *                  accumulated per row along the last dimension of the variable, i.e.
+     *                  per impulse response for Data.IR [M R N] or [M R E N], and per
+     *                  position for SourcePosition [M C].
+     *                  The signal-to-noise ratio of a row is the energy of the given values
+     *                  over the energy of the error, in dB; it is infinite when the values
+     *                  are stored exactly (e.g. given as float).
+     */
+    /************************************************************************************/
+    class SOFA_API ConversionReport
+    {
+    public:
+        struct Variable
+        {
+            std::string name;
+            double maxAbsError;                         ///< over all the values written
+            std::vector< double > signalEnergy;         ///< per row
+            std::vector< double > noiseEnergy;          ///< per row
+        };
+        
+        static double GetSNR(const double signalEnergy, const double noiseEnergy);
+    
+    public:
+        ConversionReport();
+        ~ConversionReport() {};
+        
+        void Clear();
+        
+        void Add(const std::string &variableName,
+                 const std::size_t row,
+                 const double signalEnergy,
+                 const double noiseEnergy,
+                 const double maxAbsError);
+        
+        bool IsEmpty() const;
+        const std::vector< Variable > & GetVariables() const;
+        
+        bool HasVariable(const std::string &variableName) const;
+        double GetMaxAbsError(const std::string &variableName) const;
+        double GetMinSNR(const std::string &variableName) const;
+        bool GetSNR(std::vector< double > &values, const std::string &variableName) const;
+        
+        void Print(std::ostream & output = std::cout) const;
+    
+    private:
+        Variable * findVariable(const std::string &variableName);
+        const Variable * findVariable(const std::string &variableName) const;
+    
+    private:
+        std::vector< Variable > variables;
+    };
+
+}
+
+#endif /* _SOFA_CONVERSION_REPORT_H__ */
@@ -0,0 +1,248 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFADataLayout.cpp
+ *   @brief      Memory layouts in which the Data.IR values can be delivered
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFADataLayout.h"
+#include "../src/SOFAUtils.h"
+#include <cstring>
+
+using namespace sofa;
+
+namespace DataLayoutHelper
+{
+    /// side of the square tiles of the transpose : two 32x32 tiles of double fit in the L1 cache
+    static const std::size_t kTileSize = 32;
+    
+    /// size of one measurement, along all the dimensions after M and R
+    static std::size_t getNumSamples(const std::vector< std::size_t > &storedDims)
+    {
+        std::size_t numSamples = 1;
+        
+        for( std::size_t i = 2; i < storedDims.size(); i++ )
+        {
+            numSamples *= storedDims[i];
+        }
+        
+        return numSamples;
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Cache-blocked transpose of a [numRows numColumns] matrix :
+     *                  dst[ c * numRows + r ] = src[ r * numColumns + c ]
+     *
+     */
+    /************************************************************************************/
+    template< typename T >
+    static void transpose(T *dst,
+                          const T *src,
+                          const std::size_t numRows,
+                          const std::size_t numColumns)
+    {
+        for( std::size_t r0 = 0; r0 < numRows; r0 += kTileSize )
+        {
+            const std::size_t rEnd = sofa::smin( r0 + kTileSize, numRows );
+            
+            for( std::size_t c0 = 0; c0 < numColumns; c0 += kTileSize )
+            {
+                const std::size_t cEnd = sofa::smin( c0 + kTileSize, numColumns );
+                
+                for( std::size_t c = c0; c < cEnd; c++ )
+                {
+                    for( std::size_t r = r0; r < rEnd; r++ )
+                    {
+                        dst[ c * numRows + r ] = src[ r * numColumns + c ];
+                    }
+                }
+            }
+        }
+    }
+    
+    template< typename T >
+    static void transform(T *dst,
+                          const T *src,
+                          const std::vector< std::size_t > &storedDims,
+                          const std::size_t firstMeasurement,
+                          const std::size_t numMeasurements,
+                          const sofa::DataLayout::Type &type_)
+    {
+        SOFA_ASSERT( storedDims.size() >= 2 );
+        SOFA_ASSERT( firstMeasurement + numMeasurements <= storedDims[0] );
+        
+        const std::size_t M = storedDims[0];
+        const std::size_t R = storedDims[1];
+        const std::size_t S = getNumSamples( storedDims );
+        
+        switch( type_ )
+        {
+            case sofa::DataLayout::kReceiverMeasurementSample :
+                /// the samples of one receiver of one measurement remain contiguous
+                for( std::size_t m = 0; m < numMeasurements; m++ )
+                {
+                    for( std::size_t r = 0; r < R; r++ )
+                    {
+                        std::memcpy( dst + ( r * M + firstMeasurement + m ) * S,
+                                     src + ( m * R + r ) * S,
+                                     S * sizeof( T ) );
+                    }
+                }
+                break;
+            
+            case sofa::DataLayout::kMeasurementSampleReceiver :
+                /// each measurement is a [R S] matrix, transposed to [S R]
+                for( std::size_t m = 0; m < numMeasurements; m++ )
+                {
+                    transpose( dst + ( firstMeasurement + m ) * S * R,
+                               src + m * R * S,
+                               R,
+                               S );
+                }
+                break;
+            
+            default :
+                std::memcpy( dst + firstMeasurement * R * S,
+                             src,
+                             numMeasurements * R * S * sizeof( T ) );
+                break;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of a layout
+ *  @param[in]      type_ : the layout to query
+ *
+ */
+/************************************************************************************/
+std::string DataLayout::GetName(const sofa::DataLayout::Type &type_)
+{
+    switch( type_ )
+    {
+        case sofa::DataLayout::kMeasurementReceiverSample   : return "MRN";
+        case sofa::DataLayout::kReceiverMeasurementSample   : return "RMN";
+        case sofa::DataLayout::kMeasurementSampleReceiver   : return "MNR";
+        default                                             : SOFA_ASSERT( false ); return "";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the dimensions of the values delivered in a given layout
+ *  @param[out]     dims : the dimensions in the requested layout
+ *  @param[in]      storedDims : the dimensions of the variable, as stored ([M R ...])
+ *  @param[in]      type_ : the requested layout
+ *  @return         false if the variable has less than 2 dimensions
+ *
+ */
+/************************************************************************************/
+bool DataLayout::GetDimensions(std::vector< std::size_t > &dims,
+                               const std::vector< std::size_t > &storedDims,
+                               const sofa::DataLayout::Type &type_)
+{
+    if( storedDims.size() < 2 )
+    {
+        dims.clear();
+        return false;
+    }
+    
+    dims = storedDims;
+    
+    switch( type_ )
+    {
+        case sofa::DataLayout::kReceiverMeasurementSample :
+            dims[0] = storedDims[1];
+            dims[1] = storedDims[0];
+            break;
+        
+        case sofa::DataLayout::kMeasurementSampleReceiver :
+            /// [M R d2 d3...] -> [M d2 d3... R]
+            dims.erase( dims.begin() + 1 );
+            dims.push_back( storedDims[1] );
+            break;
+        
+        default :
+            break;
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Copies a block of consecutive measurements, as stored, into the
+ *                  values of the whole variable in a given layout
+ *  @param[out]     dst : all the values of the variable, in the requested layout
+ *  @param[in]      src : the values of the measurements [firstMeasurement, firstMeasurement + numMeasurements), as stored
+ *  @param[in]      storedDims : the dimensions of the variable, as stored ([M R ...])
+ *  @param[in]      firstMeasurement : index of the first measurement of the block
+ *  @param[in]      numMeasurements : number of measurements in the block
+ *  @param[in]      type_ : the requested layout
+ *
+ *  @details        the block should be small enough to remain in cache while it is transformed
+ */
+/************************************************************************************/
+void DataLayout::Transform(double *dst,
+                           const double *src,
+                           const std::vector< std::size_t > &storedDims,
+                           const std::size_t firstMeasurement,
+                           const std::size_t numMeasurements,
+                           const sofa::DataLayout::Type &type_)
+{
+    DataLayoutHelper::transform( dst, src, storedDims, firstMeasurement, numMeasurements, type_ );
+}
+
+void DataLayout::Transform(float *dst,
+                           const float *src,
+                           const std::vector< std::size_t > &storedDims,
+                           const std::size_t firstMeasurement,
+                           const std::size_t numMeasurements,
+                           const sofa::DataLayout::Type &type_)
+{
+    DataLayoutHelper::transform( dst, src, storedDims, firstMeasurement, numMeasurements, type_ );
+}
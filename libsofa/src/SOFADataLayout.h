@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFADataLayout.h
+ *   @brief      Memory layouts in which the Data.IR values can be delivered
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_DATA_LAYOUT_H__
+#define _SOFA_DATA_LAYOUT_H__
+
+#include "../src/SOFAPlatform.h"
+#include <string>
+#include <vector>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          DataLayout
+     *  @brief          Static class to represent the memory layout of the Data.IR values
+     *
+     *  @details        Data.IR is stored [M R N] (or [M R E N], [M R N E]...) : the first two
+     *                  dimensions are always the measurements and the receivers, the
+     *                  remaining dimensions (samples, emitters) are handled as a whole.
+     *                  The receiver planar layout [R M N] suits engines processing each
+     *                  receiver (ear) separately; the sample interleaved layout [M N R] suits
+     *                  multichannel renderers (e.g. Ambisonics) processing all the receivers
+     *                  of a sample at once.
+     */
+    /************************************************************************************/
+    class SOFA_API DataLayout
+    {
+    public:
+        
+        enum Type
+        {
+            kMeasurementReceiverSample  = 0,    ///< [M R N], as stored in the file
+            kReceiverMeasurementSample  = 1,    ///< [R M N] : one planar block per receiver
+            kMeasurementSampleReceiver  = 2,    ///< [M N R] : samples interleaved across receivers
+            kNumDataLayoutTypes         = 3
+        };
+    
+    public:
+        static std::string GetName(const sofa::DataLayout::Type &type_);
+        
+        static bool GetDimensions(std::vector< std::size_t > &dims,
+                                  const std::vector< std::size_t > &storedDims,
+                                  const sofa::DataLayout::Type &type_);
+        
+        static void Transform(double *dst,
+                              const double *src,
+                              const std::vector< std::size_t > &storedDims,
+                              const std::size_t firstMeasurement,
+                              const std::size_t numMeasurements,
+                              const sofa::DataLayout::Type &type_);
+        
+        static void Transform(float *dst,
+                              const float *src,
+                              const std::vector< std::size_t > &storedDims,
+                              const std::size_t firstMeasurement,
+                              const std::size_t numMeasurements,
+                              const sofa::DataLayout::Type &type_);
+    
+    private:
+        DataLayout() SOFA_DELETED_FUNCTION;
+    };
+
+}
+
+#endif /* _SOFA_DATA_LAYOUT_H__ */
@@ -54,6 +54,7 @@ http://www.sofaconventions.org
 #include "../src/SOFAEmitter.h"
 #include "../src/SOFAString.h"
 #include "../src/SOFANcUtils.h"
+#include "../src/SOFAUtils.h"
 
 using namespace sofa;
 
@@ -62,12 +63,80 @@ using namespace sofa;
  *  @brief          Class constructor
  *  @param[in]      path : the file path
  *  @param[in]      mode : opening mode
+ *  @param[in]      options : chunk cache settings of the variables
  *
  */
 /************************************************************************************/
 File::File(const std::string &path,
-           const netCDF::NcFile::FileMode &mode)
-: sofa::NetCDFFile( path, mode )
+           const netCDF::NcFile::FileMode &mode,
+           const sofa::OpenOptions &options)
+: sofa::NetCDFFile( path, mode, options )
+, numMeasurements( -1 )
+, numReceivers( -1 )
+, numEmitters( -1 )
+, numDataSamples( -1 )
+{
+    readCachedValues();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : opens, read-only, the image of a file held in memory
+ *  @param[in]      buffer : the file image; it is not copied, and must outlive this object
+ *  @param[in]      options : chunk cache settings of the variables
+ *
+ */
+/************************************************************************************/
+File::File(const sofa::MemoryBuffer &buffer,
+           const sofa::OpenOptions &options)
+: sofa::NetCDFFile( buffer, options )
+, numMeasurements( -1 )
+, numReceivers( -1 )
+, numEmitters( -1 )
+, numDataSamples( -1 )
+{
+    readCachedValues();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads once the values queried by most accessors,
+ *                  if the file was opened in read mode
+ *
+ */
+/************************************************************************************/
+void File::readCachedValues()
+{
+    if( GetMetadata().IsLoaded() == true )
+    {
+        sofaConventions = GetAttributeValueAsString( "SOFAConventions" );
+        dataType        = GetAttributeValueAsString( "DataType" );
+        
+        numMeasurements = GetDimension( "M" );
+        numReceivers    = GetDimension( "R" );
+        numEmitters     = GetDimension( "E" );
+        numDataSamples  = GetDimension( "N" );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor sharing the handle of a sofa::File already opened.
+ *                  Nothing is read from the file, and the outcome of the SOFA checks
+ *                  already run by the shared file (if any) is reused
+ *  @param[in]      sharedFile : the file to share; it must outlive this object
+ *
+ */
+/************************************************************************************/
+File::File(const sofa::File *sharedFile)
+: sofa::NetCDFFile( sharedFile )
+, sofaValidation( sharedFile->sofaValidation )
+, sofaConventions( sharedFile->sofaConventions )
+, dataType( sharedFile->dataType )
+, numMeasurements( sharedFile->numMeasurements )
+, numReceivers( sharedFile->numReceivers )
+, numEmitters( sharedFile->numEmitters )
+, numDataSamples( sharedFile->numDataSamples )
 {
 }
 
@@ -79,21 +148,96 @@ File::File(const std::string &path,
  *                    if it contains all the SOFA required attributes,
  *                    if the "Conventions" attribute is set to "SOFA"
  *                    if the SOFA dimensions are OK (I,M,R,E,N,C)
+ *                  Throws an exception describing the first issue found, if any
+ *                  (see Validate() for a report of all the issues)
  */
 /************************************************************************************/
 bool File::IsValid() const
 {
-    return ( sofa::NetCDFFile::IsValid() == true
-            && hasSOFARequiredAttributes() == true
-            && hasSOFAConvention() == true 
-            && SOFADimensionsAreValid() == true 
-            && checkListenerVariables() == true
-            && checkSourceVariables() == true
-            && checkReceiverVariables() == true
-            && checkEmitterVariables() == true
-            && checkDimensions() == true
-            && checkDataVariable() == true 
-            );
+    sofa::ValidationReport report;
+    
+    if( File::Validate( report ) == true )
+    {
+        return true;
+    }
+    
+    return raiseFirstIssue( report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the file against the SOFA specifications, and collects all the
+ *                  issues found into a report. Never throws an exception
+ *  @param[out]     report : the issues are appended to this report
+ *  @return         true if this is a valid SOFA file
+ *
+ */
+/************************************************************************************/
+bool File::Validate(sofa::ValidationReport &report) const
+{
+    return validateOnce( report, sofaValidation, *this, &File::checkValidity );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Runs all the checks of the SOFA specifications; called once by Validate()
+ *
+ *  @details        The checks of the variables are only run if the SOFA dimensions are valid,
+ *                  since they all rely on them
+ */
+/************************************************************************************/
+bool File::checkValidity(sofa::ValidationReport &report) const
+{
+    if( sofa::NetCDFFile::IsValid() == false )
+    {
+        report.Add( sofa::ValidationReport::kInvalidNetCDFFile, "invalid netCDF file", filename );
+        return false;
+    }
+    
+    const std::size_t numIssues = report.GetNumIssues();
+    
+    hasSOFARequiredAttributes( report );
+    hasSOFAConvention( report );
+    
+    if( SOFADimensionsAreValid( report ) == false )
+    {
+        return false;
+    }
+    
+    checkListenerVariables( report );
+    checkSourceVariables( report );
+    checkReceiverVariables( report );
+    checkEmitterVariables( report );
+    checkDimensions( report );
+    checkDataVariable( report );
+    
+    return ( report.GetNumIssues() == numIssues );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Throws an exception with the message of the first issue of a report;
+ *                  this is how the throwing IsValid() methods report a failed validation
+ *  @return         false if the report is not valid
+ *
+ *  @details        If the file is not a netCDF file, no exception is raised
+ */
+/************************************************************************************/
+bool File::raiseFirstIssue(const sofa::ValidationReport &report) const
+{
+    if( report.IsValid() == true )
+    {
+        return true;
+    }
+    
+    const sofa::ValidationReport::Issue & issue = report.GetIssues().front();
+    
+    if( issue.code != sofa::ValidationReport::kInvalidNetCDFFile )
+    {
+        SOFA_THROW( issue.message );
+    }
+    
+    return false;
 }
 
 /************************************************************************************/
@@ -146,7 +290,7 @@ void File::PrintSOFADimensions(std::ostream & output, const bool withPadding) co
  *
  */
 /************************************************************************************/
-bool File::hasSOFARequiredDimensions() const
+bool File::hasSOFARequiredDimensions(sofa::ValidationReport &report) const
 {
     const bool valid = ( HasDimension("I") == true 
                         && HasDimension("M") == true  
@@ -161,7 +305,7 @@ bool File::hasSOFARequiredDimensions() const
     }
     else
     {
-        SOFA_THROW( "missing SOFA dimension(s)" );
+        report.Add( sofa::ValidationReport::kMissingDimension, "missing SOFA dimension(s)" );
         return false;
     }
 }
@@ -173,7 +317,7 @@ bool File::hasSOFARequiredDimensions() const
  *
  */
 /************************************************************************************/
-bool File::SOFADimensionsAreValid() const
+bool File::SOFADimensionsAreValid(sofa::ValidationReport &report) const
 {    
     const long M = GetDimension( "M" );
     const long N = GetDimension( "N" );
@@ -190,7 +334,7 @@ bool File::SOFADimensionsAreValid() const
     }
     else
     {
-        SOFA_THROW( "invalid SOFA dimension(s)" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension(s)" );
         return false;
     }
 }
@@ -204,6 +348,11 @@ bool File::SOFADimensionsAreValid() const
 /************************************************************************************/
 long File::GetNumMeasurements() const
 {
+    if( GetMetadata().IsLoaded() == true )
+    {
+        return numMeasurements;
+    }
+    
     return GetDimension( "M" );
 }
 
@@ -216,6 +365,11 @@ long File::GetNumMeasurements() const
 /************************************************************************************/
 long File::GetNumReceivers() const
 {
+    if( GetMetadata().IsLoaded() == true )
+    {
+        return numReceivers;
+    }
+    
     return GetDimension( "R" );
 }
 
@@ -228,6 +382,11 @@ long File::GetNumReceivers() const
 /************************************************************************************/
 long File::GetNumEmitters() const
 {
+    if( GetMetadata().IsLoaded() == true )
+    {
+        return numEmitters;
+    }
+    
     return GetDimension( "E" );
 }
 
@@ -241,7 +400,12 @@ long File::GetNumEmitters() const
 /************************************************************************************/
 long File::GetNumDataSamples() const
 {
-    return GetDimension( "N" );    
+    if( GetMetadata().IsLoaded() == true )
+    {
+        return numDataSamples;
+    }
+    
+    return GetDimension( "N" );
 }
 
 
@@ -266,8 +430,10 @@ bool File::HasAttribute(const sofa::Attributes::Type &type_) const
  *
  */
 /************************************************************************************/
-bool File::hasSOFARequiredAttributes() const
+bool File::hasSOFARequiredAttributes(sofa::ValidationReport &report) const
 {
+    bool valid = true;
+    
     for( unsigned int i = 0; i < sofa::Attributes::kNumAttributes; i++ )
     {
         const sofa::Attributes::Type type_ = static_cast< const sofa::Attributes::Type >( i );
@@ -280,13 +446,13 @@ bool File::hasSOFARequiredAttributes() const
             if( hasIt == false )
             {
                 const std::string err = "Missing SOFA attribute : " + sofa::Attributes::GetName( type_ );
-                SOFA_THROW( err );
-                return false;
+                report.Add( sofa::ValidationReport::kMissingAttribute, err, sofa::Attributes::GetName( type_ ) );
+                valid = false;
             }
         }
     }
     
-    return true;
+    return valid;
 }
 
 /************************************************************************************/
@@ -323,7 +489,7 @@ void File::GetGlobalAttributes(sofa::Attributes &attributes) const
  *
  */
 /************************************************************************************/
-bool File::hasSOFAConvention() const
+bool File::hasSOFAConvention(sofa::ValidationReport &report) const
 {
     const std::string value = GetAttributeValueAsString( "Conventions" );
     
@@ -333,7 +499,7 @@ bool File::hasSOFAConvention() const
     }
     else
     {
-        SOFA_THROW( "invalid SOFA Conventions" );
+        report.Add( sofa::ValidationReport::kInvalidConventions, "invalid SOFA Conventions", "Conventions" );
         return false;
     }
 }
@@ -348,6 +514,11 @@ bool File::hasSOFAConvention() const
 /************************************************************************************/
 std::string File::GetSOFAConventions() const
 {
+    if( GetMetadata().IsLoaded() == true )
+    {
+        return sofaConventions;
+    }
+    
     return GetAttributeValueAsString( "SOFAConventions" );
 }
 
@@ -368,26 +539,26 @@ std::string File::GetSOFAConventions() const
  *  @details        some of the tests are redundant, but anyway they should be rather fast
  */
 /************************************************************************************/
-bool File::checkListenerVariables() const
+bool File::checkListenerVariables(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );    
     if( I != 1 )
     {
-        SOFA_THROW( "invalid SOFA dimension : I" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : I", "I" );
         return false;
     }
         
     const long C = GetDimension( "C" );    
     if( C != 3 )
     {
-        SOFA_THROW( "invalid SOFA dimension : C" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : C", "C" );
         return false;
     }
     
     const long M = GetNumMeasurements();    
     if( M <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : M" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : M", "M" );
         return false;
     }
     
@@ -399,14 +570,14 @@ bool File::checkListenerVariables() const
     
     if( listener.IsValid() == false )        
     {
-        SOFA_THROW( "invalid 'Listener' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Listener' variables", "Listener" );
         return false;
     }
     
     if( listener.ListenerPositionHasDimensions(  I,  C ) == false
      && listener.ListenerPositionHasDimensions(  M,  C ) == false )
     {
-        SOFA_THROW( "invalid 'ListenerPosition' dimensions" );
+        reportDimensions( report, "invalid 'ListenerPosition' dimensions", "ListenerPosition", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
         return false;
     }
     
@@ -418,7 +589,7 @@ bool File::checkListenerVariables() const
         if( listener.ListenerUpHasDimensions(  I,  C ) == false
          && listener.ListenerUpHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'ListenerUp' dimensions" );
+            reportDimensions( report, "invalid 'ListenerUp' dimensions", "ListenerUp", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
@@ -431,7 +602,7 @@ bool File::checkListenerVariables() const
         if( listener.ListenerViewHasDimensions(  I,  C ) == false
          && listener.ListenerViewHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'ListenerView' dimensions" );
+            reportDimensions( report, "invalid 'ListenerView' dimensions", "ListenerView", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
@@ -458,26 +629,26 @@ bool File::checkListenerVariables() const
  *  @details        some of the tests are redundant, but anyway they should be rather fast
  */
 /************************************************************************************/
-bool File::checkSourceVariables() const
+bool File::checkSourceVariables(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );    
     if( I != 1 )
     {    
-        SOFA_THROW( "invalid SOFA dimension : I" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : I", "I" );
         return false;
     }
     
     const long C = GetDimension( "C" );    
     if( C != 3 )
     {
-        SOFA_THROW( "invalid SOFA dimension : C" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : C", "C" );
         return false;
     }
     
     const long M = GetNumMeasurements();    
     if( M <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : M" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : M", "M" );
         return false;
     }
     
@@ -489,14 +660,14 @@ bool File::checkSourceVariables() const
     
     if( source.IsValid() == false )
     {
-        SOFA_THROW( "invalid 'Source' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Source' variables", "Source" );
         return false;
     }
     
     if( source.SourcePositionHasDimensions(  I,  C ) == false
        && source.SourcePositionHasDimensions(  M,  C ) == false )
     {
-        SOFA_THROW( "invalid 'SourcePosition' dimensions" );
+        reportDimensions( report, "invalid 'SourcePosition' dimensions", "SourcePosition", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
         return false;
     }
     
@@ -508,7 +679,7 @@ bool File::checkSourceVariables() const
         if( source.SourceUpHasDimensions(  I,  C ) == false
            && source.SourceUpHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'SourceUp' dimensions" );
+            reportDimensions( report, "invalid 'SourceUp' dimensions", "SourceUp", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
@@ -521,7 +692,7 @@ bool File::checkSourceVariables() const
         if( source.SourceViewHasDimensions(  I,  C ) == false
            && source.SourceViewHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'SourceView' dimensions" );
+            reportDimensions( report, "invalid 'SourceView' dimensions", "SourceView", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
@@ -549,33 +720,33 @@ bool File::checkSourceVariables() const
  *  @details        some of the tests are redundant, but anyway they should be rather fast
  */
 /************************************************************************************/
-bool File::checkReceiverVariables() const
+bool File::checkReceiverVariables(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );    
     if( I != 1 )
     {
-        SOFA_THROW( "invalid SOFA dimension : I" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : I", "I" );
         return false;
     }
     
     const long C = GetDimension( "C" );    
     if( C != 3 )
     {
-        SOFA_THROW( "invalid SOFA dimension : C" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : C", "C" );
         return false;
     }
     
     const long M = GetNumMeasurements();    
     if( M <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : M" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : M", "M" );
         return false;
     }
     
     const long R = GetNumReceivers();    
     if( R <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : R" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : R", "R" );
         return false;
     }    
     
@@ -587,14 +758,14 @@ bool File::checkReceiverVariables() const
     
     if( receiver.IsValid() == false )        
     {
-        SOFA_THROW( "invalid 'Receiver' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Receiver' variables", "Receiver" );
         return false;
     }
     
     if( receiver.ReceiverPositionHasDimensions(  R,  C,  I ) == false
      && receiver.ReceiverPositionHasDimensions(  R,  C,  M ) == false )
     {
-        SOFA_THROW( "invalid 'ReceiverPosition' dimensions" );
+        reportDimensions( report, "invalid 'ReceiverPosition' dimensions", "ReceiverPosition", sofa::ValidationReport::Dimensions( R, C, I ), sofa::ValidationReport::Dimensions( R, C, M ) );
         return false;
     }
     
@@ -606,7 +777,7 @@ bool File::checkReceiverVariables() const
         if( receiver.ReceiverUpHasDimensions(  R,  C,  I ) == false
            && receiver.ReceiverUpHasDimensions(  R,  C,  M ) == false )
         {
-            SOFA_THROW( "invalid 'ReceiverUp' dimensions" );
+            reportDimensions( report, "invalid 'ReceiverUp' dimensions", "ReceiverUp", sofa::ValidationReport::Dimensions( R, C, I ), sofa::ValidationReport::Dimensions( R, C, M ) );
             return false;
         }
     }
@@ -619,7 +790,7 @@ bool File::checkReceiverVariables() const
         if( receiver.ReceiverViewHasDimensions(  R,  C,  I ) == false
            && receiver.ReceiverViewHasDimensions(  R,  C,  M ) == false )
         {
-            SOFA_THROW( "invalid 'ReceiverView' dimensions" );
+            reportDimensions( report, "invalid 'ReceiverView' dimensions", "ReceiverView", sofa::ValidationReport::Dimensions( R, C, I ), sofa::ValidationReport::Dimensions( R, C, M ) );
             return false;
         }
     }
@@ -647,33 +818,33 @@ bool File::checkReceiverVariables() const
  *  @details        some of the tests are redundant, but anyway they should be rather fast
  */
 /************************************************************************************/
-bool File::checkEmitterVariables() const
+bool File::checkEmitterVariables(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );    
     if( I != 1 )
     {
-        SOFA_THROW( "invalid SOFA dimension : I" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : I", "I" );
         return false;
     }
     
     const long C = GetDimension( "C" );    
     if( C != 3 )
     {
-        SOFA_THROW( "invalid SOFA dimension : C" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : C", "C" );
         return false;
     }
     
     const long M = GetNumMeasurements();    
     if( M <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : M" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : M", "M" );
         return false;
     }
     
     const long E = GetNumEmitters();    
     if( E <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : E" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : E", "E" );
         return false;
     }    
     
@@ -685,14 +856,14 @@ bool File::checkEmitterVariables() const
     
     if( emitter.IsValid() == false )
     {
-        SOFA_THROW( "invalid 'Emitter' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Emitter' variables", "Emitter" );
         return false;
     }
     
     if( emitter.EmitterPositionHasDimensions(  E,  C,  I ) == false
        && emitter.EmitterPositionHasDimensions(  E,  C,  M ) == false )
     {
-        SOFA_THROW( "invalid 'EmitterPosition' dimensions" );
+        reportDimensions( report, "invalid 'EmitterPosition' dimensions", "EmitterPosition", sofa::ValidationReport::Dimensions( E, C, I ), sofa::ValidationReport::Dimensions( E, C, M ) );
         return false;
     }
     
@@ -704,7 +875,7 @@ bool File::checkEmitterVariables() const
         if( emitter.EmitterUpHasDimensions(  E,  C,  I ) == false
            && emitter.EmitterUpHasDimensions(  E,  C,  M ) == false )
         {
-            SOFA_THROW( "invalid 'EmitterUp' dimensions" );
+            reportDimensions( report, "invalid 'EmitterUp' dimensions", "EmitterUp", sofa::ValidationReport::Dimensions( E, C, I ), sofa::ValidationReport::Dimensions( E, C, M ) );
             return false;
         }
     }
@@ -717,7 +888,7 @@ bool File::checkEmitterVariables() const
         if( emitter.EmitterViewHasDimensions(  E,  C,  I ) == false
            && emitter.EmitterViewHasDimensions(  E,  C,  M ) == false )
         {
-            SOFA_THROW( "invalid 'EmitterView' dimensions" );
+            reportDimensions( report, "invalid 'EmitterView' dimensions", "EmitterView", sofa::ValidationReport::Dimensions( E, C, I ), sofa::ValidationReport::Dimensions( E, C, M ) );
             return false;
         }
     }
@@ -726,33 +897,33 @@ bool File::checkEmitterVariables() const
     return true;
 }
 
-bool File::checkDimensions() const
+bool File::checkDimensions(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );
     if( I != 1 )
     {
-        SOFA_THROW( "invalid SOFA dimension : I" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : I", "I" );
         return false;
     }
     
     const long M = GetNumMeasurements();
     if( M <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : M" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : M", "M" );
         return false;
     }
     
     const long R = GetNumReceivers();
     if( R <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : R" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : R", "R" );
         return false;
     }
     
     const long N = GetNumDataSamples();
     if( N <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : N" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : N", "N" );
         return false;
     }
     
@@ -774,51 +945,71 @@ bool File::checkDimensions() const
  *  @details        some of the tests are redundant, but anyway they should be rather fast
  */
 /************************************************************************************/
-bool File::checkDataVariable() const
+bool File::checkDataVariable(sofa::ValidationReport &report) const
 {
     if( IsFIRDataType() == true )
     {
-        return checkFirDataType();
+        return checkFirDataType( report );
     }
     else if( IsTFDataType() == true )
     {
-        return checkTFDataType();
+        return checkTFDataType( report );
     }
     else if( IsSOSDataType() == true )
     {
-        return checkSOSDataType();
+        return checkSOSDataType( report );
     }
     else if( IsFIREDataType() == true )
     {
-        return checkFireDataType();
+        return checkFireDataType( report );
     }
     else
     {
-        SOFA_THROW( "invalid 'DataType'" );
+        report.Add( sofa::ValidationReport::kInvalidDataType, "invalid 'DataType'", "DataType" );
         return false;
     }
 }
 
 bool File::IsFIRDataType() const
 {
+    if( GetMetadata().IsLoaded() == true )
+    {
+        return ( dataType == "FIR" );
+    }
+    
     const std::string value = GetAttributeValueAsString( "DataType" );
     return ( value == "FIR" );
 }
 
 bool File::IsFIREDataType() const
 {
+    if( GetMetadata().IsLoaded() == true )
+    {
+        return ( dataType == "FIRE" );
+    }
+    
     const std::string value = GetAttributeValueAsString( "DataType" );
     return ( value == "FIRE" );
 }
 
 bool File::IsTFDataType() const
 {
+    if( GetMetadata().IsLoaded() == true )
+    {
+        return ( dataType == "TF" );
+    }
+    
     const std::string value = GetAttributeValueAsString( "DataType" );
     return ( value == "TF" );
 }
 
 bool File::IsSOSDataType() const
 {
+    if( GetMetadata().IsLoaded() == true )
+    {
+        return ( dataType == "SOS" );
+    }
+    
     const std::string value = GetAttributeValueAsString( "DataType" );
     return ( value == "SOS" );
 }
@@ -830,7 +1021,7 @@ bool File::IsSOSDataType() const
  *
  */
 /************************************************************************************/
-bool File::checkTFDataType() const
+bool File::checkTFDataType(sofa::ValidationReport &report) const
 {
     //const long I = GetDimension( "I" );
     const long M = GetNumMeasurements();
@@ -843,19 +1034,19 @@ bool File::checkTFDataType() const
         
         if( sofa::NcUtils::IsValid( varReal ) == false )
         {
-            SOFA_THROW( "invalid 'Data.Real' variable" );
+            report.Add( sofa::ValidationReport::kMissingVariable, "invalid 'Data.Real' variable", "Data.Real" );
             return false;
         }
         
-        if( sofa::NcUtils::IsDouble( varReal ) == false )
+        if( sofa::NcUtils::IsNumeric( varReal ) == false )
         {
-            SOFA_THROW( "invalid 'Data.Real' variable" );
+            report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.Real' variable", "Data.Real" );
             return false;
         }
         
         if( sofa::NcUtils::HasDimensions(  M,  R,  N, varReal ) == false )
         {
-            SOFA_THROW( "invalid dimensions for 'Data.Real'" );
+            reportDimensions( report, "invalid dimensions for 'Data.Real'", "Data.Real", sofa::ValidationReport::Dimensions( M, R, N ) );
             return false;
         }
     }
@@ -864,19 +1055,19 @@ bool File::checkTFDataType() const
         
         if( sofa::NcUtils::IsValid( varImag ) == false )
         {
-            SOFA_THROW( "invalid 'Data.Imag' variable" );
+            report.Add( sofa::ValidationReport::kMissingVariable, "invalid 'Data.Imag' variable", "Data.Imag" );
             return false;
         }
         
-        if( sofa::NcUtils::IsDouble( varImag ) == false )
+        if( sofa::NcUtils::IsNumeric( varImag ) == false )
         {
-            SOFA_THROW( "invalid 'Data.Imag' variable" );
+            report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.Imag' variable", "Data.Imag" );
             return false;
         }
         
         if( sofa::NcUtils::HasDimensions(  M,  R,  N, varImag ) == false )
         {
-            SOFA_THROW( "invalid dimensions for 'Data.Imag'" );
+            reportDimensions( report, "invalid dimensions for 'Data.Imag'", "Data.Imag", sofa::ValidationReport::Dimensions( M, R, N ) );
             return false;
         }
     }
@@ -887,19 +1078,19 @@ bool File::checkTFDataType() const
     
     if( sofa::NcUtils::IsValid( varN ) == false )
     {
-        SOFA_THROW( "missing 'N' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'N' variable", "N" );
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varN ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( varN ) == false )
     {
-        SOFA_THROW( "invalid 'N' variable" );
+        report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'N' variable", "N" );
         return false;
     }
     
     if( sofa::NcUtils::HasDimension( N, varN ) == false )
     {
-        SOFA_THROW( "invalid dimensions for 'N'" );
+        reportDimensions( report, "invalid dimensions for 'N'", "N", sofa::ValidationReport::Dimensions( N ) );
         return false;
     }
     
@@ -907,7 +1098,7 @@ bool File::checkTFDataType() const
     
     if( sofa::Units::IsValid( attNUnits ) == false )
     {
-        SOFA_THROW( "invalid 'N:Units'" );
+        report.Add( sofa::ValidationReport::kInvalidUnits, "invalid 'N:Units'", "N:Units" );
         return false;
     }
     
@@ -915,15 +1106,15 @@ bool File::checkTFDataType() const
     
     if( sofa::Units::IsFrequencyUnit( unitsName ) == false )
     {
-        SOFA_THROW( "invalid 'N:Units'" );
+        report.Add( sofa::ValidationReport::kInvalidUnits, "invalid 'N:Units'", "N:Units" );
         return false;
     }
     
     const netCDF::NcVarAtt attNLongName = sofa::NcUtils::GetAttribute( varN, "LongName" );
     
-    if( sofa::Units::IsValid( attNLongName ) == false )
+    if( sofa::NcUtils::IsChar( attNLongName ) == false )
     {
-        SOFA_THROW( "invalid 'LongName'" );
+        report.Add( sofa::ValidationReport::kInvalidAttribute, "invalid 'LongName'", "LongName" );
         return false;
     }
     
@@ -938,7 +1129,7 @@ bool File::checkTFDataType() const
  *
  */
 /************************************************************************************/
-bool File::checkFirDataType() const
+bool File::checkFirDataType(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );
     const long M = GetNumMeasurements();
@@ -950,19 +1141,19 @@ bool File::checkFirDataType() const
     
     if( sofa::NcUtils::IsValid( varIR ) == false )
     {
-        SOFA_THROW( "missing 'Data.IR' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'Data.IR' variable", "Data.IR" );
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varIR ) == false )
+    if( sofa::NcUtils::IsNumeric( varIR ) == false )
     {
-        SOFA_THROW( "invalid 'Data.IR' variable" );
+        report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.IR' variable", "Data.IR" );
         return false;
     }
     
     if( sofa::NcUtils::HasDimensions( M,  R,  N, varIR ) == false )
     {
-        SOFA_THROW( "invalid dimensions for 'Data.IR'" );
+        reportDimensions( report, "invalid dimensions for 'Data.IR'", "Data.IR", sofa::ValidationReport::Dimensions( M, R, N ) );
         return false;
     }
     
@@ -970,20 +1161,20 @@ bool File::checkFirDataType() const
     
     if( sofa::NcUtils::IsValid( varSamplingRate ) == false )
     {
-        SOFA_THROW( "missing 'Data.SamplingRate' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'Data.SamplingRate' variable", "Data.SamplingRate" );
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varSamplingRate ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( varSamplingRate ) == false )
     {
-        SOFA_THROW( "invalid 'Data.SamplingRate' variable" );
+        report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.SamplingRate' variable", "Data.SamplingRate" );
         return false;
     }
     
     if( sofa::NcUtils::HasDimension( I, varSamplingRate ) == false
      && sofa::NcUtils::HasDimension( M, varSamplingRate ) == false )
     {
-        SOFA_THROW( "invalid dimensions for 'Data.SamplingRate'" );
+        reportDimensions( report, "invalid dimensions for 'Data.SamplingRate'", "Data.SamplingRate", sofa::ValidationReport::Dimensions( I ), sofa::ValidationReport::Dimensions( M ) );
         return false;
     }
     
@@ -991,7 +1182,7 @@ bool File::checkFirDataType() const
     
     if( sofa::Units::IsValid( attSamplingRateUnits ) == false )
     {
-        SOFA_THROW( "invalid 'Data.SamplingRate:Units'" );
+        report.Add( sofa::ValidationReport::kInvalidUnits, "invalid 'Data.SamplingRate:Units'", "Data.SamplingRate:Units" );
         return false;
     }
     
@@ -999,7 +1190,7 @@ bool File::checkFirDataType() const
     
     if( sofa::Units::IsFrequencyUnit( unitsName ) == false )
     {
-        SOFA_THROW( "invalid 'Data.SamplingRate:Units'" );
+        report.Add( sofa::ValidationReport::kInvalidUnits, "invalid 'Data.SamplingRate:Units'", "Data.SamplingRate:Units" );
         return false;
     }
     
@@ -1008,20 +1199,20 @@ bool File::checkFirDataType() const
     
     if( sofa::NcUtils::IsValid( varDelay ) == false )
     {
-        SOFA_THROW( "missing 'Data.Delay' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'Data.Delay' variable", "Data.Delay" );
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varDelay ) == false )
+    if( sofa::NcUtils::IsNumeric( varDelay ) == false )
     {
-        SOFA_THROW( "invalid 'Data.Delay' variable" );
+        report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.Delay' variable", "Data.Delay" );
         return false;
     }
     
     if( sofa::NcUtils::HasDimensions( I, R, varDelay ) == false
      && sofa::NcUtils::HasDimensions( M, R, varDelay ) == false )
     {
-        SOFA_THROW( "invalid dimensions for 'Data.Delay'" );
+        reportDimensions( report, "invalid dimensions for 'Data.Delay'", "Data.Delay", sofa::ValidationReport::Dimensions( I, R ), sofa::ValidationReport::Dimensions( M, R ) );
         return false;
     }
     
@@ -1037,7 +1228,7 @@ bool File::checkFirDataType() const
  *
  */
 /************************************************************************************/
-bool File::checkFireDataType() const
+bool File::checkFireDataType(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );
     const long M = GetNumMeasurements();
@@ -1050,19 +1241,19 @@ bool File::checkFireDataType() const
     
     if( sofa::NcUtils::IsValid( varIR ) == false )
     {
-        SOFA_THROW( "missing 'Data.IR' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'Data.IR' variable", "Data.IR" );
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varIR ) == false )
+    if( sofa::NcUtils::IsNumeric( varIR ) == false )
     {
-        SOFA_THROW( "invalid 'Data.IR' variable" );
+        report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.IR' variable", "Data.IR" );
         return false;
     }
     
     if( sofa::NcUtils::HasDimensions( M, R, E, N, varIR ) == false )
     {
-        SOFA_THROW( "invalid dimensions for 'Data.IR'" );
+        reportDimensions( report, "invalid dimensions for 'Data.IR'", "Data.IR", sofa::ValidationReport::Dimensions( M, R, E, N ) );
         return false;
     }
     
@@ -1070,20 +1261,20 @@ bool File::checkFireDataType() const
     
     if( sofa::NcUtils::IsValid( varSamplingRate ) == false )
     {
-        SOFA_THROW( "missing 'Data.SamplingRate' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'Data.SamplingRate' variable", "Data.SamplingRate" );
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varSamplingRate ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( varSamplingRate ) == false )
     {
-        SOFA_THROW( "invalid 'Data.SamplingRate' variable" );
+        report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.SamplingRate' variable", "Data.SamplingRate" );
         return false;
     }
     
     if( sofa::NcUtils::HasDimension( I, varSamplingRate ) == false
      && sofa::NcUtils::HasDimension( M, varSamplingRate ) == false )
     {
-        SOFA_THROW( "invalid dimensions for 'Data.SamplingRate'" );
+        reportDimensions( report, "invalid dimensions for 'Data.SamplingRate'", "Data.SamplingRate", sofa::ValidationReport::Dimensions( I ), sofa::ValidationReport::Dimensions( M ) );
         return false;
     }
     
@@ -1091,7 +1282,7 @@ bool File::checkFireDataType() const
     
     if( sofa::Units::IsValid( attSamplingRateUnits ) == false )
     {
-        SOFA_THROW( "invalid 'Data.SamplingRate:Units'" );
+        report.Add( sofa::ValidationReport::kInvalidUnits, "invalid 'Data.SamplingRate:Units'", "Data.SamplingRate:Units" );
         return false;
     }
     
@@ -1099,7 +1290,7 @@ bool File::checkFireDataType() const
     
     if( sofa::Units::IsFrequencyUnit( unitsName ) == false )
     {
-        SOFA_THROW( "invalid 'Data.SamplingRate:Units'" );
+        report.Add( sofa::ValidationReport::kInvalidUnits, "invalid 'Data.SamplingRate:Units'", "Data.SamplingRate:Units" );
         return false;
     }
     
@@ -1108,20 +1299,20 @@ bool File::checkFireDataType() const
     
     if( sofa::NcUtils::IsValid( varDelay ) == false )
     {
-        SOFA_THROW( "missing 'Data.Delay' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'Data.Delay' variable", "Data.Delay" );
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varDelay ) == false )
+    if( sofa::NcUtils::IsNumeric( varDelay ) == false )
     {
-        SOFA_THROW( "invalid 'Data.Delay' variable" );
+        report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.Delay' variable", "Data.Delay" );
         return false;
     }
     
     if( sofa::NcUtils::HasDimensions( I, R, E, varDelay ) == false
      && sofa::NcUtils::HasDimensions( M, R, E, varDelay ) == false )
     {
-        SOFA_THROW( "invalid dimensions for 'Data.Delay'" );
+        reportDimensions( report, "invalid dimensions for 'Data.Delay'", "Data.Delay", sofa::ValidationReport::Dimensions( I, R, E ), sofa::ValidationReport::Dimensions( M, R, E ) );
         return false;
     }
     
@@ -1136,7 +1327,7 @@ bool File::checkFireDataType() const
  *
  */
 /************************************************************************************/
-bool File::checkSOSDataType() const
+bool File::checkSOSDataType(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );
     const long M = GetNumMeasurements();
@@ -1148,19 +1339,19 @@ bool File::checkSOSDataType() const
     
     if( sofa::NcUtils::IsValid( varSOS ) == false )
     {
-        SOFA_THROW( "missing 'Data.SOS' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'Data.SOS' variable", "Data.SOS" );
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varSOS ) == false )
+    if( sofa::NcUtils::IsNumeric( varSOS ) == false )
     {
-        SOFA_THROW( "invalid 'Data.SOS' variable" );
+        report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.SOS' variable", "Data.SOS" );
         return false;
     }
     
     if( sofa::NcUtils::HasDimensions( M,  R,  N, varSOS ) == false )
     {
-        SOFA_THROW( "invalid dimensions for 'Data.SOS'" );
+        reportDimensions( report, "invalid dimensions for 'Data.SOS'", "Data.SOS", sofa::ValidationReport::Dimensions( M, R, N ) );
         return false;
     }
     
@@ -1168,20 +1359,20 @@ bool File::checkSOSDataType() const
     
     if( sofa::NcUtils::IsValid( varSamplingRate ) == false )
     {
-        SOFA_THROW( "missing 'Data.SamplingRate' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'Data.SamplingRate' variable", "Data.SamplingRate" );
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varSamplingRate ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( varSamplingRate ) == false )
     {
-        SOFA_THROW( "invalid 'Data.SamplingRate' variable" );
+        report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.SamplingRate' variable", "Data.SamplingRate" );
         return false;
     }
     
     if( sofa::NcUtils::HasDimension( I, varSamplingRate ) == false
      && sofa::NcUtils::HasDimension( M, varSamplingRate ) == false )
     {
-        SOFA_THROW( "invalid dimensions for 'Data.SamplingRate'" );
+        reportDimensions( report, "invalid dimensions for 'Data.SamplingRate'", "Data.SamplingRate", sofa::ValidationReport::Dimensions( I ), sofa::ValidationReport::Dimensions( M ) );
         return false;
     }
     
@@ -1189,7 +1380,7 @@ bool File::checkSOSDataType() const
     
     if( sofa::Units::IsValid( attSamplingRateUnits ) == false )
     {
-        SOFA_THROW( "invalid 'Data.SamplingRate:Units'" );
+        report.Add( sofa::ValidationReport::kInvalidUnits, "invalid 'Data.SamplingRate:Units'", "Data.SamplingRate:Units" );
         return false;
     }
     
@@ -1197,7 +1388,7 @@ bool File::checkSOSDataType() const
     
     if( sofa::Units::IsFrequencyUnit( unitsName ) == false )
     {
-        SOFA_THROW( "invalid 'Data.SamplingRate:Units'" );
+        report.Add( sofa::ValidationReport::kInvalidUnits, "invalid 'Data.SamplingRate:Units'", "Data.SamplingRate:Units" );
         return false;
     }
     
@@ -1206,20 +1397,20 @@ bool File::checkSOSDataType() const
     
     if( sofa::NcUtils::IsValid( varDelay ) == false )
     {
-        SOFA_THROW( "missing 'Data.Delay' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'Data.Delay' variable", "Data.Delay" );
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varDelay ) == false )
+    if( sofa::NcUtils::IsNumeric( varDelay ) == false )
     {
-        SOFA_THROW( "invalid 'Data.Delay' variable" );
+        report.Add( sofa::ValidationReport::kInvalidVariableType, "invalid 'Data.Delay' variable", "Data.Delay" );
         return false;
     }
     
     if( sofa::NcUtils::HasDimensions( I, R, varDelay ) == false
      && sofa::NcUtils::HasDimensions( M, R, varDelay ) == false )
     {
-        SOFA_THROW( "invalid dimensions for 'Data.Delay'" );
+        reportDimensions( report, "invalid dimensions for 'Data.Delay'", "Data.Delay", sofa::ValidationReport::Dimensions( I, R ), sofa::ValidationReport::Dimensions( M, R ) );
         return false;
     }
     
@@ -1532,6 +1723,126 @@ bool File::GetEmitterView(std::vector< double > &values) const
     return NetCDFFile::GetValues( values, "EmitterView" );
 }
 
+bool File::GetReceiverPosition(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "ReceiverPosition" );
+}
+
+bool File::GetReceiverUp(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "ReceiverUp" );
+}
+
+bool File::GetReceiverView(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "ReceiverView" );
+}
+
+bool File::GetEmitterPosition(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "EmitterPosition" );
+}
+
+bool File::GetEmitterUp(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "EmitterUp" );
+}
+
+bool File::GetEmitterView(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "EmitterView" );
+}
+
+bool File::GetListenerPosition(float *values, const unsigned long dim1, const unsigned long dim2) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, "ListenerPosition" );
+}
+
+bool File::GetListenerUp(float *values, const unsigned long dim1, const unsigned long dim2) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, "ListenerUp" );
+}
+
+bool File::GetListenerView(float *values, const unsigned long dim1, const unsigned long dim2) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, "ListenerView" );
+}
+
+bool File::GetSourcePosition(float *values, const unsigned long dim1, const unsigned long dim2) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, "SourcePosition" );
+}
+
+bool File::GetSourceUp(float *values, const unsigned long dim1, const unsigned long dim2) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, "SourceUp" );
+}
+
+bool File::GetSourceView(float *values, const unsigned long dim1, const unsigned long dim2) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, "SourceView" );
+}
+
+bool File::GetListenerPosition(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "ListenerPosition" );
+}
+
+bool File::GetListenerUp(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "ListenerUp" );
+}
+
+bool File::GetListenerView(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "ListenerView" );
+}
+
+bool File::GetSourcePosition(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "SourcePosition" );
+}
+
+bool File::GetSourceUp(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "SourceUp" );
+}
+
+bool File::GetSourceView(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "SourceView" );
+}
+
+bool File::GetReceiverPosition(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "ReceiverPosition" );
+}
+
+bool File::GetReceiverUp(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "ReceiverUp" );
+}
+
+bool File::GetReceiverView(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "ReceiverView" );
+}
+
+bool File::GetEmitterPosition(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "EmitterPosition" );
+}
+
+bool File::GetEmitterUp(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "EmitterUp" );
+}
+
+bool File::GetEmitterView(std::vector< float > &values) const
+{
+    return NetCDFFile::GetValues( values, "EmitterView" );
+}
+
 
 /************************************************************************************/
 /*!
@@ -1555,45 +1866,654 @@ bool File::getDataIR(double *values, const unsigned long dim1, const unsigned lo
 
 /************************************************************************************/
 /*!
- *  @brief          Retrieves the Data.IR values
- *  @param[in]      values : the array is resized if needed
- *  @return         true on success
- *
- */
-/************************************************************************************/
-bool File::getDataIR(std::vector< double > &values) const
-{
-    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
-    
-    return NetCDFFile::GetValues( values, "Data.IR" );
-}
-
-
-/************************************************************************************/
-/*!
- *  @brief          Retrieves the channel ordering of the Data.IR variable
- *  @return         true on success
+ *  @brief          Reads a variable [M R ...] into a given layout, or into padded slots,
+ *                  a block of measurements at a time : each block is rearranged while it
+ *                  is still in cache, and the whole variable is never held twice in memory
  *
  */
 /************************************************************************************/
-bool File::GetDataIRChannelOrdering(sofa::AmbisonicsChannelOrdering::Type &channelOrdering) const
+namespace FileHelper
 {
-    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
-    
-    const netCDF::NcVar var = getVariable( "Data.IR" );
-    
-    const netCDF::NcVarAtt attNChannelOrdering  = sofa::NcUtils::GetAttribute( var, "ChannelOrdering" );
-    const std::string channelOrderingName       = sofa::NcUtils::GetAttributeValueAsString( attNChannelOrdering );
-    
-    channelOrdering = sofa::AmbisonicsChannelOrdering::GetType( channelOrderingName );
+    /// size of the blocks of measurements read at once, in bytes
+    static const std::size_t kMeasurementBlockSize = 256 * 1024;
     
-    /* attribute not found */
-    if (channelOrdering == sofa::AmbisonicsChannelOrdering::kNumAmbisonicsChannelOrderingTypes)
+    /// copies the blocks of measurements into the values of the whole variable, in a given layout
+    template< typename T >
+    class LayoutWriter
     {
-        return false;
+    public:
+        LayoutWriter(T *values_,
+                     const std::vector< std::size_t > &storedDims_,
+                     const sofa::DataLayout::Type &layout_)
+        : values( values_ )
+        , storedDims( storedDims_ )
+        , layout( layout_ )
+        {
+        }
+        
+        void Write(const T *block,
+                   const std::size_t firstMeasurement,
+                   const std::size_t numMeasurements) const
+        {
+            sofa::DataLayout::Transform( values, block, storedDims, firstMeasurement, numMeasurements, layout );
+        }
+        
+    private:
+        T * const values;
+        const std::vector< std::size_t > &storedDims;
+        const sofa::DataLayout::Type layout;
+    };
+    
+    /// copies the blocks of measurements into one slot per impulse response (i.e. along the last dimension)
+    template< typename T >
+    class SlotWriter
+    {
+    public:
+        SlotWriter(T *values_,
+                   const std::size_t responsesPerMeasurement_,
+                   const std::size_t numSamples_,
+                   const std::size_t slotSize_,
+                   const bool zeroTail_)
+        : values( values_ )
+        , responsesPerMeasurement( responsesPerMeasurement_ )
+        , numSamples( numSamples_ )
+        , slotSize( slotSize_ )
+        , zeroTail( zeroTail_ )
+        {
+        }
+        
+        void Write(const T *block,
+                   const std::size_t firstMeasurement,
+                   const std::size_t numMeasurements) const
+        {
+            sofa::PaddedLayout::CopyToSlots( values + firstMeasurement * responsesPerMeasurement * slotSize,
+                                             block,
+                                             numMeasurements * responsesPerMeasurement,
+                                             numSamples,
+                                             slotSize,
+                                             zeroTail );
+        }
+        
+    private:
+        T * const values;
+        const std::size_t responsesPerMeasurement;
+        const std::size_t numSamples;
+        const std::size_t slotSize;
+        const bool zeroTail;
+    };
+    
+    template< typename T, typename Writer >
+    bool readMeasurementBlocks(const sofa::NetCDFFile &file,
+                               const std::string &variableName,
+                               const std::vector< std::size_t > &storedDims,
+                               const Writer &writer)
+    {
+        const std::size_t M                    = storedDims[0];
+        const std::size_t measurementSize      = sofa::NcUtils::GetNumElements( storedDims ) / M;
+        const std::size_t measurementsPerBlock = sofa::smax( (std::size_t) 1, kMeasurementBlockSize / ( measurementSize * sizeof( T ) ) );
+        
+        std::vector< std::size_t > start( storedDims.size(), 0 );
+        std::vector< std::size_t > count( storedDims );
+        
+        std::vector< T > block( sofa::smin( measurementsPerBlock, M ) * measurementSize );
+        
+        for( std::size_t m = 0; m < M; m += measurementsPerBlock )
+        {
+            start[0] = m;
+            count[0] = sofa::smin( measurementsPerBlock, M - m );
+            
+            if( file.GetValues( &block[0], start, count, std::vector< std::ptrdiff_t >(), variableName ) == false )
+            {
+                return false;
+            }
+            
+            writer.Write( &block[0], m, count[0] );
+        }
+        
+        return true;
     }
     
-    return true;
+    template< typename T >
+    bool getValues(sofa::Array< T > &values,
+                   const sofa::NetCDFFile &file,
+                   const std::string &variableName,
+                   const sofa::DataLayout::Type &layout)
+    {
+        if( layout == sofa::DataLayout::kMeasurementReceiverSample )
+        {
+            return file.GetValues( values, variableName );
+        }
+        
+        std::vector< std::size_t > storedDims;
+        file.GetVariableDimensions( storedDims, variableName );
+        
+        std::vector< std::size_t > dims;
+        
+        if( sofa::DataLayout::GetDimensions( dims, storedDims, layout ) == false
+           || sofa::NcUtils::GetNumElements( dims ) == 0
+           || values.Resize( dims ) == false )
+        {
+            return false;
+        }
+        
+        return readMeasurementBlocks< T >( file, variableName, storedDims, LayoutWriter< T >( values.GetData(), storedDims, layout ) );
+    }
+    
+    /// the values must be allocated large enough : all the dimensions but the last one, times the slot size
+    template< typename T >
+    bool getPaddedValues(T *values,
+                         const sofa::NetCDFFile &file,
+                         const std::string &variableName,
+                         const sofa::PaddedLayout &padding)
+    {
+        std::vector< std::size_t > storedDims;
+        file.GetVariableDimensions( storedDims, variableName );
+        
+        if( storedDims.size() < 2 || sofa::NcUtils::GetNumElements( storedDims ) == 0 )
+        {
+            return false;
+        }
+        
+        const std::size_t N        = storedDims.back();
+        const std::size_t slotSize = padding.GetSlotSize( N );
+        
+        if( slotSize == 0 )
+        {
+            return false;
+        }
+        
+        const std::size_t responsesPerMeasurement = sofa::NcUtils::GetNumElements( storedDims ) / ( storedDims[0] * N );
+        
+        return readMeasurementBlocks< T >( file, variableName, storedDims, SlotWriter< T >( values, responsesPerMeasurement, N, slotSize, padding.HasZeroTail() ) );
+    }
+    
+    template< typename T >
+    bool getPaddedValues(sofa::Array< T > &values,
+                         const sofa::NetCDFFile &file,
+                         const std::string &variableName,
+                         const sofa::PaddedLayout &padding)
+    {
+        std::vector< std::size_t > dims;
+        file.GetVariableDimensions( dims, variableName );
+        
+        if( dims.size() < 2 || sofa::NcUtils::GetNumElements( dims ) == 0 )
+        {
+            return false;
+        }
+        
+        dims.back() = padding.GetSlotSize( dims.back() );
+        
+        if( dims.back() == 0 || values.Resize( dims ) == false )
+        {
+            return false;
+        }
+        
+        return getPaddedValues( values.GetData(), file, variableName, padding );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(std::vector< double > &values) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return NetCDFFile::GetValues( values, "Data.IR" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array shaped like Data.IR
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(sofa::Array< double > &values) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return NetCDFFile::GetValues( values, "Data.IR" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, in a given layout
+ *                  (e.g. [R M N] or [M N R]); the layout is transformed while reading
+ *  @param[in]      values : the array is resized if needed
+ *  @param[in]      layout : the requested layout
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(sofa::Array< double > &values,
+                     const sofa::DataLayout::Type &layout) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return FileHelper::getValues( values, *this, "Data.IR", layout );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, each impulse response being written at the
+ *                  beginning of its own (zero-padded) slot
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. the product of all the
+ *                  dimensions of Data.IR but the last one, times padding.GetSlotSize( N )
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(double *values,
+                     const sofa::PaddedLayout &padding) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return FileHelper::getPaddedValues( values, *this, "Data.IR", padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array shaped like Data.IR,
+ *                  except for the last dimension which is the size of the (zero-padded) slots
+ *  @param[in]      values : the array is resized if needed
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(sofa::Array< double > &values,
+                     const sofa::PaddedLayout &padding) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return FileHelper::getPaddedValues( values, *this, "Data.IR", padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a hyperslab of the Data.IR values.
+ *                  Only the requested elements are read from the file
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(double *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return NetCDFFile::GetValues( values, start, count, "Data.IR" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of consecutive measurements
+ *                  (works for Data.IR [ M R N ] as well as [ M R E N ])
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. numMeasurements x R x N
+ *                  (or numMeasurements x R x E x N)
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIRMeasurements(double *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    std::vector< std::size_t > start;
+    std::vector< std::size_t > count;
+    
+    if( getDataIRMeasurementsHyperslab( start, count, firstMeasurement, numMeasurements ) == false )
+    {
+        return false;
+    }
+    
+    return File::getDataIR( values, start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one receiver, for all measurements
+ *                  (works for Data.IR [ M R N ] as well as [ M R E N ])
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. M x N (or M x E x N)
+ *  @param[in]      receiver : index of the receiver to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIRReceiver(double *values, const unsigned long receiver) const
+{
+    std::vector< std::size_t > start;
+    std::vector< std::size_t > count;
+    
+    if( getDataIRReceiverHyperslab( start, count, receiver ) == false )
+    {
+        return false;
+    }
+    
+    return File::getDataIR( values, start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one emitter, for all measurements and receivers
+ *                  (only for Data.IR [ M R E N ], i.e. DataType 'FIRE')
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. M x R x N
+ *  @param[in]      emitter : index of the emitter to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIREmitter(double *values, const unsigned long emitter) const
+{
+    std::vector< std::size_t > start;
+    std::vector< std::size_t > count;
+    
+    if( getDataIREmitterHyperslab( start, count, emitter ) == false )
+    {
+        return false;
+    }
+    
+    return File::getDataIR( values, start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the hyperslab of Data.IR covering consecutive measurements
+ *                  (works for Data.IR [ M R N ] as well as [ M R E N ])
+ *  @param[out]     start : index of the first element along each dimension
+ *  @param[out]     count : number of elements along each dimension
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIRMeasurementsHyperslab(std::vector< std::size_t > &start, std::vector< std::size_t > &count,
+                                          const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    GetVariableDimensions( count, "Data.IR" );
+    
+    if( count.size() < 3 )
+    {
+        return false;
+    }
+    
+    start.assign( count.size(), 0 );
+    
+    /// M is always the first dimension
+    start[0] = firstMeasurement;
+    count[0] = numMeasurements;
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the hyperslab of Data.IR covering one receiver, for all measurements
+ *                  (works for Data.IR [ M R N ] as well as [ M R E N ])
+ *  @param[out]     start : index of the first element along each dimension
+ *  @param[out]     count : number of elements along each dimension
+ *  @param[in]      receiver : index of the receiver to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIRReceiverHyperslab(std::vector< std::size_t > &start, std::vector< std::size_t > &count,
+                                      const unsigned long receiver) const
+{
+    GetVariableDimensions( count, "Data.IR" );
+    
+    if( count.size() < 3 )
+    {
+        return false;
+    }
+    
+    start.assign( count.size(), 0 );
+    
+    /// R is always the second dimension
+    start[1] = receiver;
+    count[1] = 1;
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the hyperslab of Data.IR covering one emitter, for all measurements and receivers
+ *                  (only for Data.IR [ M R E N ], i.e. DataType 'FIRE')
+ *  @param[out]     start : index of the first element along each dimension
+ *  @param[out]     count : number of elements along each dimension
+ *  @param[in]      emitter : index of the emitter to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIREmitterHyperslab(std::vector< std::size_t > &start, std::vector< std::size_t > &count,
+                                     const unsigned long emitter) const
+{
+    GetVariableDimensions( count, "Data.IR" );
+    
+    if( count.size() != 4 )
+    {
+        return false;
+    }
+    
+    start.assign( count.size(), 0 );
+    
+    /// Data.IR is [ M R E N ]
+    start[2] = emitter;
+    count[2] = 1;
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, as float
+ *                  (the conversion is performed by the netCDF library while reading)
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(std::vector< float > &values) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return NetCDFFile::GetValues( values, "Data.IR" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array shaped like Data.IR, as float
+ *                  (the conversion is performed by the netCDF library while reading)
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(sofa::Array< float > &values) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return NetCDFFile::GetValues( values, "Data.IR" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, in a given layout, as float
+ *                  (e.g. [R M N] or [M N R]); the layout is transformed while reading
+ *  @param[in]      values : the array is resized if needed
+ *  @param[in]      layout : the requested layout
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(sofa::Array< float > &values,
+                     const sofa::DataLayout::Type &layout) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return FileHelper::getValues( values, *this, "Data.IR", layout );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, each impulse response being written at the
+ *                  beginning of its own (zero-padded) slot, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. the product of all the
+ *                  dimensions of Data.IR but the last one, times padding.GetSlotSize( N )
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(float *values,
+                     const sofa::PaddedLayout &padding) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return FileHelper::getPaddedValues( values, *this, "Data.IR", padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array shaped like Data.IR,
+ *                  except for the last dimension which is the size of the (zero-padded) slots, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(sofa::Array< float > &values,
+                     const sofa::PaddedLayout &padding) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return FileHelper::getPaddedValues( values, *this, "Data.IR", padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough
+ *  @param[in]      dim1 : first dimension (M)
+ *  @param[in]      dim2 : second dimension (R)
+ *  @param[in]      dim3 : third dimension (N)
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    SOFA_ASSERT( GetVariableDimensionality( "Data.IR" ) == 3 );
+    
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "Data.IR" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a hyperslab of the Data.IR values, as float.
+ *                  Only the requested elements are read from the file
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(float *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return NetCDFFile::GetValues( values, start, count, "Data.IR" );
+}
+
+bool File::getDataIRMeasurements(float *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    std::vector< std::size_t > start;
+    std::vector< std::size_t > count;
+    
+    if( getDataIRMeasurementsHyperslab( start, count, firstMeasurement, numMeasurements ) == false )
+    {
+        return false;
+    }
+    
+    return File::getDataIR( values, start, count );
+}
+
+bool File::getDataIRReceiver(float *values, const unsigned long receiver) const
+{
+    std::vector< std::size_t > start;
+    std::vector< std::size_t > count;
+    
+    if( getDataIRReceiverHyperslab( start, count, receiver ) == false )
+    {
+        return false;
+    }
+    
+    return File::getDataIR( values, start, count );
+}
+
+bool File::getDataIREmitter(float *values, const unsigned long emitter) const
+{
+    std::vector< std::size_t > start;
+    std::vector< std::size_t > count;
+    
+    if( getDataIREmitterHyperslab( start, count, emitter ) == false )
+    {
+        return false;
+    }
+    
+    return File::getDataIR( values, start, count );
+}
+
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the channel ordering of the Data.IR variable
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::GetDataIRChannelOrdering(sofa::AmbisonicsChannelOrdering::Type &channelOrdering) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    const netCDF::NcVar var = getVariable( "Data.IR" );
+    
+    const netCDF::NcVarAtt attNChannelOrdering  = sofa::NcUtils::GetAttribute( var, "ChannelOrdering" );
+    const std::string channelOrderingName       = sofa::NcUtils::GetAttributeValueAsString( attNChannelOrdering );
+    
+    channelOrdering = sofa::AmbisonicsChannelOrdering::GetType( channelOrderingName );
+    
+    /* attribute not found */
+    if (channelOrdering == sofa::AmbisonicsChannelOrdering::kNumAmbisonicsChannelOrderingTypes)
+    {
+        return false;
+    }
+    
+    return true;
 }
 
 
@@ -1640,6 +2560,21 @@ bool File::getDataDelay(std::vector< double > &values) const
     return NetCDFFile::GetValues( values, "Data.Delay" );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values into a N-dimensional array shaped like Data.Delay
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataDelay(sofa::Array< double > &values) const
+{
+    SOFA_ASSERT( HasVariable( "Data.Delay" ) == true );
+    
+    return NetCDFFile::GetValues( values, "Data.Delay" );
+}
+
 bool File::getDataDelay(double *values, const unsigned long dim1, const unsigned long dim2) const
 {
     SOFA_ASSERT( HasVariable( "Data.Delay" ) == true );
@@ -1656,6 +2591,36 @@ bool File::getDataDelay(double *values, const unsigned long dim1, const unsigned
     return NetCDFFile::GetValues( values, dim1, dim2, dim3, "Data.Delay" );
 }
 
+bool File::getDataDelay(std::vector< float > &values) const
+{
+    SOFA_ASSERT( HasVariable( "Data.Delay" ) == true );
+    
+    return NetCDFFile::GetValues( values, "Data.Delay" );
+}
+
+bool File::getDataDelay(sofa::Array< float > &values) const
+{
+    SOFA_ASSERT( HasVariable( "Data.Delay" ) == true );
+    
+    return NetCDFFile::GetValues( values, "Data.Delay" );
+}
+
+bool File::getDataDelay(float *values, const unsigned long dim1, const unsigned long dim2) const
+{
+    SOFA_ASSERT( HasVariable( "Data.Delay" ) == true );
+    SOFA_ASSERT( GetVariableDimensionality( "Data.Delay" ) == 2 );
+    
+    return NetCDFFile::GetValues( values, dim1, dim2, "Data.Delay" );
+}
+
+bool File::getDataDelay(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    SOFA_ASSERT( HasVariable( "Data.Delay" ) == true );
+    SOFA_ASSERT( GetVariableDimensionality( "Data.Delay" ) == 3 );
+    
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "Data.Delay" );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          The Data.SamplingRate variable can be either [I] or [M],
@@ -1669,7 +2634,8 @@ bool File::isSamplingRateScalar() const
     SOFA_ASSERT( HasVariable( "Data.SamplingRate" ) == true );
     
     return VariableIsScalar( "Data.SamplingRate" ) == true
-        && HasVariableType( netCDF::NcType::nc_DOUBLE, "Data.SamplingRate");
+        && ( HasVariableType( netCDF::NcType::nc_DOUBLE, "Data.SamplingRate")
+          || HasVariableType( netCDF::NcType::nc_FLOAT, "Data.SamplingRate") );
 }
 
 /************************************************************************************/
@@ -1720,26 +2686,31 @@ bool File::getSamplingRateUnits(sofa::Units::Type &units) const
 
 /************************************************************************************/
 /*!
- *  @brief          Throws an exception if the file does not contain the requested global attribute
+ *  @brief          Reports an issue if the file does not contain the requested global attribute
+ *  @return         true if the attribute exists
  *
  */
 /************************************************************************************/
-void File::ensureGlobalAttribute(const sofa::Attributes::Type &type_) const
+bool File::ensureGlobalAttribute(const sofa::Attributes::Type &type_, sofa::ValidationReport &report) const
 {
     if( HasAttribute( type_ ) == false )
     {
         const std::string err = "Missing SOFA attribute '" + sofa::Attributes::GetName( type_ ) + "'";
-        SOFA_THROW( err );
+        report.Add( sofa::ValidationReport::kMissingAttribute, err, sofa::Attributes::GetName( type_ ) );
+        return false;
     }
+    
+    return true;
 }
 
 /************************************************************************************/
 /*!
- *  @brief          Throws an exception if the file does not contain the requested global attribute
+ *  @brief          Reports an issue if the file does not contain the requested global attribute
+ *  @return         true if the attribute exists
  *
  */
 /************************************************************************************/
-void File::ensureGlobalAttribute(const std::string &attributeName) const
+bool File::ensureGlobalAttribute(const std::string &attributeName, sofa::ValidationReport &report) const
 {
     const netCDF::NcGroupAtt att = getAttribute( attributeName );
     
@@ -1747,41 +2718,87 @@ void File::ensureGlobalAttribute(const std::string &attributeName) const
     if( sofa::NcUtils::IsChar( att ) != true )
     {
         const std::string err = "Missing '" + attributeName + "' global attribute";
-        SOFA_THROW( err );
+        report.Add( sofa::ValidationReport::kMissingAttribute, err, attributeName );
+        return false;
     }
+    
+    return true;
 }
 
 /************************************************************************************/
 /*!
- *  @brief          Throws an exception if the file does not match the requested convention
+ *  @brief          Reports an issue if the file does not match the requested convention
+ *  @return         true if the file matches the convention
  *
  */
 /************************************************************************************/
-void File::ensureSOFAConvention(const std::string &conventionName) const
+bool File::ensureSOFAConvention(const std::string &conventionName, sofa::ValidationReport &report) const
 {
     const std::string attrName  = sofa::Attributes::GetName( sofa::Attributes::kSOFAConventions );
     const std::string attrValue = GetAttributeValueAsString( attrName );
     
     if( attrValue != conventionName )
     {
-        SOFA_THROW( "Not a '" + conventionName + "' SOFAConvention" );
+        report.Add( sofa::ValidationReport::kInvalidConventions, "Not a '" + conventionName + "' SOFAConvention", attrName );
+        return false;
     }
+    
+    return true;
 }
 
 /************************************************************************************/
 /*!
- *  @brief          Throws an exception if the file does not match the requested DataType
+ *  @brief          Reports an issue if the file does not match the requested DataType
+ *  @return         true if the file matches the DataType
  *
  */
 /************************************************************************************/
-void File::ensureDataType(const std::string &typeName) const
+bool File::ensureDataType(const std::string &typeName, sofa::ValidationReport &report) const
 {
     const std::string attrName  = sofa::Attributes::GetName( sofa::Attributes::kDataType );
     const std::string attrValue = GetAttributeValueAsString( attrName );
     
     if( attrValue != typeName )
     {
-        SOFA_THROW( "Invalid 'DataType' : " + attrValue );
+        report.Add( sofa::ValidationReport::kInvalidDataType, "Invalid 'DataType' : " + attrValue, attrName );
+        return false;
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reports a variable whose dimensions do not match the SOFA specifications
+ *  @param[in]      report : the report to append the issue to
+ *  @param[in]      message : description of the issue
+ *  @param[in]      variableName : name of the variable
+ *  @param[in]      expectedDimensions : expected dimensions of the variable
+ *  @param[in]      alternativeDimensions : other accepted dimensions, if any
+ *
+ */
+/************************************************************************************/
+void File::reportDimensions(sofa::ValidationReport &report,
+                            const std::string &message,
+                            const std::string &variableName,
+                            const std::vector< std::size_t > &expectedDimensions,
+                            const std::vector< std::size_t > &alternativeDimensions) const
+{
+    std::vector< std::vector< std::size_t > > expected;
+    expected.push_back( expectedDimensions );
+    
+    if( alternativeDimensions.empty() == false )
+    {
+        expected.push_back( alternativeDimensions );
+    }
+    
+    std::vector< std::size_t > actual;
+    
+    if( HasVariable( variableName ) == true )
+    {
+        GetVariableDimensions( actual, variableName );
     }
+    
+    report.Add( sofa::ValidationReport::kInvalidVariableDimensions, message, variableName, expected, actual );
 }
 
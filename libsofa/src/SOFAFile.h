@@ -55,6 +55,10 @@ http://www.sofaconventions.org
 #include "../src/SOFAUnits.h"
 #include "../src/SOFAAmbisonicsChannelOrdering.h"
 #include "../src/SOFAAmbisonicsNormalization.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAValidationReport.h"
+#include "../src/SOFADataLayout.h"
+#include "../src/SOFAPaddedLayout.h"
 
 namespace sofa
 {
@@ -71,11 +75,17 @@ namespace sofa
     {
     public:
         File(const std::string &path,
-             const netCDF::NcFile::FileMode &mode = netCDF::NcFile::read);
+             const netCDF::NcFile::FileMode &mode = netCDF::NcFile::read,
+             const sofa::OpenOptions &options = sofa::OpenOptions());
+        
+        explicit File(const sofa::MemoryBuffer &buffer,
+                      const sofa::OpenOptions &options = sofa::OpenOptions());
         
         virtual ~File() {};
         
         virtual bool IsValid() const SOFA_OVERRIDE;
+        
+        virtual bool Validate(sofa::ValidationReport &report) const;
                 
         //==============================================================================
         // SOFA Attributes
@@ -166,22 +176,90 @@ namespace sofa
         bool GetEmitterUp(std::vector< double > &values) const;
         bool GetEmitterView(std::vector< double > &values) const;
         
+        //==============================================================================
+        bool GetListenerPosition(float *values, const unsigned long dim1, const unsigned long dim2) const;
+        bool GetListenerUp(float *values, const unsigned long dim1, const unsigned long dim2) const;
+        bool GetListenerView(float *values, const unsigned long dim1, const unsigned long dim2) const;
+        
+        bool GetSourcePosition(float *values, const unsigned long dim1, const unsigned long dim2) const;
+        bool GetSourceUp(float *values, const unsigned long dim1, const unsigned long dim2) const;
+        bool GetSourceView(float *values, const unsigned long dim1, const unsigned long dim2) const;
+        
+        bool GetReceiverPosition(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool GetReceiverUp(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool GetReceiverView(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        
+        bool GetEmitterPosition(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool GetEmitterUp(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool GetEmitterView(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        
+        //==============================================================================
+        bool GetListenerPosition(std::vector< float > &values) const;
+        bool GetListenerUp(std::vector< float > &values) const;
+        bool GetListenerView(std::vector< float > &values) const;
+        
+        bool GetSourcePosition(std::vector< float > &values) const;
+        bool GetSourceUp(std::vector< float > &values) const;
+        bool GetSourceView(std::vector< float > &values) const;
+        
+        bool GetReceiverPosition(std::vector< float > &values) const;
+        bool GetReceiverUp(std::vector< float > &values) const;
+        bool GetReceiverView(std::vector< float > &values) const;
+        
+        bool GetEmitterPosition(std::vector< float > &values) const;
+        bool GetEmitterUp(std::vector< float > &values) const;
+        bool GetEmitterView(std::vector< float > &values) const;
+        
+        //==============================================================================
+        /// the values are allocated with the allocator of the vector (e.g. a memory arena,
+        /// or a std::pmr::polymorphic_allocator); T is float or double
+        template< typename T, typename Allocator >
+        bool GetListenerPosition(std::vector< T, Allocator > &values) const;
+        template< typename T, typename Allocator >
+        bool GetListenerUp(std::vector< T, Allocator > &values) const;
+        template< typename T, typename Allocator >
+        bool GetListenerView(std::vector< T, Allocator > &values) const;
+        
+        template< typename T, typename Allocator >
+        bool GetSourcePosition(std::vector< T, Allocator > &values) const;
+        template< typename T, typename Allocator >
+        bool GetSourceUp(std::vector< T, Allocator > &values) const;
+        template< typename T, typename Allocator >
+        bool GetSourceView(std::vector< T, Allocator > &values) const;
+        
+        template< typename T, typename Allocator >
+        bool GetReceiverPosition(std::vector< T, Allocator > &values) const;
+        template< typename T, typename Allocator >
+        bool GetReceiverUp(std::vector< T, Allocator > &values) const;
+        template< typename T, typename Allocator >
+        bool GetReceiverView(std::vector< T, Allocator > &values) const;
+        
+        template< typename T, typename Allocator >
+        bool GetEmitterPosition(std::vector< T, Allocator > &values) const;
+        template< typename T, typename Allocator >
+        bool GetEmitterUp(std::vector< T, Allocator > &values) const;
+        template< typename T, typename Allocator >
+        bool GetEmitterView(std::vector< T, Allocator > &values) const;
+    
     protected:
         //==============================================================================
-        bool hasSOFAConvention() const;
-        bool hasSOFARequiredAttributes() const;
-        bool hasSOFARequiredDimensions() const;
-        bool SOFADimensionsAreValid() const;
-        bool checkListenerVariables() const;
-        bool checkSourceVariables() const;
-        bool checkReceiverVariables() const;
-        bool checkEmitterVariables() const;
-        bool checkDimensions() const;
-        bool checkDataVariable() const;
-        bool checkFirDataType() const;
-        bool checkFireDataType() const;
-        bool checkTFDataType() const;
-        bool checkSOSDataType() const;
+        explicit File(const sofa::File *sharedFile);
+        
+        //==============================================================================
+        bool hasSOFAConvention(sofa::ValidationReport &report) const;
+        bool hasSOFARequiredAttributes(sofa::ValidationReport &report) const;
+        bool hasSOFARequiredDimensions(sofa::ValidationReport &report) const;
+        bool SOFADimensionsAreValid(sofa::ValidationReport &report) const;
+        bool checkListenerVariables(sofa::ValidationReport &report) const;
+        bool checkSourceVariables(sofa::ValidationReport &report) const;
+        bool checkReceiverVariables(sofa::ValidationReport &report) const;
+        bool checkEmitterVariables(sofa::ValidationReport &report) const;
+        bool checkDimensions(sofa::ValidationReport &report) const;
+        bool checkDataVariable(sofa::ValidationReport &report) const;
+        bool checkFirDataType(sofa::ValidationReport &report) const;
+        bool checkFireDataType(sofa::ValidationReport &report) const;
+        bool checkTFDataType(sofa::ValidationReport &report) const;
+        bool checkSOSDataType(sofa::ValidationReport &report) const;
         
         bool getCoordinates(sofa::Coordinates::Type &coordinates, const std::string &variableName) const;
         bool getUnits(sofa::Units::Type &units, const std::string &variableName) const;
@@ -189,12 +267,43 @@ namespace sofa
         
         //==============================================================================
         bool getDataIR(std::vector< double > &values) const;
+        bool getDataIR(sofa::Array< double > &values) const;
+        bool getDataIR(sofa::Array< double > &values, const sofa::DataLayout::Type &layout) const;
+        bool getDataIR(double *values, const sofa::PaddedLayout &padding) const;
+        bool getDataIR(sofa::Array< double > &values, const sofa::PaddedLayout &padding) const;
         bool getDataIR(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool getDataIR(double *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const;
+        bool getDataIRMeasurements(double *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const;
+        bool getDataIRReceiver(double *values, const unsigned long receiver) const;
+        bool getDataIREmitter(double *values, const unsigned long emitter) const;
+        
+        bool getDataIR(std::vector< float > &values) const;
+        bool getDataIR(sofa::Array< float > &values) const;
+        bool getDataIR(sofa::Array< float > &values, const sofa::DataLayout::Type &layout) const;
+        bool getDataIR(float *values, const sofa::PaddedLayout &padding) const;
+        bool getDataIR(sofa::Array< float > &values, const sofa::PaddedLayout &padding) const;
+        bool getDataIR(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool getDataIR(float *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const;
+        bool getDataIRMeasurements(float *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const;
+        bool getDataIRReceiver(float *values, const unsigned long receiver) const;
+        bool getDataIREmitter(float *values, const unsigned long emitter) const;
+        
+        bool getDataIRMeasurementsHyperslab(std::vector< std::size_t > &start, std::vector< std::size_t > &count,
+                                            const unsigned long firstMeasurement, const unsigned long numMeasurements) const;
+        bool getDataIRReceiverHyperslab(std::vector< std::size_t > &start, std::vector< std::size_t > &count,
+                                        const unsigned long receiver) const;
+        bool getDataIREmitterHyperslab(std::vector< std::size_t > &start, std::vector< std::size_t > &count,
+                                       const unsigned long emitter) const;
         
         //==============================================================================
         bool getDataDelay(double *values, const unsigned long dim1, const unsigned long dim2) const;
         bool getDataDelay(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
         bool getDataDelay(std::vector< double > &values) const;
+        bool getDataDelay(sofa::Array< double > &values) const;
+        bool getDataDelay(float *values, const unsigned long dim1, const unsigned long dim2) const;
+        bool getDataDelay(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool getDataDelay(std::vector< float > &values) const;
+        bool getDataDelay(sofa::Array< float > &values) const;
         
         //==============================================================================
         bool isSamplingRateScalar() const;
@@ -202,17 +311,208 @@ namespace sofa
         bool getSamplingRateUnits(sofa::Units::Type &units) const;
         
         //==============================================================================
-        void ensureGlobalAttribute(const sofa::Attributes::Type &type_) const;
-        void ensureGlobalAttribute(const std::string &attributeName) const;
-        void ensureSOFAConvention(const std::string &conventionName) const;
-        void ensureDataType(const std::string &typeName) const;
+        bool ensureGlobalAttribute(const sofa::Attributes::Type &type_, sofa::ValidationReport &report) const;
+        bool ensureGlobalAttribute(const std::string &attributeName, sofa::ValidationReport &report) const;
+        bool ensureSOFAConvention(const std::string &conventionName, sofa::ValidationReport &report) const;
+        bool ensureDataType(const std::string &typeName, sofa::ValidationReport &report) const;
         
+        void reportDimensions(sofa::ValidationReport &report,
+                              const std::string &message,
+                              const std::string &variableName,
+                              const std::vector< std::size_t > &expectedDimensions,
+                              const std::vector< std::size_t > &alternativeDimensions = std::vector< std::size_t >()) const;
+        
+        bool raiseFirstIssue(const sofa::ValidationReport &report) const;
+        
+        //==============================================================================
+        /// memoized outcome of a validation pass
+        struct ValidationCache
+        {
+            enum State
+            {
+                kNotValidated   = 0,
+                kValid          = 1,
+                kInvalid        = 2
+            };
+            
+            ValidationCache() : state( kNotValidated ) {}
+            
+            State state;
+            sofa::ValidationReport report;      ///< issues found by the validation pass
+        };
+        
+        template< class Convention >
+        bool validateOnce(sofa::ValidationReport &report,
+                          ValidationCache &cache,
+                          const Convention &convention,
+                          bool (Convention::*check)(sofa::ValidationReport &) const) const;
+        
+        template< class Convention >
+        bool runValidation(sofa::ValidationReport &report,
+                           const Convention &convention,
+                           bool (Convention::*check)(sofa::ValidationReport &) const) const;
+    
+    private:
+        //==============================================================================
+        bool checkValidity(sofa::ValidationReport &report) const;
+        
+        void readCachedValues();
+        
+        //==============================================================================
+        mutable ValidationCache sofaValidation;
+        
+        /// values read once when the file is opened in read mode
+        std::string sofaConventions;
+        std::string dataType;
+        long numMeasurements;
+        long numReceivers;
+        long numEmitters;
+        long numDataSamples;
+    
     private:
         //==============================================================================
         /// avoid shallow and copy constructor
         SOFA_AVOID_COPY_CONSTRUCTOR( File );
     };
     
+    /************************************************************************************/
+    /*!
+     *  @brief          Runs a validation check once, and appends its memoized issues
+     *                  to the report on subsequent calls.
+     *                  Nothing is memoized if the file was not opened in read mode,
+     *                  since its content may still change
+     *
+     */
+    /************************************************************************************/
+    template< class Convention >
+    inline bool File::validateOnce(sofa::ValidationReport &report,
+                                   ValidationCache &cache,
+                                   const Convention &convention,
+                                   bool (Convention::*check)(sofa::ValidationReport &) const) const
+    {
+        if( GetMetadata().IsLoaded() == false )
+        {
+            return runValidation( report, convention, check );
+        }
+        
+        if( cache.state == ValidationCache::kNotValidated )
+        {
+            const bool isValid = runValidation( cache.report, convention, check );
+            
+            cache.state = ( isValid == true ) ? ValidationCache::kValid : ValidationCache::kInvalid;
+        }
+        
+        report.Append( cache.report );
+        
+        return ( cache.state == ValidationCache::kValid );
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Runs a validation check; an exception raised while reading the file
+     *                  is reported as a kReadError issue instead of being propagated
+     *
+     */
+    /************************************************************************************/
+    template< class Convention >
+    inline bool File::runValidation(sofa::ValidationReport &report,
+                                    const Convention &convention,
+                                    bool (Convention::*check)(sofa::ValidationReport &) const) const
+    {
+        try
+        {
+            return (convention.*check)( report );
+        }
+        catch( std::exception &e )
+        {
+            report.Add( sofa::ValidationReport::kReadError, e.what() );
+        }
+        catch( ... )
+        {
+            report.Add( sofa::ValidationReport::kReadError, "unknown error while reading the file" );
+        }
+        
+        return false;
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Get*Position, Get*Up and Get*View, into a vector using any allocator
+     *
+     */
+    /************************************************************************************/
+    template< typename T, typename Allocator >
+    inline bool File::GetListenerPosition(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "ListenerPosition" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetListenerUp(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "ListenerUp" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetListenerView(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "ListenerView" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetSourcePosition(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "SourcePosition" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetSourceUp(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "SourceUp" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetSourceView(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "SourceView" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetReceiverPosition(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "ReceiverPosition" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetReceiverUp(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "ReceiverUp" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetReceiverView(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "ReceiverView" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetEmitterPosition(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "EmitterPosition" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetEmitterUp(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "EmitterUp" );
+    }
+    
+    template< typename T, typename Allocator >
+    inline bool File::GetEmitterView(std::vector< T, Allocator > &values) const
+    {
+        return NetCDFFile::GetValues( values, "EmitterView" );
+    }
+
 }
 
 #endif /* _SOFA_FILE_H__ */
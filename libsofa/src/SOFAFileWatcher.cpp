@@ -0,0 +1,1110 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFileWatcher.cpp
+ *   @brief      Reloads a SOFA file when it changes on disk, variable by variable
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAFileWatcher.h"
+#include "../src/SOFAHostArchitecture.h"
+#include "../src/SOFANcUtils.h"
+#include "../src/SOFAUtils.h"
+#include <sys/stat.h>
+#include <chrono>
+
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+    #include "../src/SOFAHdf5Utils.h"
+    
+    #if ! H5_VERSION_GE( 1, 10, 5 )
+        /// H5Dget_chunk_info was added in HDF5 1.10.5
+        #undef SOFA_HDF5_DIRECT_CHUNK_READ
+    #endif
+#endif
+
+#if( SOFA_UNIX == 1 && defined( __linux__ ) )
+    #define SOFA_FILE_WATCHER_INOTIFY 1
+    #include <sys/inotify.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <errno.h>
+#endif
+
+using namespace sofa;
+
+namespace FileWatcherHelper
+{
+    /// the worker thread checks whether it is stopping at least this often
+    static const unsigned int kMaxWaitMs = 100;
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          64-bit FNV-1a hash, accumulated over several calls
+     *
+     */
+    /************************************************************************************/
+    class Checksum
+    {
+    public:
+        Checksum()
+        : hash( 14695981039346656037ULL )
+        {
+        }
+        
+        void Add(const void *data, const std::size_t numBytes)
+        {
+            const unsigned char *bytes = static_cast< const unsigned char * >( data );
+            
+            for( std::size_t i = 0; i < numBytes; i++ )
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        }
+        
+        void Add(const std::string &value)
+        {
+            /// the length separates consecutive strings
+            Add( value.size() );
+            Add( value.data(), value.size() );
+        }
+        
+        void Add(const std::size_t value)
+        {
+            const uint64_t value64 = value;
+            Add( &value64, sizeof( value64 ) );
+        }
+        
+        void Add(const std::vector< double > &values)
+        {
+            Add( values.size() );
+            
+            if( values.empty() == false )
+            {
+                Add( &values[0], values.size() * sizeof( double ) );
+            }
+        }
+        
+        uint64_t Get() const
+        {
+            return hash;
+        }
+    
+    private:
+        uint64_t hash;
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Gives access to the attributes and variables of a file, looked up
+     *                  through the index built when the file was opened
+     *
+     */
+    /************************************************************************************/
+    class Reader : public sofa::NetCDFFile
+    {
+    public:
+        explicit Reader(const std::string &path)
+        : sofa::NetCDFFile( path )
+        {
+        }
+        
+        netCDF::NcGroupAtt GetAttribute(const std::string &name) const
+        {
+            return getAttribute( name );
+        }
+        
+        netCDF::NcVar GetVariable(const std::string &name) const
+        {
+            return getVariable( name );
+        }
+    
+    private:
+        SOFA_AVOID_COPY_CONSTRUCTOR( Reader );
+    };
+    
+    template< typename NetCDFAttribute >
+    static sofa::FileSnapshot::Attribute readAttribute(const std::string &name,
+                                                       const NetCDFAttribute &attr)
+    {
+        sofa::FileSnapshot::Attribute attribute;
+        attribute.name     = name;
+        attribute.typeName = attr.getType().getName();
+        
+        if( sofa::NcUtils::IsChar( attr ) == true )
+        {
+            attribute.value = sofa::NcUtils::GetAttributeValueAsString( attr );
+        }
+        else if( sofa::NcUtils::IsNumeric( attr ) == true && attr.getAttLength() > 0 )
+        {
+            attribute.numbers.resize( attr.getAttLength() );
+            attr.getValues( &attribute.numbers[0] );
+        }
+        
+        return attribute;
+    }
+    
+    static void addAttribute(Checksum &checksum,
+                             const sofa::FileSnapshot::Attribute &attribute)
+    {
+        checksum.Add( attribute.name );
+        checksum.Add( attribute.typeName );
+        checksum.Add( attribute.value );
+        checksum.Add( attribute.numbers );
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Gives access to the HDF5 storage of a file, to fingerprint the values
+     *                  of its variables without reading them through netCDF
+     *
+     */
+    /************************************************************************************/
+    class Storage
+    {
+    public:
+        explicit Storage(const std::string &path)
+    #if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+        : file( openFile( path ), H5Fclose )
+    #endif
+        {
+            (void) path;
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Adds the storage of a variable to a checksum : its layout, and the
+         *                  location and size of its data in the file (of each chunk, for a
+         *                  chunked variable). Returns false if the storage is not available
+         *
+         *  @details        The values are not read : the fingerprint costs a few metadata
+         *                  queries, whatever the size of the variable. As a consequence, values
+         *                  rewritten in place, at the same location and with the same size,
+         *                  are not detected. Compact variables have no location of their own :
+         *                  their (few) bytes are read as stored, from the object header.
+         */
+        /************************************************************************************/
+        bool AddStorage(Checksum &checksum, const std::string &variableName) const
+        {
+        #if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+            using sofa::Hdf5Utils::ScopedId;
+            
+            const sofa::Hdf5Utils::ScopedErrorSilencer silencer;
+            
+            if( file.id < 0 )
+            {
+                return false;
+            }
+            
+            const ScopedId dataset( H5Dopen2( file.id, variableName.c_str(), H5P_DEFAULT ), H5Dclose );
+            const ScopedId plist( ( dataset.id >= 0 ) ? H5Dget_create_plist( dataset.id ) : -1, H5Pclose );
+            const ScopedId space( ( dataset.id >= 0 ) ? H5Dget_space( dataset.id ) : -1, H5Sclose );
+            const ScopedId type( ( dataset.id >= 0 ) ? H5Dget_type( dataset.id ) : -1, H5Tclose );
+            
+            if( dataset.id < 0 || plist.id < 0 || space.id < 0 || type.id < 0 )
+            {
+                return false;
+            }
+            
+            const H5D_layout_t layout = H5Pget_layout( plist.id );
+            
+            addNumber( checksum, layout );
+            addNumber( checksum, H5Dget_storage_size( dataset.id ) );
+            
+            if( layout == H5D_CHUNKED )
+            {
+                const int rank = H5Sget_simple_extent_ndims( space.id );
+                
+                hsize_t numChunks = 0;
+                
+                if( rank <= 0 || H5Dget_num_chunks( dataset.id, space.id, &numChunks ) < 0 )
+                {
+                    return false;
+                }
+                
+                std::vector< hsize_t > offset( rank );
+                
+                for( hsize_t i = 0; i < numChunks; i++ )
+                {
+                    unsigned int filterMask = 0;
+                    haddr_t address         = HADDR_UNDEF;
+                    hsize_t size            = 0;
+                    
+                    if( H5Dget_chunk_info( dataset.id, space.id, i, &offset[0], &filterMask, &address, &size ) < 0 )
+                    {
+                        return false;
+                    }
+                    
+                    addNumber( checksum, address );
+                    addNumber( checksum, size );
+                    addNumber( checksum, filterMask );
+                    checksum.Add( &offset[0], offset.size() * sizeof( hsize_t ) );
+                }
+                
+                return true;
+            }
+            
+            if( layout == H5D_CONTIGUOUS )
+            {
+                addNumber( checksum, H5Dget_offset( dataset.id ) );
+                
+                return true;
+            }
+            
+            if( layout != H5D_COMPACT || H5Tis_variable_str( type.id ) > 0 || H5Tget_class( type.id ) == H5T_VLEN )
+            {
+                return false;
+            }
+            
+            /// compact : read with the type of the file, i.e. without conversion
+            const hssize_t numElements = H5Sget_simple_extent_npoints( space.id );
+            
+            if( numElements < 0 )
+            {
+                return false;
+            }
+            
+            std::vector< unsigned char > bytes( (std::size_t) numElements * H5Tget_size( type.id ) );
+            
+            if( bytes.empty() == false && H5Dread( dataset.id, type.id, H5S_ALL, H5S_ALL, H5P_DEFAULT, &bytes[0] ) < 0 )
+            {
+                return false;
+            }
+            
+            checksum.Add( bytes.data(), bytes.size() );
+            
+            return true;
+        #else
+            (void) checksum;
+            (void) variableName;
+            
+            return false;
+        #endif
+        }
+    
+    private:
+    #if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+        static hid_t openFile(const std::string &path)
+        {
+            const sofa::Hdf5Utils::ScopedErrorSilencer silencer;
+            
+            return sofa::Hdf5Utils::OpenFile( path );
+        }
+        
+        template< typename T >
+        static void addNumber(Checksum &checksum, const T value)
+        {
+            const uint64_t value64 = (uint64_t) value;
+            checksum.Add( &value64, sizeof( value64 ) );
+        }
+        
+        const sofa::Hdf5Utils::ScopedId file;
+    #endif
+        
+        SOFA_AVOID_COPY_CONSTRUCTOR( Storage );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Reads the values of a variable : a numeric variable keeps them
+     *                  (unpacked, as double), a char variable is only added to the checksum
+     *  @param[in]      metadata : the variable, in the metadata snapshot of the file
+     *  @param[in]      checksum : the checksum of the values, or NULL
+     *
+     */
+    /************************************************************************************/
+    static void readValues(sofa::FileSnapshot::Variable &variable,
+                           const netCDF::NcVar &var,
+                           const sofa::NcMetadata::Variable &metadata,
+                           Checksum *checksum)
+    {
+        const std::size_t numValues = sofa::NcUtils::GetNumElements( variable.dimensions );
+        
+        if( sofa::NcUtils::IsNumeric( var ) == true )
+        {
+            std::shared_ptr< std::vector< double > > values( new std::vector< double >( numValues ) );
+            
+            if( numValues > 0 )
+            {
+                var.getVar( &(*values)[0] );
+                
+                if( metadata.packed == true )
+                {
+                    for( std::size_t i = 0; i < numValues; i++ )
+                    {
+                        (*values)[i] = (*values)[i] * metadata.scale + metadata.offset;
+                    }
+                }
+            }
+            
+            if( checksum != NULL )
+            {
+                checksum->Add( *values );
+            }
+            
+            variable.values = values;
+        }
+        else if( sofa::NcUtils::IsChar( var ) == true && numValues > 0 && checksum != NULL )
+        {
+            std::vector< char > text( numValues );
+            var.getVar( &text[0] );
+            
+            checksum->Add( &text[0], text.size() );
+        }
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Reads the fingerprint of a variable : its metadata, and the checksum
+     *                  of these and of its values.
+     *                  When the storage of the file is available, the values are not read :
+     *                  the checksum is the one of their location in the file, and the values
+     *                  are read later, only if the variable changed (see FileWatcher::load)
+     *  @param[in]      metadata : the variable, in the metadata snapshot of the file
+     *
+     */
+    /************************************************************************************/
+    static sofa::FileSnapshot::Variable readVariable(const sofa::NcMetadata::Variable &metadata,
+                                                     const netCDF::NcVar &var,
+                                                     const Storage &storage)
+    {
+        sofa::FileSnapshot::Variable variable;
+        variable.name            = metadata.name;
+        variable.typeName        = metadata.typeName;
+        variable.dimensionsNames = metadata.dimensionsNames;
+        variable.dimensions      = metadata.dimensions;
+        
+        Checksum checksum;
+        checksum.Add( variable.name );
+        checksum.Add( variable.typeName );
+        
+        for( std::size_t i = 0; i < variable.dimensions.size(); i++ )
+        {
+            checksum.Add( variable.dimensionsNames[i] );
+            checksum.Add( variable.dimensions[i] );
+        }
+        
+        for( std::size_t i = 0; i < metadata.attributes.size(); i++ )
+        {
+            const std::string &name = metadata.attributes[i].name;
+            
+            variable.attributes.push_back( readAttribute( name, var.getAtt( name ) ) );
+            addAttribute( checksum, variable.attributes.back() );
+        }
+        
+        if( sofa::NcUtils::IsNumeric( var ) == true || sofa::NcUtils::IsChar( var ) == true )
+        {
+            /// the tags keep apart the checksums of the storage and of the values
+            if( storage.AddStorage( checksum, variable.name ) == true )
+            {
+                checksum.Add( std::string( "stored" ) );
+            }
+            else
+            {
+                readValues( variable, var, metadata, &checksum );
+                checksum.Add( std::string( "values" ) );
+            }
+        }
+        
+        variable.checksum = checksum.Get();
+        
+        return variable;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : an empty snapshot
+ *
+ */
+/************************************************************************************/
+FileSnapshot::FileSnapshot()
+: version( 0 )
+, attributesChecksum( 0 )
+, dimensionsChecksum( 0 )
+, attributesChanged( false )
+, dimensionsChanged( false )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the version of the snapshot, starting at 1 for the first load
+ *
+ */
+/************************************************************************************/
+unsigned long FileSnapshot::GetVersion() const
+{
+    return version;
+}
+
+const std::string & FileSnapshot::GetFilename() const
+{
+    return filename;
+}
+
+const std::vector< FileSnapshot::Attribute > & FileSnapshot::GetAttributes() const
+{
+    return attributes;
+}
+
+const std::vector< FileSnapshot::Dimension > & FileSnapshot::GetDimensions() const
+{
+    return dimensions;
+}
+
+const FileSnapshot::Variables & FileSnapshot::GetVariables() const
+{
+    return variables;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns a global attribute, or NULL if the snapshot does not have it
+ *
+ */
+/************************************************************************************/
+const FileSnapshot::Attribute * FileSnapshot::FindAttribute(const std::string &attributeName) const
+{
+    for( std::size_t i = 0; i < attributes.size(); i++ )
+    {
+        if( attributes[i].name == attributeName )
+        {
+            return &attributes[i];
+        }
+    }
+    
+    return NULL;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns a variable, or NULL if the snapshot does not have it
+ *
+ */
+/************************************************************************************/
+const FileSnapshot::Variable * FileSnapshot::FindVariable(const std::string &variableName) const
+{
+    const Variables::const_iterator it = variables.find( variableName );
+    
+    return ( it != variables.end() ) ? &it->second : NULL;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the values of a numeric variable (unpacked, as double),
+ *                  or NULL if the snapshot does not have such a variable.
+ *                  The values remain valid as long as the returned pointer is held
+ *
+ */
+/************************************************************************************/
+std::shared_ptr< const std::vector< double > > FileSnapshot::GetValues(const std::string &variableName) const
+{
+    const Variable *variable = FindVariable( variableName );
+    
+    return ( variable != NULL ) ? variable->values : std::shared_ptr< const std::vector< double > >();
+}
+
+bool FileSnapshot::HaveGlobalAttributesChanged() const
+{
+    return attributesChanged;
+}
+
+bool FileSnapshot::HaveDimensionsChanged() const
+{
+    return dimensionsChanged;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the names of the variables added or modified since the
+ *                  previous version
+ *
+ */
+/************************************************************************************/
+const std::vector< std::string > & FileSnapshot::GetChangedVariables() const
+{
+    return changedVariables;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the names of the variables removed since the previous version
+ *
+ */
+/************************************************************************************/
+const std::vector< std::string > & FileSnapshot::GetRemovedVariables() const
+{
+    return removedVariables;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if anything differs from the previous version
+ *
+ */
+/************************************************************************************/
+bool FileSnapshot::HasChanged() const
+{
+    return ( attributesChanged == true
+            || dimensionsChanged == true
+            || changedVariables.empty() == false
+            || removedVariables.empty() == false );
+}
+
+FileWatcher::FileStatus::FileStatus()
+: exists( false )
+, size( 0 )
+, modificationTime( 0 )
+, inode( 0 )
+{
+}
+
+bool FileWatcher::FileStatus::operator==(const FileStatus &other) const
+{
+    return ( exists == other.exists
+            && size == other.size
+            && modificationTime == other.modificationTime
+            && inode == other.inode );
+}
+
+bool FileWatcher::FileStatus::operator!=(const FileStatus &other) const
+{
+    return !( *this == other );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      path : the file to watch
+ *  @param[in]      pollIntervalMs : how often the status of the file is checked, in
+ *                  milliseconds (with inotify, this is only a safety net)
+ *
+ */
+/************************************************************************************/
+FileWatcher::FileWatcher(const std::string &path,
+                         const unsigned int pollIntervalMs_)
+: filename( path )
+, pollIntervalMs( smax( pollIntervalMs_, (unsigned int) 1 ) )
+, stopping( false )
+, notifyHandle( -1 )
+, watchHandle( -1 )
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+    Stop();
+}
+
+const std::string & FileWatcher::GetFilename() const
+{
+    return filename;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Loads the first version of the file, and starts watching it.
+ *                  Returns false if the file could not be loaded
+ *
+ */
+/************************************************************************************/
+bool FileWatcher::Start()
+{
+    Stop();
+    
+    if( Reload() == false && GetVersion() == 0 )
+    {
+        return false;
+    }
+
+#if( SOFA_FILE_WATCHER_INOTIFY == 1 )
+    
+    /// watch the directory rather than the file : the file is often replaced by a new one
+    const std::size_t separator = filename.find_last_of( '/' );
+    const std::string directory = ( separator == std::string::npos ) ? "." : filename.substr( 0, smax( separator, (std::size_t) 1 ) );
+    
+    notifyHandle = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+    
+    if( notifyHandle >= 0 )
+    {
+        watchHandle = inotify_add_watch( notifyHandle,
+                                         directory.c_str(),
+                                         IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY | IN_DELETE );
+        
+        if( watchHandle < 0 )
+        {
+            close( notifyHandle );
+            notifyHandle = -1;
+        }
+    }
+
+#endif
+    
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        stopping = false;
+    }
+    
+    worker = std::thread( &FileWatcher::run, this );
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Stops watching the file. The current snapshot remains available
+ *
+ */
+/************************************************************************************/
+void FileWatcher::Stop()
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        stopping = true;
+    }
+    
+    wakeUp.notify_all();
+    
+    if( worker.joinable() == true )
+    {
+        worker.join();
+    }
+
+#if( SOFA_FILE_WATCHER_INOTIFY == 1 )
+    if( notifyHandle >= 0 )
+    {
+        close( notifyHandle );
+    }
+#endif
+    
+    notifyHandle = -1;
+    watchHandle  = -1;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true while the file is being watched
+ *
+ */
+/************************************************************************************/
+bool FileWatcher::IsRunning() const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    
+    return ( worker.joinable() == true && stopping == false );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the changes are notified by the system (inotify),
+ *                  false if the file is polled
+ *
+ */
+/************************************************************************************/
+bool FileWatcher::UsesNotifications() const
+{
+    return ( notifyHandle >= 0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the current version of the file; it is never modified, and
+ *                  remains valid as long as it is held. NULL before the first load
+ *
+ */
+/************************************************************************************/
+std::shared_ptr< const FileSnapshot > FileWatcher::GetSnapshot() const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    
+    return snapshot;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the current version number (0 before the first load)
+ *
+ */
+/************************************************************************************/
+unsigned long FileWatcher::GetVersion() const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    
+    return ( snapshot != NULL ) ? snapshot->GetVersion() : 0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reloads the file now, whatever its status.
+ *                  Returns true if a new version was published
+ *
+ */
+/************************************************************************************/
+bool FileWatcher::Reload()
+{
+    return reload( FileStatus() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the status of a file
+ *
+ */
+/************************************************************************************/
+FileWatcher::FileStatus FileWatcher::getFileStatus(const std::string &path)
+{
+    FileStatus status;
+
+#if( SOFA_WINDOWS == 1 )
+    struct _stat64 info;
+    
+    if( _stat64( path.c_str(), &info ) == 0 )
+    {
+        status.exists           = true;
+        status.size             = (long long) info.st_size;
+        status.modificationTime = (long long) info.st_mtime;
+        status.inode            = 0;
+    }
+#else
+    struct stat info;
+    
+    if( stat( path.c_str(), &info ) == 0 )
+    {
+        status.exists = true;
+        status.size   = (long long) info.st_size;
+        status.inode  = (unsigned long long) info.st_ino;
+    
+    #if( SOFA_MAC == 1 )
+        status.modificationTime = (long long) info.st_mtimespec.tv_sec * 1000000000LL + info.st_mtimespec.tv_nsec;
+    #else
+        status.modificationTime = (long long) info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+    #endif
+    }
+#endif
+    
+    return status;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reloads the file unless its status is the one of the current version.
+ *                  Returns true if a new version was published
+ *  @param[in]      status : expected status, or a default status to force the reload
+ *
+ */
+/************************************************************************************/
+bool FileWatcher::reload(const FileStatus &status)
+{
+    std::lock_guard< std::mutex > reloadLock( reloadMutex );
+    
+    if( status.exists == true && status == loadedStatus )
+    {
+        return false;
+    }
+    
+    const FileStatus before = getFileStatus( filename );
+    
+    if( before.exists == false )
+    {
+        /// e.g. removed : try again later
+        return false;
+    }
+    
+    const std::shared_ptr< const FileSnapshot > current = GetSnapshot();
+    
+    std::shared_ptr< FileSnapshot > loaded;
+    
+    try
+    {
+        loaded = load( current.get() );
+    }
+    catch( ... )
+    {
+        /// most probably a file caught while being written : try again later
+        return false;
+    }
+    
+    if( loaded == NULL || getFileStatus( filename ) != before )
+    {
+        /// the file changed while it was read
+        return false;
+    }
+    
+    loadedStatus = before;
+    
+    if( current != NULL && loaded->HasChanged() == false )
+    {
+        return false;
+    }
+    
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        snapshot = loaded;
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads the file, and compares it with the previous version :
+ *                  unchanged variables share the values of the previous version
+ *  @param[in]      previous : the current version, or NULL
+ *
+ */
+/************************************************************************************/
+std::shared_ptr< FileSnapshot > FileWatcher::load(const FileSnapshot *previous) const
+{
+    const FileWatcherHelper::Reader reader( filename );
+    
+    if( reader.IsValid() == false )
+    {
+        return std::shared_ptr< FileSnapshot >();
+    }
+    
+    /// the metadata snapshot was read when the file was opened : it is walked, not queried again
+    const sofa::NcMetadata &metadata = reader.GetMetadata();
+    
+    if( metadata.IsLoaded() == false )
+    {
+        return std::shared_ptr< FileSnapshot >();
+    }
+    
+    const FileWatcherHelper::Storage storage( filename );
+    
+    std::shared_ptr< FileSnapshot > loaded( new FileSnapshot() );
+    loaded->filename = filename;
+    loaded->version  = ( previous != NULL ) ? previous->version + 1 : 1;
+    
+    FileWatcherHelper::Checksum attributesChecksum;
+    
+    const std::vector< sofa::NcMetadata::Attribute > &attributes = metadata.GetAttributes();
+    
+    loaded->attributes.reserve( attributes.size() );
+    
+    for( std::size_t i = 0; i < attributes.size(); i++ )
+    {
+        const std::string &name = attributes[i].name;
+        
+        loaded->attributes.push_back( FileWatcherHelper::readAttribute( name, reader.GetAttribute( name ) ) );
+        FileWatcherHelper::addAttribute( attributesChecksum, loaded->attributes.back() );
+    }
+    
+    FileWatcherHelper::Checksum dimensionsChecksum;
+    
+    const std::vector< sofa::NcMetadata::Dimension > &dims = metadata.GetDimensions();
+    
+    loaded->dimensions.reserve( dims.size() );
+    
+    for( std::size_t i = 0; i < dims.size(); i++ )
+    {
+        FileSnapshot::Dimension dimension;
+        dimension.name = dims[i].name;
+        dimension.size = dims[i].size;
+        
+        loaded->dimensions.push_back( dimension );
+        
+        dimensionsChecksum.Add( dimension.name );
+        dimensionsChecksum.Add( dimension.size );
+    }
+    
+    loaded->attributesChecksum = attributesChecksum.Get();
+    loaded->dimensionsChecksum = dimensionsChecksum.Get();
+    
+    const std::vector< sofa::NcMetadata::Variable > &vars = metadata.GetVariables();
+    
+    for( std::size_t i = 0; i < vars.size(); i++ )
+    {
+        const std::string &name = vars[i].name;
+        const netCDF::NcVar var = reader.GetVariable( name );
+        
+        FileSnapshot::Variable variable = FileWatcherHelper::readVariable( vars[i], var, storage );
+        
+        const FileSnapshot::Variable *old = ( previous != NULL ) ? previous->FindVariable( name ) : NULL;
+        
+        if( old != NULL && old->checksum == variable.checksum )
+        {
+            /// unchanged : readers of the previous version keep sharing the same values
+            variable.values = old->values;
+        }
+        else
+        {
+            if( variable.values == NULL && sofa::NcUtils::IsNumeric( var ) == true )
+            {
+                FileWatcherHelper::readValues( variable, var, vars[i], NULL );
+            }
+            
+            if( previous != NULL )
+            {
+                loaded->changedVariables.push_back( name );
+            }
+        }
+        
+        loaded->variables[ name ] = variable;
+    }
+    
+    if( previous != NULL )
+    {
+        loaded->attributesChanged = ( loaded->attributesChecksum != previous->attributesChecksum );
+        loaded->dimensionsChanged = ( loaded->dimensionsChecksum != previous->dimensionsChecksum );
+        
+        for( FileSnapshot::Variables::const_iterator it = previous->variables.begin();
+            it != previous->variables.end();
+            ++it )
+        {
+            if( loaded->variables.find( it->first ) == loaded->variables.end() )
+            {
+                loaded->removedVariables.push_back( it->first );
+            }
+        }
+    }
+    
+    return loaded;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Waits for the file to (possibly) change, at most pollIntervalMs.
+ *                  Returns false if the watcher is stopping
+ *
+ */
+/************************************************************************************/
+bool FileWatcher::waitForChange()
+{
+#if( SOFA_FILE_WATCHER_INOTIFY == 1 )
+    
+    if( notifyHandle >= 0 )
+    {
+        const std::size_t separator = filename.find_last_of( '/' );
+        const std::string name      = ( separator == std::string::npos ) ? filename : filename.substr( separator + 1 );
+        
+        unsigned int waitedMs = 0;
+        
+        while( waitedMs < pollIntervalMs )
+        {
+            {
+                std::lock_guard< std::mutex > lock( mutex );
+                
+                if( stopping == true )
+                {
+                    return false;
+                }
+            }
+            
+            const unsigned int timeoutMs = smin( FileWatcherHelper::kMaxWaitMs, pollIntervalMs - waitedMs );
+            
+            pollfd descriptor;
+            descriptor.fd      = notifyHandle;
+            descriptor.events  = POLLIN;
+            descriptor.revents = 0;
+            
+            const int result = poll( &descriptor, 1, (int) timeoutMs );
+            waitedMs += timeoutMs;
+            
+            if( result <= 0 )
+            {
+                continue;
+            }
+            
+            bool concerned = false;
+            
+            /// drain the pending events, and look for the watched file among them
+            alignas( struct inotify_event ) char buffer[ 4096 ];
+            
+            for( ;; )
+            {
+                const ssize_t length = read( notifyHandle, buffer, sizeof( buffer ) );
+                
+                if( length <= 0 )
+                {
+                    break;
+                }
+                
+                for( ssize_t offset = 0; offset < length; )
+                {
+                    const struct inotify_event *event = reinterpret_cast< const struct inotify_event * >( buffer + offset );
+                    
+                    if( event->len > 0 && name == event->name )
+                    {
+                        concerned = true;
+                    }
+                    
+                    offset += sizeof( struct inotify_event ) + event->len;
+                }
+            }
+            
+            if( concerned == true )
+            {
+                return true;
+            }
+        }
+        
+        return true;
+    }
+
+#endif
+    
+    std::unique_lock< std::mutex > lock( mutex );
+    
+    wakeUp.wait_for( lock, std::chrono::milliseconds( pollIntervalMs ), [this]{ return stopping; } );
+    
+    return ( stopping == false );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Worker thread
+ *
+ */
+/************************************************************************************/
+void FileWatcher::run()
+{
+    while( waitForChange() == true )
+    {
+        /// with notifications, reload() is also called at each poll interval, as a safety net :
+        /// the status of the file tells whether it changed since the last load
+        reload( getFileStatus( filename ) );
+    }
+}
@@ -0,0 +1,251 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFileWatcher.h
+ *   @brief      Reloads a SOFA file when it changes on disk, variable by variable
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_FILE_WATCHER_H__
+#define _SOFA_FILE_WATCHER_H__
+
+#include "../src/SOFANcFile.h"
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdint.h>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          FileSnapshot
+     *  @brief          Immutable image of the content of a netCDF file, at a given version
+     *
+     *  @details        Holds the global attributes, the dimensions and, for each variable,
+     *                  its attributes, its values (numeric variables only, unpacked as double)
+     *                  and a checksum of all of these.
+     *                  When libsofa is built with the HDF5 headers, the checksum covers the
+     *                  location and size of the values in the file (of each chunk, for a
+     *                  chunked variable) instead of the values : they are read only for the
+     *                  variables which changed.
+     *                  The values of a variable which did not change between two versions
+     *                  are shared by both snapshots, not copied.
+     */
+    /************************************************************************************/
+    class SOFA_API FileSnapshot
+    {
+    public:
+        struct Attribute
+        {
+            std::string name;
+            std::string typeName;
+            std::string value;                  ///< char attributes only
+            std::vector< double > numbers;      ///< numeric attributes only
+        };
+        
+        struct Dimension
+        {
+            std::string name;
+            std::size_t size;
+        };
+        
+        struct Variable
+        {
+            std::string name;
+            std::string typeName;
+            std::vector< std::string > dimensionsNames;
+            std::vector< std::size_t > dimensions;
+            std::vector< sofa::FileSnapshot::Attribute > attributes;
+            
+            /// values of a numeric variable (empty for other types), shared between versions
+            std::shared_ptr< const std::vector< double > > values;
+            
+            uint64_t checksum;                  ///< of the type, dimensions, attributes and values (or stored bytes)
+        };
+        
+        typedef std::map< std::string, sofa::FileSnapshot::Variable > Variables;
+    
+    public:
+        FileSnapshot();
+        
+        unsigned long GetVersion() const;
+        const std::string & GetFilename() const;
+        
+        const std::vector< sofa::FileSnapshot::Attribute > & GetAttributes() const;
+        const std::vector< sofa::FileSnapshot::Dimension > & GetDimensions() const;
+        const sofa::FileSnapshot::Variables & GetVariables() const;
+        
+        const sofa::FileSnapshot::Attribute * FindAttribute(const std::string &attributeName) const;
+        const sofa::FileSnapshot::Variable * FindVariable(const std::string &variableName) const;
+        
+        std::shared_ptr< const std::vector< double > > GetValues(const std::string &variableName) const;
+        
+        /// differences with the previous version (empty for the first version)
+        bool HaveGlobalAttributesChanged() const;
+        bool HaveDimensionsChanged() const;
+        const std::vector< std::string > & GetChangedVariables() const;
+        const std::vector< std::string > & GetRemovedVariables() const;
+        
+        bool HasChanged() const;
+    
+    private:
+        friend class FileWatcher;
+        
+        unsigned long version;
+        std::string filename;
+        
+        std::vector< sofa::FileSnapshot::Attribute > attributes;
+        std::vector< sofa::FileSnapshot::Dimension > dimensions;
+        sofa::FileSnapshot::Variables variables;
+        uint64_t attributesChecksum;
+        uint64_t dimensionsChecksum;
+        
+        bool attributesChanged;
+        bool dimensionsChanged;
+        std::vector< std::string > changedVariables;        ///< added or modified
+        std::vector< std::string > removedVariables;
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          FileWatcher
+     *  @brief          Watches a SOFA (netCDF) file and reloads it when it changes on disk
+     *
+     *  @details        A worker thread waits for the file to change : with inotify on
+     *                  Linux, otherwise by polling its modification time, size and inode.
+     *                  Once the file can be opened again, each variable is fingerprinted
+     *                  (type, shape, attributes, and the location and size of its storage,
+     *                  taken from the metadata snapshot and the HDF5 chunk index, without
+     *                  reading any value), compared with the current snapshot, and a new
+     *                  version is published if anything differs. Only the variables whose
+     *                  fingerprint changed are read; the others keep the values of the
+     *                  previous version. Values rewritten at the same location with the
+     *                  same size are therefore not detected : e.g. an uncompressed variable
+     *                  updated in place, or regenerated in a file with the same layout.
+     *
+     *                  Readers get the current version with GetSnapshot() : the returned
+     *                  snapshot never changes, and remains valid as long as it is held,
+     *                  even if newer versions are published in the meantime.
+     *
+     *                  A file being rewritten may be caught incomplete : the reload then
+     *                  fails, the current version is kept, and the reload is attempted again
+     *                  at the next change or poll.
+     *
+     *                  The netCDF and HDF5 libraries are not thread-safe : while the watcher
+     *                  is running, no other thread shall call libsofa (nor netCDF/HDF5),
+     *                  except the methods of the watcher and of its snapshots.
+     */
+    /************************************************************************************/
+    class SOFA_API FileWatcher
+    {
+    public:
+        FileWatcher(const std::string &path,
+                    const unsigned int pollIntervalMs = 500);
+        
+        ~FileWatcher();
+        
+        bool Start();
+        void Stop();
+        
+        bool Reload();
+        
+        std::shared_ptr< const sofa::FileSnapshot > GetSnapshot() const;
+        unsigned long GetVersion() const;
+        
+        const std::string & GetFilename() const;
+        bool IsRunning() const;
+        bool UsesNotifications() const;
+    
+    private:
+        struct FileStatus
+        {
+            FileStatus();
+            
+            bool operator==(const FileStatus &other) const;
+            bool operator!=(const FileStatus &other) const;
+            
+            bool exists;
+            long long size;
+            long long modificationTime;         ///< in nanoseconds (or seconds, depending on the platform)
+            unsigned long long inode;
+        };
+        
+        //==============================================================================
+        static sofa::FileWatcher::FileStatus getFileStatus(const std::string &path);
+        
+        bool reload(const sofa::FileWatcher::FileStatus &status);
+        
+        std::shared_ptr< sofa::FileSnapshot > load(const sofa::FileSnapshot *previous) const;
+        
+        void run();
+        bool waitForChange();
+    
+    private:
+        const std::string filename;
+        const unsigned int pollIntervalMs;
+        
+        std::thread worker;
+        mutable std::mutex mutex;
+        std::condition_variable wakeUp;
+        bool stopping;                                          ///< guarded by the mutex
+        
+        std::mutex reloadMutex;                                 ///< serializes the reloads
+        sofa::FileWatcher::FileStatus loadedStatus;             ///< status of the file when last loaded, guarded by reloadMutex
+        
+        std::shared_ptr< const sofa::FileSnapshot > snapshot;   ///< current version, guarded by the mutex
+        
+        int notifyHandle;                                       ///< inotify file descriptor, or -1
+        int watchHandle;                                        ///< inotify watch descriptor, or -1
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( FileWatcher );
+    };
+
+}
+
+#endif /* _SOFA_FILE_WATCHER_H__ */
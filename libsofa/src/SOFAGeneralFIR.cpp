@@ -68,24 +68,55 @@ std::string GeneralFIR::GetConventionVersion()
  *  @brief          Class constructor
  *  @param[in]      path : the file path
  *  @param[in]      mode : opening mode
+ *  @param[in]      options : chunk cache settings of the variables
  *
  */
 /************************************************************************************/
 GeneralFIR::GeneralFIR(const std::string &path,
-                       const netCDF::NcFile::FileMode &mode)
-: sofa::File( path, mode )
+                       const netCDF::NcFile::FileMode &mode,
+                       const sofa::OpenOptions &options)
+: sofa::File( path, mode, options )
 {
 }
 
-bool GeneralFIR::checkGlobalAttributes() const
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : opens, read-only, the image of a file held in memory
+ *  @param[in]      buffer : the file image; it is not copied, and must outlive this object
+ *  @param[in]      options : chunk cache settings of the variables
+ *
+ */
+/************************************************************************************/
+GeneralFIR::GeneralFIR(const sofa::MemoryBuffer &buffer,
+                       const sofa::OpenOptions &options)
+: sofa::File( buffer, options )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor sharing the handle of a sofa::File already opened,
+ *                  so that the GeneralFIR checks can be run without opening the file again
+ *  @param[in]      sharedFile : the file to share; it must outlive this object
+ *
+ */
+/************************************************************************************/
+GeneralFIR::GeneralFIR(const sofa::File &sharedFile)
+: sofa::File( &sharedFile )
+{
+}
+
+bool GeneralFIR::checkGlobalAttributes(sofa::ValidationReport &report) const
 {
     sofa::Attributes attributes;
     GetGlobalAttributes( attributes );
     
-    sofa::File::ensureSOFAConvention( "GeneralFIR" );
-    sofa::File::ensureDataType( "FIR" );
+    const std::size_t numIssues = report.GetNumIssues();
     
-    return true;
+    sofa::File::ensureSOFAConvention( "GeneralFIR", report );
+    sofa::File::ensureDataType( "FIR", report );
+    
+    return ( report.GetNumIssues() == numIssues );
 }
 
 /************************************************************************************/
@@ -96,26 +127,56 @@ bool GeneralFIR::checkGlobalAttributes() const
 /************************************************************************************/
 bool GeneralFIR::IsValid() const
 {
-    if( sofa::File::IsValid() == false )
+    sofa::ValidationReport report;
+    
+    if( GeneralFIR::Validate( report ) == true )
     {
-        return false;
+        return true;
     }
     
-    if( IsFIRDataType() == false )
+    return raiseFirstIssue( report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the file against the GeneralFIR convention, and collects all
+ *                  the issues found into a report. Never throws an exception
+ *  @param[out]     report : the issues are appended to this report
+ *  @return         true if this is a valid SOFA file with GeneralFIR convention
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::Validate(sofa::ValidationReport &report) const
+{
+    return validateOnce( report, conventionValidation, *this, &GeneralFIR::checkValidity );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Runs all the checks of the GeneralFIR convention; called once by Validate()
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::checkValidity(sofa::ValidationReport &report) const
+{
+    if( sofa::File::Validate( report ) == false )
     {
-        SOFA_THROW( "'DataType' shall be FIR" );
         return false;
     }
     
-    if( checkGlobalAttributes() == false )
+    const std::size_t numIssues = report.GetNumIssues();
+    
+    if( IsFIRDataType() == false )
     {
-        return false;
+        report.Add( sofa::ValidationReport::kInvalidDataType, "'DataType' shall be FIR", "DataType" );
     }
     
+    checkGlobalAttributes( report );
+    
     SOFA_ASSERT( GetDimension( "I" ) == 1 );
     SOFA_ASSERT( GetDimension( "C" ) == 3 );
     
-    return true;
+    return ( report.GetNumIssues() == numIssues );
 }
 
 /************************************************************************************/
@@ -165,6 +226,25 @@ bool GeneralFIR::GetDataIR(double *values, const unsigned long dim1, const unsig
     return sofa::File::getDataIR( values, dim1, dim2, dim3 );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough
+ *  @param[in]      dim1 : first dimension (M)
+ *  @param[in]      dim2 : second dimension (R)
+ *  @param[in]      dim3 : third dimension (N)
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, dim1, dim2, dim3 );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.IR values
@@ -180,6 +260,263 @@ bool GeneralFIR::GetDataIR(std::vector< double > &values) const
     return sofa::File::getDataIR( values );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array shaped like Data.IR
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(sofa::Array< double > &values) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, in a given layout
+ *                  (e.g. one planar block per receiver, or samples interleaved across receivers)
+ *  @param[in]      values : the array is resized if needed
+ *  @param[in]      layout : the requested layout
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(sofa::Array< double > &values,
+                           const sofa::DataLayout::Type &layout) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, layout );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, each impulse response being written at the
+ *                  beginning of its own (zero-padded) slot, e.g. ready for a FFT
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. the product of all the
+ *                  dimensions of Data.IR but the last one, times padding.GetSlotSize( N )
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(double *values,
+                           const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, each impulse
+ *                  response being written at the beginning of its own (zero-padded) slot
+ *  @param[in]      values : the array is resized if needed (the last dimension is the slot size)
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(sofa::Array< double > &values,
+                           const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(std::vector< float > &values) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array shaped like Data.IR, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(sofa::Array< float > &values) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, in a given layout, as float
+ *                  (e.g. one planar block per receiver, or samples interleaved across receivers)
+ *  @param[in]      values : the array is resized if needed
+ *  @param[in]      layout : the requested layout
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(sofa::Array< float > &values,
+                           const sofa::DataLayout::Type &layout) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, layout );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, each impulse response being written at the
+ *                  beginning of its own (zero-padded) slot, e.g. ready for a FFT, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. the product of all the
+ *                  dimensions of Data.IR but the last one, times padding.GetSlotSize( N )
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(float *values,
+                           const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, each impulse
+ *                  response being written at the beginning of its own (zero-padded) slot, as float
+ *  @param[in]      values : the array is resized if needed (the last dimension is the slot size)
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(sofa::Array< float > &values,
+                           const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a hyperslab of the Data.IR values.
+ *                  Only the requested elements are read from the file
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(double *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a hyperslab of the Data.IR values, as float.
+ *                  Only the requested elements are read from the file
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIR(float *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of consecutive measurements
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (numMeasurements x R x N)
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIRMeasurements(double *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    return sofa::File::getDataIRMeasurements( values, firstMeasurement, numMeasurements );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of consecutive measurements, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (numMeasurements x R x N)
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIRMeasurements(float *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    return sofa::File::getDataIRMeasurements( values, firstMeasurement, numMeasurements );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one receiver, for all measurements
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (M x N)
+ *  @param[in]      receiver : index of the receiver to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIRReceiver(double *values, const unsigned long receiver) const
+{
+    return sofa::File::getDataIRReceiver( values, receiver );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one receiver, for all measurements, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (M x N)
+ *  @param[in]      receiver : index of the receiver to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataIRReceiver(float *values, const unsigned long receiver) const
+{
+    return sofa::File::getDataIRReceiver( values, receiver );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.Delay values
@@ -195,6 +532,51 @@ bool GeneralFIR::GetDataDelay(std::vector< double > &values) const
     return sofa::File::getDataDelay( values );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values into a N-dimensional array shaped like Data.Delay
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataDelay(sofa::Array< double > &values) const
+{
+    /// Data.Delay is [ I R ] or [ M R ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataDelay(std::vector< float > &values) const
+{
+    /// Data.Delay is [ I R ] or [ M R ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values into a N-dimensional array shaped like Data.Delay, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIR::GetDataDelay(sofa::Array< float > &values) const
+{
+    /// Data.Delay is [ I R ] or [ M R ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
 bool GeneralFIR::GetDataDelay(double *values, const unsigned long dim1, const unsigned long dim2) const
 {
     /// Data.Delay is [ I R ] or [ M R ]
@@ -202,3 +584,10 @@ bool GeneralFIR::GetDataDelay(double *values, const unsigned long dim1, const un
     return sofa::File::getDataDelay( values, dim1, dim2 );
 }
 
+bool GeneralFIR::GetDataDelay(float *values, const unsigned long dim1, const unsigned long dim2) const
+{
+    /// Data.Delay is [ I R ] or [ M R ]
+    
+    return sofa::File::getDataDelay( values, dim1, dim2 );
+}
+
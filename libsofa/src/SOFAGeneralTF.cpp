@@ -68,24 +68,55 @@ std::string GeneralTF::GetConventionVersion()
  *  @brief          Class constructor
  *  @param[in]      path : the file path
  *  @param[in]      mode : opening mode
+ *  @param[in]      options : chunk cache settings of the variables
  *
  */
 /************************************************************************************/
 GeneralTF::GeneralTF(const std::string &path,
-                     const netCDF::NcFile::FileMode &mode)
-: sofa::File( path, mode )
+                     const netCDF::NcFile::FileMode &mode,
+                     const sofa::OpenOptions &options)
+: sofa::File( path, mode, options )
 {
 }
 
-bool GeneralTF::checkGlobalAttributes() const
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : opens, read-only, the image of a file held in memory
+ *  @param[in]      buffer : the file image; it is not copied, and must outlive this object
+ *  @param[in]      options : chunk cache settings of the variables
+ *
+ */
+/************************************************************************************/
+GeneralTF::GeneralTF(const sofa::MemoryBuffer &buffer,
+                     const sofa::OpenOptions &options)
+: sofa::File( buffer, options )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor sharing the handle of a sofa::File already opened,
+ *                  so that the GeneralTF checks can be run without opening the file again
+ *  @param[in]      sharedFile : the file to share; it must outlive this object
+ *
+ */
+/************************************************************************************/
+GeneralTF::GeneralTF(const sofa::File &sharedFile)
+: sofa::File( &sharedFile )
+{
+}
+
+bool GeneralTF::checkGlobalAttributes(sofa::ValidationReport &report) const
 {
     sofa::Attributes attributes;
     GetGlobalAttributes( attributes );
     
-    sofa::File::ensureSOFAConvention( "GeneralTF" );
-    sofa::File::ensureDataType( "TF" );
+    const std::size_t numIssues = report.GetNumIssues();
+    
+    sofa::File::ensureSOFAConvention( "GeneralTF", report );
+    sofa::File::ensureDataType( "TF", report );
     
-    return true;
+    return ( report.GetNumIssues() == numIssues );
 }
 
 /************************************************************************************/
@@ -96,25 +127,55 @@ bool GeneralTF::checkGlobalAttributes() const
 /************************************************************************************/
 bool GeneralTF::IsValid() const
 {
-    if( sofa::File::IsValid() == false )
+    sofa::ValidationReport report;
+    
+    if( GeneralTF::Validate( report ) == true )
     {
-        return false;
+        return true;
     }
     
-    if( IsTFDataType() == false )
+    return raiseFirstIssue( report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the file against the GeneralTF convention, and collects all
+ *                  the issues found into a report. Never throws an exception
+ *  @param[out]     report : the issues are appended to this report
+ *  @return         true if this is a valid SOFA file with GeneralTF convention
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::Validate(sofa::ValidationReport &report) const
+{
+    return validateOnce( report, conventionValidation, *this, &GeneralTF::checkValidity );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Runs all the checks of the GeneralTF convention; called once by Validate()
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::checkValidity(sofa::ValidationReport &report) const
+{
+    if( sofa::File::Validate( report ) == false )
     {
-        SOFA_THROW( "'DataType' shall be TF" );
         return false;
     }
     
-    if( checkGlobalAttributes() == false )
+    const std::size_t numIssues = report.GetNumIssues();
+    
+    if( IsTFDataType() == false )
     {
-        return false;
+        report.Add( sofa::ValidationReport::kInvalidDataType, "'DataType' shall be TF", "DataType" );
     }
     
+    checkGlobalAttributes( report );
+    
     SOFA_ASSERT( GetDimension( "I" ) == 1 );
     SOFA_ASSERT( GetDimension( "C" ) == 3 );
     
-    return true;
+    return ( report.GetNumIssues() == numIssues );
 }
 
@@ -71,16 +71,27 @@ namespace sofa
         
     public:
         GeneralTF(const std::string &path,
-                   const netCDF::NcFile::FileMode &mode = netCDF::NcFile::read);
+                   const netCDF::NcFile::FileMode &mode = netCDF::NcFile::read,
+                   const sofa::OpenOptions &options = sofa::OpenOptions());
+        
+        explicit GeneralTF(const sofa::MemoryBuffer &buffer,
+                           const sofa::OpenOptions &options = sofa::OpenOptions());
+        
+        explicit GeneralTF(const sofa::File &sharedFile);
         
         virtual ~GeneralTF() {};
         
         virtual bool IsValid() const SOFA_OVERRIDE;
+        virtual bool Validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
         
     private:
         //==============================================================================
-        bool checkGlobalAttributes() const;
+        bool checkValidity(sofa::ValidationReport &report) const;
+        bool checkGlobalAttributes(sofa::ValidationReport &report) const;
         
+        //==============================================================================
+        mutable sofa::File::ValidationCache conventionValidation;
+    
     private:
         /// avoid shallow and copy constructor
         SOFA_AVOID_COPY_CONSTRUCTOR( GeneralTF );
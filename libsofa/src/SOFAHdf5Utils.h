@@ -0,0 +1,395 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAHdf5Utils.h
+ *   @brief      Utility functions to access the HDF5 storage of netCDF-4 files
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_HDF5_UTILS_H__
+#define _SOFA_HDF5_UTILS_H__
+
+#include "../src/SOFAPlatform.h"
+
+/// only available when libsofa is built with the HDF5 headers
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+
+#include "hdf5.h"
+#include <string>
+#include <stdint.h>
+#include <vector>
+
+namespace sofa
+{
+    
+    namespace Hdf5Utils
+    {
+        
+        /************************************************************************************/
+        /*!
+         *  @class          ScopedId
+         *  @brief          Closes an HDF5 identifier when going out of scope
+         *
+         */
+        /************************************************************************************/
+        class ScopedId
+        {
+        public:
+            ScopedId(const hid_t id_, herr_t (*close_)(hid_t))
+            : id( id_ )
+            , close( close_ )
+            {
+            }
+            
+            ~ScopedId()
+            {
+                if( id >= 0 )
+                {
+                    close( id );
+                }
+            }
+            
+            const hid_t id;
+        
+        private:
+            herr_t (*close)(hid_t);
+            
+            SOFA_AVOID_COPY_CONSTRUCTOR( ScopedId );
+        };
+        
+        /************************************************************************************/
+        /*!
+         *  @class          ScopedErrorSilencer
+         *  @brief          Disables the HDF5 error stack printing while probing the file,
+         *                  restores it when going out of scope
+         *
+         */
+        /************************************************************************************/
+        class ScopedErrorSilencer
+        {
+        public:
+            ScopedErrorSilencer()
+            : func( NULL )
+            , data( NULL )
+            {
+                H5Eget_auto2( H5E_DEFAULT, &func, &data );
+                H5Eset_auto2( H5E_DEFAULT, NULL, NULL );
+            }
+            
+            ~ScopedErrorSilencer()
+            {
+                H5Eset_auto2( H5E_DEFAULT, func, data );
+            }
+        
+        private:
+            H5E_auto2_t func;
+            void *data;
+            
+            SOFA_AVOID_COPY_CONSTRUCTOR( ScopedErrorSilencer );
+        };
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns true if the host is little endian
+         *
+         */
+        /************************************************************************************/
+        inline bool IsLittleEndianHost()
+        {
+            const uint16_t one = 1;
+            return ( *reinterpret_cast< const unsigned char * >( &one ) == 1 );
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Opens a file through HDF5 (read-only, unless H5F_ACC_RDWR is given).
+         *                  Returns -1 if it fails
+         *
+         *  @details        The file is already opened by netCDF, and HDF5 requires the same
+         *                  close degree for all the opened instances of a file (netCDF-4 uses
+         *                  H5F_CLOSE_SEMI)
+         */
+        /************************************************************************************/
+        inline hid_t OpenFile(const std::string &path,
+                              const unsigned int flags = H5F_ACC_RDONLY)
+        {
+            const H5F_close_degree_t degrees[] = { H5F_CLOSE_SEMI, H5F_CLOSE_STRONG, H5F_CLOSE_WEAK, H5F_CLOSE_DEFAULT };
+            
+            for( std::size_t i = 0; i < sizeof( degrees ) / sizeof( degrees[0] ); i++ )
+            {
+                const hid_t fapl = H5Pcreate( H5P_FILE_ACCESS );
+                H5Pset_fclose_degree( fapl, degrees[i] );
+                
+                const hid_t fileId = H5Fopen( path.c_str(), flags, fapl );
+                
+                H5Pclose( fapl );
+                
+                if( fileId >= 0 )
+                {
+                    return fileId;
+                }
+            }
+            
+            return -1;
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns the address, in the file, of the data of a dataset : its
+         *                  contiguous storage, or its first chunk.
+         *                  Returns HADDR_UNDEF if the data is not located (compact storage,
+         *                  not written yet)
+         *
+         */
+        /************************************************************************************/
+        inline haddr_t GetStorageAddress(const hid_t dataset)
+        {
+            const ScopedId plist( H5Dget_create_plist( dataset ), H5Pclose );
+            
+            haddr_t address = HADDR_UNDEF;
+            
+            if( H5Pget_layout( plist.id ) == H5D_CONTIGUOUS )
+            {
+                address = H5Dget_offset( dataset );
+            }
+        
+        #if H5_VERSION_GE( 1, 10, 5 )
+            else if( H5Pget_layout( plist.id ) == H5D_CHUNKED )
+            {
+                const ScopedId space( H5Dget_space( dataset ), H5Sclose );
+                
+                hsize_t numChunks = 0;
+                
+                if( H5Dget_num_chunks( dataset, space.id, &numChunks ) >= 0 && numChunks > 0 )
+                {
+                    unsigned int filterMask = 0;
+                    hsize_t size = 0;
+                    
+                    if( H5Dget_chunk_info( dataset, space.id, 0, NULL, &filterMask, &address, &size ) < 0 )
+                    {
+                        address = HADDR_UNDEF;
+                    }
+                }
+            }
+        #endif
+            
+            return address;
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @class          VariableLayout
+         *  @brief          Shape, chunks, filters and type of a chunked floating-point dataset
+         *
+         */
+        /************************************************************************************/
+        struct VariableLayout
+        {
+            std::vector< hsize_t > dims;
+            std::vector< hsize_t > chunkDims;
+            std::vector< H5Z_filter_t > filters;    ///< in the order of the pipeline (i.e. as applied when writing)
+            std::size_t typeSize;                   ///< 4 (float) or 8 (double)
+            bool swapBytes;                         ///< stored with the other endianness
+            std::size_t chunkSize;                  ///< size of an uncompressed chunk, in bytes
+            std::size_t numChunks;
+            unsigned int deflateLevel;              ///< level of the deflate filter, if any
+        };
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Gets the type of the values of a dataset : float or double, any
+         *                  endianness. Returns false for the other types
+         *
+         */
+        /************************************************************************************/
+        inline bool GetType(VariableLayout &layout, const hid_t dataset)
+        {
+            const ScopedId type( H5Dget_type( dataset ), H5Tclose );
+            
+            const bool littleEndianHost = IsLittleEndianHost();
+            
+            if( H5Tequal( type.id, H5T_IEEE_F64LE ) > 0 )
+            {
+                layout.typeSize  = 8;
+                layout.swapBytes = ( littleEndianHost == false );
+            }
+            else if( H5Tequal( type.id, H5T_IEEE_F64BE ) > 0 )
+            {
+                layout.typeSize  = 8;
+                layout.swapBytes = ( littleEndianHost == true );
+            }
+            else if( H5Tequal( type.id, H5T_IEEE_F32LE ) > 0 )
+            {
+                layout.typeSize  = 4;
+                layout.swapBytes = ( littleEndianHost == false );
+            }
+            else if( H5Tequal( type.id, H5T_IEEE_F32BE ) > 0 )
+            {
+                layout.typeSize  = 4;
+                layout.swapBytes = ( littleEndianHost == true );
+            }
+            else
+            {
+                return false;
+            }
+            
+            return true;
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Gets the layout of a chunked dataset. Returns false if it is not
+         *                  chunked, if a filter other than shuffle and deflate is applied,
+         *                  or if the values are not floating point
+         *
+         */
+        /************************************************************************************/
+        inline bool GetLayout(VariableLayout &layout, const hid_t dataset)
+        {
+            const ScopedId space( H5Dget_space( dataset ), H5Sclose );
+            
+            const int rank = H5Sget_simple_extent_ndims( space.id );
+            
+            if( rank <= 0 )
+            {
+                return false;
+            }
+            
+            layout.dims.resize( rank );
+            H5Sget_simple_extent_dims( space.id, &layout.dims[0], NULL );
+            
+            const ScopedId plist( H5Dget_create_plist( dataset ), H5Pclose );
+            
+            if( H5Pget_layout( plist.id ) != H5D_CHUNKED )
+            {
+                return false;
+            }
+            
+            layout.chunkDims.resize( rank );
+            
+            if( H5Pget_chunk( plist.id, rank, &layout.chunkDims[0] ) != rank )
+            {
+                return false;
+            }
+            
+            layout.filters.clear();
+            layout.deflateLevel = 0;
+            
+            const int numFilters = H5Pget_nfilters( plist.id );
+            
+            for( int i = 0; i < numFilters; i++ )
+            {
+                unsigned int flags = 0;
+                unsigned int values[8];
+                std::size_t numValues = 8;
+                
+                const H5Z_filter_t filter = H5Pget_filter2( plist.id, i, &flags, &numValues, values, 0, NULL, NULL );
+                
+                if( filter != H5Z_FILTER_DEFLATE && filter != H5Z_FILTER_SHUFFLE )
+                {
+                    return false;
+                }
+                
+                if( filter == H5Z_FILTER_DEFLATE && numValues > 0 )
+                {
+                    layout.deflateLevel = values[0];
+                }
+                
+                layout.filters.push_back( filter );
+            }
+            
+            if( GetType( layout, dataset ) == false )
+            {
+                return false;
+            }
+            
+            layout.chunkSize = layout.typeSize;
+            layout.numChunks = 1;
+            
+            for( int i = 0; i < rank; i++ )
+            {
+                if( layout.chunkDims[i] == 0 )
+                {
+                    return false;
+                }
+                
+                layout.chunkSize *= layout.chunkDims[i];
+                layout.numChunks *= ( layout.dims[i] + layout.chunkDims[i] - 1 ) / layout.chunkDims[i];
+            }
+            
+            return true;
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns the offset (in elements) of a chunk, the chunks being
+         *                  numbered in row-major order
+         *
+         */
+        /************************************************************************************/
+        inline void GetChunkOffset(std::vector< hsize_t > &offset,
+                                   std::size_t index,
+                                   const VariableLayout &layout)
+        {
+            const std::size_t rank = layout.dims.size();
+            
+            offset.resize( rank );
+            
+            for( std::size_t i = rank; i > 0; i-- )
+            {
+                const std::size_t d = i - 1;
+                const std::size_t numChunks = ( layout.dims[d] + layout.chunkDims[d] - 1 ) / layout.chunkDims[d];
+                
+                offset[d] = ( index % numChunks ) * layout.chunkDims[d];
+                index    /= numChunks;
+            }
+        }
+    
+    }
+
+}
+
+#endif /* SOFA_HDF5_DIRECT_CHUNK_READ */
+
+#endif /* _SOFA_HDF5_UTILS_H__ */
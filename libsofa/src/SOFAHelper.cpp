@@ -56,36 +56,87 @@
 #include "../src/SOFAGeneralFIRE.h"
 #include "../src/SOFAGeneralTF.h"
 #include "../src/SOFASingleRoomDRIR.h"
+#include "../src/SOFAAmbisonicsDRIR.h"
 
 using namespace sofa;
 
 namespace sofaLocal
 {
+    /// the checks of the conventions collect their issues into a report instead of
+    /// raising exceptions : only a failure to open the file may throw
     template< class Type >
     bool isValid(const std::string &filename) SOFA_NOEXCEPT
     {
-        const bool exceptionState = sofa::Exception::IsLoggedToCerr();
-        
-        /// temporarily disable exceptions logging
-        sofa::Exception::LogToCerr( false );
-        
-        bool isValid = false;
-        
         try
         {
             const Type file( filename );
-            isValid = file.IsValid();
+            
+            sofa::ValidationReport report;
+            return file.Validate( report );
+        }
+        catch( ... )
+        {
+            /// the file could not be opened
+            return false;
+        }
+    }
+    
+    /// checks a convention against a file already opened, sharing its handle
+    template< class Type >
+    bool isValid(const sofa::File &file) SOFA_NOEXCEPT
+    {
+        try
+        {
+            const Type convention( file );
+            
+            sofa::ValidationReport report;
+            return convention.Validate( report );
         }
         catch( ... )
         {
             /// something went wrong
-            isValid = false;
+            return false;
         }
+    }
+    
+    /// opens the file only once, and checks it against all the conventions
+    template< class Source >
+    DetectedConventions detectConventions(const Source &source) SOFA_NOEXCEPT
+    {
+        DetectedConventions detected;
         
-        /// restore exceptions logging
-        sofa::Exception::LogToCerr( exceptionState );
+        try
+        {
+            const sofa::File file( source );
+            
+            detected.isNetCDF = file.sofa::NetCDFFile::IsValid();
+            
+            if( detected.isNetCDF == true )
+            {
+                /// the outcome of the SOFA checks is memoized, and shared with the conventions below
+                sofa::ValidationReport report;
+                detected.isSOFA = file.sofa::File::Validate( report );
+            }
+            
+            if( detected.isSOFA == true )
+            {
+                detected.isSimpleFreeFieldHRIR  = sofaLocal::isValid< sofa::SimpleFreeFieldHRIR >( file );
+                detected.isSimpleFreeFieldSOS   = sofaLocal::isValid< sofa::SimpleFreeFieldSOS >( file );
+                detected.isSimpleHeadphoneIR    = sofaLocal::isValid< sofa::SimpleHeadphoneIR >( file );
+                detected.isGeneralFIR           = sofaLocal::isValid< sofa::GeneralFIR >( file );
+                detected.isGeneralFIRE          = sofaLocal::isValid< sofa::GeneralFIRE >( file );
+                detected.isGeneralTF            = sofaLocal::isValid< sofa::GeneralTF >( file );
+                detected.isMultiSpeakerBRIR     = sofaLocal::isValid< sofa::MultiSpeakerBRIR >( file );
+                detected.isSingleRoomDRIR       = sofaLocal::isValid< sofa::SingleRoomDRIR >( file );
+                detected.isAmbisonicsDRIR       = sofaLocal::isValid< sofa::AmbisonicsDRIR >( file );
+            }
+        }
+        catch( ... )
+        {
+            /// the file could not be opened
+        }
         
-        return isValid;
+        return detected;
     }
 }
 
@@ -102,7 +153,16 @@ namespace sofaLocal
 /************************************************************************************/
 bool sofa::IsValidNetCDFFile(const std::string &filename) SOFA_NOEXCEPT
 {
-    return sofaLocal::isValid< sofa::NetCDFFile >( filename );
+    try
+    {
+        const sofa::NetCDFFile file( filename );
+        return file.IsValid();
+    }
+    catch( ... )
+    {
+        /// the file could not be opened
+        return false;
+    }
 }
 
 /************************************************************************************/
@@ -240,3 +300,70 @@ bool sofa::IsValidSingleRoomDRIRFile(const std::string &filename) SOFA_NOEXCEPT
     return sofaLocal::isValid< sofa::SingleRoomDRIR >( filename );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the file is a valid AmbisonicsDRIR file
+ *  @param[in]      filename : full path to a local file, or an OpenDAP URL
+ *                  (e.g. http://bili1.ircam.fr/opendap/hyrax/listen/irc_1002.sofa)
+ *
+ *  @details        This method wont raise any exception
+ *
+ */
+/************************************************************************************/
+bool sofa::IsValidAmbisonicsDRIRFile(const std::string &filename) SOFA_NOEXCEPT
+{
+    return sofaLocal::isValid< sofa::AmbisonicsDRIR >( filename );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : nothing detected
+ *
+ */
+/************************************************************************************/
+DetectedConventions::DetectedConventions()
+: isNetCDF( false )
+, isSOFA( false )
+, isSimpleFreeFieldHRIR( false )
+, isSimpleFreeFieldSOS( false )
+, isSimpleHeadphoneIR( false )
+, isGeneralFIR( false )
+, isGeneralFIRE( false )
+, isGeneralTF( false )
+, isMultiSpeakerBRIR( false )
+, isSingleRoomDRIR( false )
+, isAmbisonicsDRIR( false )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks a file against all the supported conventions at once
+ *  @param[in]      filename : full path to a local file, or an OpenDAP URL
+ *                  (e.g. http://bili1.ircam.fr/opendap/hyrax/listen/irc_1002.sofa)
+ *
+ *  @details        The file is opened only once, the SOFA checks are run only once,
+ *                  and the rules of each convention are checked against the same handle.
+ *                  This method wont raise any exception
+ *
+ */
+/************************************************************************************/
+DetectedConventions sofa::DetectConventions(const std::string &filename) SOFA_NOEXCEPT
+{
+    return sofaLocal::detectConventions( filename );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the image of a file held in memory against all the supported
+ *                  conventions at once
+ *  @param[in]      buffer : the file image
+ *
+ *  @details        This method wont raise any exception
+ *
+ */
+/************************************************************************************/
+DetectedConventions sofa::DetectConventions(const sofa::MemoryBuffer &buffer) SOFA_NOEXCEPT
+{
+    return sofaLocal::detectConventions( buffer );
+}
@@ -53,6 +53,7 @@
 
 namespace sofa
 {
+    class MemoryBuffer;
     
     /************************************************************************************/
     /*!
@@ -173,6 +174,69 @@ namespace sofa
      */
     /************************************************************************************/
     bool IsValidSingleRoomDRIRFile(const std::string &filename) SOFA_NOEXCEPT;
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns true if the file is a valid AmbisonicsDRIR file
+     *  @param[in]      filename : full path to a local file, or an OpenDAP URL
+     *                  (e.g. http://bili1.ircam.fr/opendap/hyrax/listen/irc_1002.sofa)
+     *
+     *  @details        This method wont raise any exception
+     *
+     */
+    /************************************************************************************/
+    bool IsValidAmbisonicsDRIRFile(const std::string &filename) SOFA_NOEXCEPT;
+    
+    /************************************************************************************/
+    /*!
+     *  @struct         DetectedConventions
+     *  @brief          Outcome of sofa::DetectConventions : which of the checks does a file pass
+     *
+     */
+    /************************************************************************************/
+    struct SOFA_API DetectedConventions
+    {
+        DetectedConventions();
+        
+        bool isNetCDF;
+        bool isSOFA;
+        bool isSimpleFreeFieldHRIR;
+        bool isSimpleFreeFieldSOS;
+        bool isSimpleHeadphoneIR;
+        bool isGeneralFIR;
+        bool isGeneralFIRE;
+        bool isGeneralTF;
+        bool isMultiSpeakerBRIR;
+        bool isSingleRoomDRIR;
+        bool isAmbisonicsDRIR;
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Checks a file against all the supported conventions at once
+     *  @param[in]      filename : full path to a local file, or an OpenDAP URL
+     *                  (e.g. http://bili1.ircam.fr/opendap/hyrax/listen/irc_1002.sofa)
+     *
+     *  @details        This is equivalent to calling all the IsValid...File() functions above,
+     *                  but the file is opened only once, the SOFA checks are run only once,
+     *                  and the rules of each convention are checked against the same handle.
+     *                  This method wont raise any exception
+     *
+     */
+    /************************************************************************************/
+    DetectedConventions DetectConventions(const std::string &filename) SOFA_NOEXCEPT;
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Checks the image of a file held in memory against all the supported
+     *                  conventions at once
+     *  @param[in]      buffer : the file image
+     *
+     *  @details        This method wont raise any exception
+     *
+     */
+    /************************************************************************************/
+    DetectedConventions DetectConventions(const sofa::MemoryBuffer &buffer) SOFA_NOEXCEPT;
 }
 
 #endif /* _SOFA_HELPER_H__ */
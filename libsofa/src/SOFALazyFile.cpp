@@ -0,0 +1,299 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFALazyFile.cpp
+ *   @brief      Files opened on first access, within a bounded pool of open handles
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFALazyFile.h"
+#include "../src/SOFAUtils.h"
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      maxOpenFiles : maximum number of files kept open by the pool (0 : unbounded)
+ *
+ */
+/************************************************************************************/
+FilePool::FilePool(const std::size_t maxOpenFiles_)
+: maxOpenFiles( maxOpenFiles_ )
+, numEvictions( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor : closes the files of the pool
+ *
+ */
+/************************************************************************************/
+FilePool::~FilePool()
+{
+    CloseAll();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the maximum number of files kept open by the pool (0 : unbounded).
+ *                  The least recently used files are closed if there are too many
+ *
+ */
+/************************************************************************************/
+void FilePool::SetMaxOpenFiles(const std::size_t maxOpenFiles_)
+{
+    maxOpenFiles = maxOpenFiles_;
+    
+    evict();
+}
+
+std::size_t FilePool::GetMaxOpenFiles() const
+{
+    return maxOpenFiles;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of files currently kept open by the pool
+ *
+ */
+/************************************************************************************/
+std::size_t FilePool::GetNumOpenFiles() const
+{
+    return openFiles.size();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns how many times a file was closed to make room for another one
+ *
+ */
+/************************************************************************************/
+unsigned long FilePool::GetNumEvictions() const
+{
+    return numEvictions;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Closes all the files of the pool (they are opened again on their next access)
+ *
+ */
+/************************************************************************************/
+void FilePool::CloseAll()
+{
+    while( openFiles.empty() == false )
+    {
+        openFiles.front()->Close();
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Marks a file as the most recently used one, adding it to the pool if
+ *                  it was just opened, and closes the least recently used files if needed
+ *
+ */
+/************************************************************************************/
+void FilePool::touch(LazyFileBase *file)
+{
+    if( file->pooled == true )
+    {
+        openFiles.splice( openFiles.begin(), openFiles, file->position );
+    }
+    else
+    {
+        openFiles.push_front( file );
+        file->position = openFiles.begin();
+        file->pooled   = true;
+    }
+    
+    evict();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Removes a file from the pool, without closing it
+ *
+ */
+/************************************************************************************/
+void FilePool::remove(LazyFileBase *file)
+{
+    if( file->pooled == true )
+    {
+        openFiles.erase( file->position );
+        file->pooled = false;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Closes the least recently used files, until the pool is not over its
+ *                  limit. The most recently used file is never closed
+ *
+ */
+/************************************************************************************/
+void FilePool::evict()
+{
+    if( maxOpenFiles == 0 )
+    {
+        return;
+    }
+    
+    while( openFiles.size() > smax( maxOpenFiles, (std::size_t) 1 ) )
+    {
+        LazyFileBase *file = openFiles.back();
+        
+        openFiles.pop_back();
+        file->pooled = false;
+        file->releaseHandle();
+        
+        numEvictions++;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : records the path, the file is not opened
+ *  @param[in]      path : the file
+ *  @param[in]      pool : pool bounding the number of open files, or NULL
+ *  @param[in]      options : options used each time the file is opened
+ *
+ */
+/************************************************************************************/
+LazyFileBase::LazyFileBase(const std::string &path,
+                           FilePool *pool_,
+                           const OpenOptions &options_)
+: filename( path )
+, options( options_ )
+, pool( pool_ )
+, pooled( false )
+, numOpens( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor : leaves the pool
+ *
+ */
+/************************************************************************************/
+LazyFileBase::~LazyFileBase()
+{
+    if( pool != NULL )
+    {
+        pool->remove( this );
+    }
+}
+
+const std::string & LazyFileBase::GetFilename() const
+{
+    return filename;
+}
+
+const OpenOptions & LazyFileBase::GetOpenOptions() const
+{
+    return options;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the file is currently open
+ *
+ */
+/************************************************************************************/
+bool LazyFileBase::IsOpen() const
+{
+    return hasHandle();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Closes the file (it is opened again on its next access).
+ *                  The file actually remains open while the pointers returned by Get() are held
+ *
+ */
+/************************************************************************************/
+void LazyFileBase::Close()
+{
+    if( pool != NULL )
+    {
+        pool->remove( this );
+    }
+    
+    releaseHandle();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns how many times the file was opened
+ *
+ */
+/************************************************************************************/
+unsigned long LazyFileBase::GetNumOpens() const
+{
+    return numOpens;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          To be called on each access
+ *  @param[in]      justOpened : true if the file was opened by this access
+ *
+ */
+/************************************************************************************/
+void LazyFileBase::touch(const bool justOpened)
+{
+    if( justOpened == true )
+    {
+        numOpens++;
+    }
+    
+    if( pool != NULL )
+    {
+        pool->touch( this );
+    }
+}
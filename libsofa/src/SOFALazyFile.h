@@ -0,0 +1,219 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFALazyFile.h
+ *   @brief      Files opened on first access, within a bounded pool of open handles
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_LAZY_FILE_H__
+#define _SOFA_LAZY_FILE_H__
+
+#include "../src/SOFAFile.h"
+#include <memory>
+#include <list>
+
+namespace sofa
+{
+    class LazyFileBase;
+    
+    /************************************************************************************/
+    /*!
+     *  @class          FilePool
+     *  @brief          Bounds the number of files kept open by a set of sofa::LazyFile
+     *
+     *  @details        When a file of the pool is opened and the pool is full, the least
+     *                  recently used file is closed; it is opened again on its next access.
+     *                  The pool shall outlive its files. Neither the pool nor its files are
+     *                  thread-safe.
+     */
+    /************************************************************************************/
+    class SOFA_API FilePool
+    {
+    public:
+        explicit FilePool(const std::size_t maxOpenFiles = 64);
+        ~FilePool();
+        
+        void SetMaxOpenFiles(const std::size_t maxOpenFiles);
+        std::size_t GetMaxOpenFiles() const;
+        
+        std::size_t GetNumOpenFiles() const;
+        unsigned long GetNumEvictions() const;
+        
+        void CloseAll();
+    
+    private:
+        friend class LazyFileBase;
+        
+        void touch(sofa::LazyFileBase *file);
+        void remove(sofa::LazyFileBase *file);
+        void evict();
+    
+    private:
+        std::size_t maxOpenFiles;                       ///< 0 : unbounded
+        std::list< sofa::LazyFileBase * > openFiles;    ///< most recently used first
+        unsigned long numEvictions;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( FilePool );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          LazyFileBase
+     *  @brief          Path of a file, opened on first access (see sofa::LazyFile)
+     *
+     */
+    /************************************************************************************/
+    class SOFA_API LazyFileBase
+    {
+    public:
+        virtual ~LazyFileBase();
+        
+        const std::string & GetFilename() const;
+        const sofa::OpenOptions & GetOpenOptions() const;
+        
+        bool IsOpen() const;
+        void Close();
+        
+        unsigned long GetNumOpens() const;
+    
+    protected:
+        LazyFileBase(const std::string &path,
+                     sofa::FilePool *pool,
+                     const sofa::OpenOptions &options);
+        
+        void touch(const bool justOpened);
+        
+        virtual bool hasHandle() const = 0;
+        virtual void releaseHandle() = 0;
+    
+    protected:
+        const std::string filename;
+        const sofa::OpenOptions options;
+    
+    private:
+        friend class FilePool;
+        
+        sofa::FilePool *pool;
+        bool pooled;                                                ///< true while the file is in pool->openFiles
+        std::list< sofa::LazyFileBase * >::iterator position;       ///< in pool->openFiles
+        unsigned long numOpens;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( LazyFileBase );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          LazyFile
+     *  @brief          Records the path of a file, and opens it (read-only) on first access
+     *
+     *  @details        FileType is sofa::File, sofa::NetCDFFile, or one of the conventions
+     *                  (e.g. sofa::SimpleFreeFieldHRIR).
+     *                  Registering a file does not touch the disk. Get() opens the file if
+     *                  needed; the returned pointer keeps the file open while it is held,
+     *                  even if the pool closes its own reference in the meantime (the
+     *                  file is then opened anew on the next Get()).
+     */
+    /************************************************************************************/
+    template< typename FileType = sofa::File >
+    class LazyFile : public sofa::LazyFileBase
+    {
+    public:
+        explicit LazyFile(const std::string &path,
+                          sofa::FilePool *pool = NULL,
+                          const sofa::OpenOptions &options = sofa::OpenOptions())
+        : sofa::LazyFileBase( path, pool, options )
+        {
+        }
+        
+        virtual ~LazyFile() {};
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns the file, opened if needed.
+         *                  Throws the exceptions of the FileType constructor (e.g. if the
+         *                  file does not exist)
+         *
+         */
+        /************************************************************************************/
+        std::shared_ptr< const FileType > Get()
+        {
+            const bool justOpened = ( file == NULL );
+            
+            if( justOpened == true )
+            {
+                file.reset( new FileType( filename, netCDF::NcFile::read, options ) );
+            }
+            
+            touch( justOpened );
+            
+            return file;
+        }
+    
+    protected:
+        virtual bool hasHandle() const
+        {
+            return ( file != NULL );
+        }
+        
+        virtual void releaseHandle()
+        {
+            file.reset();
+        }
+    
+    private:
+        std::shared_ptr< const FileType > file;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( LazyFile );
+    };
+
+}
+
+#endif /* _SOFA_LAZY_FILE_H__ */
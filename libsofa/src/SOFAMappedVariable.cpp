@@ -0,0 +1,582 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMappedVariable.cpp
+ *   @brief      Read-only memory mapping of a contiguous, uncompressed variable
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAMappedVariable.h"
+#include "../src/SOFAHdf5Utils.h"
+#include "../src/SOFAHostArchitecture.h"
+#include "../src/SOFANcUtils.h"
+#include <cstring>
+#include <stdint.h>
+
+#if( SOFA_WINDOWS == 1 )
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace sofa;
+
+namespace MappedVariableHelper
+{
+    static std::size_t getElementSize(const nc_type type)
+    {
+        switch( type )
+        {
+            case NC_BYTE :
+            case NC_UBYTE :
+                return 1;
+            case NC_SHORT :
+            case NC_USHORT :
+                return 2;
+            case NC_INT :
+            case NC_UINT :
+            case NC_FLOAT :
+                return 4;
+            case NC_INT64 :
+            case NC_UINT64 :
+            case NC_DOUBLE :
+                return 8;
+            default :
+                return 0;
+        }
+    }
+    
+    /// reads one stored value, swapping its bytes if needed
+    template< typename Stored >
+    static Stored readValue(const unsigned char *src, const bool swapBytes)
+    {
+        unsigned char bytes[ sizeof( Stored ) ];
+        
+        if( swapBytes == true )
+        {
+            for( std::size_t i = 0; i < sizeof( Stored ); i++ )
+            {
+                bytes[i] = src[ sizeof( Stored ) - 1 - i ];
+            }
+        }
+        else
+        {
+            std::memcpy( bytes, src, sizeof( Stored ) );
+        }
+        
+        Stored value;
+        std::memcpy( &value, bytes, sizeof( Stored ) );
+        
+        return value;
+    }
+    
+    template< typename T, typename Stored >
+    static void convert(T *values,
+                        const unsigned char *src,
+                        const std::size_t numElements,
+                        const bool swapBytes,
+                        const bool packed,
+                        const double scale,
+                        const double offset)
+    {
+        for( std::size_t i = 0; i < numElements; i++ )
+        {
+            const Stored value = readValue< Stored >( src + i * sizeof( Stored ), swapBytes );
+            
+            values[i] = ( packed == true ) ? (T) ( (double) value * scale + offset ) : (T) value;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : maps a variable, if it can be mapped
+ *  @param[in]      file : the file containing the variable (opened in read mode)
+ *  @param[in]      variableName : the variable to map
+ *
+ */
+/************************************************************************************/
+MappedVariable::MappedVariable(const sofa::NetCDFFile &file,
+                               const std::string &variableName_)
+: variableName( variableName_ )
+, type( NC_NAT )
+, elementSize( 0 )
+, nativeByteOrder( true )
+, packed( false )
+, scale( 1.0 )
+, offset( 0.0 )
+, fileOffset( 0 )
+, mapping( NULL )
+, mappingSize( 0 )
+, data( NULL )
+, mappingHandle( NULL )
+{
+    if( locate( file ) == true )
+    {
+        map( file.GetFilename() );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor : unmaps the variable
+ *
+ */
+/************************************************************************************/
+MappedVariable::~MappedVariable()
+{
+    Unmap();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the variable is mapped
+ *
+ */
+/************************************************************************************/
+bool MappedVariable::IsMapped() const
+{
+    return ( data != NULL );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Unmaps the variable (the views previously returned become invalid)
+ *
+ */
+/************************************************************************************/
+void MappedVariable::Unmap()
+{
+    if( mapping != NULL )
+    {
+    #if( SOFA_WINDOWS == 1 )
+        UnmapViewOfFile( mapping );
+        CloseHandle( (HANDLE) mappingHandle );
+    #else
+        munmap( mapping, mappingSize );
+    #endif
+    }
+    
+    mapping       = NULL;
+    mappingSize   = 0;
+    mappingHandle = NULL;
+    data          = NULL;
+}
+
+const std::string & MappedVariable::GetVariableName() const
+{
+    return variableName;
+}
+
+const std::vector< std::size_t > & MappedVariable::GetDimensions() const
+{
+    return dims;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of elements of the variable
+ *
+ */
+/************************************************************************************/
+std::size_t MappedVariable::GetNumElements() const
+{
+    return ( dims.empty() == true ) ? 0 : sofa::NcUtils::GetNumElements( dims );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the type of the variable, as stored in the file
+ *
+ */
+/************************************************************************************/
+nc_type MappedVariable::GetType() const
+{
+    return type;
+}
+
+std::size_t MappedVariable::GetElementSize() const
+{
+    return elementSize;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the values are stored in the byte order of the host
+ *
+ */
+/************************************************************************************/
+bool MappedVariable::IsNativeByteOrder() const
+{
+    return nativeByteOrder;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the variable is packed (CF scale_factor and add_offset)
+ *
+ */
+/************************************************************************************/
+bool MappedVariable::IsPacked() const
+{
+    return packed;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the location of the values in the file, in bytes
+ *
+ */
+/************************************************************************************/
+unsigned long long MappedVariable::GetFileOffset() const
+{
+    return fileOffset;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the values as stored in the file (type, byte order, packing),
+ *                  or NULL if the variable is not mapped
+ *
+ */
+/************************************************************************************/
+const void * MappedVariable::GetRawData() const
+{
+    return data;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns a view of the values, in place, shaped like the variable.
+ *                  The view is empty unless the variable is stored as double, in the byte
+ *                  order of the host, not packed, suitably aligned in the file, and has at
+ *                  most kArrayMaxRank dimensions.
+ *                  It remains valid as long as the variable is mapped
+ *
+ */
+/************************************************************************************/
+sofa::ArrayView< const double > MappedVariable::GetDoubleView() const
+{
+    if( data == NULL || type != NC_DOUBLE || nativeByteOrder == false || packed == true || dims.size() > kArrayMaxRank
+       || reinterpret_cast< uintptr_t >( data ) % sizeof( double ) != 0 )
+    {
+        return sofa::ArrayView< const double >();
+    }
+    
+    return sofa::ArrayView< const double >( reinterpret_cast< const double * >( data ), dims );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns a view of the values, in place, shaped like the variable.
+ *                  The view is empty unless the variable is stored as float, in the byte
+ *                  order of the host, not packed, suitably aligned in the file, and has at
+ *                  most kArrayMaxRank dimensions.
+ *                  It remains valid as long as the variable is mapped
+ *
+ */
+/************************************************************************************/
+sofa::ArrayView< const float > MappedVariable::GetFloatView() const
+{
+    if( data == NULL || type != NC_FLOAT || nativeByteOrder == false || packed == true || dims.size() > kArrayMaxRank
+       || reinterpret_cast< uintptr_t >( data ) % sizeof( float ) != 0 )
+    {
+        return sofa::ArrayView< const float >();
+    }
+    
+    return sofa::ArrayView< const float >( reinterpret_cast< const float * >( data ), dims );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Copies a range of values (in row-major order), converted to double :
+ *                  the bytes are swapped if needed, and packed values are unpacked.
+ *                  Only the pages holding the range are read from the disk.
+ *                  Returns false if the variable is not mapped, or the range out of bounds
+ *  @param[out]     values : numElements values, allocated by the caller
+ *  @param[in]      firstElement : index of the first value
+ *  @param[in]      numElements : number of values
+ *
+ */
+/************************************************************************************/
+bool MappedVariable::GetValues(double *values,
+                               const std::size_t firstElement,
+                               const std::size_t numElements) const
+{
+    return getValues( values, firstElement, numElements );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Copies a range of values (in row-major order), converted to float :
+ *                  the bytes are swapped if needed, and packed values are unpacked.
+ *                  Only the pages holding the range are read from the disk.
+ *                  Returns false if the variable is not mapped, or the range out of bounds
+ *  @param[out]     values : numElements values, allocated by the caller
+ *  @param[in]      firstElement : index of the first value
+ *  @param[in]      numElements : number of values
+ *
+ */
+/************************************************************************************/
+bool MappedVariable::GetValues(float *values,
+                               const std::size_t firstElement,
+                               const std::size_t numElements) const
+{
+    return getValues( values, firstElement, numElements );
+}
+
+template< typename T >
+bool MappedVariable::getValues(T *values,
+                               const std::size_t firstElement,
+                               const std::size_t numElements) const
+{
+    const std::size_t totalElements = GetNumElements();
+    
+    if( data == NULL || values == NULL || firstElement > totalElements || numElements > totalElements - firstElement )
+    {
+        return false;
+    }
+    
+    const unsigned char *src = data + firstElement * elementSize;
+    const bool swapBytes     = ( nativeByteOrder == false );
+    
+    switch( type )
+    {
+        case NC_BYTE :
+            MappedVariableHelper::convert< T, signed char >( values, src, numElements, swapBytes, packed, scale, offset );
+            break;
+        case NC_UBYTE :
+            MappedVariableHelper::convert< T, unsigned char >( values, src, numElements, swapBytes, packed, scale, offset );
+            break;
+        case NC_SHORT :
+            MappedVariableHelper::convert< T, short >( values, src, numElements, swapBytes, packed, scale, offset );
+            break;
+        case NC_USHORT :
+            MappedVariableHelper::convert< T, unsigned short >( values, src, numElements, swapBytes, packed, scale, offset );
+            break;
+        case NC_INT :
+            MappedVariableHelper::convert< T, int >( values, src, numElements, swapBytes, packed, scale, offset );
+            break;
+        case NC_UINT :
+            MappedVariableHelper::convert< T, unsigned int >( values, src, numElements, swapBytes, packed, scale, offset );
+            break;
+        case NC_INT64 :
+            MappedVariableHelper::convert< T, long long >( values, src, numElements, swapBytes, packed, scale, offset );
+            break;
+        case NC_UINT64 :
+            MappedVariableHelper::convert< T, unsigned long long >( values, src, numElements, swapBytes, packed, scale, offset );
+            break;
+        case NC_FLOAT :
+            MappedVariableHelper::convert< T, float >( values, src, numElements, swapBytes, packed, scale, offset );
+            break;
+        default :
+            MappedVariableHelper::convert< T, double >( values, src, numElements, swapBytes, packed, scale, offset );
+            break;
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Finds the type, the shape and the location of the variable, and checks
+ *                  that its storage is a flat array
+ *
+ */
+/************************************************************************************/
+bool MappedVariable::locate(const sofa::NetCDFFile &file)
+{
+#if defined( SOFA_HDF5_DIRECT_CHUNK_READ )
+    if( file.IsInMemory() == true || file.GetMetadata().IsLoaded() == false )
+    {
+        return false;
+    }
+    
+    const sofa::NcMetadata::Variable * var = file.GetMetadata().FindVariable( variableName );
+    
+    if( var == NULL || var->dimensions.empty() == true )
+    {
+        return false;
+    }
+    
+    type        = var->type;
+    elementSize = MappedVariableHelper::getElementSize( type );
+    dims        = var->dimensions;
+    packed      = file.GetVariablePacking( scale, offset, variableName );
+    
+    if( elementSize == 0 || GetNumElements() == 0 )
+    {
+        return false;
+    }
+    
+    const sofa::Hdf5Utils::ScopedErrorSilencer silencer;
+    
+    const sofa::Hdf5Utils::ScopedId fileId( sofa::Hdf5Utils::OpenFile( file.GetFilename() ), H5Fclose );
+    
+    if( fileId.id < 0 )
+    {
+        return false;
+    }
+    
+    const sofa::Hdf5Utils::ScopedId dataset( H5Dopen2( fileId.id, variableName.c_str(), H5P_DEFAULT ), H5Dclose );
+    
+    if( dataset.id < 0 )
+    {
+        return false;
+    }
+    
+    const sofa::Hdf5Utils::ScopedId plist( H5Dget_create_plist( dataset.id ), H5Pclose );
+    
+    if( H5Pget_layout( plist.id ) != H5D_CONTIGUOUS )
+    {
+        return false;
+    }
+    
+    const haddr_t address = sofa::Hdf5Utils::GetStorageAddress( dataset.id );
+    
+    if( address == HADDR_UNDEF
+       || H5Dget_storage_size( dataset.id ) != (hsize_t) ( GetNumElements() * elementSize ) )
+    {
+        /// e.g. not written yet
+        return false;
+    }
+    
+    const sofa::Hdf5Utils::ScopedId datatype( H5Dget_type( dataset.id ), H5Tclose );
+    
+    if( H5Tget_size( datatype.id ) != elementSize )
+    {
+        return false;
+    }
+    
+    const H5T_order_t order = H5Tget_order( datatype.id );
+    
+    if( elementSize > 1 && order != H5T_ORDER_LE && order != H5T_ORDER_BE )
+    {
+        return false;
+    }
+    
+    nativeByteOrder = ( elementSize == 1 || ( order == H5T_ORDER_LE ) == sofa::Hdf5Utils::IsLittleEndianHost() );
+    fileOffset      = (unsigned long long) address;
+    
+    return true;
+#else
+    (void) file;
+    return false;
+#endif
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Maps the values in memory, read-only
+ *
+ */
+/************************************************************************************/
+bool MappedVariable::map(const std::string &path)
+{
+    const std::size_t numBytes = GetNumElements() * elementSize;
+
+#if( SOFA_WINDOWS == 1 )
+    SYSTEM_INFO info;
+    GetSystemInfo( &info );
+    
+    /// the mapping shall start at a multiple of the allocation granularity
+    const unsigned long long start = fileOffset - fileOffset % info.dwAllocationGranularity;
+    const std::size_t delta        = (std::size_t) ( fileOffset - start );
+    
+    const HANDLE fileHandle = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    
+    if( fileHandle == INVALID_HANDLE_VALUE )
+    {
+        return false;
+    }
+    
+    /// the mapping object keeps the file open
+    const HANDLE handle = CreateFileMappingA( fileHandle, NULL, PAGE_READONLY, 0, 0, NULL );
+    CloseHandle( fileHandle );
+    
+    if( handle == NULL )
+    {
+        return false;
+    }
+    
+    void *region = MapViewOfFile( handle, FILE_MAP_READ, (DWORD) ( start >> 32 ), (DWORD) ( start & 0xFFFFFFFF ), delta + numBytes );
+    
+    if( region == NULL )
+    {
+        CloseHandle( handle );
+        return false;
+    }
+    
+    mappingHandle = handle;
+#else
+    /// the mapping shall start at a multiple of the page size
+    const long pageSize            = sysconf( _SC_PAGESIZE );
+    const unsigned long long start = fileOffset - fileOffset % (unsigned long long) ( ( pageSize > 0 ) ? pageSize : 4096 );
+    const std::size_t delta        = (std::size_t) ( fileOffset - start );
+    
+    const int fd = open( path.c_str(), O_RDONLY );
+    
+    if( fd < 0 )
+    {
+        return false;
+    }
+    
+    /// the mapping keeps the file open
+    void *region = mmap( NULL, delta + numBytes, PROT_READ, MAP_SHARED, fd, (off_t) start );
+    close( fd );
+    
+    if( region == MAP_FAILED )
+    {
+        return false;
+    }
+#endif
+    
+    mapping     = region;
+    mappingSize = delta + numBytes;
+    data        = static_cast< const unsigned char * >( region ) + delta;
+    
+    return true;
+}
@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMappedVariable.h
+ *   @brief      Read-only memory mapping of a contiguous, uncompressed variable
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_MAPPED_VARIABLE_H__
+#define _SOFA_MAPPED_VARIABLE_H__
+
+#include "../src/SOFANcFile.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          MappedVariable
+     *  @brief          Maps the storage of a variable in memory, read-only, without reading it
+     *
+     *  @details        A variable of a netCDF-4 file written without compression (contiguous
+     *                  storage) sits in the file as a flat array. Its location is found through
+     *                  HDF5, and the file is mapped in memory : nothing is read until the
+     *                  values are accessed, and the system pages them in on demand.
+     *
+     *                  When the variable is stored as float or double, in the byte order of the
+     *                  host, not packed, and aligned for its type in the file, the values are
+     *                  accessed in place through GetFloatView() or GetDoubleView(). Otherwise
+     *                  (other byte order, integer types, packed variables, or data left unaligned,
+     *                  as HDF5 does by default), GetValues() converts ranges of values while
+     *                  copying them.
+     *
+     *                  A variable can not be mapped if it is chunked (e.g. compressed), if the
+     *                  file is opened in memory or in write mode, or if libsofa was built without
+     *                  the HDF5 headers (SOFA_HDF5_DIRECT_CHUNK_READ not defined) : IsMapped()
+     *                  then returns false, and the values shall be read through the file.
+     *                  The mapping does not depend on the file object, which may be closed;
+     *                  the file on disk shall not be modified while it is mapped.
+     */
+    /************************************************************************************/
+    class SOFA_API MappedVariable
+    {
+    public:
+        MappedVariable(const sofa::NetCDFFile &file,
+                       const std::string &variableName);
+        
+        ~MappedVariable();
+        
+        bool IsMapped() const;
+        void Unmap();
+        
+        const std::string & GetVariableName() const;
+        const std::vector< std::size_t > & GetDimensions() const;
+        std::size_t GetNumElements() const;
+        
+        nc_type GetType() const;
+        std::size_t GetElementSize() const;
+        bool IsNativeByteOrder() const;
+        bool IsPacked() const;
+        unsigned long long GetFileOffset() const;
+        
+        const void * GetRawData() const;
+        
+        sofa::ArrayView< const double > GetDoubleView() const;
+        sofa::ArrayView< const float > GetFloatView() const;
+        
+        bool GetValues(double *values,
+                       const std::size_t firstElement,
+                       const std::size_t numElements) const;
+        
+        bool GetValues(float *values,
+                       const std::size_t firstElement,
+                       const std::size_t numElements) const;
+    
+    private:
+        //==============================================================================
+        bool locate(const sofa::NetCDFFile &file);
+        bool map(const std::string &path);
+        
+        template< typename T >
+        bool getValues(T *values,
+                       const std::size_t firstElement,
+                       const std::size_t numElements) const;
+    
+    private:
+        const std::string variableName;
+        std::vector< std::size_t > dims;
+        nc_type type;
+        std::size_t elementSize;
+        bool nativeByteOrder;
+        bool packed;
+        double scale;                       ///< CF packing, if packed
+        double offset;
+        unsigned long long fileOffset;      ///< location of the values in the file, in bytes
+        
+        void *mapping;                      ///< the mapped region, starting at a page boundary
+        std::size_t mappingSize;
+        const unsigned char *data;          ///< first byte of the values, within the mapped region
+        void *mappingHandle;                ///< Windows only : the file mapping object
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( MappedVariable );
+    };
+
+}
+
+#endif /* _SOFA_MAPPED_VARIABLE_H__ */
@@ -0,0 +1,139 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMemoryBuffer.cpp
+ *   @brief      Image of a SOFA file held in memory
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAMemoryBuffer.h"
+
+#include <cstring>
+
+using namespace sofa;
+
+namespace MemoryBufferHelper
+{
+    /// the signature of the superblock of any HDF5 (thus netCDF-4) file
+    static const unsigned char kHdf5Signature[8] = { 0x89, 'H', 'D', 'F', '\r', '\n', 0x1A, '\n' };
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      data : start of the file image
+ *  @param[in]      size : size of the file image, in bytes
+ *  @param[in]      name : name identifying the file (it is never opened)
+ *
+ */
+/************************************************************************************/
+MemoryBuffer::MemoryBuffer(const void *data_,
+                           const std::size_t size_,
+                           const std::string &name_)
+: data( data_ )
+, size( size_ )
+, name( name_ )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the start of the file image
+ *
+ */
+/************************************************************************************/
+const void * MemoryBuffer::GetData() const
+{
+    return data;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the size of the file image, in bytes
+ *
+ */
+/************************************************************************************/
+std::size_t MemoryBuffer::GetSize() const
+{
+    return size;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name identifying the file
+ *
+ */
+/************************************************************************************/
+const std::string & MemoryBuffer::GetName() const
+{
+    return name;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the image holds an HDF5 file, i.e. if the HDF5 signature
+ *                  is found at the start of the image, or after a user block (at 512,
+ *                  1024, 2048... bytes)
+ *
+ */
+/************************************************************************************/
+bool MemoryBuffer::HasHdf5Signature() const
+{
+    const std::size_t signatureSize = sizeof( MemoryBufferHelper::kHdf5Signature );
+    
+    if( data == NULL )
+    {
+        return false;
+    }
+    
+    for( std::size_t offset = 0; offset + signatureSize <= size; offset = ( offset == 0 ) ? 512 : offset * 2 )
+    {
+        if( std::memcmp( static_cast< const unsigned char * >( data ) + offset, MemoryBufferHelper::kHdf5Signature, signatureSize ) == 0 )
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
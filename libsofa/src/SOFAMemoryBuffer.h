@@ -0,0 +1,99 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMemoryBuffer.h
+ *   @brief      Image of a SOFA file held in memory
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_MEMORY_BUFFER_H__
+#define _SOFA_MEMORY_BUFFER_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          MemoryBuffer
+     *  @brief          Image of a SOFA file held in memory
+     *
+     *  @details        e.g. a file embedded in a binary, or received over IPC.
+     *                  The buffer is not copied : it shall remain valid and unchanged as long
+     *                  as a file opened from it is alive.
+     *                  Only netCDF-4 (i.e. HDF5) images can be opened, as any SOFA file.
+     *                  The name only identifies the file (e.g. in the error messages) : it is
+     *                  never opened.
+     */
+    /************************************************************************************/
+    class SOFA_API MemoryBuffer
+    {
+    public:
+        MemoryBuffer(const void *data,
+                     const std::size_t size,
+                     const std::string &name = "memory");
+        
+        ~MemoryBuffer() {};
+        
+        const void * GetData() const;
+        std::size_t GetSize() const;
+        const std::string & GetName() const;
+        
+        bool HasHdf5Signature() const;
+    
+    private:
+        const void *data;
+        const std::size_t size;
+        const std::string name;     ///< identifies the file (never opened)
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( MemoryBuffer );
+    };
+
+}
+
+#endif /* _SOFA_MEMORY_BUFFER_H__ */
+
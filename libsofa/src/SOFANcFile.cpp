@@ -50,22 +50,304 @@ http://www.sofaconventions.org
 #include "../src/SOFANcUtils.h"
 #include "../src/SOFAUtils.h"
 #include "../src/SOFAString.h"
+#include "../src/SOFAExceptions.h"
+#include "netcdf_meta.h"
+#include <cstdio>
+#include <cstdlib>
+
+#if( SOFA_WINDOWS == 1 )
+    #include <io.h>
+    #include <fcntl.h>
+    #include <share.h>
+    #include <sys/stat.h>
+#else
+    #include <unistd.h>
+#endif
 
 using namespace sofa;
 
+namespace NcFileHelper
+{
+#if( NC_VERSION_MAJOR == 4 && NC_VERSION_MINOR < 5 )
+    /************************************************************************************/
+    /*!
+     *  @brief          netCDF-C prior to 4.5.0 (e.g. the bundled 4.4.1) detects the format of
+     *                  an in-memory file by reading the first bytes of the file named after it,
+     *                  rather than the buffer. This file holds only the HDF5 signature : it is
+     *                  created once per process, with a unique name and exclusively (an
+     *                  existing file or link is never opened), and stands for all the buffers
+     *                  (the data itself is always read from memory)
+     *
+     */
+    /************************************************************************************/
+    class FormatProbe
+    {
+    public:
+        FormatProbe()
+        {
+            static const unsigned char signature[8] = { 0x89, 'H', 'D', 'F', '\r', '\n', 0x1A, '\n' };
+    
+    #if( SOFA_WINDOWS == 1 )
+            const char *folder = std::getenv( "TEMP" );
+    #else
+            const char *folder = std::getenv( "TMPDIR" );
+    #endif
+            const std::string temporaryFolder = ( folder != NULL && folder[0] != '\0' ) ? folder : "/tmp";
+            const std::string pattern         = temporaryFolder + "/libsofa_hdf5_signature_XXXXXX";
+            
+            std::vector< char > name;
+            int fd = -1;
+    
+    #if( SOFA_WINDOWS == 1 )
+            /// _mktemp_s only picks a name : _O_EXCL makes the creation fail if it exists
+            for( int attempt = 0; attempt < 26 && fd < 0; attempt++ )
+            {
+                name.assign( pattern.begin(), pattern.end() );
+                name.push_back( '\0' );
+                
+                if( _mktemp_s( &name[0], name.size() ) != 0
+                   || _sopen_s( &fd, &name[0], _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE ) != 0 )
+                {
+                    fd = -1;
+                }
+            }
+            
+            const bool written = ( fd >= 0 && _write( fd, signature, sizeof( signature ) ) == (int) sizeof( signature ) );
+            
+            if( fd >= 0 )
+            {
+                _close( fd );
+            }
+    #else
+            name.assign( pattern.begin(), pattern.end() );
+            name.push_back( '\0' );
+            
+            fd = mkstemp( &name[0] );
+            
+            const bool written = ( fd >= 0 && write( fd, signature, sizeof( signature ) ) == (ssize_t) sizeof( signature ) );
+            
+            if( fd >= 0 )
+            {
+                close( fd );
+            }
+    #endif
+            
+            if( written == true )
+            {
+                path = &name[0];
+            }
+            else if( fd >= 0 )
+            {
+                std::remove( &name[0] );
+            }
+        }
+        
+        ~FormatProbe()
+        {
+            if( path.empty() == false )
+            {
+                std::remove( path.c_str() );
+            }
+        }
+        
+        std::string path;           ///< empty if the probe could not be written
+    };
+#endif
+    
+    /// the name given to nc_open_mem : netCDF never opens it, except for detecting the format (see above)
+    static std::string getOpenName(const sofa::MemoryBuffer &buffer)
+    {
+        if( buffer.HasHdf5Signature() == false )
+        {
+            SOFA_THROW( "not a netCDF-4 file image : " + buffer.GetName() );
+        }
+
+#if( NC_VERSION_MAJOR == 4 && NC_VERSION_MINOR < 5 )
+        static const FormatProbe probe;
+        
+        if( probe.path.empty() == true )
+        {
+            SOFA_THROW( "could not create the format probe of the in-memory files, in the temporary folder" );
+        }
+        
+        return probe.path;
+#else
+        return buffer.GetName();
+#endif
+    }
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Class constructor
  *  @param[in]      path : the file path
  *  @param[in]      mode : opening mode
+ *  @param[in]      options : chunk cache settings of the variables
  *
  */
 /************************************************************************************/
 NetCDFFile::NetCDFFile(const std::string & path,
-                       const netCDF::NcFile::FileMode &mode)
-: file( path, mode )
+                       const netCDF::NcFile::FileMode &mode,
+                       const sofa::OpenOptions &options)
+: ownFile( path, mode )
+, file( ownFile )
 , filename( path )
+, inMemory( false )
+, hasIndex( false )
+, ownMetadata( ownFile, mode == netCDF::NcFile::read )
+, metadata( ownMetadata )
+{
+    if( mode == netCDF::NcFile::read )
+    {
+        buildIndex();
+    }
+    
+    applyOpenOptions( options );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : opens, read-only, the image of a file held in memory
+ *  @param[in]      buffer : the file image; it is not copied, and must outlive this object
+ *  @param[in]      options : chunk cache settings of the variables
+ *
+ */
+/************************************************************************************/
+NetCDFFile::NetCDFFile(const sofa::MemoryBuffer &buffer,
+                       const sofa::OpenOptions &options)
+: ownFile( NcFileHelper::getOpenName( buffer ), buffer.GetData(), buffer.GetSize() )
+, file( ownFile )
+, filename( buffer.GetName() )
+, inMemory( true )
+, hasIndex( false )
+, ownMetadata( ownFile, true )
+, metadata( ownMetadata )
+{
+    buildIndex();
+    
+    applyOpenOptions( options );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor sharing the handle of a file already opened.
+ *                  The handle, the lookup tables and the metadata snapshot of the shared
+ *                  file are reused, so nothing is read from the file.
+ *  @param[in]      sharedFile : the file to share; it must outlive this object
+ *
+ */
+/************************************************************************************/
+NetCDFFile::NetCDFFile(const sofa::NetCDFFile *sharedFile)
+: ownFile()
+, file( sharedFile->file )
+, filename( sharedFile->filename )
+, inMemory( sharedFile->inMemory )
+, hasIndex( sharedFile->hasIndex )
+, attributesIndex( sharedFile->attributesIndex )
+, dimensionsIndex( sharedFile->dimensionsIndex )
+, variablesIndex( sharedFile->variablesIndex )
+, ownMetadata()
+, metadata( sharedFile->metadata )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Builds the name -> object lookup tables of the attributes, dimensions
+ *                  and variables of the file. Each lookup is then a simple map search,
+ *                  instead of enumerating the whole content of the file through netCDF
+ *
+ */
+/************************************************************************************/
+void NetCDFFile::buildIndex()
+{
+    attributesIndex.clear();
+    dimensionsIndex.clear();
+    variablesIndex.clear();
+    
+    if( sofa::NcUtils::IsValid( file ) == false )
+    {
+        hasIndex = false;
+        return;
+    }
+    
+    const std::multimap< std::string, netCDF::NcGroupAtt > attributes = file.getAtts();
+    attributesIndex.insert( attributes.begin(), attributes.end() );
+    
+    const std::multimap< std::string, netCDF::NcDim > dims = file.getDims();
+    dimensionsIndex.insert( dims.begin(), dims.end() );
+    
+    const std::multimap< std::string, netCDF::NcVar > vars = file.getVars();
+    variablesIndex.insert( vars.begin(), vars.end() );
+    
+    hasIndex = true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Applies the chunk cache settings to all the chunked variables of the file
+ *  @param[in]      options : chunk cache settings
+ *
+ *  @details        The cache of a variable is attached to its HDF5 dataset : the settings
+ *                  then apply to every object sharing this file handle.
+ *                  Contiguous variables, and netCDF-3 files, have no chunk cache and are
+ *                  left untouched
+ */
+/************************************************************************************/
+void NetCDFFile::applyOpenOptions(const sofa::OpenOptions &options)
 {
+    if( options.IsDefault() == true || sofa::NcUtils::IsValid( file ) == false )
+    {
+        return;
+    }
+    
+    const int ncid = file.getId();
+    
+    const std::multimap< std::string, netCDF::NcVar > vars = file.getVars();
+    
+    for( std::multimap< std::string, netCDF::NcVar >::const_iterator it = vars.begin();
+        it != vars.end();
+        ++it )
+    {
+        const netCDF::NcVar & var = it->second;
+        const int varid = var.getId();
+        
+        const int numDims = var.getDimCount();
+        
+        int storage = NC_CONTIGUOUS;
+        std::vector< std::size_t > chunkSizes( sofa::smax( numDims, 1 ), 0 );
+        
+        if( nc_inq_var_chunking( ncid, varid, &storage, &chunkSizes[0] ) != NC_NOERR
+           || storage != NC_CHUNKED )
+        {
+            continue;
+        }
+        
+        std::size_t size       = 0;
+        std::size_t numSlots   = 0;
+        float preemption       = 0.0f;
+        
+        if( nc_get_var_chunk_cache( ncid, varid, &size, &numSlots, &preemption ) != NC_NOERR )
+        {
+            continue;
+        }
+        
+        const std::size_t typeSize = var.getType().getSize();
+        const std::vector< netCDF::NcDim > dims = var.getDims();
+        
+        std::size_t variableSize = typeSize;
+        std::size_t chunkSize    = typeSize;
+        
+        for( int i = 0; i < numDims; i++ )
+        {
+            variableSize *= dims[i].getSize();
+            chunkSize    *= chunkSizes[i];
+        }
+        
+        options.GetChunkCacheParameters( size, numSlots, preemption, variableSize, chunkSize );
+        
+        nc_set_var_chunk_cache( ncid, varid, size, numSlots, preemption );
+    }
 }
 
 /************************************************************************************/
@@ -90,6 +372,30 @@ const std::string & NetCDFFile::GetFilename() const
     return filename;
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Returns the snapshot of the metadata of the file, loaded when the file
+ *                  was opened (in read mode only; otherwise the snapshot is not loaded)
+ *
+ */
+/************************************************************************************/
+const sofa::NcMetadata & NetCDFFile::GetMetadata() const
+{
+    return metadata;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the file was opened from an image held in memory
+ *                  (the filename then does not necessarily refer to this file)
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::IsInMemory() const
+{
+    return inMemory;
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Returns the names of all attributes
@@ -98,6 +404,20 @@ const std::string & NetCDFFile::GetFilename() const
 /************************************************************************************/
 void NetCDFFile::GetAllAttributesNames(std::vector< std::string > &attributeNames) const
 {        
+    if( metadata.IsLoaded() == true )
+    {
+        const std::vector< sofa::NcMetadata::Attribute > & attributes = metadata.GetAttributes();
+        
+        attributeNames.resize( attributes.size() );
+        
+        for( std::size_t i = 0; i < attributes.size(); i++ )
+        {
+            attributeNames[ i ] = attributes[i].name;
+        }
+        
+        return;
+    }
+    
     const std::multimap< std::string, netCDF::NcGroupAtt > attributes = file.getAtts();
     
     const std::size_t size = attributes.size();
@@ -129,6 +449,22 @@ void NetCDFFile::GetAllCharAttributes(std::vector< std::string > &attributeNames
     attributeNames.clear();
     attributeValues.clear();
     
+    if( metadata.IsLoaded() == true )
+    {
+        const std::vector< sofa::NcMetadata::Attribute > & attributes = metadata.GetAttributes();
+        
+        for( std::size_t i = 0; i < attributes.size(); i++ )
+        {
+            if( attributes[i].type == NC_CHAR )
+            {
+                attributeNames.push_back( attributes[i].name );
+                attributeValues.push_back( attributes[i].value );
+            }
+        }
+        
+        return;
+    }
+    
     const std::multimap< std::string, netCDF::NcGroupAtt > attributes = file.getAtts();
     
     for( std::multimap< std::string, netCDF::NcGroupAtt >::const_iterator it = attributes.begin();
@@ -188,6 +524,20 @@ void NetCDFFile::PrintAllAttributes(std::ostream & output,
 /************************************************************************************/
 void NetCDFFile::GetAllDimensionsNames(std::vector< std::string > &dimensionNames) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const std::vector< sofa::NcMetadata::Dimension > & dims = metadata.GetDimensions();
+        
+        dimensionNames.resize( dims.size() );
+        
+        for( std::size_t i = 0; i < dims.size(); i++ )
+        {
+            dimensionNames[i] = dims[i].name;
+        }
+        
+        return;
+    }
+    
     const std::multimap< std::string, netCDF::NcDim > dims = file.getDims();
     
     const std::size_t size = dims.size();
@@ -213,6 +563,18 @@ void NetCDFFile::GetAllDimensionsNames(std::vector< std::string > &dimensionName
 /************************************************************************************/
 void NetCDFFile::PrintAllDimensions(std::ostream & output) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const std::vector< sofa::NcMetadata::Dimension > & dims = metadata.GetDimensions();
+        
+        for( std::size_t i = 0; i < dims.size(); i++ )
+        {
+            output << dims[i].name << " = " << dims[i].size << std::endl;
+        }
+        
+        return;
+    }
+    
     const std::multimap< std::string, netCDF::NcDim > dims = file.getDims();
     
     for( std::multimap< std::string, netCDF::NcDim >::const_iterator it = dims.begin();
@@ -238,6 +600,20 @@ void NetCDFFile::PrintAllDimensions(std::ostream & output) const
 /************************************************************************************/
 void NetCDFFile::GetAllVariablesNames(std::vector< std::string > &variableNames) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const std::vector< sofa::NcMetadata::Variable > & vars = metadata.GetVariables();
+        
+        variableNames.resize( vars.size() );
+        
+        for( std::size_t i = 0; i < vars.size(); i++ )
+        {
+            variableNames[i] = vars[i].name;
+        }
+        
+        return;
+    }
+    
     const std::multimap< std::string, netCDF::NcVar > vars = file.getVars();
     
     const std::size_t size = vars.size();
@@ -264,16 +640,15 @@ void NetCDFFile::GetAllVariablesNames(std::vector< std::string > &variableNames)
 void NetCDFFile::PrintAllVariables(std::ostream & output) const
 {
     /// retrieves all the variables
-    const std::multimap< std::string, netCDF::NcVar > vars = file.getVars();
+    std::vector< std::string > variableNames;
+    GetAllVariablesNames( variableNames );
     
-    for( std::multimap< std::string, netCDF::NcVar >::const_iterator it = vars.begin();
-        it != vars.end();
-        ++it )
+    for( std::size_t i = 0; i < variableNames.size(); i++ )
     {
-        const std::string varName       = (*it).first;
+        const std::string varName       = variableNames[i];
         
         std::vector< std::size_t > dimensions;
-        GetVariableDimensions( dimensions, varName ),
+        GetVariableDimensions( dimensions, varName );
         
         output << varName << " = " << "(";
         
@@ -300,6 +675,11 @@ void NetCDFFile::PrintAllVariables(std::ostream & output) const
 /************************************************************************************/
 unsigned int NetCDFFile::GetNumGlobalAttributes() const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        return (unsigned int) metadata.GetAttributes().size();
+    }
+    
     const int nattr = file.getAttCount();
     
     return (unsigned int) sofa::smax( (int) 0 , nattr );
@@ -313,6 +693,11 @@ unsigned int NetCDFFile::GetNumGlobalAttributes() const
 /************************************************************************************/
 unsigned int NetCDFFile::GetNumDimensions() const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        return (unsigned int) metadata.GetDimensions().size();
+    }
+    
     const int ndims = file.getDimCount();
     
     return (unsigned int) sofa::smax( (int) 0 , ndims );
@@ -326,6 +711,11 @@ unsigned int NetCDFFile::GetNumDimensions() const
 /************************************************************************************/
 unsigned int NetCDFFile::GetNumVariables() const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        return (unsigned int) metadata.GetVariables().size();
+    }
+    
     const int nvars = file.getVarCount();
     
     return (unsigned int) sofa::smax( (int) 0 , nvars );
@@ -340,13 +730,20 @@ unsigned int NetCDFFile::GetNumVariables() const
 /************************************************************************************/
 std::size_t NetCDFFile::GetDimension(const std::string &dimensionName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Dimension * dim = metadata.FindDimension( dimensionName );
+        
+        return ( dim != NULL ) ? dim->size : 0;
+    }
+    
     if( HasDimension( dimensionName ) == false )
     {
         return 0;
     }
     else
     {
-        const netCDF::NcDim dim = file.getDim( dimensionName );
+        const netCDF::NcDim dim = getDimension( dimensionName );
         return dim.getSize();
     }
 }
@@ -360,6 +757,11 @@ std::size_t NetCDFFile::GetDimension(const std::string &dimensionName) const
 /************************************************************************************/
 bool NetCDFFile::HasDimension(const std::string &dimensionName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        return ( metadata.FindDimension( dimensionName ) != NULL );
+    }
+    
     const netCDF::NcDim dim = getDimension( dimensionName );
     
     return sofa::NcUtils::IsValid( dim );
@@ -374,6 +776,11 @@ bool NetCDFFile::HasDimension(const std::string &dimensionName) const
 /************************************************************************************/
 bool NetCDFFile::HasVariable(const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        return ( metadata.FindVariable( variableName ) != NULL );
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     
     return sofa::NcUtils::IsValid( var );
@@ -389,6 +796,13 @@ bool NetCDFFile::HasVariable(const std::string &variableName) const
 /************************************************************************************/
 netCDF::NcType NetCDFFile::GetAttributeType(const std::string &attributeName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Attribute * att = metadata.FindAttribute( attributeName );
+        
+        return ( att != NULL ) ? netCDF::NcType( att->type ) : netCDF::NcType();
+    }
+    
     const netCDF::NcGroupAtt att = getAttribute( attributeName );
     
     return sofa::NcUtils::GetType( att );
@@ -404,6 +818,13 @@ netCDF::NcType NetCDFFile::GetAttributeType(const std::string &attributeName) co
 /************************************************************************************/
 int NetCDFFile::GetVariableDimensionality(const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        return ( var != NULL ) ? (int) var->dimensions.size() : -1;
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     return sofa::NcUtils::GetDimensionality( var );
 }
@@ -482,6 +903,22 @@ std::string NetCDFFile::GetVariableDimensionsAsString(const std::string &variabl
 /************************************************************************************/
 void NetCDFFile::GetVariableDimensionsNames(std::vector< std::string > &dims, const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        if( var != NULL )
+        {
+            dims = var->dimensionsNames;
+        }
+        else
+        {
+            dims.clear();
+        }
+        
+        return;
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     sofa::NcUtils::GetDimensionsNames( dims, var );
 }
@@ -496,10 +933,53 @@ void NetCDFFile::GetVariableDimensionsNames(std::vector< std::string > &dims, co
 /************************************************************************************/
 void NetCDFFile::GetVariableDimensions(std::vector< std::size_t > &dims, const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        if( var != NULL )
+        {
+            dims = var->dimensions;
+        }
+        else
+        {
+            dims.clear();
+        }
+        
+        return;
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     sofa::NcUtils::GetDimensions( dims, var );    
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of elements of a named variable (i.e. the product of
+ *                  its dimensions). Returns 0 if the variable does not exist or has no dimension
+ *
+ */
+/************************************************************************************/
+std::size_t NetCDFFile::GetVariableNumElements(const std::string &variableName) const
+{
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        if( var == NULL || var->dimensions.empty() == true )
+        {
+            return 0;
+        }
+        
+        return sofa::NcUtils::GetNumElements( var->dimensions );
+    }
+    
+    std::vector< std::size_t > dims;
+    GetVariableDimensions( dims, variableName );
+    
+    return ( dims.empty() == true ) ? 0 : sofa::NcUtils::GetNumElements( dims );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Returns true if a given variable is a scalar (i.e. dimensionality = 1 and dimension = 1)
@@ -509,6 +989,13 @@ void NetCDFFile::GetVariableDimensions(std::vector< std::size_t > &dims, const s
 /************************************************************************************/
 bool NetCDFFile::VariableIsScalar(const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        return ( var != NULL && var->dimensions.size() == 1 && var->dimensions[0] == 1 );
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     return sofa::NcUtils::IsScalar( var );
 }
@@ -523,6 +1010,20 @@ bool NetCDFFile::VariableIsScalar(const std::string &variableName) const
 /************************************************************************************/
 netCDF::NcType NetCDFFile::GetVariableType(const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        if( var == NULL )
+        {
+            return netCDF::NcType();
+        }
+        else if( var->type <= NC_MAX_ATOMIC_TYPE )
+        {
+            return netCDF::NcType( var->type );
+        }
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     return sofa::NcUtils::GetType( var );
 }
@@ -536,6 +1037,13 @@ netCDF::NcType NetCDFFile::GetVariableType(const std::string &variableName) cons
 /************************************************************************************/
 std::string NetCDFFile::GetVariableTypeName(const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        return ( var != NULL ) ? var->typeName : std::string();
+    }
+    
     const netCDF::NcType type_ = GetVariableType( variableName );
     return type_.getName();
 }
@@ -544,7 +1052,21 @@ std::string NetCDFFile::GetVariableTypeName(const std::string &variableName) con
 bool NetCDFFile::VariableHasDimension(const std::size_t dim,
                                       const std::string &variableName) const
 {
-    const netCDF::NcVar var = getVariable( variableName );
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        if( var == NULL || var->dimensions.size() != 1 )
+        {
+            return false;
+        }
+        
+        const std::vector< std::size_t > & dims = var->dimensions;
+        
+        return ( dims[0] == dim );
+    }
+    
+    const netCDF::NcVar var = getVariable( variableName );
     return sofa::NcUtils::HasDimension( dim, var );    
 }
 
@@ -552,6 +1074,20 @@ bool NetCDFFile::VariableHasDimensions(const std::size_t dim1,
                                        const std::size_t dim2,
                                        const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        if( var == NULL || var->dimensions.size() != 2 )
+        {
+            return false;
+        }
+        
+        const std::vector< std::size_t > & dims = var->dimensions;
+        
+        return ( dims[0] == dim1 && dims[1] == dim2 );
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     return sofa::NcUtils::HasDimensions( dim1, dim2, var );    
 }
@@ -561,6 +1097,20 @@ bool NetCDFFile::VariableHasDimensions(const std::size_t dim1,
                                        const std::size_t dim3,
                                        const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        if( var == NULL || var->dimensions.size() != 3 )
+        {
+            return false;
+        }
+        
+        const std::vector< std::size_t > & dims = var->dimensions;
+        
+        return ( dims[0] == dim1 && dims[1] == dim2 && dims[2] == dim3 );
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     return sofa::NcUtils::HasDimensions( dim1, dim2, dim3, var );
 }
@@ -571,6 +1121,20 @@ bool NetCDFFile::VariableHasDimensions(const std::size_t dim1,
                                        const std::size_t dim4,
                                        const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        if( var == NULL || var->dimensions.size() != 4 )
+        {
+            return false;
+        }
+        
+        const std::vector< std::size_t > & dims = var->dimensions;
+        
+        return ( dims[0] == dim1 && dims[1] == dim2 && dims[2] == dim3 && dims[3] == dim4 );
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     return sofa::NcUtils::HasDimensions( dim1, dim2, dim3, dim4, var );
 }
@@ -585,10 +1149,48 @@ bool NetCDFFile::VariableHasDimensions(const std::size_t dim1,
 /************************************************************************************/
 bool NetCDFFile::VariableHasAttribute(const std::string &attributeName, const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        return ( var != NULL && var->FindAttribute( attributeName ) != NULL );
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     return sofa::NcUtils::HasAttribute( var, attributeName );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Returns the CF packing parameters of a named variable : values are
+ *                  unpacked as stored * scale + offset.
+ *                  Returns false if the variable is not packed (scale = 1, offset = 0)
+ *  @param[out]     scale : the scale_factor attribute, or 1
+ *  @param[out]     offset : the add_offset attribute, or 0
+ *  @param[in]      variableName
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetVariablePacking(double &scale, double &offset, const std::string &variableName) const
+{
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        if( var != NULL )
+        {
+            scale  = var->scale;
+            offset = var->offset;
+            
+            return var->packed;
+        }
+    }
+    
+    const netCDF::NcVar var = getVariable( variableName );
+    
+    return sofa::NcUtils::GetPackingParameters( scale, offset, var );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the names of all attributes of a named variable
@@ -599,6 +1201,25 @@ bool NetCDFFile::VariableHasAttribute(const std::string &attributeName, const st
 void NetCDFFile::GetVariablesAttributes(std::vector< std::string > &attributeNames,
                                         const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        attributeNames.clear();
+        
+        if( var != NULL )
+        {
+            attributeNames.resize( var->attributes.size() );
+            
+            for( std::size_t i = 0; i < var->attributes.size(); i++ )
+            {
+                attributeNames[i] = var->attributes[i].name;
+            }
+        }
+        
+        return;
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     
     if( sofa::NcUtils::IsValid( var ) == true )
@@ -635,6 +1256,28 @@ void NetCDFFile::GetVariablesAttributes(std::vector< std::string > &attributeNam
                                         std::vector< std::string > &attributeValues,
                                         const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        attributeNames.clear();
+        attributeValues.clear();
+        
+        if( var != NULL )
+        {
+            attributeNames.resize( var->attributes.size() );
+            attributeValues.resize( var->attributes.size() );
+            
+            for( std::size_t i = 0; i < var->attributes.size(); i++ )
+            {
+                attributeNames[i]  = var->attributes[i].name;
+                attributeValues[i] = var->attributes[i].value;
+            }
+        }
+        
+        return;
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     
     if( sofa::NcUtils::IsValid( var ) == true )
@@ -677,6 +1320,13 @@ void NetCDFFile::GetVariablesAttributes(std::vector< std::string > &attributeNam
 /************************************************************************************/
 bool NetCDFFile::HasVariableType(const netCDF::NcType &type_, const std::string &variableName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+        
+        return ( var != NULL && netCDF::NcType( var->type ) == type_ );
+    }
+    
     const netCDF::NcVar var = getVariable( variableName );
     return sofa::NcUtils::CheckType( var, type_ );    
 }
@@ -690,6 +1340,11 @@ bool NetCDFFile::HasVariableType(const netCDF::NcType &type_, const std::string
 /************************************************************************************/
 bool NetCDFFile::HasAttribute(const std::string & attributeName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        return ( metadata.FindAttribute( attributeName ) != NULL );
+    }
+    
     const netCDF::NcGroupAtt att = getAttribute( attributeName );
     
     return sofa::NcUtils::IsValid( att );
@@ -705,12 +1360,19 @@ bool NetCDFFile::HasAttribute(const std::string & attributeName) const
 /************************************************************************************/
 std::string NetCDFFile::GetAttributeValueAsString(const std::string &attributeName) const
 {
+    if( metadata.IsLoaded() == true )
+    {
+        const sofa::NcMetadata::Attribute * att = metadata.FindAttribute( attributeName );
+        
+        return ( att != NULL ) ? att->value : std::string();
+    }
+    
     if( HasAttribute( attributeName ) == false )
     {
         return std::string();
     }
     
-    const netCDF::NcGroupAtt att = file.getAtt( attributeName );
+    const netCDF::NcGroupAtt att = getAttribute( attributeName );
     
     return sofa::NcUtils::GetAttributeValueAsString( att );
 }
@@ -731,28 +1393,25 @@ netCDF::NcGroupAtt NetCDFFile::getAttribute(const std::string &attributeName) co
         return netCDF::NcGroupAtt();
     }
     
-    const std::multimap< std::string, netCDF::NcGroupAtt > attributes = file.getAtts();
-    
-    for( std::multimap< std::string, netCDF::NcGroupAtt >::const_iterator it = attributes.begin();
-        it != attributes.end();
-        ++it )
+    if( hasIndex == true )
     {
-        const std::string attrName      = (*it).first;
+        const AttributesIndex::const_iterator it = attributesIndex.find( attributeName );
         
-        if( attrName == attributeName )
+        if( it != attributesIndex.end() )
         {
-            const netCDF::NcGroupAtt att    = (*it).second;
-            
-            return att;
+            return (*it).second;
         }
+        
+        /// returns a null object
+        return netCDF::NcGroupAtt();
     }
     
-    return netCDF::NcGroupAtt();
+    return file.getAtt( attributeName );
 }
 
 /************************************************************************************/
 /*!
- *  @brief          Retrieves a variable given its name;
+ *  @brief          Retrieves a dimension given its name;
  *                  Returns a null object in case the variable is not found or any error occured.
  *  @param[in]      dimensionName
  *
@@ -766,24 +1425,20 @@ netCDF::NcDim NetCDFFile::getDimension(const std::string &dimensionName) const
         return netCDF::NcDim();
     }
     
-    const std::multimap< std::string, netCDF::NcDim > dims = file.getDims();
-    
-    for( std::multimap< std::string, netCDF::NcDim >::const_iterator it = dims.begin();
-        it != dims.end();
-        ++it )
+    if( hasIndex == true )
     {
-        const std::string dimName = (*it).first;
+        const DimensionsIndex::const_iterator it = dimensionsIndex.find( dimensionName );
         
-        if( dimName == dimensionName )
+        if( it != dimensionsIndex.end() )
         {
-            const netCDF::NcDim dim   = (*it).second;
-            return dim;
+            return (*it).second;
         }
         
+        /// returns a null object
+        return netCDF::NcDim();
     }
     
-    /// returns a null object
-    return netCDF::NcDim();
+    return file.getDim( dimensionName );
 }
 
 /************************************************************************************/
@@ -802,23 +1457,20 @@ netCDF::NcVar NetCDFFile::getVariable(const std::string &variableName) const
         return netCDF::NcVar();
     }
     
-    const std::multimap< std::string, netCDF::NcVar > vars = file.getVars();
-    
-    for( std::multimap< std::string, netCDF::NcVar >::const_iterator it = vars.begin();
-        it != vars.end();
-        ++it )
+    if( hasIndex == true )
     {
-        const std::string varName       = (*it).first;
+        const VariablesIndex::const_iterator it = variablesIndex.find( variableName );
         
-        if( varName == variableName )
+        if( it != variablesIndex.end() )
         {
-            const netCDF::NcVar var         = (*it).second;
-            return var;
+            return (*it).second;
         }
+        
+        /// returns a null object
+        return netCDF::NcVar();
     }
     
-    /// returns a null object
-    return netCDF::NcVar();
+    return file.getVar( variableName );
 }
 
 
@@ -833,8 +1485,7 @@ netCDF::NcVar NetCDFFile::getVariable(const std::string &variableName) const
 /************************************************************************************/
 bool NetCDFFile::IsAttributeFloat(const std::string &attributeName) const
 {
-    const netCDF::NcGroupAtt attr = getAttribute( attributeName );
-    return sofa::NcUtils::IsFloat( attr );
+    return hasAttributeType( netCDF::NcType::nc_FLOAT, attributeName );
 }
 
 /************************************************************************************/
@@ -848,8 +1499,7 @@ bool NetCDFFile::IsAttributeFloat(const std::string &attributeName) const
 /************************************************************************************/
 bool NetCDFFile::IsAttributeDouble(const std::string &attributeName) const
 {
-    const netCDF::NcGroupAtt attr = getAttribute( attributeName );
-    return sofa::NcUtils::IsDouble( attr );
+    return hasAttributeType( netCDF::NcType::nc_DOUBLE, attributeName );
 }
 
 /************************************************************************************/
@@ -863,8 +1513,7 @@ bool NetCDFFile::IsAttributeDouble(const std::string &attributeName) const
 /************************************************************************************/
 bool NetCDFFile::IsAttributeByte(const std::string &attributeName) const
 {
-    const netCDF::NcGroupAtt attr = getAttribute( attributeName );
-    return sofa::NcUtils::IsByte( attr );
+    return hasAttributeType( netCDF::NcType::nc_BYTE, attributeName );
 }
 
 /************************************************************************************/
@@ -878,8 +1527,7 @@ bool NetCDFFile::IsAttributeByte(const std::string &attributeName) const
 /************************************************************************************/
 bool NetCDFFile::IsAttributeChar(const std::string &attributeName) const
 {
-    const netCDF::NcGroupAtt attr = getAttribute( attributeName );
-    return sofa::NcUtils::IsChar( attr );
+    return hasAttributeType( netCDF::NcType::nc_CHAR, attributeName );
 }
 
 /************************************************************************************/
@@ -893,8 +1541,7 @@ bool NetCDFFile::IsAttributeChar(const std::string &attributeName) const
 /************************************************************************************/
 bool NetCDFFile::IsAttributeShort(const std::string &attributeName) const
 {
-    const netCDF::NcGroupAtt attr = getAttribute( attributeName );
-    return sofa::NcUtils::IsShort( attr );
+    return hasAttributeType( netCDF::NcType::nc_SHORT, attributeName );
 }
 
 /************************************************************************************/
@@ -908,8 +1555,7 @@ bool NetCDFFile::IsAttributeShort(const std::string &attributeName) const
 /************************************************************************************/
 bool NetCDFFile::IsAttributeInt(const std::string &attributeName) const
 {
-    const netCDF::NcGroupAtt attr = getAttribute( attributeName );
-    return sofa::NcUtils::IsInt( attr );
+    return hasAttributeType( netCDF::NcType::nc_INT, attributeName );
 }
 
 /************************************************************************************/
@@ -923,180 +1569,976 @@ bool NetCDFFile::IsAttributeInt(const std::string &attributeName) const
 /************************************************************************************/
 bool NetCDFFile::IsAttributeInt64(const std::string &attributeName) const
 {
-    const netCDF::NcGroupAtt attr = getAttribute( attributeName );
-    return sofa::NcUtils::IsInt64( attr );
+    return hasAttributeType( netCDF::NcType::nc_INT64, attributeName );
 }
 
 /************************************************************************************/
 /*!
- *  @brief          Reads values of variable stored as a 2-dimensional array of double
- *                  Returns true if everything goes well, false otherwise (not a valid variable,
- *                  not a double variable, not the proper dimensions)
- *  @param[out]     values :
- *  @param[in]      variableName : the named variable to query
- *  @param[in]      dim1 : first dimension of the array
- *  @param[in]      dim2 : second dimension of the array
+ *  @brief          Checks if a given attribute has a given NcType, given its name.
+ *                  Returns false if the type does not match or if the attribute does not exist
+ *  @param[in]      type_
+ *  @param[in]      attributeName : name of the attribute to query
  *
  */
 /************************************************************************************/
-bool NetCDFFile::GetValues(double *values,
-                           const std::size_t dim1,
-                           const std::size_t dim2,
-                           const std::string &variableName) const
+bool NetCDFFile::hasAttributeType(const netCDF::NcType &type_, const std::string &attributeName) const
 {
-    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
-    
-    if( sofa::NcUtils::IsValid( var ) == false )
-    {
-        return false;
-    }
-    
-    if( sofa::NcUtils::IsDouble( var ) == false )
-    {
-        return false;
-    }
-    
-    if( sofa::NcUtils::HasDimensions( dim1, dim2, var ) == false )
+    if( metadata.IsLoaded() == true )
     {
-        return false;
+        const sofa::NcMetadata::Attribute * att = metadata.FindAttribute( attributeName );
+        
+        return ( att != NULL && netCDF::NcType( att->type ) == type_ );
     }
     
-    var.getVar( values );
-    
-    return true;
+    const netCDF::NcGroupAtt attr = getAttribute( attributeName );
+    return sofa::NcUtils::CheckType( attr, type_ );
 }
 
-
 /************************************************************************************/
 /*!
- *  @brief          Reads values of variable stored as a 3-dimensional array of double
- *                  Returns true if everything goes well, false otherwise (not a valid variable,
- *                  not a double variable, not the proper dimensions)
- *  @param[out]     values :
- *  @param[in]      variableName : the named variable to query
- *  @param[in]      dim1 : first dimension of the array
- *  @param[in]      dim2 : second dimension of the array
- *  @param[in]      dim3 : third dimension of the array
+ *  @brief          Helpers shared by the reading methods, for all the output types.
+ *                  The variable may be stored with any numeric type : the conversion
+ *                  (if any) is performed by the netCDF library while reading (e.g.
+ *                  nc_get_vara_double), except for packed variables (CF scale_factor
+ *                  and add_offset attributes) which are read with their stored type,
+ *                  then unpacked and converted in one pass (sofa::NcUtils::UnpackValues)
  *
  */
 /************************************************************************************/
-bool NetCDFFile::GetValues(double *values,
-                           const std::size_t dim1,
-                           const std::size_t dim2,
-                           const std::size_t dim3,
-                           const std::string &variableName) const
+namespace NcFileHelper
 {
-    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
-    
-    if( sofa::NcUtils::IsValid( var ) == false )
+    /// the CF packing parameters of a variable, looked up once per read
+    /// (from the metadata snapshot, when it is loaded)
+    struct Packing
     {
-        return false;
-    }
+        Packing(const sofa::NetCDFFile &file, const std::string &variableName)
+        : scale( 1.0 )
+        , offset( 0.0 )
+        , packed( file.GetVariablePacking( scale, offset, variableName ) )
+        {
+        }
+        
+        double scale;
+        double offset;
+        bool packed;
+    };
     
-    if( sofa::NcUtils::IsDouble( var ) == false )
+    template< typename T >
+    void getVar(T *values,
+                const std::vector< std::size_t > &start,
+                const std::vector< std::size_t > &count,
+                const std::vector< std::ptrdiff_t > &stride,
+                const netCDF::NcVar &var)
     {
-        return false;
+        if( sofa::NcUtils::IsUnitStride( stride ) == true )
+        {
+            /// contiguous hyperslab : avoid the (slower) strided access path of the netCDF library
+            var.getVar( start, count, values );
+        }
+        else
+        {
+            var.getVar( start, count, stride, values );
+        }
     }
     
-    if( sofa::NcUtils::HasDimensions( dim1, dim2, dim3, var ) == false )
+    template< typename T, typename Stored >
+    void getPackedValues(T *values,
+                         const std::vector< std::size_t > &start,
+                         const std::vector< std::size_t > &count,
+                         const std::vector< std::ptrdiff_t > &stride,
+                         const netCDF::NcVar &var,
+                         const double scale,
+                         const double offset)
     {
-        return false;
+        const std::size_t numElements = sofa::NcUtils::GetNumElements( count );
+        
+        std::vector< Stored > packed( numElements );
+        
+        getVar( &packed[0], start, count, stride, var );
+        
+        sofa::NcUtils::UnpackValues( values, &packed[0], numElements, scale, offset );
     }
     
-    var.getVar( values );
-    
-    return true;
-}
-
-/************************************************************************************/
-/*!
- *  @brief          Reads values of variable stored as a 3-dimensional array of double
- *                  Returns true if everything goes well, false otherwise (not a valid variable,
- *                  not a double variable, not the proper dimensions)
- *  @param[out]     values :
- *  @param[in]      variableName : the named variable to query
- *  @param[in]      dim1 : first dimension of the array
- *  @param[in]      dim2 : second dimension of the array
- *  @param[in]      dim3 : third dimension of the array
- *  @param[in]      dim4 : fourth dimension of the array
- *
- */
-/************************************************************************************/
-bool NetCDFFile::GetValues(double *values,
-                           const std::size_t dim1,
-                           const std::size_t dim2,
-                           const std::size_t dim3,
-                           const std::size_t dim4,
-                           const std::string &variableName) const
-{
-    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
-    
-    if( sofa::NcUtils::IsValid( var ) == false )
+    /// reads a hyperslab of a numeric variable, already checked
+    template< typename T >
+    void readValues(T *values,
+                    const std::vector< std::size_t > &start,
+                    const std::vector< std::size_t > &count,
+                    const std::vector< std::ptrdiff_t > &stride,
+                    const netCDF::NcVar &var,
+                    const Packing &packing)
     {
-        return false;
+        if( sofa::NcUtils::GetNumElements( count ) == 0 )
+        {
+            return;
+        }
+        
+        if( packing.packed == false )
+        {
+            getVar( values, start, count, stride, var );
+            return;
+        }
+        
+        const double scale  = packing.scale;
+        const double offset = packing.offset;
+        
+        switch( var.getType().getTypeClass() )
+        {
+            case netCDF::NcType::nc_BYTE :
+                getPackedValues< T, signed char >( values, start, count, stride, var, scale, offset );
+                break;
+            case netCDF::NcType::nc_UBYTE :
+                getPackedValues< T, unsigned char >( values, start, count, stride, var, scale, offset );
+                break;
+            case netCDF::NcType::nc_SHORT :
+                getPackedValues< T, short >( values, start, count, stride, var, scale, offset );
+                break;
+            case netCDF::NcType::nc_USHORT :
+                getPackedValues< T, unsigned short >( values, start, count, stride, var, scale, offset );
+                break;
+            case netCDF::NcType::nc_INT :
+                getPackedValues< T, int >( values, start, count, stride, var, scale, offset );
+                break;
+            case netCDF::NcType::nc_UINT :
+                getPackedValues< T, unsigned int >( values, start, count, stride, var, scale, offset );
+                break;
+            case netCDF::NcType::nc_INT64 :
+                getPackedValues< T, long long >( values, start, count, stride, var, scale, offset );
+                break;
+            case netCDF::NcType::nc_UINT64 :
+                getPackedValues< T, unsigned long long >( values, start, count, stride, var, scale, offset );
+                break;
+            case netCDF::NcType::nc_FLOAT :
+                getPackedValues< T, float >( values, start, count, stride, var, scale, offset );
+                break;
+            default :
+                getPackedValues< T, double >( values, start, count, stride, var, scale, offset );
+                break;
+        }
     }
     
-    if( sofa::NcUtils::IsDouble( var ) == false )
+    template< typename T >
+    void readValues(T *values,
+                    const std::vector< std::size_t > &dims,
+                    const netCDF::NcVar &var,
+                    const Packing &packing)
     {
-        return false;
+        readValues( values, std::vector< std::size_t >( dims.size(), 0 ), dims, std::vector< std::ptrdiff_t >(), var, packing );
     }
     
-    if( sofa::NcUtils::HasDimensions( dim1, dim2, dim3, dim4, var ) == false )
+    /// reads a whole numeric variable, already checked : packed variables go through a
+    /// temporary buffer, the others are read straight into the values
+    template< typename T >
+    void readAllValues(T *values,
+                       const netCDF::NcVar &var,
+                       const Packing &packing)
     {
-        return false;
+        if( packing.packed == false )
+        {
+            var.getVar( values );
+        }
+        else
+        {
+            std::vector< std::size_t > dims;
+            sofa::NcUtils::GetDimensions( dims, var );
+            
+            readValues( values, dims, var, packing );
+        }
     }
     
-    var.getVar( values );
-    
-    return true;
-}
-
-
-/************************************************************************************/
-/*!
- *  @brief          Reads values of named variable stored as a N-dimensional array of double
- *                  Returns true if everything goes well, false otherwise (not a valid variable,
- *                  not a double variable, not the proper dimensions)
- *  @param[out]     values :
- *  @param[in]      variableName : the named variable to query
- *
- */
-/************************************************************************************/
-bool NetCDFFile::GetValues(std::vector< double > &values,
-                           const std::string &variableName) const
-{
-    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
-    
-    if( sofa::NcUtils::IsValid( var ) == false )
+    template< typename T >
+    bool GetValues(T *values,
+                   const std::vector< std::size_t > &dims,
+                   const netCDF::NcVar &var,
+                   const Packing &packing)
     {
-        return false;
+        if( sofa::NcUtils::IsValid( var ) == false )
+        {
+            return false;
+        }
+        
+        if( sofa::NcUtils::IsNumeric( var ) == false )
+        {
+            return false;
+        }
+        
+        std::vector< std::size_t > varDims;
+        sofa::NcUtils::GetDimensions( varDims, var );
+        
+        if( varDims != dims )
+        {
+            return false;
+        }
+        
+        readValues( values, dims, var, packing );
+        
+        return true;
     }
     
-    if( sofa::NcUtils::IsDouble( var ) == false )
+    template< typename T >
+    bool GetValues(std::vector< T > &values,
+                   const netCDF::NcVar &var,
+                   const Packing &packing)
     {
-        return false;
+        if( sofa::NcUtils::IsValid( var ) == false )
+        {
+            return false;
+        }
+        
+        if( sofa::NcUtils::IsNumeric( var ) == false )
+        {
+            return false;
+        }
+        
+        std::vector< std::size_t > dims;
+        sofa::NcUtils::GetDimensions( dims, var );
+        
+        if( dims.size() == 0 )
+        {
+            return false;
+        }
+        
+        const std::size_t totalSize = sofa::NcUtils::GetNumElements( dims );
+        
+        values.resize( totalSize );
+        
+        SOFA_ASSERT( totalSize > 0 );
+        
+        readValues( &values[0], dims, var, packing );
+        
+        return true;
     }
     
-    std::vector< std::size_t > dims;
-    GetVariableDimensions( dims, variableName );
+    template< typename T >
+    bool GetValues(T *values,
+                   const std::vector< std::size_t > &start,
+                   const std::vector< std::size_t > &count,
+                   const std::vector< std::ptrdiff_t > &stride,
+                   const netCDF::NcVar &var,
+                   const Packing &packing)
+    {
+        if( sofa::NcUtils::IsValid( var ) == false )
+        {
+            return false;
+        }
+        
+        if( sofa::NcUtils::IsNumeric( var ) == false )
+        {
+            return false;
+        }
+        
+        if( sofa::NcUtils::IsValidHyperslab( start, count, stride, var ) == false )
+        {
+            return false;
+        }
+        
+        readValues( values, start, count, stride, var, packing );
+        
+        return true;
+    }
     
-    if( dims.size() == 0 )
+    template< typename T >
+    bool GetValues(std::vector< T > &values,
+                   const std::vector< std::size_t > &start,
+                   const std::vector< std::size_t > &count,
+                   const netCDF::NcVar &var,
+                   const Packing &packing)
     {
-        return false;
+        const std::size_t totalSize = sofa::NcUtils::GetNumElements( count );
+        
+        if( totalSize == 0 )
+        {
+            return false;
+        }
+        
+        values.resize( totalSize );
+        
+        return GetValues( &values[0], start, count, std::vector< std::ptrdiff_t >(), var, packing );
     }
     
-    std::size_t totalSize = dims[0];
-    for( std::size_t i = 1; i < dims.size(); i++ )
+    template< typename T >
+    bool GetValues(sofa::Array< T > &values,
+                   const netCDF::NcVar &var,
+                   const Packing &packing)
     {
-        totalSize *= dims[i];
+        if( sofa::NcUtils::IsValid( var ) == false )
+        {
+            return false;
+        }
+        
+        if( sofa::NcUtils::IsNumeric( var ) == false )
+        {
+            return false;
+        }
+        
+        std::vector< std::size_t > dims;
+        sofa::NcUtils::GetDimensions( dims, var );
+        
+        if( dims.size() == 0 || sofa::NcUtils::GetNumElements( dims ) == 0 )
+        {
+            return false;
+        }
+        
+        if( values.Resize( dims ) == false )
+        {
+            return false;
+        }
+        
+        readValues( values.GetData(), dims, var, packing );
+        
+        return true;
     }
     
-    values.resize( totalSize );
+    template< typename T >
+    bool GetValues(sofa::Array< T > &values,
+                   const std::vector< std::size_t > &start,
+                   const std::vector< std::size_t > &count,
+                   const netCDF::NcVar &var,
+                   const Packing &packing)
+    {
+        if( sofa::NcUtils::GetNumElements( count ) == 0 )
+        {
+            return false;
+        }
+        
+        if( values.Resize( count ) == false )
+        {
+            return false;
+        }
+        
+        return GetValues( values.GetData(), start, count, std::vector< std::ptrdiff_t >(), var, packing );
+    }
+    
+    inline std::vector< std::size_t > MakeDimensions(const std::size_t dim1,
+                                                     const std::size_t dim2)
+    {
+        std::vector< std::size_t > dims( 2 );
+        dims[0] = dim1;
+        dims[1] = dim2;
+        return dims;
+    }
+    
+    inline std::vector< std::size_t > MakeDimensions(const std::size_t dim1,
+                                                     const std::size_t dim2,
+                                                     const std::size_t dim3)
+    {
+        std::vector< std::size_t > dims( 3 );
+        dims[0] = dim1;
+        dims[1] = dim2;
+        dims[2] = dim3;
+        return dims;
+    }
+    
+    inline std::vector< std::size_t > MakeDimensions(const std::size_t dim1,
+                                                     const std::size_t dim2,
+                                                     const std::size_t dim3,
+                                                     const std::size_t dim4)
+    {
+        std::vector< std::size_t > dims( 4 );
+        dims[0] = dim1;
+        dims[1] = dim2;
+        dims[2] = dim3;
+        dims[3] = dim4;
+        return dims;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of variable stored as a 2-dimensional array of double
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, not the proper dimensions)
+ *  @param[out]     values :
+ *  @param[in]      variableName : the named variable to query
+ *  @param[in]      dim1 : first dimension of the array
+ *  @param[in]      dim2 : second dimension of the array
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(double *values,
+                           const std::size_t dim1,
+                           const std::size_t dim2,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, NcFileHelper::MakeDimensions( dim1, dim2 ), var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of variable stored as a 3-dimensional array of double
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, not the proper dimensions)
+ *  @param[out]     values :
+ *  @param[in]      variableName : the named variable to query
+ *  @param[in]      dim1 : first dimension of the array
+ *  @param[in]      dim2 : second dimension of the array
+ *  @param[in]      dim3 : third dimension of the array
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(double *values,
+                           const std::size_t dim1,
+                           const std::size_t dim2,
+                           const std::size_t dim3,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, NcFileHelper::MakeDimensions( dim1, dim2, dim3 ), var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of variable stored as a 4-dimensional array of double
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, not the proper dimensions)
+ *  @param[out]     values :
+ *  @param[in]      variableName : the named variable to query
+ *  @param[in]      dim1 : first dimension of the array
+ *  @param[in]      dim2 : second dimension of the array
+ *  @param[in]      dim3 : third dimension of the array
+ *  @param[in]      dim4 : fourth dimension of the array
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(double *values,
+                           const std::size_t dim1,
+                           const std::size_t dim2,
+                           const std::size_t dim3,
+                           const std::size_t dim4,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
     
-    SOFA_ASSERT( totalSize > 0 );
+    return NcFileHelper::GetValues( values, NcFileHelper::MakeDimensions( dim1, dim2, dim3, dim4 ), var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of named variable stored as a N-dimensional array of double
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, not the proper dimensions)
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(std::vector< double > &values,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
     
-    var.getVar( &values[0] );
+    return NcFileHelper::GetValues( values, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a hyperslab of a named variable stored as a N-dimensional array of double.
+ *                  Only the requested elements are read from the file.
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, hyperslab out of range)
+ *  @param[out]     values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(double *values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::string &variableName) const
+{
+    return NetCDFFile::GetValues( values, start, count, std::vector< std::ptrdiff_t >(), variableName );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a strided hyperslab of a named variable stored as a N-dimensional array of double.
+ *                  Only the requested elements are read from the file.
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, hyperslab out of range)
+ *  @param[out]     values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      stride : sampling interval along each dimension (an empty vector means unit stride)
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(double *values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::vector< std::ptrdiff_t > &stride,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, start, count, stride, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a hyperslab of a named variable stored as a N-dimensional array of double.
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, hyperslab out of range)
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(std::vector< double > &values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, start, count, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of named variable into a N-dimensional array of double,
+ *                  shaped like the variable
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable)
+ *  @param[out]     values : the array is resized if needed (without reallocation if it is large enough)
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(sofa::Array< double > &values,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a hyperslab of a named variable into a N-dimensional array of double,
+ *                  shaped like the hyperslab (i.e. count)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, hyperslab out of range)
+ *  @param[out]     values : the array is resized if needed (without reallocation if it is large enough)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(sofa::Array< double > &values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, start, count, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of variable stored as a 2-dimensional array of float
+ *                  The variable may be stored with any numeric type : the conversion to float
+ *                  is performed while reading (packed variables are unpacked)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, not the proper dimensions)
+ *  @param[out]     values :
+ *  @param[in]      variableName : the named variable to query
+ *  @param[in]      dim1 : first dimension of the array
+ *  @param[in]      dim2 : second dimension of the array
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(float *values,
+                           const std::size_t dim1,
+                           const std::size_t dim2,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, NcFileHelper::MakeDimensions( dim1, dim2 ), var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of variable stored as a 3-dimensional array of float
+ *                  The variable may be stored with any numeric type : the conversion to float
+ *                  is performed while reading (packed variables are unpacked)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, not the proper dimensions)
+ *  @param[out]     values :
+ *  @param[in]      variableName : the named variable to query
+ *  @param[in]      dim1 : first dimension of the array
+ *  @param[in]      dim2 : second dimension of the array
+ *  @param[in]      dim3 : third dimension of the array
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(float *values,
+                           const std::size_t dim1,
+                           const std::size_t dim2,
+                           const std::size_t dim3,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, NcFileHelper::MakeDimensions( dim1, dim2, dim3 ), var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of variable stored as a 4-dimensional array of float
+ *                  The variable may be stored with any numeric type : the conversion to float
+ *                  is performed while reading (packed variables are unpacked)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, not the proper dimensions)
+ *  @param[out]     values :
+ *  @param[in]      variableName : the named variable to query
+ *  @param[in]      dim1 : first dimension of the array
+ *  @param[in]      dim2 : second dimension of the array
+ *  @param[in]      dim3 : third dimension of the array
+ *  @param[in]      dim4 : fourth dimension of the array
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(float *values,
+                           const std::size_t dim1,
+                           const std::size_t dim2,
+                           const std::size_t dim3,
+                           const std::size_t dim4,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, NcFileHelper::MakeDimensions( dim1, dim2, dim3, dim4 ), var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of named variable stored as a N-dimensional array of float
+ *                  The variable may be stored with any numeric type : the conversion to float
+ *                  is performed while reading (packed variables are unpacked)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, not the proper dimensions)
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(std::vector< float > &values,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a hyperslab of a named variable stored as a N-dimensional array of float.
+ *                  Only the requested elements are read from the file.
+ *                  The variable may be stored with any numeric type : the conversion to float
+ *                  is performed while reading (packed variables are unpacked)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, hyperslab out of range)
+ *  @param[out]     values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(float *values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::string &variableName) const
+{
+    return NetCDFFile::GetValues( values, start, count, std::vector< std::ptrdiff_t >(), variableName );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a strided hyperslab of a named variable stored as a N-dimensional array of float.
+ *                  Only the requested elements are read from the file.
+ *                  The variable may be stored with any numeric type : the conversion to float
+ *                  is performed while reading (packed variables are unpacked)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, hyperslab out of range)
+ *  @param[out]     values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      stride : sampling interval along each dimension (an empty vector means unit stride)
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(float *values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::vector< std::ptrdiff_t > &stride,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, start, count, stride, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a hyperslab of a named variable stored as a N-dimensional array of float.
+ *                  The variable may be stored with any numeric type : the conversion to float
+ *                  is performed while reading (packed variables are unpacked)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, hyperslab out of range)
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(std::vector< float > &values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, start, count, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of named variable into a N-dimensional array of float,
+ *                  shaped like the variable
+ *                  The variable may be stored with any numeric type : the conversion to float
+ *                  is performed while reading (packed variables are unpacked)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable)
+ *  @param[out]     values : the array is resized if needed (without reallocation if it is large enough)
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(sofa::Array< float > &values,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a hyperslab of a named variable into a N-dimensional array of float,
+ *                  shaped like the hyperslab (i.e. count)
+ *                  The variable may be stored with any numeric type : the conversion to float
+ *                  is performed while reading (packed variables are unpacked)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, hyperslab out of range)
+ *  @param[out]     values : the array is resized if needed (without reallocation if it is large enough)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(sofa::Array< float > &values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, start, count, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of named variable stored as a N-dimensional array,
+ *                  as any numeric type T
+ *                  The variable may be stored with any numeric type : the conversion to T
+ *                  is performed while reading (packed variables are unpacked, in double
+ *                  precision, then truncated toward zero if T is an integer type)
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable)
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+template< typename T >
+bool NetCDFFile::GetValues(std::vector< T > &values,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of named variable, as any numeric type T
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, or numValues is not its number of elements)
+ *  @param[out]     values : array containing the values, allocated by the caller
+ *  @param[in]      numValues : size of the array (see GetVariableNumElements)
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+template< typename T >
+bool NetCDFFile::GetValues(T *values,
+                           const std::size_t numValues,
+                           const std::string &variableName) const
+{
+    if( values == NULL || numValues == 0 || numValues != GetVariableNumElements( variableName ) )
+    {
+        return false;
+    }
+    
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    if( sofa::NcUtils::IsNumeric( var ) == false )
+    {
+        return false;
+    }
+    
+    NcFileHelper::readAllValues( values, var, packing );
     
     return true;
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Reads a strided hyperslab of a named variable, as any numeric type T
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, hyperslab out of range)
+ *  @param[out]     values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      stride : sampling interval along each dimension (an empty vector means unit stride)
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+template< typename T >
+bool NetCDFFile::GetValues(T *values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::vector< std::ptrdiff_t > &stride,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, start, count, stride, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a hyperslab of a named variable, as any numeric type T
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable, hyperslab out of range)
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+template< typename T >
+bool NetCDFFile::GetValues(std::vector< T > &values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, start, count, var, packing );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of named variable into a N-dimensional array shaped like
+ *                  the variable, as any numeric type T
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a numeric variable)
+ *  @param[out]     values : the array is resized if needed
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+template< typename T >
+bool NetCDFFile::GetValues(sofa::Array< T > &values,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    const NcFileHelper::Packing packing( *this, variableName );
+    
+    return NcFileHelper::GetValues( values, var, packing );
+}
+
+/// explicit instantiations for all the supported output types
+#define SOFA_INSTANTIATE_GET_VALUES( T )                                                    \
+    template bool NetCDFFile::GetValues< T >(std::vector< T > &,                            \
+                                             const std::string &) const;                    \
+    template bool NetCDFFile::GetValues< T >(T *,                                           \
+                                             const std::size_t,                             \
+                                             const std::string &) const;                    \
+    template bool NetCDFFile::GetValues< T >(T *,                                           \
+                                             const std::vector< std::size_t > &,            \
+                                             const std::vector< std::size_t > &,            \
+                                             const std::vector< std::ptrdiff_t > &,         \
+                                             const std::string &) const;                    \
+    template bool NetCDFFile::GetValues< T >(std::vector< T > &,                            \
+                                             const std::vector< std::size_t > &,            \
+                                             const std::vector< std::size_t > &,            \
+                                             const std::string &) const;                    \
+    template bool NetCDFFile::GetValues< T >(sofa::Array< T > &,                            \
+                                             const std::string &) const;
+
+SOFA_INSTANTIATE_GET_VALUES( signed char )
+SOFA_INSTANTIATE_GET_VALUES( unsigned char )
+SOFA_INSTANTIATE_GET_VALUES( short )
+SOFA_INSTANTIATE_GET_VALUES( unsigned short )
+SOFA_INSTANTIATE_GET_VALUES( int )
+SOFA_INSTANTIATE_GET_VALUES( unsigned int )
+SOFA_INSTANTIATE_GET_VALUES( long long )
+SOFA_INSTANTIATE_GET_VALUES( unsigned long long )
+SOFA_INSTANTIATE_GET_VALUES( float )
+SOFA_INSTANTIATE_GET_VALUES( double )
+
+#undef SOFA_INSTANTIATE_GET_VALUES
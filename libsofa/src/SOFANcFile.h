@@ -50,8 +50,16 @@ http://www.sofaconventions.org
 #define _SOFA_NC_FILE_H__
 
 #include "../src/SOFAPlatform.h"
+#include "../src/SOFANcMetadata.h"
+#include "../src/SOFAMemoryBuffer.h"
+#include "../src/SOFAOpenOptions.h"
+#include "../src/SOFAArray.h"
 #include "netcdf.h"
 #include "ncFile.h"
+#include "ncVar.h"
+#include "ncDim.h"
+#include "ncGroupAtt.h"
+#include <map>
 
 namespace sofa
 {
@@ -68,12 +76,20 @@ namespace sofa
     {
     public:
         NetCDFFile(const std::string &path,
-                   const netCDF::NcFile::FileMode &mode = netCDF::NcFile::read);
+                   const netCDF::NcFile::FileMode &mode = netCDF::NcFile::read,
+                   const sofa::OpenOptions &options = sofa::OpenOptions());
+        
+        explicit NetCDFFile(const sofa::MemoryBuffer &buffer,
+                            const sofa::OpenOptions &options = sofa::OpenOptions());
         
         virtual ~NetCDFFile() {};
         
         const std::string & GetFilename() const;
         
+        const sofa::NcMetadata & GetMetadata() const;
+        
+        bool IsInMemory() const;
+        
         virtual bool IsValid() const;
         
         //==============================================================================
@@ -123,6 +139,9 @@ namespace sofa
         
         void GetAllVariablesNames(std::vector< std::string > &variableNames) const;
         
+        template< typename String, typename Allocator >
+        void GetAllVariablesNames(std::vector< String, Allocator > &variableNames) const;
+        
         netCDF::NcType GetVariableType(const std::string &variableName) const;
         std::string GetVariableTypeName(const std::string &variableName) const;
         
@@ -130,6 +149,12 @@ namespace sofa
         
         int GetVariableDimensionality(const std::string &variableName) const;
         void GetVariableDimensions(std::vector< std::size_t > &dims, const std::string &variableName) const;
+        
+        template< typename Allocator >
+        void GetVariableDimensions(std::vector< std::size_t, Allocator > &dims, const std::string &variableName) const;
+        
+        std::size_t GetVariableNumElements(const std::string &variableName) const;
+        
         void GetVariableDimensionsNames(std::vector< std::string > &dims, const std::string &variableName) const;
         std::string GetVariableDimensionsNamesAsString(const std::string &variableName) const;
         std::string GetVariableDimensionsAsString(const std::string &variableName) const;
@@ -155,7 +180,18 @@ namespace sofa
         void GetVariablesAttributes(std::vector< std::string > &attributeNames,
                                     std::vector< std::string > &attributeValues,
                                     const std::string &variableName) const;
+        
+        template< typename String, typename Allocator >
+        void GetVariablesAttributes(std::vector< String, Allocator > &attributeNames,
+                                    const std::string &variableName) const;
+        
+        template< typename String, typename Allocator >
+        void GetVariablesAttributes(std::vector< String, Allocator > &attributeNames,
+                                    std::vector< String, Allocator > &attributeValues,
+                                    const std::string &variableName) const;
+        
         bool VariableHasAttribute(const std::string &attributeName, const std::string &variableName) const;
+        bool GetVariablePacking(double &scale, double &offset, const std::string &variableName) const;
         
         void PrintAllVariables(std::ostream & output = std::cout) const;
         
@@ -180,7 +216,116 @@ namespace sofa
         bool GetValues(std::vector< double > &values,
                        const std::string &variableName) const;
         
+        bool GetValues(double *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::string &variableName) const;
+        
+        bool GetValues(double *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::vector< std::ptrdiff_t > &stride,
+                       const std::string &variableName) const;
+        
+        bool GetValues(std::vector< double > &values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::string &variableName) const;
+        
+        bool GetValues(sofa::Array< double > &values,
+                       const std::string &variableName) const;
+        
+        bool GetValues(sofa::Array< double > &values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::string &variableName) const;
+        
+        //==============================================================================
+        bool GetValues(float *values,
+                       const std::size_t dim1,
+                       const std::size_t dim2,
+                       const std::string &variableName) const;
+        
+        bool GetValues(float *values,
+                       const std::size_t dim1,
+                       const std::size_t dim2,
+                       const std::size_t dim3,
+                       const std::string &variableName) const;
+        
+        bool GetValues(float *values,
+                       const std::size_t dim1,
+                       const std::size_t dim2,
+                       const std::size_t dim3,
+                       const std::size_t dim4,
+                       const std::string &variableName) const;
+        
+        bool GetValues(std::vector< float > &values,
+                       const std::string &variableName) const;
+        
+        bool GetValues(float *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::string &variableName) const;
+        
+        bool GetValues(float *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::vector< std::ptrdiff_t > &stride,
+                       const std::string &variableName) const;
+        
+        bool GetValues(std::vector< float > &values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::string &variableName) const;
+        
+        bool GetValues(sofa::Array< float > &values,
+                       const std::string &variableName) const;
+        
+        bool GetValues(sofa::Array< float > &values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::string &variableName) const;
+        
+        //==============================================================================
+        /// any output type among signed char, unsigned char, short, unsigned short, int,
+        /// unsigned int, long long, unsigned long long, float and double
+        template< typename T >
+        bool GetValues(std::vector< T > &values,
+                       const std::string &variableName) const;
+        
+        template< typename T >
+        bool GetValues(T *values,
+                       const std::size_t numValues,
+                       const std::string &variableName) const;
+        
+        template< typename T >
+        bool GetValues(T *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::vector< std::ptrdiff_t > &stride,
+                       const std::string &variableName) const;
+        
+        template< typename T >
+        bool GetValues(std::vector< T > &values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::string &variableName) const;
+        
+        template< typename T >
+        bool GetValues(sofa::Array< T > &values,
+                       const std::string &variableName) const;
+        
+        //==============================================================================
+        /// the values are allocated with the allocator of the vector (e.g. a memory arena,
+        /// or a std::pmr::polymorphic_allocator); same output types as above
+        template< typename T, typename Allocator >
+        bool GetValues(std::vector< T, Allocator > &values,
+                       const std::string &variableName) const;
+    
     protected:
+        //==============================================================================
+        explicit NetCDFFile(const sofa::NetCDFFile *sharedFile);
+        
         //==============================================================================
         netCDF::NcGroupAtt getAttribute(const std::string &attributeName) const;
         
@@ -189,16 +334,241 @@ namespace sofa
         netCDF::NcVar getVariable(const std::string &variableName) const;
         
 
+    private:
+        netCDF::NcFile ownFile;             ///< handle opened by this object (closed if the handle is shared)
+    
     protected:
-        netCDF::NcFile file;
+        const netCDF::NcFile & file;        ///< either ownFile, or the handle of the shared file
         const std::string filename;
+        const bool inMemory;                ///< true if the file was opened from a sofa::MemoryBuffer
+        
+    private:
+        //==============================================================================
+        void buildIndex();
+        
+        void applyOpenOptions(const sofa::OpenOptions &options);
+        
+        bool hasAttributeType(const netCDF::NcType &type_, const std::string &attributeName) const;
         
+        typedef std::map< std::string, netCDF::NcGroupAtt > AttributesIndex;
+        typedef std::map< std::string, netCDF::NcDim > DimensionsIndex;
+        typedef std::map< std::string, netCDF::NcVar > VariablesIndex;
+        
+        /// name -> object lookup tables, built once when the file is opened in read mode
+        /// (in other modes the content of the file may change, so lookups go through netCDF)
+        bool hasIndex;
+        AttributesIndex attributesIndex;
+        DimensionsIndex dimensionsIndex;
+        VariablesIndex variablesIndex;
+        
+        /// snapshot of all the metadata, loaded once when the file is opened in read mode
+        const sofa::NcMetadata ownMetadata;
+        const sofa::NcMetadata & metadata;  ///< either ownMetadata, or the snapshot of the shared file
+    
     private:
         //==============================================================================
+        template< typename String, typename Allocator >
+        static void assignStrings(std::vector< String, Allocator > &destination,
+                                  const std::vector< std::string > &source);
+        
         /// avoid shallow and copy constructor
         SOFA_AVOID_COPY_CONSTRUCTOR( NetCDFFile );         
     };
     
+    /************************************************************************************/
+    /*!
+     *  @brief          Copies strings into a vector of any string type, without going
+     *                  through its copy assignment (so that the allocator of the vector
+     *                  is passed on to the strings, when it is a scoped or polymorphic one)
+     *
+     */
+    /************************************************************************************/
+    template< typename String, typename Allocator >
+    void NetCDFFile::assignStrings(std::vector< String, Allocator > &destination,
+                                   const std::vector< std::string > &source)
+    {
+        destination.clear();
+        destination.reserve( source.size() );
+        
+        for( std::size_t i = 0; i < source.size(); i++ )
+        {
+            destination.emplace_back( source[i].begin(), source[i].end() );
+        }
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns the names of all the variables, into a vector of strings
+     *                  using any allocator
+     *
+     */
+    /************************************************************************************/
+    template< typename String, typename Allocator >
+    void NetCDFFile::GetAllVariablesNames(std::vector< String, Allocator > &variableNames) const
+    {
+        if( metadata.IsLoaded() == true )
+        {
+            const std::vector< sofa::NcMetadata::Variable > & vars = metadata.GetVariables();
+            
+            variableNames.clear();
+            variableNames.reserve( vars.size() );
+            
+            for( std::size_t i = 0; i < vars.size(); i++ )
+            {
+                variableNames.emplace_back( vars[i].name.begin(), vars[i].name.end() );
+            }
+        }
+        else
+        {
+            std::vector< std::string > names;
+            GetAllVariablesNames( names );
+            
+            assignStrings( variableNames, names );
+        }
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns the dimensions of a named variable, into a vector using any allocator.
+     *                  Returns an empty vector if the variable does not exist
+     *
+     */
+    /************************************************************************************/
+    template< typename Allocator >
+    void NetCDFFile::GetVariableDimensions(std::vector< std::size_t, Allocator > &dims,
+                                           const std::string &variableName) const
+    {
+        if( metadata.IsLoaded() == true )
+        {
+            const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+            
+            if( var != NULL )
+            {
+                dims.assign( var->dimensions.begin(), var->dimensions.end() );
+            }
+            else
+            {
+                dims.clear();
+            }
+        }
+        else
+        {
+            std::vector< std::size_t > dimensions;
+            GetVariableDimensions( dimensions, variableName );
+            
+            dims.assign( dimensions.begin(), dimensions.end() );
+        }
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns the names of the attributes of a named variable, into a
+     *                  vector of strings using any allocator
+     *
+     */
+    /************************************************************************************/
+    template< typename String, typename Allocator >
+    void NetCDFFile::GetVariablesAttributes(std::vector< String, Allocator > &attributeNames,
+                                            const std::string &variableName) const
+    {
+        if( metadata.IsLoaded() == true )
+        {
+            const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+            
+            attributeNames.clear();
+            
+            if( var != NULL )
+            {
+                attributeNames.reserve( var->attributes.size() );
+                
+                for( std::size_t i = 0; i < var->attributes.size(); i++ )
+                {
+                    const std::string &name = var->attributes[i].name;
+                    attributeNames.emplace_back( name.begin(), name.end() );
+                }
+            }
+        }
+        else
+        {
+            std::vector< std::string > names;
+            GetVariablesAttributes( names, variableName );
+            
+            assignStrings( attributeNames, names );
+        }
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns the names and values of the attributes of a named variable,
+     *                  into vectors of strings using any allocator
+     *                  (the values of non-char attributes are empty)
+     *
+     */
+    /************************************************************************************/
+    template< typename String, typename Allocator >
+    void NetCDFFile::GetVariablesAttributes(std::vector< String, Allocator > &attributeNames,
+                                            std::vector< String, Allocator > &attributeValues,
+                                            const std::string &variableName) const
+    {
+        if( metadata.IsLoaded() == true )
+        {
+            const sofa::NcMetadata::Variable * var = metadata.FindVariable( variableName );
+            
+            attributeNames.clear();
+            attributeValues.clear();
+            
+            if( var != NULL )
+            {
+                attributeNames.reserve( var->attributes.size() );
+                attributeValues.reserve( var->attributes.size() );
+                
+                for( std::size_t i = 0; i < var->attributes.size(); i++ )
+                {
+                    const std::string &name  = var->attributes[i].name;
+                    const std::string &value = var->attributes[i].value;
+                    
+                    attributeNames.emplace_back( name.begin(), name.end() );
+                    attributeValues.emplace_back( value.begin(), value.end() );
+                }
+            }
+        }
+        else
+        {
+            std::vector< std::string > names;
+            std::vector< std::string > values;
+            GetVariablesAttributes( names, values, variableName );
+            
+            assignStrings( attributeNames, names );
+            assignStrings( attributeValues, values );
+        }
+    }
+    
+    /************************************************************************************/
+    /*!
+     *  @brief          Reads values of named variable, into a vector using any allocator
+     *                  Returns true if everything goes well, false otherwise (not a valid variable,
+     *                  not a numeric variable)
+     *  @param[out]     values : the vector is resized if needed
+     *  @param[in]      variableName : the named variable to query
+     *
+     */
+    /************************************************************************************/
+    template< typename T, typename Allocator >
+    bool NetCDFFile::GetValues(std::vector< T, Allocator > &values,
+                               const std::string &variableName) const
+    {
+        const std::size_t numValues = GetVariableNumElements( variableName );
+        
+        if( numValues == 0 )
+        {
+            return false;
+        }
+        
+        values.resize( numValues );
+        
+        return GetValues< T >( &values[0], numValues, variableName );
+    }
+
 }
 
 #endif /* _SOFA_NC_FILE_H__ */
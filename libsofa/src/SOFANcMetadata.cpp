@@ -0,0 +1,316 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFANcMetadata.cpp
+ *   @brief      Snapshot of the metadata of a netCDF file
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFANcMetadata.h"
+#include "../src/SOFANcUtils.h"
+
+using namespace sofa;
+
+namespace NcMetadataHelper
+{
+    template< typename Element >
+    const Element * Find(const std::vector< Element > &elements,
+                         const std::map< std::string, std::size_t > &index,
+                         const std::string &name)
+    {
+        const std::map< std::string, std::size_t >::const_iterator it = index.find( name );
+        
+        if( it == index.end() )
+        {
+            return NULL;
+        }
+        
+        return &elements[ (*it).second ];
+    }
+    
+    template< typename NetCDFAttribute >
+    NcMetadata::Attribute MakeAttribute(const std::string &name, const NetCDFAttribute &att)
+    {
+        NcMetadata::Attribute attribute;
+        attribute.name  = name;
+        attribute.type  = att.getType().getId();
+        attribute.value = sofa::NcUtils::GetAttributeValueAsString( att );
+        
+        return attribute;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Creates an empty snapshot (not loaded)
+ *
+ */
+/************************************************************************************/
+NcMetadata::NcMetadata()
+: loaded( false )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Loads the snapshot of a netCDF file.
+ *                  This queries the whole content of the file, once.
+ *  @param[in]      file : the netCDF file to query
+ *  @param[in]      shouldLoad : if false, an empty (not loaded) snapshot is created
+ *
+ */
+/************************************************************************************/
+NcMetadata::NcMetadata(const netCDF::NcFile &file, const bool shouldLoad)
+: loaded( false )
+{
+    if( shouldLoad == true )
+    {
+        load( file );
+    }
+}
+
+void NcMetadata::load(const netCDF::NcFile &file)
+{
+    if( sofa::NcUtils::IsValid( file ) == false )
+    {
+        return;
+    }
+    
+    /// global attributes
+    {
+        const std::multimap< std::string, netCDF::NcGroupAtt > atts = file.getAtts();
+        
+        attributes.reserve( atts.size() );
+        
+        for( std::multimap< std::string, netCDF::NcGroupAtt >::const_iterator it = atts.begin();
+            it != atts.end();
+            ++it )
+        {
+            if( attributesIndex.insert( std::make_pair( (*it).first, attributes.size() ) ).second == true )
+            {
+                attributes.push_back( NcMetadataHelper::MakeAttribute( (*it).first, (*it).second ) );
+            }
+        }
+    }
+    
+    /// dimensions
+    {
+        const std::multimap< std::string, netCDF::NcDim > dims = file.getDims();
+        
+        dimensions.reserve( dims.size() );
+        
+        for( std::multimap< std::string, netCDF::NcDim >::const_iterator it = dims.begin();
+            it != dims.end();
+            ++it )
+        {
+            if( dimensionsIndex.insert( std::make_pair( (*it).first, dimensions.size() ) ).second == true )
+            {
+                Dimension dimension;
+                dimension.name = (*it).first;
+                dimension.size = (*it).second.getSize();
+                
+                dimensions.push_back( dimension );
+            }
+        }
+    }
+    
+    /// variables
+    {
+        const std::multimap< std::string, netCDF::NcVar > vars = file.getVars();
+        
+        variables.reserve( vars.size() );
+        
+        for( std::multimap< std::string, netCDF::NcVar >::const_iterator it = vars.begin();
+            it != vars.end();
+            ++it )
+        {
+            if( variablesIndex.insert( std::make_pair( (*it).first, variables.size() ) ).second == false )
+            {
+                continue;
+            }
+            
+            const netCDF::NcVar var = (*it).second;
+            
+            variables.push_back( Variable() );
+            Variable & variable = variables.back();
+            
+            const netCDF::NcType type_ = var.getType();
+            
+            variable.name     = (*it).first;
+            variable.type     = type_.getId();
+            variable.typeName = type_.getName();
+            
+            const std::vector< netCDF::NcDim > dims = var.getDims();
+            
+            variable.dimensionsNames.resize( dims.size() );
+            variable.dimensions.resize( dims.size() );
+            
+            for( std::size_t i = 0; i < dims.size(); i++ )
+            {
+                variable.dimensionsNames[i] = dims[i].getName();
+                variable.dimensions[i]      = dims[i].getSize();
+            }
+            
+            const std::map< std::string, netCDF::NcVarAtt > atts = var.getAtts();
+            
+            variable.attributes.reserve( atts.size() );
+            
+            for( std::map< std::string, netCDF::NcVarAtt >::const_iterator itAtt = atts.begin();
+                itAtt != atts.end();
+                ++itAtt )
+            {
+                variable.attributes.push_back( NcMetadataHelper::MakeAttribute( (*itAtt).first, (*itAtt).second ) );
+            }
+            
+            /// the packing parameters are read once, rather than on every read of the values
+            variable.packed = sofa::NcUtils::GetPackingParameters( variable.scale, variable.offset, var );
+        }
+    }
+    
+    loaded = true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the snapshot has been loaded successfully
+ *
+ */
+/************************************************************************************/
+bool NcMetadata::IsLoaded() const
+{
+    return loaded;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns all the global attributes, sorted by name
+ *
+ */
+/************************************************************************************/
+const std::vector< NcMetadata::Attribute > & NcMetadata::GetAttributes() const
+{
+    return attributes;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns all the dimensions, sorted by name
+ *
+ */
+/************************************************************************************/
+const std::vector< NcMetadata::Dimension > & NcMetadata::GetDimensions() const
+{
+    return dimensions;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns all the variables, sorted by name
+ *
+ */
+/************************************************************************************/
+const std::vector< NcMetadata::Variable > & NcMetadata::GetVariables() const
+{
+    return variables;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a global attribute given its name.
+ *                  Returns NULL if the attribute does not exist
+ *  @param[in]      attributeName : name of the attribute to query
+ *
+ */
+/************************************************************************************/
+const NcMetadata::Attribute * NcMetadata::FindAttribute(const std::string &attributeName) const
+{
+    return NcMetadataHelper::Find( attributes, attributesIndex, attributeName );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a dimension given its name.
+ *                  Returns NULL if the dimension does not exist
+ *  @param[in]      dimensionName : name of the dimension to query
+ *
+ */
+/************************************************************************************/
+const NcMetadata::Dimension * NcMetadata::FindDimension(const std::string &dimensionName) const
+{
+    return NcMetadataHelper::Find( dimensions, dimensionsIndex, dimensionName );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a variable given its name.
+ *                  Returns NULL if the variable does not exist
+ *  @param[in]      variableName : name of the variable to query
+ *
+ */
+/************************************************************************************/
+const NcMetadata::Variable * NcMetadata::FindVariable(const std::string &variableName) const
+{
+    return NcMetadataHelper::Find( variables, variablesIndex, variableName );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves an attribute of the variable given its name.
+ *                  Returns NULL if the attribute does not exist
+ *  @param[in]      attributeName : name of the attribute to query
+ *
+ */
+/************************************************************************************/
+const NcMetadata::Attribute * NcMetadata::Variable::FindAttribute(const std::string &attributeName) const
+{
+    /// variables only have a few attributes : a linear search is enough
+    for( std::size_t i = 0; i < attributes.size(); i++ )
+    {
+        if( attributes[i].name == attributeName )
+        {
+            return &attributes[i];
+        }
+    }
+    
+    return NULL;
+}
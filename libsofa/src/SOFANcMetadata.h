@@ -0,0 +1,146 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFANcMetadata.h
+ *   @brief      Snapshot of the metadata of a netCDF file
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_NC_METADATA_H__
+#define _SOFA_NC_METADATA_H__
+
+#include "../src/SOFAPlatform.h"
+#include "netcdf.h"
+#include "ncFile.h"
+#include <map>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          NcMetadata
+     *  @brief          Immutable snapshot of the metadata of a netCDF file
+     *
+     *  @details        Holds the global attributes, the dimensions, and the variables
+     *                  (type, shape and attributes) of a netCDF file, as they were when the
+     *                  snapshot was loaded. Once loaded, all queries are answered without
+     *                  any call to the netCDF library.
+     *                  Attributes, dimensions and variables are sorted by name.
+     */
+    /************************************************************************************/
+    class SOFA_API NcMetadata
+    {
+    public:
+        struct Attribute
+        {
+            std::string name;
+            nc_type type;
+            std::string value;                          ///< value as a string (only for nc_CHAR attributes; empty otherwise)
+        };
+        
+        struct Dimension
+        {
+            std::string name;
+            std::size_t size;
+        };
+        
+        struct Variable
+        {
+            std::string name;
+            nc_type type;
+            std::string typeName;
+            std::vector< std::string > dimensionsNames;
+            std::vector< std::size_t > dimensions;
+            std::vector< Attribute > attributes;        ///< sorted by name
+            
+            bool packed;                                ///< has CF packing attributes (scale_factor, add_offset)
+            double scale;                               ///< scale_factor, or 1
+            double offset;                              ///< add_offset, or 0
+            
+            const Attribute * FindAttribute(const std::string &attributeName) const;
+        };
+    
+    public:
+        NcMetadata();
+        NcMetadata(const netCDF::NcFile &file, const bool shouldLoad = true);
+        
+        ~NcMetadata() {};
+        
+        bool IsLoaded() const;
+        
+        //==============================================================================
+        const std::vector< Attribute > & GetAttributes() const;
+        const std::vector< Dimension > & GetDimensions() const;
+        const std::vector< Variable > & GetVariables() const;
+        
+        const Attribute * FindAttribute(const std::string &attributeName) const;
+        const Dimension * FindDimension(const std::string &dimensionName) const;
+        const Variable * FindVariable(const std::string &variableName) const;
+    
+    private:
+        //==============================================================================
+        void load(const netCDF::NcFile &file);
+        
+        typedef std::map< std::string, std::size_t > NameIndex;
+        
+        bool loaded;
+        
+        std::vector< Attribute > attributes;
+        std::vector< Dimension > dimensions;
+        std::vector< Variable > variables;
+        
+        NameIndex attributesIndex;
+        NameIndex dimensionsIndex;
+        NameIndex variablesIndex;
+    
+    private:
+        //==============================================================================
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( NcMetadata );
+    };
+
+}
+
+#endif /* _SOFA_NC_METADATA_H__ */
+
@@ -55,6 +55,7 @@ http://www.sofaconventions.org
 #include "ncDim.h"
 #include "ncAtt.h"
 #include "ncException.h"
+#include <limits>
 
 namespace sofa
 {
@@ -116,6 +117,19 @@ namespace sofa
             return CheckType( ncStuff, netCDF::NcType::nc_DOUBLE );
         }
         
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns true if a NcVar or NcAtt is of type nc_DOUBLE or nc_FLOAT
+         *  @param[in]      ncStuff : the stuff to query
+         *
+         */
+        /************************************************************************************/
+        template< typename NetCDFType >
+        bool IsFloatingPoint(const NetCDFType & ncStuff)
+        {
+            return IsDouble( ncStuff ) == true || IsFloat( ncStuff ) == true;
+        }
+        
         /************************************************************************************/
         /*!
          *  @brief          Returns true if a NcVar or NcAtt is of type nc_BYTE
@@ -181,6 +195,40 @@ namespace sofa
             return CheckType( ncStuff, netCDF::NcType::nc_INT64 );
         }
         
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns true if a NcVar or NcAtt is of a numeric type, i.e. any
+         *                  integer type (signed or unsigned, 8 to 64 bits), nc_FLOAT or nc_DOUBLE
+         *  @param[in]      ncStuff : the stuff to query
+         *
+         */
+        /************************************************************************************/
+        template< typename NetCDFType >
+        bool IsNumeric(const NetCDFType & ncStuff)
+        {
+            if( IsValid( ncStuff ) == false )
+            {
+                return false;
+            }
+            
+            switch( ncStuff.getType().getTypeClass() )
+            {
+                case netCDF::NcType::nc_BYTE :
+                case netCDF::NcType::nc_UBYTE :
+                case netCDF::NcType::nc_SHORT :
+                case netCDF::NcType::nc_USHORT :
+                case netCDF::NcType::nc_INT :
+                case netCDF::NcType::nc_UINT :
+                case netCDF::NcType::nc_INT64 :
+                case netCDF::NcType::nc_UINT64 :
+                case netCDF::NcType::nc_FLOAT :
+                case netCDF::NcType::nc_DOUBLE :
+                    return true;
+                default :
+                    return false;
+            }
+        }
+        
             
         /************************************************************************************/
         /*!
@@ -291,7 +339,7 @@ namespace sofa
         /************************************************************************************/
         /*!
          *  @brief          Retrieves the value of a NcVar, as double.
-         *                  This assumes the NcVar is scalar, of type double;
+         *                  This assumes the NcVar is scalar, of type double (or float);
          *  @param[in]      ncStuff : the stuff to query
          *  @param[out]     value : the requested value
          *
@@ -299,7 +347,7 @@ namespace sofa
         /************************************************************************************/
         inline bool GetValue(double &value, const netCDF::NcVar & ncStuff)
         {
-            if( IsScalar( ncStuff ) == true && IsDouble( ncStuff ) == true )
+            if( IsScalar( ncStuff ) == true && IsFloatingPoint( ncStuff ) == true )
             {
                 ncStuff.getVar( &value );
                  
@@ -379,10 +427,200 @@ namespace sofa
             }
         }
         
+        /************************************************************************************/
+        /*!
+         *  @brief          Retrieves if a variable has a given attribute
+         *  @param[in]      var : the Nc variable to query
+         *  @param[in]      attributeName : the name of the attribute
+         *
+         */
+        /************************************************************************************/
+        inline bool HasAttribute(const netCDF::NcVar & var,
+                                 const std::string & attributeName)
+        {
+            if( IsValid( var ) == false )
+            {
+                return false;
+            }
+            else
+            {
+                /// direct lookup by name, rather than enumerating all the attributes of the variable
+                const int groupId = var.getParentGroup().getId();
+                int attributeId   = -1;
+                
+                return ( nc_inq_attid( groupId, var.getId(), attributeName.c_str(), &attributeId ) == NC_NOERR );
+            }
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Retrieves the attribute of a given variable, if it exists
+         *                  Returns a null object otherwise
+         *  @param[in]      var : the Nc variable to query
+         *  @param[in]      attributeName : the name of the attribute we want to retrieve
+         *
+         */
+        /************************************************************************************/ 
+        inline netCDF::NcVarAtt GetAttribute(const netCDF::NcVar & var,
+                                             const std::string & attributeName)
+        {
+            if( IsValid( var ) == false )
+            {
+                return netCDF::NcVarAtt();
+            }
+            else
+            {
+                if( sofa::NcUtils::HasAttribute( var, attributeName ) == true )
+                {
+                    return var.getAtt( attributeName );
+                }
+                else
+                {
+                    return netCDF::NcVarAtt();
+                }
+            }
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Retrieves the CF packing attributes of a variable (scale_factor and
+         *                  add_offset), i.e. unpacked = packed * scale + offset
+         *                  Returns false if the variable is not packed (then scale = 1 and offset = 0)
+         *  @param[out]     scale : the scale_factor attribute, or 1 if missing
+         *  @param[out]     offset : the add_offset attribute, or 0 if missing
+         *  @param[in]      var : the Nc variable to query
+         *
+         */
+        /************************************************************************************/
+        inline bool GetPackingParameters(double &scale,
+                                         double &offset,
+                                         const netCDF::NcVar & var)
+        {
+            scale  = 1.0;
+            offset = 0.0;
+            
+            const netCDF::NcVarAtt attScale  = GetAttribute( var, "scale_factor" );
+            const netCDF::NcVarAtt attOffset = GetAttribute( var, "add_offset" );
+            
+            bool packed = false;
+            
+            if( IsNumeric( attScale ) == true && attScale.getAttLength() == 1 )
+            {
+                attScale.getValues( &scale );
+                packed = true;
+            }
+            
+            if( IsNumeric( attOffset ) == true && attOffset.getAttLength() == 1 )
+            {
+                attOffset.getValues( &offset );
+                packed = true;
+            }
+            
+            return packed;
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Converts an unpacked value to T
+         *
+         *  @details        Converting a double out of the range of an integer type (or NaN) is
+         *                  undefined : for the integer types, the value is truncated toward zero
+         *                  then saturated to the range of T, and NaN gives 0
+         */
+        /************************************************************************************/
+        template< typename T, bool isInteger = std::numeric_limits< T >::is_integer >
+        struct UnpackedValue
+        {
+            static T Convert(const double value)
+            {
+                return static_cast< T >( value );
+            }
+        };
+        
+        template< typename T >
+        struct UnpackedValue< T, true >
+        {
+            static T Convert(const double value)
+            {
+                if( value != value )
+                {
+                    return 0;
+                }
+                
+                /// (the bounds are exact, or rounded up to a power of 2, as double)
+                if( value <= static_cast< double >( std::numeric_limits< T >::min() ) )
+                {
+                    return std::numeric_limits< T >::min();
+                }
+                
+                if( value >= static_cast< double >( std::numeric_limits< T >::max() ) )
+                {
+                    return std::numeric_limits< T >::max();
+                }
+                
+                return static_cast< T >( value );
+            }
+        };
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Unpacks values : values[i] = packed[i] * scale + offset
+         *                  The computation is done in double precision, then converted to T
+         *                  (truncated toward zero, and saturated, for integer types)
+         *  @param[out]     values : the unpacked values (must not overlap packed)
+         *  @param[in]      packed : the values, as stored in the file
+         *  @param[in]      numValues : number of values
+         *  @param[in]      scale : the scale_factor
+         *  @param[in]      offset : the add_offset
+         *
+         *  @details        a plain loop over contiguous arrays, without branches for the
+         *                  floating-point types, that the compiler vectorizes
+         */
+        /************************************************************************************/
+        template< typename T, typename Stored >
+        void UnpackValues(T *values,
+                          const Stored *packed,
+                          const std::size_t numValues,
+                          const double scale,
+                          const double offset)
+        {
+            for( std::size_t i = 0; i < numValues; i++ )
+            {
+                values[i] = UnpackedValue< T >::Convert( static_cast< double >( packed[i] ) * scale + offset );
+            }
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Unpacks in place values already read as double, if the variable is packed
+         *  @param[in, out] values : the values read from the variable
+         *  @param[in]      numValues : number of values
+         *  @param[in]      var : the Nc variable the values were read from
+         *
+         */
+        /************************************************************************************/
+        inline void UnpackValues(double *values,
+                                 const std::size_t numValues,
+                                 const netCDF::NcVar & var)
+        {
+            double scale  = 1.0;
+            double offset = 0.0;
+            
+            if( GetPackingParameters( scale, offset, var ) == true )
+            {
+                /// all the packed types up to 32 bits are exactly represented as double
+                for( std::size_t i = 0; i < numValues; i++ )
+                {
+                    values[i] = values[i] * scale + offset;
+                }
+            }
+        }
+        
         /************************************************************************************/
         /*!
          *  @brief          Retrieves the values of a NcVar, as double.
-         *                  This assumes the NcVar has 'numValues' values, of type double;
+         *                  This assumes the NcVar has 'numValues' values, of any numeric type;
+         *                  packed values (scale_factor, add_offset) are unpacked
          *  @param[in]      ncStuff : the stuff to query
          *  @param[in]      numValues : number of values to read
          *  @param[out]     values : the requested values
@@ -394,7 +632,7 @@ namespace sofa
                               const netCDF::NcVar & ncStuff)
         {
             
-            if( IsValid( ncStuff ) == true && IsDouble( ncStuff ) == true  )
+            if( IsValid( ncStuff ) == true && IsNumeric( ncStuff ) == true  )
             {
                 /// dimensionality might be 2 for instance for a [I C] variable
                 std::vector< std::size_t > dims;
@@ -405,6 +643,7 @@ namespace sofa
                     if( dims[0] == numValues )
                     {
                         ncStuff.getVar( values );
+                        UnpackValues( values, numValues, ncStuff );
                         return true;
                     }
                     else
@@ -420,6 +659,7 @@ namespace sofa
                        )
                     {
                         ncStuff.getVar( values );
+                        UnpackValues( values, numValues, ncStuff );
                         return true;
                     }
                     else
@@ -439,70 +679,6 @@ namespace sofa
 
         }
         
-        /************************************************************************************/
-        /*!
-         *  @brief          Retrieves if a variable has a given attribute
-         *  @param[in]      var : the Nc variable to query
-         *  @param[in]      attributeName : the name of the attribute
-         *
-         */
-        /************************************************************************************/
-        inline bool HasAttribute(const netCDF::NcVar & var,
-                                 const std::string & attributeName)
-        {
-            if( IsValid( var ) == false )
-            {
-                return false;
-            }
-            else
-            {
-                const std::map< std::string, netCDF::NcVarAtt > attributes = var.getAtts();
-                
-                for( std::map< std::string, netCDF::NcVarAtt >::const_iterator it = attributes.begin();
-                    it != attributes.end();
-                    ++it )
-                {
-                    const std::string attrName      = (*it).first;
-                    
-                    if( attrName == attributeName )
-                    {
-                        return true;
-                    }
-                }
-                
-                return false;
-            }
-        }
-        
-        /************************************************************************************/
-        /*!
-         *  @brief          Retrieves the attribute of a given variable, if it exists
-         *                  Returns a null object otherwise
-         *  @param[in]      var : the Nc variable to query
-         *  @param[in]      attributeName : the name of the attribute we want to retrieve
-         *
-         */
-        /************************************************************************************/ 
-        inline netCDF::NcVarAtt GetAttribute(const netCDF::NcVar & var,
-                                             const std::string & attributeName)
-        {
-            if( IsValid( var ) == false )
-            {
-                return netCDF::NcVarAtt();
-            }
-            else
-            {
-                if( sofa::NcUtils::HasAttribute( var, attributeName ) == true )
-                {
-                    return var.getAtt( attributeName );
-                }
-                else
-                {
-                    return netCDF::NcVarAtt();
-                }
-            }
-        }
-        
 
         
         /************************************************************************************/
@@ -620,6 +796,109 @@ namespace sofa
             return ( dims[0] == dim1 && dims[1] == dim2 && dims[2] == dim3 && dims[3] == dim4 );
         }
         
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns the number of elements described by a hyperslab 'count' vector
+         *                  (i.e. the product of all counts). Returns 0 if the vector is empty
+         *  @param[in]      count : number of elements along each dimension
+         *
+         */
+        /************************************************************************************/
+        inline std::size_t GetNumElements(const std::vector< std::size_t > &count)
+        {
+            if( count.size() == 0 )
+            {
+                return 0;
+            }
+            
+            std::size_t numElements = count[0];
+            for( std::size_t i = 1; i < count.size(); i++ )
+            {
+                numElements *= count[i];
+            }
+            
+            return numElements;
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns true if (start, count, stride) describes a valid hyperslab of a NcVar,
+         *                  i.e. the vectors match the dimensionality of the variable, all counts are
+         *                  strictly positive and the hyperslab fits within the variable dimensions.
+         *  @param[in]      start : index of the first element along each dimension
+         *  @param[in]      count : number of elements along each dimension
+         *  @param[in]      stride : sampling interval along each dimension (an empty vector means unit stride)
+         *  @param[in]      var : the Nc variable to query
+         *
+         */
+        /************************************************************************************/
+        inline bool IsValidHyperslab(const std::vector< std::size_t > &start,
+                                     const std::vector< std::size_t > &count,
+                                     const std::vector< std::ptrdiff_t > &stride,
+                                     const netCDF::NcVar & var)
+        {
+            std::vector< std::size_t > dims;
+            GetDimensions( dims, var );
+            
+            if( dims.size() == 0
+               || start.size() != dims.size()
+               || count.size() != dims.size() )
+            {
+                return false;
+            }
+            
+            if( stride.size() != 0 && stride.size() != dims.size() )
+            {
+                return false;
+            }
+            
+            for( std::size_t i = 0; i < dims.size(); i++ )
+            {
+                const std::size_t step = ( stride.size() == 0 ) ? 1 : (std::size_t) stride[i];
+                
+                if( stride.size() != 0 && stride[i] <= 0 )
+                {
+                    return false;
+                }
+                
+                if( count[i] == 0 || start[i] >= dims[i] )
+                {
+                    return false;
+                }
+                
+                /// index of the last element read along this dimension
+                const std::size_t last = start[i] + ( count[i] - 1 ) * step;
+                
+                if( last >= dims[i] )
+                {
+                    return false;
+                }
+            }
+            
+            return true;
+        }
+        
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns true if all the elements of a stride vector are equal to 1
+         *                  (or if the vector is empty)
+         *  @param[in]      stride : sampling interval along each dimension
+         *
+         */
+        /************************************************************************************/
+        inline bool IsUnitStride(const std::vector< std::ptrdiff_t > &stride)
+        {
+            for( std::size_t i = 0; i < stride.size(); i++ )
+            {
+                if( stride[i] != 1 )
+                {
+                    return false;
+                }
+            }
+            
+            return true;
+        }
+    
     }
 }
 
@@ -0,0 +1,261 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAOpenOptions.cpp
+ *   @brief      Options used when opening a SOFA file
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAOpenOptions.h"
+#include "../src/SOFAUtils.h"
+
+using namespace sofa;
+
+namespace OpenOptionsHelper
+{
+    /// upper bound of the cache sized automatically for random access (per variable)
+    static const std::size_t kMaxAutomaticCacheSize = 64 * 1024 * 1024;
+    
+    /// number of hash slots per chunk held in the cache (HDF5 advises at least 10, ideally 100)
+    static const std::size_t kSlotsPerChunk = 10;
+    
+    static bool isPrime(const std::size_t n)
+    {
+        if( n < 2 )
+        {
+            return false;
+        }
+        
+        for( std::size_t i = 2; i * i <= n; i++ )
+        {
+            if( n % i == 0 )
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    /// HDF5 advises a prime number of slots, to limit the collisions in the hash table
+    static std::size_t nextPrime(const std::size_t n)
+    {
+        std::size_t prime = n;
+        
+        while( isPrime( prime ) == false )
+        {
+            prime++;
+        }
+        
+        return prime;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : all the library defaults are kept
+ *
+ */
+/************************************************************************************/
+OpenOptions::OpenOptions()
+: chunkCacheSize( 0 )
+, chunkCacheSlots( 0 )
+, chunkCachePreemption( -1.0f )
+, accessPattern( kDefaultAccess )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      chunkCacheSize : size of the chunk cache of each variable, in bytes (0 : default)
+ *  @param[in]      chunkCacheSlots : number of hash slots of each cache (0 : default)
+ *  @param[in]      chunkCachePreemption : in [0 1] (negative : default)
+ *  @param[in]      accessPattern : how the data of the file is going to be read
+ *
+ */
+/************************************************************************************/
+OpenOptions::OpenOptions(const std::size_t chunkCacheSize_,
+                         const std::size_t chunkCacheSlots_,
+                         const float chunkCachePreemption_,
+                         const AccessPattern accessPattern_)
+: chunkCacheSize( chunkCacheSize_ )
+, chunkCacheSlots( chunkCacheSlots_ )
+, chunkCachePreemption( chunkCachePreemption_ )
+, accessPattern( accessPattern_ )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : the cache settings are derived from the access pattern
+ *  @param[in]      accessPattern : how the data of the file is going to be read
+ *
+ */
+/************************************************************************************/
+OpenOptions::OpenOptions(const AccessPattern accessPattern_)
+: chunkCacheSize( 0 )
+, chunkCacheSlots( 0 )
+, chunkCachePreemption( -1.0f )
+, accessPattern( accessPattern_ )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the options keep all the library defaults
+ *
+ */
+/************************************************************************************/
+bool OpenOptions::IsDefault() const
+{
+    return ( chunkCacheSize == 0
+            && chunkCacheSlots == 0
+            && chunkCachePreemption < 0.0f
+            && accessPattern == kDefaultAccess );
+}
+
+void OpenOptions::SetChunkCacheSize(const std::size_t size)
+{
+    chunkCacheSize = size;
+}
+
+void OpenOptions::SetChunkCacheSlots(const std::size_t numSlots)
+{
+    chunkCacheSlots = numSlots;
+}
+
+void OpenOptions::SetChunkCachePreemption(const float preemption)
+{
+    chunkCachePreemption = ( preemption < 0.0f ) ? -1.0f : sofa::smin( preemption, 1.0f );
+}
+
+void OpenOptions::SetAccessPattern(const AccessPattern pattern)
+{
+    accessPattern = pattern;
+}
+
+std::size_t OpenOptions::GetChunkCacheSize() const
+{
+    return chunkCacheSize;
+}
+
+std::size_t OpenOptions::GetChunkCacheSlots() const
+{
+    return chunkCacheSlots;
+}
+
+float OpenOptions::GetChunkCachePreemption() const
+{
+    return chunkCachePreemption;
+}
+
+OpenOptions::AccessPattern OpenOptions::GetAccessPattern() const
+{
+    return accessPattern;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Resolves the chunk cache parameters of one variable
+ *  @param[in, out] size : the current cache size, in bytes; receives the size to use
+ *  @param[in, out] numSlots : the current number of hash slots; receives the number to use
+ *  @param[in, out] preemption : the current preemption; receives the preemption to use
+ *  @param[in]      variableSize : size of the (uncompressed) variable, in bytes
+ *  @param[in]      chunkSize : size of one (uncompressed) chunk of the variable, in bytes
+ *
+ *  @details        The explicit settings always win. Otherwise :
+ *                  - random access : the cache is enlarged to hold the whole variable
+ *                  (within 64 MB), and recently used chunks are kept even if fully read
+ *                  - sequential access : the cache holds at least one chunk (HDF5 does
+ *                  not cache the chunks larger than the cache), and fully read chunks are
+ *                  evicted first
+ */
+/************************************************************************************/
+void OpenOptions::GetChunkCacheParameters(std::size_t &size,
+                                          std::size_t &numSlots,
+                                          float &preemption,
+                                          const std::size_t variableSize,
+                                          const std::size_t chunkSize) const
+{
+    const std::size_t defaultSize = size;
+    
+    if( chunkCacheSize > 0 )
+    {
+        size = chunkCacheSize;
+    }
+    else if( accessPattern == kRandomAccess )
+    {
+        size = sofa::smax( defaultSize, sofa::smin( variableSize, OpenOptionsHelper::kMaxAutomaticCacheSize ) );
+    }
+    else if( accessPattern == kSequentialAccess )
+    {
+        size = sofa::smax( defaultSize, chunkSize );
+    }
+    
+    if( chunkCacheSlots > 0 )
+    {
+        numSlots = chunkCacheSlots;
+    }
+    else if( size != defaultSize && chunkSize > 0 )
+    {
+        const std::size_t numChunks = ( size + chunkSize - 1 ) / chunkSize;
+        
+        numSlots = sofa::smax( numSlots, OpenOptionsHelper::nextPrime( numChunks * OpenOptionsHelper::kSlotsPerChunk ) );
+    }
+    
+    if( chunkCachePreemption >= 0.0f )
+    {
+        preemption = chunkCachePreemption;
+    }
+    else if( accessPattern == kRandomAccess )
+    {
+        preemption = 0.0f;
+    }
+    else if( accessPattern == kSequentialAccess )
+    {
+        preemption = 1.0f;
+    }
+}
+
@@ -0,0 +1,122 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAOpenOptions.h
+ *   @brief      Options used when opening a SOFA file
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_OPEN_OPTIONS_H__
+#define _SOFA_OPEN_OPTIONS_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          OpenOptions
+     *  @brief          Options used when opening a SOFA file
+     *
+     *  @details        Tunes the HDF5 chunk cache of each (chunked) variable of the file.
+     *                  By default, netCDF gives each variable a cache of a few MB : the chunks
+     *                  of a large Data.IR may not fit, and reading the measurements one at a
+     *                  time then inflates the same chunks again and again.
+     *                  The cache settings left to 0 (or negative, for the preemption) are
+     *                  derived from the access pattern hint, or else left to the library defaults.
+     */
+    /************************************************************************************/
+    class SOFA_API OpenOptions
+    {
+    public:
+        /// how the data of the file is going to be read
+        enum AccessPattern
+        {
+            kDefaultAccess      = 0,    ///< no hint : the library defaults are kept
+            kSequentialAccess   = 1,    ///< each chunk is read once, in storage order
+            kRandomAccess       = 2     ///< the same chunks are read several times, in any order
+        };
+    
+    public:
+        OpenOptions();
+        
+        OpenOptions(const std::size_t chunkCacheSize,
+                    const std::size_t chunkCacheSlots = 0,
+                    const float chunkCachePreemption = -1.0f,
+                    const AccessPattern accessPattern = kDefaultAccess);
+        
+        explicit OpenOptions(const AccessPattern accessPattern);
+        
+        ~OpenOptions() {};
+        
+        bool IsDefault() const;
+        
+        void SetChunkCacheSize(const std::size_t size);
+        void SetChunkCacheSlots(const std::size_t numSlots);
+        void SetChunkCachePreemption(const float preemption);
+        void SetAccessPattern(const AccessPattern pattern);
+        
+        std::size_t GetChunkCacheSize() const;
+        std::size_t GetChunkCacheSlots() const;
+        float GetChunkCachePreemption() const;
+        AccessPattern GetAccessPattern() const;
+        
+        void GetChunkCacheParameters(std::size_t &size,
+                                     std::size_t &numSlots,
+                                     float &preemption,
+                                     const std::size_t variableSize,
+                                     const std::size_t chunkSize) const;
+    
+    private:
+        std::size_t chunkCacheSize;     ///< size of the cache of each variable, in bytes (0 : default)
+        std::size_t chunkCacheSlots;    ///< number of hash slots of the cache of each variable (0 : default)
+        float chunkCachePreemption;     ///< in [0 1], 1 evicts fully read chunks first (negative : default)
+        AccessPattern accessPattern;
+    };
+
+}
+
+#endif /* _SOFA_OPEN_OPTIONS_H__ */
+
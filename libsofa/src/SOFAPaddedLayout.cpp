@@ -0,0 +1,211 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAPaddedLayout.cpp
+ *   @brief      Describes zero-padded slots receiving impulse responses (e.g. for FFT)
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAPaddedLayout.h"
+#include "../src/SOFAUtils.h"
+#include <cstring>
+#include <algorithm>
+
+using namespace sofa;
+
+namespace PaddedLayoutHelper
+{
+    template< typename T >
+    static void copyToSlots(T *dst,
+                            const T *src,
+                            const std::size_t numResponses,
+                            const std::size_t numSamples,
+                            const std::size_t slotSize,
+                            const bool zeroTail)
+    {
+        SOFA_ASSERT( slotSize >= numSamples );
+        
+        for( std::size_t i = 0; i < numResponses; i++ )
+        {
+            T *slot = dst + i * slotSize;
+            
+            std::memcpy( slot, src + i * numSamples, numSamples * sizeof( T ) );
+            
+            if( zeroTail == true )
+            {
+                std::fill( slot + numSamples, slot + slotSize, static_cast< T >( 0 ) );
+            }
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      blockSize : the slot size is rounded up to a multiple of this size (0 : no constraint)
+ *  @param[in]      powerOfTwo : the slot size is rounded up to a power of two
+ *  @param[in]      zeroTail : the samples after the impulse response are set to zero
+ *
+ */
+/************************************************************************************/
+PaddedLayout::PaddedLayout(const std::size_t blockSize_,
+                           const bool powerOfTwo_,
+                           const bool zeroTail_)
+: slotSize( 0 )
+, blockSize( blockSize_ )
+, powerOfTwo( powerOfTwo_ )
+, zeroTail( zeroTail_ )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the size of the slots explicitly (0 : computed from the number of samples).
+ *                  The size must not be less than the number of samples
+ *
+ */
+/************************************************************************************/
+void PaddedLayout::SetSlotSize(const std::size_t slotSize_)
+{
+    slotSize = slotSize_;
+}
+
+void PaddedLayout::SetBlockSize(const std::size_t blockSize_)
+{
+    blockSize = blockSize_;
+}
+
+void PaddedLayout::SetPowerOfTwo(const bool powerOfTwo_)
+{
+    powerOfTwo = powerOfTwo_;
+}
+
+void PaddedLayout::SetZeroTail(const bool zeroTail_)
+{
+    zeroTail = zeroTail_;
+}
+
+std::size_t PaddedLayout::GetBlockSize() const
+{
+    return blockSize;
+}
+
+bool PaddedLayout::IsPowerOfTwo() const
+{
+    return powerOfTwo;
+}
+
+bool PaddedLayout::HasZeroTail() const
+{
+    return zeroTail;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the size of the slots for impulse responses of a given length
+ *  @param[in]      numSamples : length of the impulse responses (N)
+ *  @return         the size of a slot (in samples), or 0 if the explicit slot size is too short
+ *
+ */
+/************************************************************************************/
+std::size_t PaddedLayout::GetSlotSize(const std::size_t numSamples) const
+{
+    if( slotSize > 0 )
+    {
+        return ( slotSize >= numSamples ) ? slotSize : 0;
+    }
+    
+    std::size_t size = sofa::smax( numSamples, (std::size_t) 1 );
+    
+    if( powerOfTwo == true )
+    {
+        std::size_t power = 1;
+        
+        while( power < size )
+        {
+            power *= 2;
+        }
+        
+        size = power;
+    }
+    
+    if( blockSize > 0 )
+    {
+        size = ( ( size + blockSize - 1 ) / blockSize ) * blockSize;
+    }
+    
+    return size;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Copies contiguous impulse responses into their slots
+ *  @param[out]     dst : the slots (numResponses * slotSize values)
+ *  @param[in]      src : the impulse responses (numResponses * numSamples values)
+ *  @param[in]      numResponses : number of impulse responses
+ *  @param[in]      numSamples : length of the impulse responses
+ *  @param[in]      slotSize : size of the slots (not less than numSamples)
+ *  @param[in]      zeroTail : set the rest of each slot to zero
+ *
+ */
+/************************************************************************************/
+void PaddedLayout::CopyToSlots(double *dst,
+                               const double *src,
+                               const std::size_t numResponses,
+                               const std::size_t numSamples,
+                               const std::size_t slotSize_,
+                               const bool zeroTail_)
+{
+    PaddedLayoutHelper::copyToSlots( dst, src, numResponses, numSamples, slotSize_, zeroTail_ );
+}
+
+void PaddedLayout::CopyToSlots(float *dst,
+                               const float *src,
+                               const std::size_t numResponses,
+                               const std::size_t numSamples,
+                               const std::size_t slotSize_,
+                               const bool zeroTail_)
+{
+    PaddedLayoutHelper::copyToSlots( dst, src, numResponses, numSamples, slotSize_, zeroTail_ );
+}
@@ -0,0 +1,115 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAPaddedLayout.h
+ *   @brief      Describes zero-padded slots receiving impulse responses (e.g. for FFT)
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_PADDED_LAYOUT_H__
+#define _SOFA_PADDED_LAYOUT_H__
+
+#include "../src/SOFAPlatform.h"
+#include <cstddef>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          PaddedLayout
+     *  @brief          Describes the slots receiving the impulse responses of Data.IR, one slot
+     *                  per impulse response, each slot being longer than the impulse response
+     *
+     *  @details        The N samples of each impulse response are written at the beginning of
+     *                  its slot, and the rest of the slot (the tail) is filled with zeros, so
+     *                  that the slots can be handed as is to a FFT or a partitioned convolution.
+     *                  By default, the slot size is N rounded up to a power of two; it may also be
+     *                  rounded up to a multiple of a block size (partition size), or given explicitly.
+     *                  In a sofa::Array, all the slots are 64-byte aligned as soon as the size of
+     *                  a slot in bytes is a multiple of 64 (e.g. any power of two >= 16 floats).
+     */
+    /************************************************************************************/
+    class SOFA_API PaddedLayout
+    {
+    public:
+        explicit PaddedLayout(const std::size_t blockSize = 0,
+                              const bool powerOfTwo = true,
+                              const bool zeroTail = true);
+        
+        void SetSlotSize(const std::size_t slotSize);
+        void SetBlockSize(const std::size_t blockSize);
+        void SetPowerOfTwo(const bool powerOfTwo);
+        void SetZeroTail(const bool zeroTail);
+        
+        std::size_t GetBlockSize() const;
+        bool IsPowerOfTwo() const;
+        bool HasZeroTail() const;
+        
+        std::size_t GetSlotSize(const std::size_t numSamples) const;
+        
+        static void CopyToSlots(double *dst,
+                                const double *src,
+                                const std::size_t numResponses,
+                                const std::size_t numSamples,
+                                const std::size_t slotSize,
+                                const bool zeroTail);
+        
+        static void CopyToSlots(float *dst,
+                                const float *src,
+                                const std::size_t numResponses,
+                                const std::size_t numSamples,
+                                const std::size_t slotSize,
+                                const bool zeroTail);
+    
+    private:
+        std::size_t slotSize;       ///< explicit size of the slots (0 : computed from N)
+        std::size_t blockSize;      ///< the slot size is a multiple of the block size (0 : no constraint)
+        bool powerOfTwo;            ///< the slot size is a power of two
+        bool zeroTail;              ///< the samples after the impulse response are set to zero
+    };
+
+}
+
+#endif /* _SOFA_PADDED_LAYOUT_H__ */
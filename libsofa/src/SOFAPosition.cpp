@@ -129,7 +129,7 @@ bool PositionVariable::HasDimensions(const std::size_t dim1, const std::size_t d
 bool PositionVariable::HasUnits() const
 {
     SOFA_ASSERT( sofa::NcUtils::IsValid( var ) == true );
-    SOFA_ASSERT( sofa::NcUtils::IsDouble( var ) == true );
+    SOFA_ASSERT( sofa::NcUtils::IsFloatingPoint( var ) == true );
     
     const netCDF::NcVarAtt attrType = sofa::NcUtils::GetAttribute( var, "Type" );
     
@@ -139,7 +139,7 @@ bool PositionVariable::HasUnits() const
 bool PositionVariable::HasCoordinates() const
 {
     SOFA_ASSERT( sofa::NcUtils::IsValid( var ) == true );
-    SOFA_ASSERT( sofa::NcUtils::IsDouble( var ) == true );
+    SOFA_ASSERT( sofa::NcUtils::IsFloatingPoint( var ) == true );
 
     const netCDF::NcVarAtt attrUnits = sofa::NcUtils::GetAttribute( var, "Units" );
     
@@ -169,7 +169,7 @@ bool PositionVariable::IsValid(const bool shouldHaveTypeAndUnits) const
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( var ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( var ) == false )
     {
         return false;
     }
@@ -0,0 +1,465 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAPrefetchReader.cpp
+ *   @brief      Reads slabs of measurements on a background thread
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAPrefetchReader.h"
+#include "../src/SOFAUtils.h"
+
+using namespace sofa;
+
+namespace PrefetchReaderHelper
+{
+    static std::size_t getNumValues(const std::vector< std::size_t > &count)
+    {
+        std::size_t numValues = 1;
+        
+        for( std::size_t i = 0; i < count.size(); i++ )
+        {
+            numValues *= count[i];
+        }
+        
+        return numValues;
+    }
+}
+
+const std::size_t PrefetchReader::kAll = (std::size_t) -1;
+
+PrefetchReader::SlabRequest::SlabRequest(const std::size_t measurement_,
+                                         const std::size_t receiver_,
+                                         const std::size_t emitter_)
+: measurement( measurement_ )
+, receiver( receiver_ )
+, emitter( emitter_ )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the file to read; it must outlive this object
+ *  @param[in]      variableName : the data variable to read, shaped [M R N] or [M R E N]
+ *  @param[in]      numBuffers : number of slabs that can be read ahead of the consumer
+ *
+ */
+/************************************************************************************/
+PrefetchReader::PrefetchReader(const sofa::File &file_,
+                               const std::string &variableName_,
+                               const std::size_t numBuffers_)
+: file( file_ )
+, variableName( variableName_ )
+, numBuffers( sofa::smax( numBuffers_, (std::size_t) 1 ) )
+, numRead( 0 )
+, numReleased( 0 )
+, acquired( false )
+, stopping( false )
+, failed( false )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor : stops the worker thread
+ *
+ */
+/************************************************************************************/
+PrefetchReader::~PrefetchReader()
+{
+    Stop();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the hyperslab of one request
+ *  @param[out]     start : index of the first value, along each dimension of the variable
+ *  @param[out]     count : number of values, along each dimension of the variable
+ *  @param[in]      request : the slab requested
+ *  @return         false if the request is out of the bounds of the variable
+ *
+ */
+/************************************************************************************/
+bool PrefetchReader::getSlabCount(std::vector< std::size_t > &start,
+                                  std::vector< std::size_t > &count,
+                                  const sofa::PrefetchReader::SlabRequest &request) const
+{
+    const std::size_t rank = variableDims.size();
+    
+    start.assign( rank, 0 );
+    count = variableDims;
+    
+    if( request.measurement >= variableDims[0] )
+    {
+        return false;
+    }
+    
+    start[0] = request.measurement;
+    count[0] = 1;
+    
+    if( request.receiver != kAll )
+    {
+        if( request.receiver >= variableDims[1] )
+        {
+            return false;
+        }
+        
+        start[1] = request.receiver;
+        count[1] = 1;
+    }
+    
+    if( rank == 4 && request.emitter != kAll )
+    {
+        if( request.emitter >= variableDims[2] )
+        {
+            return false;
+        }
+        
+        start[2] = request.emitter;
+        count[2] = 1;
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Starts reading a list of slabs on the worker thread.
+ *                  A reader already running is stopped first
+ *  @param[in]      requests : the slabs to read, in the order in which they will be acquired
+ *  @return         false if the variable is not shaped [M R N] or [M R E N],
+ *                  or if a request is out of its bounds
+ *
+ */
+/************************************************************************************/
+bool PrefetchReader::Start(const std::vector< sofa::PrefetchReader::SlabRequest > &requests_)
+{
+    Stop();
+    
+    requests.clear();
+    
+    if( file.HasVariable( variableName ) == false )
+    {
+        return false;
+    }
+    
+    file.GetVariableDimensions( variableDims, variableName );
+    
+    if( variableDims.size() != 3 && variableDims.size() != 4 )
+    {
+        return false;
+    }
+    
+    std::size_t maxSlabSize = 0;
+    
+    std::vector< std::size_t > start;
+    std::vector< std::size_t > count;
+    
+    for( std::size_t i = 0; i < requests_.size(); i++ )
+    {
+        if( getSlabCount( start, count, requests_[i] ) == false )
+        {
+            return false;
+        }
+        
+        maxSlabSize = sofa::smax( maxSlabSize, PrefetchReaderHelper::getNumValues( count ) );
+    }
+    
+    requests = requests_;
+    
+    /// the buffers are allocated once, and reused by all the slabs
+    buffers.resize( sofa::smin( numBuffers, sofa::smax( requests.size(), (std::size_t) 1 ) ) );
+    
+    for( std::size_t i = 0; i < buffers.size(); i++ )
+    {
+        buffers[i].resize( sofa::smax( maxSlabSize, (std::size_t) 1 ) );
+    }
+    
+    numRead     = 0;
+    numReleased = 0;
+    acquired    = false;
+    stopping    = false;
+    failed      = false;
+    
+    worker = std::thread( &PrefetchReader::run, this );
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Stops the worker thread, and waits for it to finish.
+ *                  The slabs not acquired yet are discarded
+ *
+ */
+/************************************************************************************/
+void PrefetchReader::Stop()
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        stopping = true;
+    }
+    
+    bufferFree.notify_all();
+    slabReady.notify_all();
+    
+    if( worker.joinable() == true )
+    {
+        worker.join();
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Worker thread : reads the slabs in order, as soon as a buffer is free
+ *
+ */
+/************************************************************************************/
+void PrefetchReader::run()
+{
+    std::vector< std::size_t > start;
+    std::vector< std::size_t > count;
+    
+    for( std::size_t i = 0; i < requests.size(); i++ )
+    {
+        {
+            std::unique_lock< std::mutex > lock( mutex );
+            
+            /// the buffer of slab i is free once slab i - numBuffers has been released
+            bufferFree.wait( lock, [&]{ return stopping == true || i < numReleased + buffers.size(); } );
+            
+            if( stopping == true )
+            {
+                return;
+            }
+        }
+        
+        getSlabCount( start, count, requests[i] );
+        
+        bool ok = false;
+        
+        try
+        {
+            ok = file.GetValues( &buffers[ i % buffers.size() ][0], start, count, variableName );
+        }
+        catch( ... )
+        {
+            ok = false;
+        }
+        
+        {
+            std::lock_guard< std::mutex > lock( mutex );
+            
+            if( ok == true )
+            {
+                numRead = i + 1;
+            }
+            else
+            {
+                failed = true;
+            }
+        }
+        
+        slabReady.notify_all();
+        
+        if( ok == false )
+        {
+            return;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Hands the next slab over to the consumer, if it has been read.
+ *                  The mutex shall be locked
+ *
+ */
+/************************************************************************************/
+bool PrefetchReader::acquireReadySlab(sofa::PrefetchReader::Slab &slab)
+{
+    if( stopping == true || numReleased >= numRead )
+    {
+        return false;
+    }
+    
+    const std::size_t index = numReleased;
+    
+    std::vector< std::size_t > start;
+    std::vector< std::size_t > count;
+    getSlabCount( start, count, requests[index] );
+    
+    slab.index      = index;
+    slab.request    = requests[index];
+    slab.values     = &buffers[ index % buffers.size() ][0];
+    slab.numValues  = PrefetchReaderHelper::getNumValues( count );
+    
+    acquired = true;
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Gives the buffer of the slab held by the consumer back to the worker.
+ *                  The mutex shall be locked
+ *
+ */
+/************************************************************************************/
+void PrefetchReader::releaseAcquiredSlab()
+{
+    if( acquired == true )
+    {
+        acquired = false;
+        numReleased++;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Waits for the next slab. The slab previously acquired is released
+ *  @param[out]     slab : the next slab; its values remain valid until it is released
+ *  @return         false once all the slabs have been acquired, or if the reader was
+ *                  stopped, or if a read failed
+ *
+ */
+/************************************************************************************/
+bool PrefetchReader::Acquire(sofa::PrefetchReader::Slab &slab)
+{
+    std::unique_lock< std::mutex > lock( mutex );
+    
+    releaseAcquiredSlab();
+    bufferFree.notify_one();
+    
+    slabReady.wait( lock, [&]{ return numReleased < numRead
+                                      || numReleased >= requests.size()
+                                      || stopping == true
+                                      || failed == true; } );
+    
+    return acquireReadySlab( slab );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Gets the next slab if it has already been read, without waiting.
+ *                  The slab previously acquired is released
+ *  @param[out]     slab : the next slab; its values remain valid until it is released
+ *  @return         false if the next slab is not ready (yet); see IsFinished()
+ *
+ */
+/************************************************************************************/
+bool PrefetchReader::TryAcquire(sofa::PrefetchReader::Slab &slab)
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    
+    releaseAcquiredSlab();
+    bufferFree.notify_one();
+    
+    return acquireReadySlab( slab );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Releases the slab held by the consumer, so that its buffer can be reused
+ *
+ */
+/************************************************************************************/
+void PrefetchReader::Release()
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        releaseAcquiredSlab();
+    }
+    
+    bufferFree.notify_one();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if no more slab will be acquired : all the slabs have
+ *                  been acquired, or the reader was stopped, or a read failed
+ *
+ */
+/************************************************************************************/
+bool PrefetchReader::IsFinished() const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    
+    /// index of the slab that the next call to Acquire() would return
+    const std::size_t next = numReleased + ( acquired == true ? 1 : 0 );
+    
+    if( next >= requests.size() || stopping == true )
+    {
+        /// once stopped, the slabs already read are no longer delivered
+        return true;
+    }
+    
+    /// after a failure, the slabs read before are still delivered
+    return ( failed == true && next >= numRead );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if a read failed (the following slabs are not read)
+ *
+ */
+/************************************************************************************/
+bool PrefetchReader::HasFailed() const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    
+    return failed;
+}
+
+std::size_t PrefetchReader::GetNumSlabs() const
+{
+    return requests.size();
+}
+
+std::size_t PrefetchReader::GetNumBuffers() const
+{
+    return numBuffers;
+}
+
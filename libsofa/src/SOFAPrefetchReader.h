@@ -0,0 +1,163 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAPrefetchReader.h
+ *   @brief      Reads slabs of measurements on a background thread
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_PREFETCH_READER_H__
+#define _SOFA_PREFETCH_READER_H__
+
+#include "../src/SOFAFile.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          PrefetchReader
+     *  @brief          Reads slabs of measurements on a background thread
+     *
+     *  @details        The slabs of a data variable (Data.IR by default), given as a list
+     *                  of (measurement, receiver, emitter) indices, are read in order by a
+     *                  worker thread into a bounded ring of buffers, allocated once. The
+     *                  consumer pulls the slabs in the same order : as long as the worker
+     *                  keeps ahead, Acquire() does not block and the reads overlap with the
+     *                  processing of the previous slabs.
+     *
+     *                  The netCDF and HDF5 libraries are not thread-safe : while the reader
+     *                  is running, no other thread shall call libsofa (nor netCDF/HDF5).
+     *                  The file shall outlive the reader.
+     */
+    /************************************************************************************/
+    class SOFA_API PrefetchReader
+    {
+    public:
+        /// index reading the whole receiver (or emitter) dimension
+        static const std::size_t kAll;
+        
+        struct SlabRequest
+        {
+            SlabRequest(const std::size_t measurement_ = 0,
+                        const std::size_t receiver_    = kAll,
+                        const std::size_t emitter_     = kAll);
+            
+            std::size_t measurement;
+            std::size_t receiver;       ///< index of the receiver, or kAll
+            std::size_t emitter;        ///< index of the emitter, or kAll (ignored if the variable has no E dimension)
+        };
+        
+        struct Slab
+        {
+            std::size_t index;          ///< position of the slab in the list of requests
+            SlabRequest request;
+            const double *values;       ///< valid until the slab is released
+            std::size_t numValues;      ///< e.g. R x E x N values if both receiver and emitter are kAll
+        };
+    
+    public:
+        PrefetchReader(const sofa::File &file,
+                       const std::string &variableName = "Data.IR",
+                       const std::size_t numBuffers = 8);
+        
+        ~PrefetchReader();
+        
+        bool Start(const std::vector< sofa::PrefetchReader::SlabRequest > &requests);
+        void Stop();
+        
+        bool Acquire(sofa::PrefetchReader::Slab &slab);
+        bool TryAcquire(sofa::PrefetchReader::Slab &slab);
+        void Release();
+        
+        bool IsFinished() const;
+        bool HasFailed() const;
+        
+        std::size_t GetNumSlabs() const;
+        std::size_t GetNumBuffers() const;
+    
+    private:
+        //==============================================================================
+        void run();
+        
+        bool getSlabCount(std::vector< std::size_t > &start,
+                          std::vector< std::size_t > &count,
+                          const sofa::PrefetchReader::SlabRequest &request) const;
+        
+        bool acquireReadySlab(sofa::PrefetchReader::Slab &slab);
+        void releaseAcquiredSlab();
+    
+    private:
+        const sofa::File & file;
+        const std::string variableName;
+        const std::size_t numBuffers;
+        
+        std::vector< std::size_t > variableDims;            ///< [M R N] or [M R E N]
+        std::vector< sofa::PrefetchReader::SlabRequest > requests;
+        std::vector< std::vector< double > > buffers;       ///< slab i is read into buffers[ i % numBuffers ]
+        
+        std::thread worker;
+        mutable std::mutex mutex;
+        std::condition_variable slabReady;                  ///< signaled by the worker
+        std::condition_variable bufferFree;                 ///< signaled by the consumer
+        
+        /// all guarded by the mutex
+        std::size_t numRead;                                ///< number of slabs read by the worker
+        std::size_t numReleased;                            ///< number of slabs released by the consumer
+        bool acquired;                                      ///< true while the consumer holds slab numReleased
+        bool stopping;
+        bool failed;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( PrefetchReader );
+    };
+
+}
+
+#endif /* _SOFA_PREFETCH_READER_H__ */
+
@@ -0,0 +1,513 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAReadPlan.cpp
+ *   @brief      Reads a set of variables and slabs in one pass, in storage order
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAReadPlan.h"
+#include "../src/SOFAChunkReader.h"
+#include "../src/SOFANcUtils.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+
+using namespace sofa;
+
+namespace ReadPlanHelper
+{
+    /// number of elements of a slab, for one index along its first dimension
+    static std::size_t getRowSize(const std::vector< std::size_t > &count)
+    {
+        std::size_t size = 1;
+        
+        for( std::size_t i = 1; i < count.size(); i++ )
+        {
+            size *= count[i];
+        }
+        
+        return size;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the file to read; it must outlive this object
+ *
+ */
+/************************************************************************************/
+ReadPlan::ReadPlan(const sofa::NetCDFFile &file_)
+: file( file_ )
+, numReads( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds a whole variable to the plan. Returns the index of the request
+ *
+ */
+/************************************************************************************/
+std::size_t ReadPlan::Add(const std::string &variableName)
+{
+    Request request;
+    request.variableName  = variableName;
+    request.wholeVariable = true;
+    request.read          = false;
+    
+    requests.push_back( request );
+    
+    return requests.size() - 1;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds a hyperslab of a variable to the plan. Returns the index of the request
+ *  @param[in]      variableName : the variable to read
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *
+ */
+/************************************************************************************/
+std::size_t ReadPlan::Add(const std::string &variableName,
+                          const std::vector< std::size_t > &start,
+                          const std::vector< std::size_t > &count)
+{
+    Request request;
+    request.variableName  = variableName;
+    request.wholeVariable = false;
+    request.start         = start;
+    request.count         = count;
+    request.read          = false;
+    
+    requests.push_back( request );
+    
+    return requests.size() - 1;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Removes all the requests, and their values
+ *
+ */
+/************************************************************************************/
+void ReadPlan::Clear()
+{
+    requests.clear();
+    offsets.clear();
+    variableIndices.clear();
+    readOrder.clear();
+    numReads = 0;
+}
+
+std::size_t ReadPlan::GetNumRequests() const
+{
+    return requests.size();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of reads issued by the last Execute() (merged and
+ *                  duplicated slabs are read at once)
+ *
+ */
+/************************************************************************************/
+std::size_t ReadPlan::GetNumReads() const
+{
+    return numReads;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if a request was read by the last Execute()
+ *
+ */
+/************************************************************************************/
+bool ReadPlan::IsRead(const std::size_t index) const
+{
+    return ( index < requests.size() && requests[index].read == true );
+}
+
+const std::string & ReadPlan::GetVariableName(const std::size_t index) const
+{
+    if( index >= requests.size() )
+    {
+        SOFA_THROW( "ReadPlan : invalid request index" );
+    }
+    
+    return requests[index].variableName;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the dimensions of the values of a request (i.e. the count of
+ *                  the hyperslab, or the dimensions of the variable)
+ *
+ */
+/************************************************************************************/
+const std::vector< std::size_t > & ReadPlan::GetDimensions(const std::size_t index) const
+{
+    if( index >= requests.size() )
+    {
+        SOFA_THROW( "ReadPlan : invalid request index" );
+    }
+    
+    return requests[index].count;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the values of a request (empty if it was not read)
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & ReadPlan::GetValues(const std::size_t index) const
+{
+    if( index >= requests.size() )
+    {
+        SOFA_THROW( "ReadPlan : invalid request index" );
+    }
+    
+    return requests[index].values;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Copies the values of a request. Returns false if it was not read
+ *
+ */
+/************************************************************************************/
+bool ReadPlan::GetValues(std::vector< double > &values, const std::size_t index) const
+{
+    if( IsRead( index ) == false )
+    {
+        return false;
+    }
+    
+    values = requests[index].values;
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the indices of the requests read by the last Execute(), in the
+ *                  order they were read
+ *
+ */
+/************************************************************************************/
+const std::vector< std::size_t > & ReadPlan::GetReadOrder() const
+{
+    return readOrder;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads all the requests.
+ *                  Returns true if all of them could be read; the requests which could not
+ *                  (unknown or non numeric variable, hyperslab out of range) are left empty
+ *
+ */
+/************************************************************************************/
+bool ReadPlan::Execute()
+{
+    readOrder.clear();
+    numReads = 0;
+    
+    /// each variable is looked up once
+    std::vector< std::string > variableNames;
+    
+    for( std::size_t i = 0; i < requests.size(); i++ )
+    {
+        if( std::find( variableNames.begin(), variableNames.end(), requests[i].variableName ) == variableNames.end() )
+        {
+            variableNames.push_back( requests[i].variableName );
+        }
+    }
+    
+    std::vector< unsigned long long > variableOffsets;
+    
+    const sofa::ChunkReader chunkReader( file, 1 );
+    chunkReader.GetStorageOffsets( variableOffsets, variableNames );
+    
+    offsets.resize( requests.size() );
+    variableIndices.resize( requests.size() );
+    
+    std::vector< std::size_t > order;
+    
+    for( std::size_t i = 0; i < requests.size(); i++ )
+    {
+        Request &request = requests[i];
+        
+        request.read = false;
+        request.values.clear();
+        
+        const std::size_t k = std::find( variableNames.begin(), variableNames.end(), request.variableName ) - variableNames.begin();
+        offsets[i]         = variableOffsets[k];
+        variableIndices[i] = k;
+        
+        if( resolve( request ) == true )
+        {
+            order.push_back( i );
+        }
+    }
+    
+    /// variables in storage order (when unknown, in the order they first appear), slabs by start
+    std::stable_sort( order.begin(), order.end(),
+                      [this]( const std::size_t index1, const std::size_t index2 ){ return isBefore( index1, index2 ); } );
+    
+    bool success = ( order.size() == requests.size() );
+    
+    std::size_t i = 0;
+    
+    while( i < order.size() )
+    {
+        std::vector< std::size_t > batch( 1, order[i] );
+        
+        std::size_t end = requests[ order[i] ].start[0] + requests[ order[i] ].count[0];
+        
+        for( i++; i < order.size() && canMerge( batch[0], end, order[i] ) == true; i++ )
+        {
+            batch.push_back( order[i] );
+            
+            end = smax( end, requests[ order[i] ].start[0] + requests[ order[i] ].count[0] );
+        }
+        
+        if( readBatch( batch ) == false )
+        {
+            success = false;
+        }
+    }
+    
+    return success;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks a request against the dimensions of its variable; the start
+ *                  and count of a whole variable are set
+ *
+ */
+/************************************************************************************/
+bool ReadPlan::resolve(Request &request) const
+{
+    /// non numeric variables are rejected when read
+    if( file.GetVariableNumElements( request.variableName ) == 0 )
+    {
+        return false;
+    }
+    
+    std::vector< std::size_t > dims;
+    file.GetVariableDimensions( dims, request.variableName );
+    
+    /// the reads are merged along the first dimension : a resolved request has one at least
+    if( dims.empty() == true )
+    {
+        return false;
+    }
+    
+    if( request.wholeVariable == true )
+    {
+        request.start.assign( dims.size(), 0 );
+        request.count = dims;
+        
+        return true;
+    }
+    
+    if( request.start.size() != dims.size() || request.count.size() != dims.size() )
+    {
+        return false;
+    }
+    
+    for( std::size_t i = 0; i < dims.size(); i++ )
+    {
+        if( request.count[i] == 0 || request.start[i] >= dims[i] || request.count[i] > dims[i] - request.start[i] )
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Execution order of two (resolved) requests : storage offset of the
+ *                  variable, then the order the variables first appear in the plan (which
+ *                  groups the requests of a variable when the offsets are unknown), then
+ *                  start and count of the slab
+ *
+ */
+/************************************************************************************/
+bool ReadPlan::isBefore(const std::size_t index1, const std::size_t index2) const
+{
+    if( offsets[index1] != offsets[index2] )
+    {
+        return ( offsets[index1] < offsets[index2] );
+    }
+    
+    if( variableIndices[index1] != variableIndices[index2] )
+    {
+        return ( variableIndices[index1] < variableIndices[index2] );
+    }
+    
+    const Request &request1 = requests[index1];
+    const Request &request2 = requests[index2];
+    
+    if( request1.start != request2.start )
+    {
+        return ( request1.start < request2.start );
+    }
+    
+    return ( request1.count < request2.count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if a request can be read together with a batch : same
+ *                  variable, same slab except along the first dimension, where it starts
+ *                  within or right after the batch
+ *  @param[in]      first : first request of the batch
+ *  @param[in]      end : end of the batch along the first dimension
+ *  @param[in]      index : the candidate request
+ *
+ */
+/************************************************************************************/
+bool ReadPlan::canMerge(const std::size_t first,
+                        const std::size_t end,
+                        const std::size_t index) const
+{
+    const Request &request1 = requests[first];
+    const Request &request2 = requests[index];
+    
+    if( request1.variableName != request2.variableName || request2.start[0] > end )
+    {
+        return false;
+    }
+    
+    for( std::size_t i = 1; i < request1.start.size(); i++ )
+    {
+        if( request1.start[i] != request2.start[i] || request1.count[i] != request2.count[i] )
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a batch of requests with a single read, and splits the values
+ *
+ */
+/************************************************************************************/
+bool ReadPlan::readBatch(const std::vector< std::size_t > &batch)
+{
+    Request &first = requests[ batch[0] ];
+    
+    const std::vector< std::ptrdiff_t > stride;
+    
+    bool success = false;
+    
+    if( batch.size() == 1 )
+    {
+        first.values.resize( sofa::NcUtils::GetNumElements( first.count ) );
+        
+        success = file.GetValues< double >( &first.values[0], first.start, first.count, stride, first.variableName );
+    }
+    else
+    {
+        std::vector< std::size_t > start = first.start;
+        std::vector< std::size_t > count = first.count;
+        
+        for( std::size_t k = 1; k < batch.size(); k++ )
+        {
+            const Request &request = requests[ batch[k] ];
+            
+            count[0] = smax( count[0], request.start[0] + request.count[0] - start[0] );
+        }
+        
+        std::vector< double > values( sofa::NcUtils::GetNumElements( count ) );
+        
+        success = file.GetValues< double >( &values[0], start, count, stride, first.variableName );
+        
+        if( success == true )
+        {
+            const std::size_t rowSize = ReadPlanHelper::getRowSize( count );
+            
+            for( std::size_t k = 0; k < batch.size(); k++ )
+            {
+                Request &request = requests[ batch[k] ];
+                
+                const std::size_t offset = ( request.start[0] - start[0] ) * rowSize;
+                
+                request.values.assign( values.begin() + offset,
+                                       values.begin() + offset + request.count[0] * rowSize );
+            }
+        }
+    }
+    
+    numReads++;
+    
+    for( std::size_t k = 0; k < batch.size(); k++ )
+    {
+        Request &request = requests[ batch[k] ];
+        
+        request.read = success;
+        
+        if( success == true )
+        {
+            readOrder.push_back( batch[k] );
+        }
+        else
+        {
+            request.values.clear();
+        }
+    }
+    
+    return success;
+}
@@ -0,0 +1,142 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAReadPlan.h
+ *   @brief      Reads a set of variables and slabs in one pass, in storage order
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_READ_PLAN_H__
+#define _SOFA_READ_PLAN_H__
+
+#include "../src/SOFANcFile.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          ReadPlan
+     *  @brief          Reads a set of variables, or slabs of variables, in one pass
+     *
+     *  @details        The requests (whole variables, or hyperslabs) are collected first,
+     *                  then executed at once : each variable is looked up once, the variables
+     *                  are read in the order of their location in the file (when unknown, in the
+     *                  order they first appear in the plan), the slabs of a variable in the order
+     *                  of their start, duplicated slabs are read once, and slabs following
+     *                  each other along the first dimension (e.g. consecutive ranges of
+     *                  measurements) are merged into a single read.
+     *
+     *                  The values are unpacked, and delivered as double. Variables of rank 0
+     *                  hold no element for the library (see GetVariableNumElements), and are
+     *                  not read.
+     */
+    /************************************************************************************/
+    class SOFA_API ReadPlan
+    {
+    public:
+        explicit ReadPlan(const sofa::NetCDFFile &file);
+        
+        ~ReadPlan() {};
+        
+        std::size_t Add(const std::string &variableName);
+        
+        std::size_t Add(const std::string &variableName,
+                        const std::vector< std::size_t > &start,
+                        const std::vector< std::size_t > &count);
+        
+        void Clear();
+        
+        bool Execute();
+        
+        std::size_t GetNumRequests() const;
+        std::size_t GetNumReads() const;
+        
+        bool IsRead(const std::size_t index) const;
+        
+        const std::string & GetVariableName(const std::size_t index) const;
+        const std::vector< std::size_t > & GetDimensions(const std::size_t index) const;
+        const std::vector< double > & GetValues(const std::size_t index) const;
+        
+        bool GetValues(std::vector< double > &values, const std::size_t index) const;
+        
+        const std::vector< std::size_t > & GetReadOrder() const;
+    
+    private:
+        struct Request
+        {
+            std::string variableName;
+            bool wholeVariable;
+            std::vector< std::size_t > start;
+            std::vector< std::size_t > count;
+            
+            bool read;
+            std::vector< double > values;
+        };
+        
+        //==============================================================================
+        bool resolve(Request &request) const;
+        
+        bool isBefore(const std::size_t index1, const std::size_t index2) const;
+        bool canMerge(const std::size_t first, const std::size_t end, const std::size_t index) const;
+        
+        bool readBatch(const std::vector< std::size_t > &batch);
+    
+    private:
+        const sofa::NetCDFFile & file;
+        
+        std::vector< Request > requests;
+        std::vector< unsigned long long > offsets;      ///< storage offset of the variable of each request
+        std::vector< std::size_t > variableIndices;     ///< index of the variable of each request, in the order the variables first appear
+        std::vector< std::size_t > readOrder;           ///< indices of the requests, in the order they were read
+        std::size_t numReads;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( ReadPlan );
+    };
+
+}
+
+#endif /* _SOFA_READ_PLAN_H__ */
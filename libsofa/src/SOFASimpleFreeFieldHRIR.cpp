@@ -68,54 +68,84 @@ std::string SimpleFreeFieldHRIR::GetConventionVersion()
  *  @brief          Class constructor
  *  @param[in]      path : the file path
  *  @param[in]      mode : opening mode
+ *  @param[in]      options : chunk cache settings of the variables
  *
  */
 /************************************************************************************/
 SimpleFreeFieldHRIR::SimpleFreeFieldHRIR(const std::string &path,
-                                         const netCDF::NcFile::FileMode &mode)
-: sofa::File( path, mode )
+                                         const netCDF::NcFile::FileMode &mode,
+                                         const sofa::OpenOptions &options)
+: sofa::File( path, mode, options )
 {
 }
 
-bool SimpleFreeFieldHRIR::checkGlobalAttributes() const
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : opens, read-only, the image of a file held in memory
+ *  @param[in]      buffer : the file image; it is not copied, and must outlive this object
+ *  @param[in]      options : chunk cache settings of the variables
+ *
+ */
+/************************************************************************************/
+SimpleFreeFieldHRIR::SimpleFreeFieldHRIR(const sofa::MemoryBuffer &buffer,
+                                         const sofa::OpenOptions &options)
+: sofa::File( buffer, options )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor sharing the handle of a sofa::File already opened,
+ *                  so that the SimpleFreeFieldHRIR checks can be run without opening the file again
+ *  @param[in]      sharedFile : the file to share; it must outlive this object
+ *
+ */
+/************************************************************************************/
+SimpleFreeFieldHRIR::SimpleFreeFieldHRIR(const sofa::File &sharedFile)
+: sofa::File( &sharedFile )
+{
+}
+
+bool SimpleFreeFieldHRIR::checkGlobalAttributes(sofa::ValidationReport &report) const
 {
     sofa::Attributes attributes;
     GetGlobalAttributes( attributes );
     
-    sofa::File::ensureSOFAConvention( "SimpleFreeFieldHRIR" );
-    sofa::File::ensureDataType( "FIR" );
+    const std::size_t numIssues = report.GetNumIssues();
+    
+    sofa::File::ensureSOFAConvention( "SimpleFreeFieldHRIR", report );
+    sofa::File::ensureDataType( "FIR", report );
     
     if( attributes.Get( sofa::Attributes::kRoomType ) != "free field" )
     {
-        SOFA_THROW( "invalid 'RoomType'" );
-        return false;
+        report.Add( sofa::ValidationReport::kInvalidAttribute, "invalid 'RoomType'", "RoomType" );
     }
     
-    sofa::File::ensureGlobalAttribute( sofa::Attributes::kListenerShortName );
+    sofa::File::ensureGlobalAttribute( sofa::Attributes::kListenerShortName, report );
     
-    return true;
+    return ( report.GetNumIssues() == numIssues );
 }
 
-bool SimpleFreeFieldHRIR::checkListenerVariables() const
+bool SimpleFreeFieldHRIR::checkListenerVariables(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );
     if( I != 1 )
     {
-        SOFA_THROW( "invalid SOFA dimension : I" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : I", "I" );
         return false;
     }
     
     const long C = GetDimension( "C" );
     if( C != 3 )
     {
-        SOFA_THROW( "invalid SOFA dimension : C" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : C", "C" );
         return false;
     }
     
     const long M = GetNumMeasurements();
     if( M <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : M" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : M", "M" );
         return false;
     }
     
@@ -127,14 +157,14 @@ bool SimpleFreeFieldHRIR::checkListenerVariables() const
     
     if( listener.IsValid() == false )
     {
-        SOFA_THROW( "invalid 'Listener' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Listener' variables", "Listener" );
         return false;
     }
     
     if( listener.ListenerPositionHasDimensions(  I,  C ) == false
      && listener.ListenerPositionHasDimensions(  M,  C ) == false )
     {
-        SOFA_THROW( "invalid 'ListenerPosition' dimensions" );
+        reportDimensions( report, "invalid 'ListenerPosition' dimensions", "ListenerPosition", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
         return false;
     }
     
@@ -146,13 +176,13 @@ bool SimpleFreeFieldHRIR::checkListenerVariables() const
         if( listener.ListenerUpHasDimensions(  I,  C ) == false
          && listener.ListenerUpHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'ListenerUp' dimensions" );
+            reportDimensions( report, "invalid 'ListenerUp' dimensions", "ListenerUp", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
     else
     {
-        SOFA_THROW( "missing 'ListenerUp' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'ListenerUp' variable", "ListenerUp" );
         return false;
     }
     
@@ -164,13 +194,13 @@ bool SimpleFreeFieldHRIR::checkListenerVariables() const
         if( listener.ListenerViewHasDimensions(  I,  C ) == false
          && listener.ListenerViewHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'ListenerView' dimensions" );
+            reportDimensions( report, "invalid 'ListenerView' dimensions", "ListenerView", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
     else
     {
-        SOFA_THROW( "missing 'ListenerView' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'ListenerView' variable", "ListenerView" );
         return false;
     }
     
@@ -186,30 +216,59 @@ bool SimpleFreeFieldHRIR::checkListenerVariables() const
 /************************************************************************************/
 bool SimpleFreeFieldHRIR::IsValid() const
 {
-    if( sofa::File::IsValid() == false )
+    sofa::ValidationReport report;
+    
+    if( SimpleFreeFieldHRIR::Validate( report ) == true )
     {
-        return false;
+        return true;
     }
     
-    sofa::File::ensureGlobalAttribute( "DatabaseName" );
-        
-    if( IsFIRDataType() == false )
+    return raiseFirstIssue( report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the file against the SimpleFreeFieldHRIR convention, and collects all
+ *                  the issues found into a report. Never throws an exception
+ *  @param[out]     report : the issues are appended to this report
+ *  @return         true if this is a valid SOFA file with SimpleFreeFieldHRIR convention
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::Validate(sofa::ValidationReport &report) const
+{
+    return validateOnce( report, conventionValidation, *this, &SimpleFreeFieldHRIR::checkValidity );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Runs all the checks of the SimpleFreeFieldHRIR convention; called once by Validate()
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::checkValidity(sofa::ValidationReport &report) const
+{
+    if( sofa::File::Validate( report ) == false )
     {
-        SOFA_THROW( "'DataType' shall be FIR" );
         return false;
     }
     
-    if( checkGlobalAttributes() == false )
+    const std::size_t numIssues = report.GetNumIssues();
+    
+    sofa::File::ensureGlobalAttribute( "DatabaseName", report );
+        
+    if( IsFIRDataType() == false )
     {
-        return false;
+        report.Add( sofa::ValidationReport::kInvalidDataType, "'DataType' shall be FIR", "DataType" );
     }
     
+    checkGlobalAttributes( report );
+    
     
     /// The number of emitters is 1
     if( GetNumEmitters() != 1 )
     {
-        SOFA_THROW( "invalid number of emitters" );
-        return false;
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid number of emitters", "E" );
     }
     
     /*
@@ -233,16 +292,13 @@ bool SimpleFreeFieldHRIR::IsValid() const
     }
      */
     
-    if( checkListenerVariables() == false )
-    {
-        return false;
-    }
+    checkListenerVariables( report );
     
     
     SOFA_ASSERT( GetDimension( "I" ) == 1 );
     SOFA_ASSERT( GetDimension( "C" ) == 3 );
      
-    return true;
+    return ( report.GetNumIssues() == numIssues );
 }
 
 /************************************************************************************/
@@ -291,6 +347,25 @@ bool SimpleFreeFieldHRIR::GetDataIR(double *values, const unsigned long dim1, co
     return sofa::File::getDataIR( values, dim1, dim2, dim3 );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, as float
+ *  @param[in]      values : array containing the values. 
+ *                  The array must be allocated large enough
+ *  @param[in]      dim1 : first dimension (M)
+ *  @param[in]      dim2 : second dimension (R)
+ *  @param[in]      dim3 : third dimension (N)
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, dim1, dim2, dim3 );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.IR values
@@ -306,6 +381,263 @@ bool SimpleFreeFieldHRIR::GetDataIR(std::vector< double > &values) const
     return sofa::File::getDataIR( values );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array shaped like Data.IR
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(sofa::Array< double > &values) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, in a given layout
+ *                  (e.g. one planar block per receiver, or samples interleaved across receivers)
+ *  @param[in]      values : the array is resized if needed
+ *  @param[in]      layout : the requested layout
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(sofa::Array< double > &values,
+                                    const sofa::DataLayout::Type &layout) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, layout );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, each impulse response being written at the
+ *                  beginning of its own (zero-padded) slot, e.g. ready for a FFT
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. the product of all the
+ *                  dimensions of Data.IR but the last one, times padding.GetSlotSize( N )
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(double *values,
+                                    const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, each impulse
+ *                  response being written at the beginning of its own (zero-padded) slot
+ *  @param[in]      values : the array is resized if needed (the last dimension is the slot size)
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(sofa::Array< double > &values,
+                                    const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(std::vector< float > &values) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array shaped like Data.IR, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(sofa::Array< float > &values) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, in a given layout, as float
+ *                  (e.g. one planar block per receiver, or samples interleaved across receivers)
+ *  @param[in]      values : the array is resized if needed
+ *  @param[in]      layout : the requested layout
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(sofa::Array< float > &values,
+                                    const sofa::DataLayout::Type &layout) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, layout );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values, each impulse response being written at the
+ *                  beginning of its own (zero-padded) slot, e.g. ready for a FFT, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough, i.e. the product of all the
+ *                  dimensions of Data.IR but the last one, times padding.GetSlotSize( N )
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(float *values,
+                                    const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values into a N-dimensional array, each impulse
+ *                  response being written at the beginning of its own (zero-padded) slot, as float
+ *  @param[in]      values : the array is resized if needed (the last dimension is the slot size)
+ *  @param[in]      padding : describes the slots
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(sofa::Array< float > &values,
+                                    const sofa::PaddedLayout &padding) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, padding );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a hyperslab of the Data.IR values.
+ *                  Only the requested elements are read from the file
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(double *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves a hyperslab of the Data.IR values, as float.
+ *                  Only the requested elements are read from the file
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (i.e. the product of all counts)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIR(float *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values, start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of consecutive measurements
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (numMeasurements x R x N)
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIRMeasurements(double *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    return sofa::File::getDataIRMeasurements( values, firstMeasurement, numMeasurements );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of consecutive measurements, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (numMeasurements x R x N)
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIRMeasurements(float *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    return sofa::File::getDataIRMeasurements( values, firstMeasurement, numMeasurements );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one receiver, for all measurements
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (M x N)
+ *  @param[in]      receiver : index of the receiver to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIRReceiver(double *values, const unsigned long receiver) const
+{
+    return sofa::File::getDataIRReceiver( values, receiver );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one receiver, for all measurements, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough (M x N)
+ *  @param[in]      receiver : index of the receiver to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataIRReceiver(float *values, const unsigned long receiver) const
+{
+    return sofa::File::getDataIRReceiver( values, receiver );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.Delay values
@@ -321,6 +653,51 @@ bool SimpleFreeFieldHRIR::GetDataDelay(std::vector< double > &values) const
     return sofa::File::getDataDelay( values );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values into a N-dimensional array shaped like Data.Delay
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataDelay(sofa::Array< double > &values) const
+{
+    /// Data.Delay is [ I R ] or [ M R ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataDelay(std::vector< float > &values) const
+{
+    /// Data.Delay is [ I R ] or [ M R ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values into a N-dimensional array shaped like Data.Delay, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldHRIR::GetDataDelay(sofa::Array< float > &values) const
+{
+    /// Data.Delay is [ I R ] or [ M R ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
 bool SimpleFreeFieldHRIR::GetDataDelay(double *values, const unsigned long dim1, const unsigned long dim2) const
 {
     /// Data.Delay is [ I R ] or [ M R ]
@@ -328,3 +705,10 @@ bool SimpleFreeFieldHRIR::GetDataDelay(double *values, const unsigned long dim1,
     return sofa::File::getDataDelay( values, dim1, dim2 );
 }
 
+bool SimpleFreeFieldHRIR::GetDataDelay(float *values, const unsigned long dim1, const unsigned long dim2) const
+{
+    /// Data.Delay is [ I R ] or [ M R ]
+    
+    return sofa::File::getDataDelay( values, dim1, dim2 );
+}
+
@@ -71,28 +71,61 @@ namespace sofa
         
     public:
         SimpleFreeFieldHRIR(const std::string &path,
-                            const netCDF::NcFile::FileMode &mode = netCDF::NcFile::read);
+                            const netCDF::NcFile::FileMode &mode = netCDF::NcFile::read,
+                            const sofa::OpenOptions &options = sofa::OpenOptions());
+        
+        explicit SimpleFreeFieldHRIR(const sofa::MemoryBuffer &buffer,
+                                     const sofa::OpenOptions &options = sofa::OpenOptions());
+        
+        explicit SimpleFreeFieldHRIR(const sofa::File &sharedFile);
         
         virtual ~SimpleFreeFieldHRIR() {};
         
         virtual bool IsValid() const SOFA_OVERRIDE;
+        virtual bool Validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
         
         bool GetSamplingRate(double &value) const;
         bool GetSamplingRateUnits(sofa::Units::Type &units) const;
         
         //==============================================================================
         bool GetDataIR(std::vector< double > &values) const;
+        bool GetDataIR(sofa::Array< double > &values) const;
+        bool GetDataIR(sofa::Array< double > &values, const sofa::DataLayout::Type &layout) const;
+        bool GetDataIR(double *values, const sofa::PaddedLayout &padding) const;
+        bool GetDataIR(sofa::Array< double > &values, const sofa::PaddedLayout &padding) const;
         bool GetDataIR(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool GetDataIR(double *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const;
+        bool GetDataIRMeasurements(double *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const;
+        bool GetDataIRReceiver(double *values, const unsigned long receiver) const;
+        
+        bool GetDataIR(std::vector< float > &values) const;
+        bool GetDataIR(sofa::Array< float > &values) const;
+        bool GetDataIR(sofa::Array< float > &values, const sofa::DataLayout::Type &layout) const;
+        bool GetDataIR(float *values, const sofa::PaddedLayout &padding) const;
+        bool GetDataIR(sofa::Array< float > &values, const sofa::PaddedLayout &padding) const;
+        bool GetDataIR(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool GetDataIR(float *values, const std::vector< std::size_t > &start, const std::vector< std::size_t > &count) const;
+        bool GetDataIRMeasurements(float *values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const;
+        bool GetDataIRReceiver(float *values, const unsigned long receiver) const;
         
         //==============================================================================
         bool GetDataDelay(double *values, const unsigned long dim1, const unsigned long dim2) const;
         bool GetDataDelay(std::vector< double > &values) const;
+        bool GetDataDelay(sofa::Array< double > &values) const;
         
+        bool GetDataDelay(float *values, const unsigned long dim1, const unsigned long dim2) const;
+        bool GetDataDelay(std::vector< float > &values) const;
+        bool GetDataDelay(sofa::Array< float > &values) const;
+    
     private:
         //==============================================================================
-        bool checkGlobalAttributes() const;
-        bool checkListenerVariables() const;
+        bool checkValidity(sofa::ValidationReport &report) const;
+        bool checkGlobalAttributes(sofa::ValidationReport &report) const;
+        bool checkListenerVariables(sofa::ValidationReport &report) const;
         
+        //==============================================================================
+        mutable sofa::File::ValidationCache conventionValidation;
+    
     private:
         /// avoid shallow and copy constructor
         SOFA_AVOID_COPY_CONSTRUCTOR( SimpleFreeFieldHRIR );
@@ -69,52 +69,82 @@ std::string SimpleFreeFieldSOS::GetConventionVersion()
  *  @brief          Class constructor
  *  @param[in]      path : the file path
  *  @param[in]      mode : opening mode
+ *  @param[in]      options : chunk cache settings of the variables
  *
  */
 /************************************************************************************/
 SimpleFreeFieldSOS::SimpleFreeFieldSOS(const std::string &path,
-                                       const netCDF::NcFile::FileMode &mode)
-: sofa::File( path, mode )
+                                       const netCDF::NcFile::FileMode &mode,
+                                       const sofa::OpenOptions &options)
+: sofa::File( path, mode, options )
 {
 }
 
-bool SimpleFreeFieldSOS::checkGlobalAttributes() const
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : opens, read-only, the image of a file held in memory
+ *  @param[in]      buffer : the file image; it is not copied, and must outlive this object
+ *  @param[in]      options : chunk cache settings of the variables
+ *
+ */
+/************************************************************************************/
+SimpleFreeFieldSOS::SimpleFreeFieldSOS(const sofa::MemoryBuffer &buffer,
+                                       const sofa::OpenOptions &options)
+: sofa::File( buffer, options )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor sharing the handle of a sofa::File already opened,
+ *                  so that the SimpleFreeFieldSOS checks can be run without opening the file again
+ *  @param[in]      sharedFile : the file to share; it must outlive this object
+ *
+ */
+/************************************************************************************/
+SimpleFreeFieldSOS::SimpleFreeFieldSOS(const sofa::File &sharedFile)
+: sofa::File( &sharedFile )
+{
+}
+
+bool SimpleFreeFieldSOS::checkGlobalAttributes(sofa::ValidationReport &report) const
 {
     sofa::Attributes attributes;
     GetGlobalAttributes( attributes );
     
-    sofa::File::ensureSOFAConvention( "SimpleFreeFieldSOS" );
-    sofa::File::ensureDataType( "SOS" );
+    const std::size_t numIssues = report.GetNumIssues();
+    
+    sofa::File::ensureSOFAConvention( "SimpleFreeFieldSOS", report );
+    sofa::File::ensureDataType( "SOS", report );
     
     if( attributes.Get( sofa::Attributes::kRoomType ) != "free field" )
     {
-        SOFA_THROW( "invalid 'RoomType'" );
-        return false;
+        report.Add( sofa::ValidationReport::kInvalidAttribute, "invalid 'RoomType'", "RoomType" );
     }
     
-    return true;
+    return ( report.GetNumIssues() == numIssues );
 }
 
-bool SimpleFreeFieldSOS::checkListenerVariables() const
+bool SimpleFreeFieldSOS::checkListenerVariables(sofa::ValidationReport &report) const
 {
     const long I = GetDimension( "I" );
     if( I != 1 )
     {
-        SOFA_THROW( "invalid SOFA dimension : I" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : I", "I" );
         return false;
     }
     
     const long C = GetDimension( "C" );
     if( C != 3 )
     {
-        SOFA_THROW( "invalid SOFA dimension : C" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : C", "C" );
         return false;
     }
     
     const long M = GetNumMeasurements();
     if( M <= 0 )
     {
-        SOFA_THROW( "invalid SOFA dimension : M" );
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid SOFA dimension : M", "M" );
         return false;
     }
     
@@ -126,14 +156,14 @@ bool SimpleFreeFieldSOS::checkListenerVariables() const
     
     if( listener.IsValid() == false )
     {
-        SOFA_THROW( "invalid 'Listener' variables" );
+        report.Add( sofa::ValidationReport::kInvalidVariable, "invalid 'Listener' variables", "Listener" );
         return false;
     }
     
     if( listener.ListenerPositionHasDimensions(  I,  C ) == false
      && listener.ListenerPositionHasDimensions(  M,  C ) == false )
     {
-        SOFA_THROW( "invalid 'ListenerPosition' dimensions" );
+        reportDimensions( report, "invalid 'ListenerPosition' dimensions", "ListenerPosition", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
         return false;
     }
     
@@ -145,13 +175,13 @@ bool SimpleFreeFieldSOS::checkListenerVariables() const
         if( listener.ListenerUpHasDimensions(  I,  C ) == false
            && listener.ListenerUpHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'ListenerUp' dimensions" );
+            reportDimensions( report, "invalid 'ListenerUp' dimensions", "ListenerUp", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
     else
     {
-        SOFA_THROW( "missing 'ListenerUp' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'ListenerUp' variable", "ListenerUp" );
         return false;
     }
     
@@ -163,13 +193,13 @@ bool SimpleFreeFieldSOS::checkListenerVariables() const
         if( listener.ListenerViewHasDimensions(  I,  C ) == false
          && listener.ListenerViewHasDimensions(  M,  C ) == false )
         {
-            SOFA_THROW( "invalid 'ListenerView' dimensions" );
+            reportDimensions( report, "invalid 'ListenerView' dimensions", "ListenerView", sofa::ValidationReport::Dimensions( I, C ), sofa::ValidationReport::Dimensions( M, C ) );
             return false;
         }
     }
     else
     {
-        SOFA_THROW( "missing 'ListenerView' variable" );
+        report.Add( sofa::ValidationReport::kMissingVariable, "missing 'ListenerView' variable", "ListenerView" );
         return false;
     }
     
@@ -185,29 +215,58 @@ bool SimpleFreeFieldSOS::checkListenerVariables() const
 /************************************************************************************/
 bool SimpleFreeFieldSOS::IsValid() const
 {
-    if( sofa::File::IsValid() == false )
+    sofa::ValidationReport report;
+    
+    if( SimpleFreeFieldSOS::Validate( report ) == true )
     {
-        return false;
+        return true;
     }
     
-    sofa::File::ensureGlobalAttribute( "DatabaseName" );
-    
-    if( IsSOSDataType() == false )
+    return raiseFirstIssue( report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the file against the SimpleFreeFieldSOS convention, and collects all
+ *                  the issues found into a report. Never throws an exception
+ *  @param[out]     report : the issues are appended to this report
+ *  @return         true if this is a valid SOFA file with SimpleFreeFieldSOS convention
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldSOS::Validate(sofa::ValidationReport &report) const
+{
+    return validateOnce( report, conventionValidation, *this, &SimpleFreeFieldSOS::checkValidity );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Runs all the checks of the SimpleFreeFieldSOS convention; called once by Validate()
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldSOS::checkValidity(sofa::ValidationReport &report) const
+{
+    if( sofa::File::Validate( report ) == false )
     {
-        SOFA_THROW( "'DataType' shall be SOS" );
         return false;
     }
     
-    if( checkGlobalAttributes() == false )
+    const std::size_t numIssues = report.GetNumIssues();
+    
+    sofa::File::ensureGlobalAttribute( "DatabaseName", report );
+    
+    if( IsSOSDataType() == false )
     {
-        return false;
+        report.Add( sofa::ValidationReport::kInvalidDataType, "'DataType' shall be SOS", "DataType" );
     }
     
+    checkGlobalAttributes( report );
+    
     /// The number of emitters is 1
     if( GetNumEmitters() != 1 )
     {
-        SOFA_THROW( "invalid number of emitters" );
-        return false;
+        report.Add( sofa::ValidationReport::kInvalidDimension, "invalid number of emitters", "E" );
     }
     
     /*
@@ -237,22 +296,18 @@ bool SimpleFreeFieldSOS::IsValid() const
         
         if( ( N % 6 ) != 0 )
         {
-            SOFA_THROW( "invalid 'N' (should be a multiple of 6)" );
-            return false;
+            report.Add( sofa::ValidationReport::kInvalidDimension, "invalid 'N' (should be a multiple of 6)", "N" );
         }
     }
 
     
-    if( checkListenerVariables() == false )
-    {
-        return false;
-    }
+    checkListenerVariables( report );
     
     
     SOFA_ASSERT( GetDimension( "I" ) == 1 );
     SOFA_ASSERT( GetDimension( "C" ) == 3 );
     
-    return true;
+    return ( report.GetNumIssues() == numIssues );
 }
 
 /************************************************************************************/
@@ -299,6 +354,23 @@ bool SimpleFreeFieldSOS::GetDataSOS(double *values, const unsigned long dim1, co
     return NetCDFFile::GetValues( values, dim1, dim2, dim3, "Data.SOS" );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.SOS values, as float
+ *  @param[in]      values : array containing the values.
+ *                  The array must be allocated large enough
+ *  @param[in]      dim1 : first dimension (M)
+ *  @param[in]      dim2 : second dimension (R)
+ *  @param[in]      dim3 : third dimension (N)
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldSOS::GetDataSOS(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "Data.SOS" );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.SOS values
@@ -326,6 +398,33 @@ bool SimpleFreeFieldSOS::GetDataSOS(std::vector< double > &values) const
     return GetDataSOS( &values[0], M, R, N );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.SOS values, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldSOS::GetDataSOS(std::vector< float > &values) const
+{
+    const long M = GetNumMeasurements();
+    const long R = GetNumReceivers();
+    const long N = GetNumDataSamples();
+    
+    SOFA_ASSERT( M > 0 );
+    SOFA_ASSERT( R > 0 );
+    SOFA_ASSERT( N > 0 );
+    
+    const std::size_t size_ = M * R * N;
+    
+    values.resize( size_ );
+    
+    SOFA_ASSERT( values.empty() == false );
+    
+    return GetDataSOS( &values[0], M, R, N );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.Delay values
@@ -341,6 +440,51 @@ bool SimpleFreeFieldSOS::GetDataDelay(std::vector< double > &values) const
     return sofa::File::getDataDelay( values );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values into a N-dimensional array shaped like Data.Delay
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldSOS::GetDataDelay(sofa::Array< double > &values) const
+{
+    /// Data.Delay is [ M R ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldSOS::GetDataDelay(std::vector< float > &values) const
+{
+    /// Data.Delay is [ M R ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values into a N-dimensional array shaped like Data.Delay, as float
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldSOS::GetDataDelay(sofa::Array< float > &values) const
+{
+    /// Data.Delay is [ M R ]
+    
+    return sofa::File::getDataDelay( values );
+}
+
 bool SimpleFreeFieldSOS::GetDataDelay(double *values, const unsigned long dim1, const unsigned long dim2) const
 {
     /// Data.Delay is [ M R ]
@@ -348,3 +492,10 @@ bool SimpleFreeFieldSOS::GetDataDelay(double *values, const unsigned long dim1,
     return sofa::File::getDataDelay( values, dim1, dim2 );
 }
 
+bool SimpleFreeFieldSOS::GetDataDelay(float *values, const unsigned long dim1, const unsigned long dim2) const
+{
+    /// Data.Delay is [ M R ]
+    
+    return sofa::File::getDataDelay( values, dim1, dim2 );
+}
+
@@ -71,11 +71,18 @@ namespace sofa
         
     public:
         SimpleFreeFieldSOS(const std::string &path,
-                            const netCDF::NcFile::FileMode &mode = netCDF::NcFile::read);
+                            const netCDF::NcFile::FileMode &mode = netCDF::NcFile::read,
+                            const sofa::OpenOptions &options = sofa::OpenOptions());
+        
+        explicit SimpleFreeFieldSOS(const sofa::MemoryBuffer &buffer,
+                                    const sofa::OpenOptions &options = sofa::OpenOptions());
+        
+        explicit SimpleFreeFieldSOS(const sofa::File &sharedFile);
         
         virtual ~SimpleFreeFieldSOS() {};
         
         virtual bool IsValid() const SOFA_OVERRIDE;
+        virtual bool Validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
         
         bool GetSamplingRate(double &value) const;
         bool GetSamplingRateUnits(sofa::Units::Type &units) const;
@@ -84,17 +91,29 @@ namespace sofa
         bool GetDataSOS(std::vector< double > &values) const;
         bool GetDataSOS(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
         
+        bool GetDataSOS(std::vector< float > &values) const;
+        bool GetDataSOS(float *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        
         //==============================================================================
         bool GetDataDelay(double *values, const unsigned long dim1, const unsigned long dim2) const;
         bool GetDataDelay(std::vector< double > &values) const;
+        bool GetDataDelay(sofa::Array< double > &values) const;
         
+        bool GetDataDelay(float *values, const unsigned long dim1, const unsigned long dim2) const;
+        bool GetDataDelay(std::vector< float > &values) const;
+        bool GetDataDelay(sofa::Array< float > &values) const;
+    
     private:
         //==============================================================================
-        bool checkGlobalAttributes() const;
-        bool checkListenerVariables() const;
+        bool checkValidity(sofa::ValidationReport &report) const;
+        bool checkGlobalAttributes(sofa::ValidationReport &report) const;
+        bool checkListenerVariables(sofa::ValidationReport &report) const;
         
         bool hasDatabaseName() const;
         
+        //==============================================================================
+        mutable sofa::File::ValidationCache conventionValidation;
+    
     private:
         /// avoid shallow and copy constructor
         SOFA_AVOID_COPY_CONSTRUCTOR( SimpleFreeFieldSOS );
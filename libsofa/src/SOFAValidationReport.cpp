@@ -0,0 +1,267 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAValidationReport.cpp
+ *   @brief      Issues found while validating a SOFA file
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAValidationReport.h"
+
+using namespace sofa;
+
+namespace ValidationReportHelper
+{
+    static void PrintDimensions(const std::vector< std::size_t > &dims,
+                                std::ostream & output)
+    {
+        output << "[";
+        
+        for( std::size_t i = 0; i < dims.size(); i++ )
+        {
+            output << dims[i];
+            
+            if( i < dims.size() - 1 )
+            {
+                output << " ";
+            }
+        }
+        
+        output << "]";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of a given issue code
+ *
+ */
+/************************************************************************************/
+std::string ValidationReport::GetName(const sofa::ValidationReport::Code &code)
+{
+    switch( code )
+    {
+        case sofa::ValidationReport::kInvalidNetCDFFile             : return "InvalidNetCDFFile";
+        case sofa::ValidationReport::kReadError                     : return "ReadError";
+        case sofa::ValidationReport::kMissingAttribute              : return "MissingAttribute";
+        case sofa::ValidationReport::kInvalidAttribute              : return "InvalidAttribute";
+        case sofa::ValidationReport::kInvalidConventions            : return "InvalidConventions";
+        case sofa::ValidationReport::kInvalidDataType               : return "InvalidDataType";
+        case sofa::ValidationReport::kMissingDimension              : return "MissingDimension";
+        case sofa::ValidationReport::kInvalidDimension              : return "InvalidDimension";
+        case sofa::ValidationReport::kMissingVariable               : return "MissingVariable";
+        case sofa::ValidationReport::kInvalidVariable               : return "InvalidVariable";
+        case sofa::ValidationReport::kInvalidVariableType           : return "InvalidVariableType";
+        case sofa::ValidationReport::kInvalidVariableDimensions     : return "InvalidVariableDimensions";
+        case sofa::ValidationReport::kInvalidUnits                  : return "InvalidUnits";
+        default                                                     : return "Unknown";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Helpers to build the expected dimensions of a variable
+ *
+ */
+/************************************************************************************/
+std::vector< std::size_t > ValidationReport::Dimensions(const std::size_t dim1)
+{
+    return std::vector< std::size_t >( 1, dim1 );
+}
+
+std::vector< std::size_t > ValidationReport::Dimensions(const std::size_t dim1, const std::size_t dim2)
+{
+    std::vector< std::size_t > dims = Dimensions( dim1 );
+    dims.push_back( dim2 );
+    return dims;
+}
+
+std::vector< std::size_t > ValidationReport::Dimensions(const std::size_t dim1, const std::size_t dim2, const std::size_t dim3)
+{
+    std::vector< std::size_t > dims = Dimensions( dim1, dim2 );
+    dims.push_back( dim3 );
+    return dims;
+}
+
+std::vector< std::size_t > ValidationReport::Dimensions(const std::size_t dim1, const std::size_t dim2, const std::size_t dim3, const std::size_t dim4)
+{
+    std::vector< std::size_t > dims = Dimensions( dim1, dim2, dim3 );
+    dims.push_back( dim4 );
+    return dims;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : an empty report
+ *
+ */
+/************************************************************************************/
+ValidationReport::ValidationReport()
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Removes all the issues
+ *
+ */
+/************************************************************************************/
+void ValidationReport::Clear()
+{
+    issues.clear();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Records an issue
+ *  @param[in]      code : kind of issue
+ *  @param[in]      message : description of the issue
+ *  @param[in]      name : attribute, dimension or variable concerned (may be empty)
+ *
+ */
+/************************************************************************************/
+void ValidationReport::Add(const sofa::ValidationReport::Code &code,
+                           const std::string &message,
+                           const std::string &name)
+{
+    Issue issue;
+    issue.code      = code;
+    issue.message   = message;
+    issue.name      = name;
+    
+    issues.push_back( issue );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Records an issue concerning the dimensions of a variable
+ *  @param[in]      code : kind of issue
+ *  @param[in]      message : description of the issue
+ *  @param[in]      name : the variable concerned
+ *  @param[in]      expectedDimensions : accepted shapes for this variable
+ *  @param[in]      actualDimensions : actual shape of the variable
+ *
+ */
+/************************************************************************************/
+void ValidationReport::Add(const sofa::ValidationReport::Code &code,
+                           const std::string &message,
+                           const std::string &name,
+                           const std::vector< std::vector< std::size_t > > &expectedDimensions,
+                           const std::vector< std::size_t > &actualDimensions)
+{
+    Add( code, message, name );
+    
+    issues.back().expectedDimensions    = expectedDimensions;
+    issues.back().actualDimensions      = actualDimensions;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Appends all the issues of another report
+ *
+ */
+/************************************************************************************/
+void ValidationReport::Append(const sofa::ValidationReport &other)
+{
+    issues.insert( issues.end(), other.issues.begin(), other.issues.end() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if no issue was found
+ *
+ */
+/************************************************************************************/
+bool ValidationReport::IsValid() const
+{
+    return issues.empty();
+}
+
+std::size_t ValidationReport::GetNumIssues() const
+{
+    return issues.size();
+}
+
+const std::vector< ValidationReport::Issue > & ValidationReport::GetIssues() const
+{
+    return issues;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Prints all the issues, one per line
+ *  @param[in]      output : output stream
+ *
+ */
+/************************************************************************************/
+void ValidationReport::Print(std::ostream & output) const
+{
+    for( std::size_t i = 0; i < issues.size(); i++ )
+    {
+        const Issue & issue = issues[i];
+        
+        output << ValidationReport::GetName( issue.code ) << " : " << issue.message;
+        
+        if( issue.code == sofa::ValidationReport::kInvalidVariableDimensions )
+        {
+            output << " (expected ";
+            
+            for( std::size_t k = 0; k < issue.expectedDimensions.size(); k++ )
+            {
+                if( k > 0 )
+                {
+                    output << " or ";
+                }
+                ValidationReportHelper::PrintDimensions( issue.expectedDimensions[k], output );
+            }
+            
+            output << ", actual ";
+            ValidationReportHelper::PrintDimensions( issue.actualDimensions, output );
+            output << ")";
+        }
+        
+        output << std::endl;
+    }
+}
+
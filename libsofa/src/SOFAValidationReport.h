@@ -0,0 +1,139 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAValidationReport.h
+ *   @brief      Issues found while validating a SOFA file
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_VALIDATION_REPORT_H__
+#define _SOFA_VALIDATION_REPORT_H__
+
+#include "../src/SOFAPlatform.h"
+#include <iostream>
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          ValidationReport
+     *  @brief          Issues found while validating a SOFA file
+     *
+     *  @details        Filled by sofa::File::Validate() and the Validate() method of each
+     *                  convention, which never raise exceptions. The issues are stored in
+     *                  the order in which they were found; the message of each issue is the
+     *                  one of the exception raised by the corresponding IsValid() method.
+     */
+    /************************************************************************************/
+    class SOFA_API ValidationReport
+    {
+    public:
+        enum Code
+        {
+            kInvalidNetCDFFile          = 0,    ///< the file could not be read as a netCDF file
+            kReadError                  = 1,    ///< an error occured while reading the file
+            kMissingAttribute           = 2,
+            kInvalidAttribute           = 3,
+            kInvalidConventions         = 4,    ///< 'Conventions' or 'SOFAConventions' attribute
+            kInvalidDataType            = 5,
+            kMissingDimension           = 6,
+            kInvalidDimension           = 7,
+            kMissingVariable            = 8,
+            kInvalidVariable            = 9,
+            kInvalidVariableType        = 10,
+            kInvalidVariableDimensions  = 11,
+            kInvalidUnits               = 12,
+            
+            kNumCodes
+        };
+        
+        static std::string GetName(const sofa::ValidationReport::Code &code);
+        
+        struct Issue
+        {
+            Code code;
+            std::string message;
+            std::string name;                                               ///< attribute, dimension or variable concerned (may be empty)
+            std::vector< std::vector< std::size_t > > expectedDimensions;   ///< accepted shapes (only for kInvalidVariableDimensions)
+            std::vector< std::size_t > actualDimensions;                    ///< actual shape (only for kInvalidVariableDimensions)
+        };
+        
+        static std::vector< std::size_t > Dimensions(const std::size_t dim1);
+        static std::vector< std::size_t > Dimensions(const std::size_t dim1, const std::size_t dim2);
+        static std::vector< std::size_t > Dimensions(const std::size_t dim1, const std::size_t dim2, const std::size_t dim3);
+        static std::vector< std::size_t > Dimensions(const std::size_t dim1, const std::size_t dim2, const std::size_t dim3, const std::size_t dim4);
+    
+    public:
+        ValidationReport();
+        ~ValidationReport() {};
+        
+        void Clear();
+        
+        void Add(const sofa::ValidationReport::Code &code,
+                 const std::string &message,
+                 const std::string &name = "");
+        
+        void Add(const sofa::ValidationReport::Code &code,
+                 const std::string &message,
+                 const std::string &name,
+                 const std::vector< std::vector< std::size_t > > &expectedDimensions,
+                 const std::vector< std::size_t > &actualDimensions);
+        
+        void Append(const sofa::ValidationReport &other);
+        
+        bool IsValid() const;
+        std::size_t GetNumIssues() const;
+        const std::vector< Issue > & GetIssues() const;
+        
+        void Print(std::ostream & output = std::cout) const;
+    
+    private:
+        std::vector< Issue > issues;
+    };
+
+}
+
+#endif /* _SOFA_VALIDATION_REPORT_H__ */
+
@@ -0,0 +1,361 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAWriteOptions.cpp
+ *   @brief      Options used when writing a SOFA file : chunking and compression
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAWriteOptions.h"
+#include "../src/SOFAUtils.h"
+
+using namespace sofa;
+
+namespace WriteOptionsHelper
+{
+    /// targeted size of the chunks : the default chunk cache of HDF5 (1 MB) holds one of them
+    static const std::size_t kDefaultChunkSize = 1024 * 1024;
+    
+    /// upper bound of the chunks holding one measurement, before they are split along R, then E
+    static const std::size_t kMaxMeasurementChunkSize = 4 * 1024 * 1024;
+    
+    static std::size_t findDimension(const std::vector< std::string > &dimensionNames,
+                                     const std::string &name)
+    {
+        for( std::size_t i = 0; i < dimensionNames.size(); i++ )
+        {
+            if( dimensionNames[i] == name )
+            {
+                return i;
+            }
+        }
+        
+        return dimensionNames.size();
+    }
+    
+    static std::size_t getNumBytes(const std::vector< std::size_t > &chunkShape,
+                                   const std::size_t elementSize)
+    {
+        std::size_t numBytes = elementSize;
+        
+        for( std::size_t i = 0; i < chunkShape.size(); i++ )
+        {
+            numBytes *= chunkShape[i];
+        }
+        
+        return numBytes;
+    }
+    
+    /// number of measurements per chunk, so that the chunks are close to the targeted size
+    static std::size_t getNumMeasurements(const std::size_t targetSize,
+                                          const std::size_t measurementSize,
+                                          const std::size_t numMeasurements)
+    {
+        std::size_t num = sofa::smax( (std::size_t) 1, targetSize / sofa::smax( (std::size_t) 1, measurementSize ) );
+        
+        /// 0 : unlimited dimension, of unknown size
+        if( numMeasurements > 0 )
+        {
+            num = sofa::smin( num, numMeasurements );
+        }
+        
+        return num;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : all the library defaults are kept
+ *
+ */
+/************************************************************************************/
+WriteOptions::WriteOptions()
+: accessPattern( kDefaultAccess )
+, deflateLevel( -1 )
+, shuffle( true )
+, chunkSize( 0 )
+, numThreads( 1 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      accessPattern : how the data of the file is going to be read
+ *  @param[in]      deflateLevel : in [0 9], 0 disables the compression
+ *                  (negative : derived from the access pattern)
+ *  @param[in]      shuffle : shuffles the bytes of the values before deflating them
+ *
+ */
+/************************************************************************************/
+WriteOptions::WriteOptions(const AccessPattern accessPattern_,
+                           const int deflateLevel_,
+                           const bool shuffle_)
+: accessPattern( accessPattern_ )
+, deflateLevel( -1 )
+, shuffle( shuffle_ )
+, chunkSize( 0 )
+, numThreads( 1 )
+{
+    SetDeflateLevel( deflateLevel_ );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the options keep all the library defaults
+ *
+ */
+/************************************************************************************/
+bool WriteOptions::IsDefault() const
+{
+    return ( accessPattern == kDefaultAccess
+            && deflateLevel <= 0
+            && chunkSize == 0 );
+}
+
+void WriteOptions::SetAccessPattern(const AccessPattern pattern)
+{
+    accessPattern = pattern;
+}
+
+void WriteOptions::SetDeflateLevel(const int level)
+{
+    deflateLevel = ( level < 0 ) ? -1 : sofa::smin( level, 9 );
+}
+
+void WriteOptions::SetShuffle(const bool enable)
+{
+    shuffle = enable;
+}
+
+void WriteOptions::SetChunkSize(const std::size_t size)
+{
+    chunkSize = size;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the number of threads compressing the data variables
+ *  @param[in]      num : 1 lets netCDF compress the chunks, 0 uses one thread per
+ *                  hardware thread
+ *
+ */
+/************************************************************************************/
+void WriteOptions::SetNumThreads(const unsigned int num)
+{
+    numThreads = num;
+}
+
+WriteOptions::AccessPattern WriteOptions::GetAccessPattern() const
+{
+    return accessPattern;
+}
+
+int WriteOptions::GetDeflateLevel() const
+{
+    return deflateLevel;
+}
+
+bool WriteOptions::GetShuffle() const
+{
+    return shuffle;
+}
+
+std::size_t WriteOptions::GetChunkSize() const
+{
+    return chunkSize;
+}
+
+unsigned int WriteOptions::GetNumThreads() const
+{
+    return numThreads;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true for the variables the options apply to : those along
+ *                  both M and N (Data.IR, Data.Real, Data.Imag, Data.SOS)
+ *
+ */
+/************************************************************************************/
+bool WriteOptions::IsDataVariable(const std::vector< std::string > &dimensionNames)
+{
+    return ( WriteOptionsHelper::findDimension( dimensionNames, "M" ) < dimensionNames.size()
+            && WriteOptionsHelper::findDimension( dimensionNames, "N" ) < dimensionNames.size() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the chunk shape of a data variable
+ *  @param[out]     chunkShape : the size of the chunks along each dimension
+ *  @param[in]      dimensionNames : the dimensions of the variable, e.g. [M R E N]
+ *  @param[in]      dimensionSizes : their sizes (0 for an unlimited dimension)
+ *  @param[in]      elementSize : size of one value, in bytes
+ *  @return         false if the chunk shape is left to the library
+ *
+ *  @details        - measurement access : one measurement per chunk; split along R, then E,
+ *                  if a measurement exceeds 4 MB
+ *                  - whole file access : whole measurements, as many per chunk as fit in
+ *                  the targeted chunk size
+ *                  - receiver access : one receiver per chunk, and as many measurements
+ *                  as fit in the targeted chunk size
+ */
+/************************************************************************************/
+bool WriteOptions::GetChunkShape(std::vector< std::size_t > &chunkShape,
+                                 const std::vector< std::string > &dimensionNames,
+                                 const std::vector< std::size_t > &dimensionSizes,
+                                 const std::size_t elementSize) const
+{
+    chunkShape.clear();
+    
+    if( accessPattern == kDefaultAccess
+     || IsDataVariable( dimensionNames ) == false
+     || dimensionNames.size() != dimensionSizes.size() )
+    {
+        return false;
+    }
+    
+    const std::size_t m = WriteOptionsHelper::findDimension( dimensionNames, "M" );
+    const std::size_t r = WriteOptionsHelper::findDimension( dimensionNames, "R" );
+    const std::size_t e = WriteOptionsHelper::findDimension( dimensionNames, "E" );
+    
+    const std::size_t targetSize = ( chunkSize > 0 ) ? chunkSize : WriteOptionsHelper::kDefaultChunkSize;
+    
+    /// whole dimensions, 1 along the unlimited ones
+    for( std::size_t i = 0; i < dimensionSizes.size(); i++ )
+    {
+        chunkShape.push_back( sofa::smax( (std::size_t) 1, dimensionSizes[i] ) );
+    }
+    
+    chunkShape[m] = 1;
+    
+    if( accessPattern == kMeasurementAccess )
+    {
+        if( r < chunkShape.size()
+         && WriteOptionsHelper::getNumBytes( chunkShape, elementSize ) > WriteOptionsHelper::kMaxMeasurementChunkSize )
+        {
+            chunkShape[r] = 1;
+        }
+        
+        if( e < chunkShape.size()
+         && WriteOptionsHelper::getNumBytes( chunkShape, elementSize ) > WriteOptionsHelper::kMaxMeasurementChunkSize )
+        {
+            chunkShape[e] = 1;
+        }
+    }
+    else if( accessPattern == kWholeFileAccess )
+    {
+        const std::size_t measurementSize = WriteOptionsHelper::getNumBytes( chunkShape, elementSize );
+        
+        chunkShape[m] = WriteOptionsHelper::getNumMeasurements( targetSize, measurementSize, dimensionSizes[m] );
+    }
+    else if( accessPattern == kReceiverAccess )
+    {
+        if( r < chunkShape.size() )
+        {
+            chunkShape[r] = 1;
+        }
+        
+        const std::size_t measurementSize = WriteOptionsHelper::getNumBytes( chunkShape, elementSize );
+        
+        chunkShape[m] = WriteOptionsHelper::getNumMeasurements( targetSize, measurementSize, dimensionSizes[m] );
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Resolves the compression parameters of the data variables
+ *  @param[out]     deflateLevel : in [0 9], 0 if the values are not compressed
+ *  @param[out]     shuffle : true if the shuffle filter is enabled (only when deflating)
+ *
+ *  @details        The explicit deflate level always wins. Otherwise, the chunks read one
+ *                  at a time (measurement and receiver access) use a fast level (1), and
+ *                  the large chunks of the whole file access a stronger one (4)
+ */
+/************************************************************************************/
+void WriteOptions::GetCompressionParameters(int &deflateLevel_,
+                                            bool &shuffle_) const
+{
+    if( deflateLevel >= 0 )
+    {
+        deflateLevel_ = deflateLevel;
+    }
+    else if( accessPattern == kMeasurementAccess || accessPattern == kReceiverAccess )
+    {
+        deflateLevel_ = 1;
+    }
+    else if( accessPattern == kWholeFileAccess )
+    {
+        deflateLevel_ = 4;
+    }
+    else
+    {
+        deflateLevel_ = 0;
+    }
+    
+    shuffle_ = ( shuffle == true && deflateLevel_ > 0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the name of an access pattern
+ *
+ */
+/************************************************************************************/
+std::string WriteOptions::GetName(const AccessPattern pattern)
+{
+    switch( pattern )
+    {
+        case kDefaultAccess     : return "default";
+        case kMeasurementAccess : return "measurement";
+        case kWholeFileAccess   : return "whole file";
+        case kReceiverAccess    : return "receiver";
+    }
+    
+    return "unknown";
+}
@@ -0,0 +1,136 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAWriteOptions.h
+ *   @brief      Options used when writing a SOFA file : chunking and compression
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_WRITE_OPTIONS_H__
+#define _SOFA_WRITE_OPTIONS_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          WriteOptions
+     *  @brief          Options used when writing a SOFA file
+     *
+     *  @details        Chooses the chunk shape and the compression (deflate, shuffle) of the
+     *                  data variables, i.e. the variables along M and N (Data.IR, Data.Real,
+     *                  Data.Imag, Data.SOS). The other variables are small, and keep the
+     *                  library defaults.
+     *                  The default chunk shapes of netCDF do not know how the file is going
+     *                  to be read : the chunk shape is instead derived from an access pattern,
+     *                  so that reading one measurement, or one receiver, inflates as few
+     *                  chunks as possible. The deflate level left negative is also derived
+     *                  from the access pattern.
+     *                  With more than one thread, the chunks of the compressed data variables
+     *                  are compressed in parallel, and written with sofa::ChunkWriter : the
+     *                  file is the same as the one written by netCDF.
+     */
+    /************************************************************************************/
+    class SOFA_API WriteOptions
+    {
+    public:
+        /// how the data of the file is going to be read
+        enum AccessPattern
+        {
+            kDefaultAccess      = 0,    ///< no hint : the library defaults are kept
+            kMeasurementAccess  = 1,    ///< one measurement at a time, in any order : one chunk per measurement
+            kWholeFileAccess    = 2,    ///< all the measurements at once : large chunks, along M
+            kReceiverAccess     = 3     ///< one receiver at a time, streaming along M
+        };
+    
+    public:
+        WriteOptions();
+        
+        explicit WriteOptions(const AccessPattern accessPattern,
+                              const int deflateLevel = -1,
+                              const bool shuffle = true);
+        
+        ~WriteOptions() {};
+        
+        bool IsDefault() const;
+        
+        void SetAccessPattern(const AccessPattern pattern);
+        void SetDeflateLevel(const int level);
+        void SetShuffle(const bool enable);
+        void SetChunkSize(const std::size_t size);
+        void SetNumThreads(const unsigned int num);
+        
+        AccessPattern GetAccessPattern() const;
+        int GetDeflateLevel() const;
+        bool GetShuffle() const;
+        std::size_t GetChunkSize() const;
+        unsigned int GetNumThreads() const;
+        
+        static bool IsDataVariable(const std::vector< std::string > &dimensionNames);
+        
+        bool GetChunkShape(std::vector< std::size_t > &chunkShape,
+                           const std::vector< std::string > &dimensionNames,
+                           const std::vector< std::size_t > &dimensionSizes,
+                           const std::size_t elementSize) const;
+        
+        void GetCompressionParameters(int &deflateLevel,
+                                      bool &shuffle) const;
+        
+        static std::string GetName(const AccessPattern pattern);
+    
+    private:
+        AccessPattern accessPattern;
+        int deflateLevel;               ///< in [0 9], 0 disables the compression (negative : derived from the access pattern)
+        bool shuffle;                   ///< shuffles the bytes of the values before deflating them
+        std::size_t chunkSize;          ///< targeted size of the chunks, in bytes (0 : default)
+        unsigned int numThreads;        ///< threads compressing the data variables (1 : by netCDF, 0 : one per hardware thread)
+    };
+
+}
+
+#endif /* _SOFA_WRITE_OPTIONS_H__ */
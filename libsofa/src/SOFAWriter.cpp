@@ -0,0 +1,1842 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAWriter.cpp
+ *   @brief      Creates SOFA files : schema defined in one pass, data written in bulk
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#include "../src/SOFAWriter.h"
+#include "../src/SOFASimpleFreeFieldHRIR.h"
+#include "../src/SOFASimpleFreeFieldSOS.h"
+#include "../src/SOFASimpleHeadphoneIR.h"
+#include "../src/SOFAGeneralFIR.h"
+#include "../src/SOFAGeneralFIRE.h"
+#include "../src/SOFAGeneralTF.h"
+#include "../src/SOFAMultiSpeakerBRIR.h"
+#include "../src/SOFASingleRoomDRIR.h"
+#include "../src/SOFAAmbisonicsDRIR.h"
+#include "../src/SOFAChunkWriter.h"
+#include "../src/SOFADate.h"
+#include "../src/SOFANcUtils.h"
+#include "../src/SOFAString.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace WriterHelper
+{
+    typedef std::vector< std::pair< std::string, std::string > > Attributes;
+    
+    static Attributes::iterator findAttribute(Attributes &attributes, const std::string &name)
+    {
+        for( Attributes::iterator it = attributes.begin(); it != attributes.end(); ++it )
+        {
+            if( it->first == name )
+            {
+                return it;
+            }
+        }
+        
+        return attributes.end();
+    }
+    
+    /// once the file is written, an attribute can no longer be changed (that would
+    /// require going back to define mode) : setting the same value again is accepted
+    static bool setAttribute(Attributes &attributes,
+                             const std::string &name,
+                             const std::string &value,
+                             const bool written)
+    {
+        Attributes::iterator it = findAttribute( attributes, name );
+        
+        if( it != attributes.end() && it->second == value )
+        {
+            return true;
+        }
+        
+        if( written == true )
+        {
+            return false;
+        }
+        
+        if( it != attributes.end() )
+        {
+            it->second = value;
+        }
+        else
+        {
+            attributes.push_back( std::make_pair( name, value ) );
+        }
+        
+        return true;
+    }
+    
+    /// the checks of the conventions never raise exceptions : only opening the file may throw
+    template< class FileType >
+    bool validate(const std::string &filename, sofa::ValidationReport &report)
+    {
+        try
+        {
+            const FileType file( filename );
+            
+            return file.Validate( report );
+        }
+        catch( std::exception &e )
+        {
+            report.Add( sofa::ValidationReport::kInvalidNetCDFFile, e.what(), filename );
+            return false;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor. The file is not created until Write()
+ *  @param[in]      path : the file to create
+ *  @param[in]      overwrite : if false, Write() fails if the file already exists
+ *
+ */
+/************************************************************************************/
+Writer::Writer(const std::string &path,
+               const bool overwrite_)
+: filename( path )
+, overwrite( overwrite_ )
+, written( false )
+, closed( false )
+, numAppended( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor : completes the last measurement appended and closes
+ *                  the file, if Write() created it and Close() was not called.
+ *                  A file that was not written yet is never created (nor overwritten)
+ *
+ */
+/************************************************************************************/
+Writer::~Writer()
+{
+    if( written == false || closed == true )
+    {
+        return;
+    }
+    
+    /// the destructor may be called while an exception is thrown : throwing from it
+    /// would terminate the program, so the errors are ignored (call Close() to get them)
+    try
+    {
+        commitMeasurement();
+        
+        file.close();
+        closed = true;
+    }
+    catch( ... )
+    {
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets a global attribute; the SOFA global attributes are always strings
+ *  @return         false if the file is already written, and the value differs
+ *
+ */
+/************************************************************************************/
+bool Writer::SetGlobalAttribute(const std::string &name, const std::string &value)
+{
+    return WriterHelper::setAttribute( globalAttributes, name, value, written );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets a global attribute defined by the SOFA specifications
+ *  @return         false if the file is already written, and the value differs
+ *
+ */
+/************************************************************************************/
+bool Writer::SetGlobalAttribute(const sofa::Attributes::Type &type_, const std::string &value)
+{
+    return SetGlobalAttribute( sofa::Attributes::GetName( type_ ), value );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the global attributes defined by the SOFA specifications
+ *  @param[in]      attributes : the required attributes are always set, the optional ones
+ *                  only if not empty
+ *  @return         false if the file is already written, and a value differs
+ *
+ *  @details        The read-only attributes (Conventions, SOFAConventions, APIName, etc.)
+ *                  that are already defined (e.g. by a per-convention writer) are kept
+ */
+/************************************************************************************/
+bool Writer::SetGlobalAttributes(const sofa::Attributes &attributes)
+{
+    bool success = true;
+    
+    for( unsigned int i = 0; i < sofa::Attributes::kNumAttributes; i++ )
+    {
+        const sofa::Attributes::Type type_ = static_cast< const sofa::Attributes::Type >( i );
+        
+        const std::string name  = sofa::Attributes::GetName( type_ );
+        const std::string value = attributes.Get( type_ );
+        
+        const bool defined = ( WriterHelper::findAttribute( globalAttributes, name ) != globalAttributes.end() );
+        
+        if( sofa::Attributes::IsReadOnly( type_ ) == true && defined == true )
+        {
+            continue;
+        }
+        
+        if( sofa::Attributes::IsRequired( type_ ) == true || value.empty() == false )
+        {
+            success &= SetGlobalAttribute( name, value );
+        }
+    }
+    
+    return success;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the value of a global attribute, or an empty string if it is not set
+ *
+ */
+/************************************************************************************/
+std::string Writer::GetGlobalAttribute(const std::string &name) const
+{
+    for( std::size_t i = 0; i < globalAttributes.size(); i++ )
+    {
+        if( globalAttributes[i].first == name )
+        {
+            return globalAttributes[i].second;
+        }
+    }
+    
+    return "";
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the chunking and compression of the data variables
+ *  @return         false if the file is already written
+ *
+ */
+/************************************************************************************/
+bool Writer::SetWriteOptions(const sofa::WriteOptions &options_)
+{
+    if( written == true )
+    {
+        return false;
+    }
+    
+    options = options_;
+    
+    return true;
+}
+
+const sofa::WriteOptions & Writer::GetWriteOptions() const
+{
+    return options;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds a dimension
+ *  @param[in]      name : name of the dimension
+ *  @param[in]      size : its size; 0 for an unlimited dimension (M, when the measurements
+ *                  are appended one at a time)
+ *  @return         false if the dimension already exists, or if the file is already written
+ *
+ */
+/************************************************************************************/
+bool Writer::AddDimension(const std::string &name, const std::size_t size)
+{
+    if( written == true || GetDimension( name ) >= 0 )
+    {
+        return false;
+    }
+    
+    dimensions.push_back( std::make_pair( name, size ) );
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the size of a dimension, or -1 if the dimension does not exist
+ *
+ */
+/************************************************************************************/
+long Writer::GetDimension(const std::string &name) const
+{
+    for( std::size_t i = 0; i < dimensions.size(); i++ )
+    {
+        if( dimensions[i].first == name )
+        {
+            return (long) dimensions[i].second;
+        }
+    }
+    
+    return -1;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds a variable
+ *  @param[in]      name : name of the variable
+ *  @param[in]      dimensionNames : its dimensions, which must have been added beforehand
+ *                  (empty for a scalar)
+ *  @param[in]      type : type of the values stored in the file
+ *  @return         false if the variable already exists, if a dimension is missing,
+ *                  or if the file is already written
+ *
+ */
+/************************************************************************************/
+bool Writer::AddVariable(const std::string &name,
+                         const std::vector< std::string > &dimensionNames,
+                         const netCDF::NcType &type)
+{
+    if( written == true || HasVariable( name ) == true || hasDimensions( dimensionNames ) == false )
+    {
+        return false;
+    }
+    
+    Variable variable;
+    variable.name           = name;
+    variable.type           = type.getId();
+    variable.dimensionNames = dimensionNames;
+    variable.hasValues      = false;
+    variable.hasMeasurement = false;
+    
+    variables.push_back( variable );
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Changes the dimensions of a variable (e.g. SourcePosition defined as [I C]
+ *                  by a per-convention writer, that varies along the measurements : [M C])
+ *  @return         false if the variable or a dimension is missing, or if the file is already written
+ *
+ *  @details        The values already set are dropped if their number no longer matches
+ */
+/************************************************************************************/
+bool Writer::SetVariableDimensions(const std::string &name,
+                                   const std::vector< std::string > &dimensionNames)
+{
+    Variable *variable = findVariable( name );
+    
+    if( written == true || variable == NULL || hasDimensions( dimensionNames ) == false )
+    {
+        return false;
+    }
+    
+    variable->dimensionNames = dimensionNames;
+    
+    if( variable->hasValues == true && variable->values.size() != getNumElements( *variable ) )
+    {
+        variable->hasValues = false;
+        variable->values.clear();
+    }
+    
+    if( variable->defaultMeasurement.size() != getMeasurementNumElements( *variable ) )
+    {
+        variable->defaultMeasurement.clear();
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Changes the type of the values of a variable stored in the file
+ *                  (e.g. Data.IR stored as float rather than double)
+ *  @param[in]      type : netCDF::ncFloat or netCDF::ncDouble
+ *  @return         false if the variable is missing, if the type is not floating-point,
+ *                  or if the file is already written
+ *
+ *  @details        The values are given as double or float either way, and converted when
+ *                  written; the precision lost is reported by GetConversionReport()
+ */
+/************************************************************************************/
+bool Writer::SetVariableType(const std::string &name,
+                             const netCDF::NcType &type)
+{
+    Variable *variable = findVariable( name );
+    
+    if( written == true || variable == NULL || ( type != netCDF::ncFloat && type != netCDF::ncDouble ) )
+    {
+        return false;
+    }
+    
+    variable->type = type.getId();
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets an attribute of a variable
+ *  @return         false if the variable is missing, or if the file is already written
+ *                  and the value differs
+ *
+ */
+/************************************************************************************/
+bool Writer::SetVariableAttribute(const std::string &variableName,
+                                  const std::string &attributeName,
+                                  const std::string &value)
+{
+    Variable *variable = findVariable( variableName );
+    
+    if( variable == NULL )
+    {
+        return false;
+    }
+    
+    return WriterHelper::setAttribute( variable->attributes, attributeName, value, written );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the variable is defined
+ *
+ */
+/************************************************************************************/
+bool Writer::HasVariable(const std::string &name) const
+{
+    return ( findVariable( name ) != NULL );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of elements of a variable, or 0 if it is not defined
+ *
+ */
+/************************************************************************************/
+std::size_t Writer::GetVariableNumElements(const std::string &name) const
+{
+    const Variable *variable = findVariable( name );
+    
+    return ( variable != NULL ) ? getNumElements( *variable ) : 0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets all the values of a variable
+ *  @param[in]      variableName : the variable
+ *  @param[in]      values : the values, laid out as the dimensions of the variable
+ *  @param[in]      numValues : must match the number of elements of the variable
+ *  @return         true on success
+ *
+ *  @details        Before Write(), the values are copied, and written by Write().
+ *                  Afterwards, they are written at once
+ */
+/************************************************************************************/
+bool Writer::SetValues(const std::string &variableName, const double *values, const std::size_t numValues)
+{
+    return setValues( variableName, values, numValues );
+}
+
+bool Writer::SetValues(const std::string &variableName, const float *values, const std::size_t numValues)
+{
+    return setValues( variableName, values, numValues );
+}
+
+bool Writer::SetValues(const std::string &variableName, const std::vector< double > &values)
+{
+    return setValues( variableName, values.empty() ? NULL : &values[0], values.size() );
+}
+
+bool Writer::SetValues(const std::string &variableName, const std::vector< float > &values)
+{
+    return setValues( variableName, values.empty() ? NULL : &values[0], values.size() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the values of a position (or view) variable, and its Type and Units
+ *  @param[in]      variableName : e.g. SourcePosition
+ *  @param[in]      values : the coordinates of each position
+ *  @param[in]      numValues : must match the number of elements of the variable
+ *  @param[in]      coordinates : the Units are "metre", or "degree, degree, metre"
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool Writer::SetPosition(const std::string &variableName,
+                         const double *values,
+                         const std::size_t numValues,
+                         const sofa::Coordinates::Type &coordinates)
+{
+    const sofa::Units::Type units = ( coordinates == sofa::Coordinates::kSpherical ) ? sofa::Units::kSphericalUnits : sofa::Units::kMeter;
+    
+    if( SetVariableAttribute( variableName, "Type", sofa::Coordinates::GetName( coordinates ) ) == false
+     || SetVariableAttribute( variableName, "Units", sofa::Units::GetName( units ) ) == false )
+    {
+        return false;
+    }
+    
+    return SetValues( variableName, values, numValues );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets Data.SamplingRate, when it is a scalar
+ *
+ */
+/************************************************************************************/
+bool Writer::SetSamplingRate(const double samplingRate)
+{
+    return SetValues( "Data.SamplingRate", &samplingRate, 1 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets all the values of Data.IR
+ *
+ */
+/************************************************************************************/
+bool Writer::SetDataIR(const double *values, const std::size_t numValues)
+{
+    return SetValues( "Data.IR", values, numValues );
+}
+
+bool Writer::SetDataIR(const float *values, const std::size_t numValues)
+{
+    return SetValues( "Data.IR", values, numValues );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets all the values of Data.Delay
+ *
+ */
+/************************************************************************************/
+bool Writer::SetDataDelay(const double *values, const std::size_t numValues)
+{
+    return SetValues( "Data.Delay", values, numValues );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the values of a variable for the measurements where it is not put
+ *  @param[in]      variableName : a variable whose first dimension is M
+ *  @param[in]      values : the values of one measurement
+ *  @param[in]      numValues : must match GetMeasurementNumElements()
+ *  @return         false if the file is already written
+ *
+ *  @details        Without default measurement, zeros are written
+ */
+/************************************************************************************/
+bool Writer::SetDefaultMeasurement(const std::string &variableName,
+                                   const double *values,
+                                   const std::size_t numValues)
+{
+    Variable *variable = findVariable( variableName );
+    
+    if( written == true || variable == NULL || values == NULL
+     || numValues == 0 || numValues != getMeasurementNumElements( *variable ) )
+    {
+        return false;
+    }
+    
+    variable->defaultMeasurement.assign( values, values + numValues );
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of elements of a variable for one measurement,
+ *                  or 0 if the first dimension of the variable is not M
+ *
+ */
+/************************************************************************************/
+std::size_t Writer::GetMeasurementNumElements(const std::string &variableName) const
+{
+    const Variable *variable = findVariable( variableName );
+    
+    return ( variable != NULL ) ? getMeasurementNumElements( *variable ) : 0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Starts a new measurement. The previous one is completed first : the
+ *                  variables that were not put are written with their default measurement
+ *  @return         false if the file is not written yet (or closed), or if M is pre-sized
+ *                  and all its measurements are already appended
+ *
+ */
+/************************************************************************************/
+bool Writer::AppendMeasurement()
+{
+    const long size = GetDimension( "M" );
+    
+    if( written == false || closed == true || size < 0 )
+    {
+        return false;
+    }
+    
+    if( size > 0 && numAppended >= (std::size_t) size )
+    {
+        return false;
+    }
+    
+    commitMeasurement();
+    
+    numAppended++;
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the values of a variable for the current measurement
+ *  @param[in]      variableName : a variable whose first dimension is M
+ *  @param[in]      values : the values of one measurement
+ *  @param[in]      numValues : must match GetMeasurementNumElements()
+ *  @return         false if no measurement was appended, or if the file is closed
+ *
+ */
+/************************************************************************************/
+bool Writer::PutMeasurement(const std::string &variableName, const double *values, const std::size_t numValues)
+{
+    return putMeasurement( variableName, values, numValues );
+}
+
+bool Writer::PutMeasurement(const std::string &variableName, const float *values, const std::size_t numValues)
+{
+    return putMeasurement( variableName, values, numValues );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of measurements appended so far
+ *
+ */
+/************************************************************************************/
+std::size_t Writer::GetNumMeasurements() const
+{
+    return numAppended;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Creates the file, defines all the global attributes, dimensions and
+ *                  variables, then writes all the values set so far
+ *  @return         false if the file was already written
+ *
+ *  @details        Define mode is left only once, after the whole schema is defined :
+ *                  the values are not written in between definitions, which would
+ *                  go back and forth between define mode and data mode.
+ *                  Errors of the netCDF library (e.g. the file already exists and
+ *                  overwrite is false) raise exceptions
+ */
+/************************************************************************************/
+bool Writer::Write()
+{
+    if( written == true )
+    {
+        return false;
+    }
+    
+    const netCDF::NcFile::FileMode mode = ( overwrite == true ) ? netCDF::NcFile::replace : netCDF::NcFile::newFile;
+    
+    file.open( filename, mode, netCDF::NcFile::nc4 );
+    written = true;
+    
+    for( std::size_t i = 0; i < globalAttributes.size(); i++ )
+    {
+        file.putAtt( globalAttributes[i].first, globalAttributes[i].second );
+    }
+    
+    std::vector< netCDF::NcDim > ncDims( dimensions.size() );
+    
+    for( std::size_t i = 0; i < dimensions.size(); i++ )
+    {
+        ncDims[i] = file.addDim( dimensions[i].first, dimensions[i].second );
+    }
+    
+    std::vector< netCDF::NcVar > ncVars( variables.size() );
+    
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        const Variable & variable = variables[i];
+        
+        std::vector< netCDF::NcDim > varDims( variable.dimensionNames.size() );
+        
+        for( std::size_t j = 0; j < varDims.size(); j++ )
+        {
+            const std::size_t index = std::distance( dimensions.begin(),
+                                                     std::find_if( dimensions.begin(), dimensions.end(),
+                                                                   [&]( const std::pair< std::string, std::size_t > &dim )
+                                                                   {
+                                                                       return dim.first == variable.dimensionNames[j];
+                                                                   } ) );
+            SOFA_ASSERT( index < ncDims.size() );
+            
+            varDims[j] = ncDims[index];
+        }
+        
+        ncVars[i] = file.addVar( variable.name, netCDF::NcType( variable.type ), varDims );
+        
+        for( std::size_t j = 0; j < variable.attributes.size(); j++ )
+        {
+            ncVars[i].putAtt( variable.attributes[j].first, variable.attributes[j].second );
+        }
+        
+        if( sofa::WriteOptions::IsDataVariable( variable.dimensionNames ) == true )
+        {
+            applyWriteOptions( ncVars[i], variable );
+        }
+    }
+    
+    /// the schema is complete : leave define mode, once
+    file.enddef();
+    
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        Variable & variable = variables[i];
+        
+        if( variable.hasValues == true )
+        {
+            std::vector< std::size_t > start, count;
+            getVariableSlab( variable, start, count );
+            
+            addToConversionReport( variable, &variable.values[0], start, count );
+            
+            /// (putChunks may close the file : the variable is looked up through getFile())
+            if( putChunks( variable, &variable.values[0], start, count ) == false )
+            {
+                getFile().getVar( variable.name ).putVar( &variable.values[0] );
+            }
+            
+            /// release the staged copy
+            std::vector< double >().swap( variable.values );
+        }
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true once the file is created
+ *
+ */
+/************************************************************************************/
+bool Writer::IsWritten() const
+{
+    return written;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a hyperslab of a variable, directly from the buffer of the caller
+ *  @param[in]      variableName : the variable
+ *  @param[in]      values : the values of the hyperslab
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @return         false if the file is not written yet (or closed), or if the variable is missing
+ *
+ */
+/************************************************************************************/
+bool Writer::PutValues(const std::string &variableName,
+                       const double *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count)
+{
+    return putValues( variableName, values, start, count );
+}
+
+bool Writer::PutValues(const std::string &variableName,
+                       const float *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count)
+{
+    return putValues( variableName, values, start, count );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Closes the file; writes it first if Write() was not called,
+ *                  and completes the last measurement appended
+ *
+ *  @details        When M is pre-sized, the measurements that were not appended keep
+ *                  the fill value of the netCDF library
+ */
+/************************************************************************************/
+void Writer::Close()
+{
+    if( closed == true )
+    {
+        return;
+    }
+    
+    Write();
+    commitMeasurement();
+    
+    file.close();
+    closed = true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Closes the file, then checks it against its convention
+ *  @param[out]     report : the issues found are appended to this report
+ *  @return         true if the file is valid
+ *
+ */
+/************************************************************************************/
+bool Writer::Close(sofa::ValidationReport &report)
+{
+    Close();
+    
+    return Validate( report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true once the file is closed
+ *
+ */
+/************************************************************************************/
+bool Writer::IsClosed() const
+{
+    return closed;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the file produced against its convention. Never throws an exception
+ *  @param[out]     report : the issues found are appended to this report
+ *  @return         true if the file is valid; false if it is not closed yet
+ *
+ */
+/************************************************************************************/
+bool Writer::Validate(sofa::ValidationReport &report) const
+{
+    if( closed == false )
+    {
+        report.Add( sofa::ValidationReport::kInvalidNetCDFFile, "the file is not closed", filename );
+        return false;
+    }
+    
+    return validate( report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the precision lost by the variables stored as float, for all
+ *                  the values written so far
+ *
+ */
+/************************************************************************************/
+const sofa::ConversionReport & Writer::GetConversionReport() const
+{
+    return conversionReport;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the path of the file
+ *
+ */
+/************************************************************************************/
+const std::string & Writer::GetFilename() const
+{
+    return filename;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the file against the SOFA specifications
+ *
+ */
+/************************************************************************************/
+bool Writer::validate(sofa::ValidationReport &report) const
+{
+    return WriterHelper::validate< sofa::File >( filename, report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the global attributes to their default, for a given convention
+ *
+ */
+/************************************************************************************/
+void Writer::defineConvention(const std::string &conventionName,
+                              const std::string &conventionVersion,
+                              const std::string &dataType,
+                              const std::string &roomType)
+{
+    const std::string now = sofa::Date::GetCurrentDate().ToISO8601();
+    
+    sofa::Attributes attributes;
+    attributes.ResetToDefault();
+    
+    attributes.Set( sofa::Attributes::kSOFAConventions,        conventionName );
+    attributes.Set( sofa::Attributes::kSOFAConventionsVersion, conventionVersion );
+    attributes.Set( sofa::Attributes::kDataType,               dataType );
+    attributes.Set( sofa::Attributes::kRoomType,               roomType );
+    attributes.Set( sofa::Attributes::kDateCreated,            now );
+    attributes.Set( sofa::Attributes::kDateModified,           now );
+    
+    SetGlobalAttributes( attributes );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds the SOFA dimensions
+ *
+ */
+/************************************************************************************/
+void Writer::defineDimensions(const std::size_t numMeasurements,
+                              const std::size_t numReceivers,
+                              const std::size_t numEmitters,
+                              const std::size_t numDataSamples)
+{
+    AddDimension( "C", 3 );
+    AddDimension( "I", 1 );
+    AddDimension( "M", numMeasurements );
+    AddDimension( "R", numReceivers );
+    AddDimension( "E", numEmitters );
+    AddDimension( "N", numDataSamples );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds a position (or view) variable, with its Type and Units,
+ *                  the same coordinates being repeated for each element
+ *
+ *  @details        C must be the last dimension of the variable, or be followed by I only
+ */
+/************************************************************************************/
+void Writer::definePosition(const std::string &name,
+                            const std::vector< std::string > &dimensionNames,
+                            const sofa::Coordinates::Type &coordinates,
+                            const double x, const double y, const double z)
+{
+    defineDirection( name, dimensionNames, x, y, z );
+    
+    const sofa::Units::Type units = ( coordinates == sofa::Coordinates::kSpherical ) ? sofa::Units::kSphericalUnits : sofa::Units::kMeter;
+    
+    SetVariableAttribute( name, "Type", sofa::Coordinates::GetName( coordinates ) );
+    SetVariableAttribute( name, "Units", sofa::Units::GetName( units ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds an up vector, without Type nor Units (those of the view are used),
+ *                  the same vector being repeated for each element
+ *
+ */
+/************************************************************************************/
+void Writer::defineDirection(const std::string &name,
+                             const std::vector< std::string > &dimensionNames,
+                             const double x, const double y, const double z)
+{
+    AddVariable( name, dimensionNames );
+    
+    /// when the measurements are appended, the values are those of each measurement
+    const bool appended = ( GetDimension( "M" ) == 0 && GetMeasurementNumElements( name ) > 0 );
+    
+    const std::size_t numElements = ( appended == true ) ? GetMeasurementNumElements( name ) : GetVariableNumElements( name );
+    
+    std::vector< double > values( numElements );
+    
+    for( std::size_t i = 0; i + 2 < numElements; i += 3 )
+    {
+        values[i]     = x;
+        values[i + 1] = y;
+        values[i + 2] = z;
+    }
+    
+    if( appended == true )
+    {
+        SetDefaultMeasurement( name, &values[0], numElements );
+    }
+    else
+    {
+        SetValues( name, values );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds Data.SamplingRate, as a scalar [I]
+ *
+ */
+/************************************************************************************/
+void Writer::defineSamplingRate(const double samplingRate)
+{
+    AddVariable( "Data.SamplingRate", { "I" } );
+    SetVariableAttribute( "Data.SamplingRate", "Units", sofa::Units::GetName( sofa::Units::kHertz ) );
+    SetSamplingRate( samplingRate );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds a variable filled with zeros
+ *
+ */
+/************************************************************************************/
+void Writer::defineZeros(const std::string &name,
+                         const std::vector< std::string > &dimensionNames)
+{
+    AddVariable( name, dimensionNames );
+    
+    const std::vector< double > values( GetVariableNumElements( name ), 0.0 );
+    SetValues( name, values );
+}
+
+Writer::Variable * Writer::findVariable(const std::string &name)
+{
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        if( variables[i].name == name )
+        {
+            return &variables[i];
+        }
+    }
+    
+    return NULL;
+}
+
+const Writer::Variable * Writer::findVariable(const std::string &name) const
+{
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        if( variables[i].name == name )
+        {
+            return &variables[i];
+        }
+    }
+    
+    return NULL;
+}
+
+bool Writer::hasDimensions(const std::vector< std::string > &dimensionNames) const
+{
+    for( std::size_t i = 0; i < dimensionNames.size(); i++ )
+    {
+        if( GetDimension( dimensionNames[i] ) < 0 )
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+std::size_t Writer::getNumElements(const Variable &variable) const
+{
+    std::size_t numElements = 1;
+    
+    for( std::size_t i = 0; i < variable.dimensionNames.size(); i++ )
+    {
+        numElements *= (std::size_t) GetDimension( variable.dimensionNames[i] );
+    }
+    
+    return numElements;
+}
+
+std::size_t Writer::getMeasurementNumElements(const Variable &variable) const
+{
+    if( variable.dimensionNames.empty() == true || variable.dimensionNames[0] != "M" )
+    {
+        return 0;
+    }
+    
+    std::size_t numElements = 1;
+    
+    for( std::size_t i = 1; i < variable.dimensionNames.size(); i++ )
+    {
+        numElements *= (std::size_t) GetDimension( variable.dimensionNames[i] );
+    }
+    
+    return numElements;
+}
+
+/// chunk shape and compression of a data variable, in define mode
+void Writer::applyWriteOptions(const netCDF::NcVar &var, const Variable &variable) const
+{
+    std::vector< std::size_t > dimensionSizes( variable.dimensionNames.size() );
+    
+    for( std::size_t i = 0; i < dimensionSizes.size(); i++ )
+    {
+        dimensionSizes[i] = (std::size_t) GetDimension( variable.dimensionNames[i] );
+    }
+    
+    std::vector< std::size_t > chunkShape;
+    
+    if( options.GetChunkShape( chunkShape, variable.dimensionNames, dimensionSizes, var.getType().getSize() ) == true )
+    {
+        var.setChunking( netCDF::NcVar::nc_CHUNKED, chunkShape );
+    }
+    
+    int deflateLevel = 0;
+    bool shuffle     = false;
+    options.GetCompressionParameters( deflateLevel, shuffle );
+    
+    if( deflateLevel > 0 )
+    {
+        var.setCompression( shuffle, true, deflateLevel );
+    }
+}
+
+/// the hyperslab of the current measurement
+void Writer::getMeasurementSlab(const Variable &variable,
+                                std::vector< std::size_t > &start,
+                                std::vector< std::size_t > &count) const
+{
+    start.assign( variable.dimensionNames.size(), 0 );
+    count.resize( variable.dimensionNames.size() );
+    
+    start[0] = numAppended - 1;
+    count[0] = 1;
+    
+    for( std::size_t i = 1; i < count.size(); i++ )
+    {
+        count[i] = (std::size_t) GetDimension( variable.dimensionNames[i] );
+    }
+}
+
+/// the hyperslab of the whole variable
+void Writer::getVariableSlab(const Variable &variable,
+                             std::vector< std::size_t > &start,
+                             std::vector< std::size_t > &count) const
+{
+    start.assign( variable.dimensionNames.size(), 0 );
+    count.resize( variable.dimensionNames.size() );
+    
+    for( std::size_t i = 0; i < count.size(); i++ )
+    {
+        count[i] = (std::size_t) GetDimension( variable.dimensionNames[i] );
+    }
+}
+
+/// the netCDF handle of the file being written, reopened if putChunks closed it
+netCDF::NcFile & Writer::getFile()
+{
+    if( file.isNull() == true && written == true && closed == false )
+    {
+        file.open( filename, netCDF::NcFile::write );
+    }
+    
+    return file;
+}
+
+/// writes the default measurement of the variables that were not put for the current measurement
+void Writer::commitMeasurement()
+{
+    if( numAppended == 0 )
+    {
+        return;
+    }
+    
+    for( std::size_t i = 0; i < variables.size(); i++ )
+    {
+        Variable & variable = variables[i];
+        
+        const std::size_t numElements = getMeasurementNumElements( variable );
+        
+        if( numElements == 0 || variable.hasValues == true )
+        {
+            continue;
+        }
+        
+        if( variable.hasMeasurement == false )
+        {
+            if( variable.defaultMeasurement.empty() == true )
+            {
+                variable.defaultMeasurement.assign( numElements, 0.0 );
+            }
+            
+            std::vector< std::size_t > start, count;
+            getMeasurementSlab( variable, start, count );
+            
+            addToConversionReport( variable, &variable.defaultMeasurement[0], start, count );
+            
+            getFile().getVar( variable.name ).putVar( start, count, &variable.defaultMeasurement[0] );
+        }
+        
+        variable.hasMeasurement = false;
+    }
+}
+
+/// accumulates the error of the values of a slab, converted to float, per row along the last dimension
+template< typename Type >
+void Writer::addToConversionReport(const Variable &variable,
+                                   const Type *values,
+                                   const std::vector< std::size_t > &start,
+                                   const std::vector< std::size_t > &count)
+{
+    if( variable.type != NC_FLOAT || start.size() != count.size() )
+    {
+        return;
+    }
+    
+    const std::size_t rank = count.size();
+    
+    /// a scalar is a single row of one value
+    const std::size_t rowLength = ( rank > 0 ) ? count[rank - 1] : 1;
+    const std::size_t numRows   = ( rowLength > 0 ) ? sofa::NcUtils::GetNumElements( count ) / rowLength : 0;
+    
+    std::vector< std::size_t > position( rank, 0 );
+    
+    for( std::size_t row = 0; row < numRows; row++ )
+    {
+        /// position of the row inside the slab, then index of the row in the whole variable
+        std::size_t r = row;
+        
+        for( std::size_t i = rank; i > 1; i-- )
+        {
+            position[i - 2] = r % count[i - 2];
+            r /= count[i - 2];
+        }
+        
+        std::size_t index = 0;
+        
+        for( std::size_t d = 0; d + 1 < rank; d++ )
+        {
+            index = index * (std::size_t) GetDimension( variable.dimensionNames[d] ) + start[d] + position[d];
+        }
+        
+        double signalEnergy = 0.0;
+        double noiseEnergy  = 0.0;
+        double maxAbsError  = 0.0;
+        
+        for( std::size_t n = 0; n < rowLength; n++ )
+        {
+            const double value = (double) values[ row * rowLength + n ];
+            const double error = (double) (float) value - value;
+            
+            signalEnergy += value * value;
+            noiseEnergy  += error * error;
+            maxAbsError   = sofa::smax( maxAbsError, std::fabs( error ) );
+        }
+        
+        conversionReport.Add( variable.name, index, signalEnergy, noiseEnergy, maxAbsError );
+    }
+}
+
+/// compresses the chunks of a data variable in parallel, if the options ask for it.
+/// Returns false if the values are left to netCDF (e.g. the slab does not cover whole chunks)
+template< typename Type >
+bool Writer::putChunks(const Variable &variable,
+                       const Type *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count)
+{
+    int deflateLevel = 0;
+    bool shuffle     = false;
+    options.GetCompressionParameters( deflateLevel, shuffle );
+    
+    if( options.GetNumThreads() == 1
+     || deflateLevel <= 0
+     || sofa::WriteOptions::IsDataVariable( variable.dimensionNames ) == false
+     || ( variable.type != NC_DOUBLE && variable.type != NC_FLOAT )
+     || sofa::ChunkWriter::IsAvailable() == false )
+    {
+        return false;
+    }
+    
+    /// the chunks are written through HDF5 while the netCDF handle is closed : the file is
+    /// never opened twice, which is unsafe when netCDF bundles its own HDF5 library.
+    /// The handle is reopened by getFile(), when netCDF is needed again
+    file.close();
+    
+    const sofa::ChunkWriter writer( filename, options.GetNumThreads() );
+    
+    return writer.PutValues( variable.name, values, start, count );
+}
+
+template< typename Type >
+bool Writer::setValues(const std::string &variableName, const Type *values, const std::size_t numValues)
+{
+    Variable *variable = findVariable( variableName );
+    
+    if( closed == true || variable == NULL || values == NULL || numValues != getNumElements( *variable ) )
+    {
+        return false;
+    }
+    
+    if( written == true )
+    {
+        std::vector< std::size_t > start, count;
+        getVariableSlab( *variable, start, count );
+        
+        addToConversionReport( *variable, values, start, count );
+        
+        if( putChunks( *variable, values, start, count ) == false )
+        {
+            getFile().getVar( variableName ).putVar( values );
+        }
+    }
+    else
+    {
+        variable->values.assign( values, values + numValues );
+    }
+    
+    variable->hasValues = true;
+    
+    return true;
+}
+
+template< typename Type >
+bool Writer::putValues(const std::string &variableName,
+                       const Type *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count)
+{
+    const Variable *variable = findVariable( variableName );
+    
+    if( written == false || closed == true || variable == NULL || values == NULL )
+    {
+        return false;
+    }
+    
+    addToConversionReport( *variable, values, start, count );
+    
+    if( putChunks( *variable, values, start, count ) == false )
+    {
+        getFile().getVar( variableName ).putVar( start, count, values );
+    }
+    
+    return true;
+}
+
+template< typename Type >
+bool Writer::putMeasurement(const std::string &variableName, const Type *values, const std::size_t numValues)
+{
+    Variable *variable = findVariable( variableName );
+    
+    if( written == false || closed == true || numAppended == 0 || variable == NULL || values == NULL )
+    {
+        return false;
+    }
+    
+    const std::size_t numElements = getMeasurementNumElements( *variable );
+    
+    if( numElements == 0 || numValues != numElements )
+    {
+        return false;
+    }
+    
+    std::vector< std::size_t > start, count;
+    getMeasurementSlab( *variable, start, count );
+    
+    addToConversionReport( *variable, values, start, count );
+    
+    getFile().getVar( variableName ).putVar( start, count, values );
+    
+    variable->hasMeasurement = true;
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : defines the schema of a SimpleFreeFieldHRIR file
+ *  @param[in]      path : the file to create
+ *  @param[in]      numMeasurements : M, or 0 to append the measurements one at a time
+ *  @param[in]      numDataSamples : N
+ *  @param[in]      overwrite : if false, Write() fails if the file already exists
+ *
+ *  @details        The receivers are the left and right ears, at +/- 9 cm along y;
+ *                  Data.SamplingRate is 48 kHz, Data.Delay is 0, until set otherwise
+ */
+/************************************************************************************/
+SimpleFreeFieldHRIRWriter::SimpleFreeFieldHRIRWriter(const std::string &path,
+                                                     const std::size_t numMeasurements,
+                                                     const std::size_t numDataSamples,
+                                                     const bool overwrite_)
+: sofa::Writer( path, overwrite_ )
+{
+    defineConvention( "SimpleFreeFieldHRIR", SimpleFreeFieldHRIR::GetConventionVersion(), "FIR", "free field" );
+    SetGlobalAttribute( "DatabaseName", "" );
+    SetGlobalAttribute( sofa::Attributes::kListenerShortName, "" );
+    
+    defineDimensions( numMeasurements, 2, 1, numDataSamples );
+    
+    definePosition( "ListenerPosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "ListenerUp", { "I", "C" }, 0., 0., 1. );
+    definePosition( "ListenerView", { "I", "C" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    definePosition( "ReceiverPosition", { "R", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    {
+        const double ears[ 6 ] = { 0., 0.09, 0., 0., -0.09, 0. };
+        SetValues( "ReceiverPosition", ears, 6 );
+    }
+    
+    definePosition( "SourcePosition", { "M", "C" }, sofa::Coordinates::kSpherical, 0., 0., 1. );
+    definePosition( "EmitterPosition", { "E", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    
+    AddVariable( "Data.IR", { "M", "R", "N" } );
+    defineSamplingRate( 48000. );
+    defineZeros( "Data.Delay", { "I", "R" } );
+}
+
+bool SimpleFreeFieldHRIRWriter::validate(sofa::ValidationReport &report) const
+{
+    return WriterHelper::validate< sofa::SimpleFreeFieldHRIR >( GetFilename(), report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : defines the schema of a SimpleFreeFieldSOS file
+ *  @param[in]      path : the file to create
+ *  @param[in]      numMeasurements : M, or 0 to append the measurements one at a time
+ *  @param[in]      numSections : number of second-order sections; N is 6 times this number
+ *  @param[in]      overwrite : if false, Write() fails if the file already exists
+ *
+ */
+/************************************************************************************/
+SimpleFreeFieldSOSWriter::SimpleFreeFieldSOSWriter(const std::string &path,
+                                                   const std::size_t numMeasurements,
+                                                   const std::size_t numSections,
+                                                   const bool overwrite_)
+: sofa::Writer( path, overwrite_ )
+{
+    defineConvention( "SimpleFreeFieldSOS", SimpleFreeFieldSOS::GetConventionVersion(), "SOS", "free field" );
+    SetGlobalAttribute( "DatabaseName", "" );
+    
+    defineDimensions( numMeasurements, 2, 1, 6 * numSections );
+    
+    definePosition( "ListenerPosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "ListenerUp", { "I", "C" }, 0., 0., 1. );
+    definePosition( "ListenerView", { "I", "C" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    definePosition( "ReceiverPosition", { "R", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    {
+        const double ears[ 6 ] = { 0., 0.09, 0., 0., -0.09, 0. };
+        SetValues( "ReceiverPosition", ears, 6 );
+    }
+    
+    definePosition( "SourcePosition", { "M", "C" }, sofa::Coordinates::kSpherical, 0., 0., 1. );
+    definePosition( "EmitterPosition", { "E", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    
+    AddVariable( "Data.SOS", { "M", "R", "N" } );
+    defineSamplingRate( 48000. );
+    defineZeros( "Data.Delay", { "I", "R" } );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets all the values of Data.SOS
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldSOSWriter::SetDataSOS(const double *values, const std::size_t numValues)
+{
+    return SetValues( "Data.SOS", values, numValues );
+}
+
+bool SimpleFreeFieldSOSWriter::validate(sofa::ValidationReport &report) const
+{
+    return WriterHelper::validate< sofa::SimpleFreeFieldSOS >( GetFilename(), report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : defines the schema of a SimpleHeadphoneIR file
+ *  @param[in]      path : the file to create
+ *  @param[in]      numMeasurements : M, or 0 to append the measurements one at a time
+ *  @param[in]      numReceivers : R, which is also the number of emitters E
+ *  @param[in]      numDataSamples : N
+ *  @param[in]      overwrite : if false, Write() fails if the file already exists
+ *
+ */
+/************************************************************************************/
+SimpleHeadphoneIRWriter::SimpleHeadphoneIRWriter(const std::string &path,
+                                                 const std::size_t numMeasurements,
+                                                 const std::size_t numReceivers,
+                                                 const std::size_t numDataSamples,
+                                                 const bool overwrite_)
+: sofa::Writer( path, overwrite_ )
+{
+    defineConvention( "SimpleHeadphoneIR", SimpleHeadphoneIR::GetConventionVersion(), "FIR", "free field" );
+    SetGlobalAttribute( "DatabaseName", "" );
+    SetGlobalAttribute( "SourceModel", "" );
+    SetGlobalAttribute( "SourceManufacturer", "" );
+    SetGlobalAttribute( "SourceURI", "" );
+    SetGlobalAttribute( sofa::Attributes::kListenerShortName, "" );
+    SetGlobalAttribute( sofa::Attributes::kListenerDescription, "" );
+    SetGlobalAttribute( sofa::Attributes::kSourceDescription, "" );
+    SetGlobalAttribute( sofa::Attributes::kEmitterDescription, "" );
+    
+    defineDimensions( numMeasurements, numReceivers, numReceivers, numDataSamples );
+    
+    definePosition( "ListenerPosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "ListenerUp", { "I", "C" }, 0., 0., 1. );
+    definePosition( "ListenerView", { "I", "C" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    definePosition( "ReceiverPosition", { "R", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    definePosition( "SourcePosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    definePosition( "EmitterPosition", { "E", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    
+    AddVariable( "Data.IR", { "M", "R", "N" } );
+    defineSamplingRate( 48000. );
+    defineZeros( "Data.Delay", { "I", "R" } );
+}
+
+bool SimpleHeadphoneIRWriter::validate(sofa::ValidationReport &report) const
+{
+    return WriterHelper::validate< sofa::SimpleHeadphoneIR >( GetFilename(), report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : defines the schema of a GeneralFIR file
+ *  @param[in]      path : the file to create
+ *  @param[in]      numMeasurements : M, or 0 to append the measurements one at a time
+ *  @param[in]      numReceivers : R
+ *  @param[in]      numEmitters : E
+ *  @param[in]      numDataSamples : N
+ *  @param[in]      overwrite : if false, Write() fails if the file already exists
+ *
+ */
+/************************************************************************************/
+GeneralFIRWriter::GeneralFIRWriter(const std::string &path,
+                                   const std::size_t numMeasurements,
+                                   const std::size_t numReceivers,
+                                   const std::size_t numEmitters,
+                                   const std::size_t numDataSamples,
+                                   const bool overwrite_)
+: sofa::Writer( path, overwrite_ )
+{
+    defineConvention( "GeneralFIR", GeneralFIR::GetConventionVersion(), "FIR", "free field" );
+    
+    defineDimensions( numMeasurements, numReceivers, numEmitters, numDataSamples );
+    
+    definePosition( "ListenerPosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "ListenerUp", { "I", "C" }, 0., 0., 1. );
+    definePosition( "ListenerView", { "I", "C" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    definePosition( "ReceiverPosition", { "R", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    definePosition( "SourcePosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    definePosition( "EmitterPosition", { "E", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    
+    AddVariable( "Data.IR", { "M", "R", "N" } );
+    defineSamplingRate( 48000. );
+    defineZeros( "Data.Delay", { "I", "R" } );
+}
+
+bool GeneralFIRWriter::validate(sofa::ValidationReport &report) const
+{
+    return WriterHelper::validate< sofa::GeneralFIR >( GetFilename(), report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : defines the schema of a GeneralFIRE file
+ *  @param[in]      path : the file to create
+ *  @param[in]      numMeasurements : M, or 0 to append the measurements one at a time
+ *  @param[in]      numReceivers : R
+ *  @param[in]      numEmitters : E
+ *  @param[in]      numDataSamples : N
+ *  @param[in]      overwrite : if false, Write() fails if the file already exists
+ *
+ */
+/************************************************************************************/
+GeneralFIREWriter::GeneralFIREWriter(const std::string &path,
+                                     const std::size_t numMeasurements,
+                                     const std::size_t numReceivers,
+                                     const std::size_t numEmitters,
+                                     const std::size_t numDataSamples,
+                                     const bool overwrite_)
+: sofa::Writer( path, overwrite_ )
+{
+    defineConvention( "GeneralFIRE", GeneralFIRE::GetConventionVersion(), "FIRE", "free field" );
+    
+    defineDimensions( numMeasurements, numReceivers, numEmitters, numDataSamples );
+    
+    definePosition( "ListenerPosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "ListenerUp", { "I", "C" }, 0., 0., 1. );
+    definePosition( "ListenerView", { "I", "C" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    definePosition( "ReceiverPosition", { "R", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    definePosition( "SourcePosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    definePosition( "EmitterPosition", { "E", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    
+    AddVariable( "Data.IR", { "M", "R", "E", "N" } );
+    defineSamplingRate( 48000. );
+    defineZeros( "Data.Delay", { "I", "R", "E" } );
+}
+
+bool GeneralFIREWriter::validate(sofa::ValidationReport &report) const
+{
+    return WriterHelper::validate< sofa::GeneralFIRE >( GetFilename(), report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : defines the schema of a GeneralTF file
+ *  @param[in]      path : the file to create
+ *  @param[in]      numMeasurements : M, or 0 to append the measurements one at a time
+ *  @param[in]      numReceivers : R
+ *  @param[in]      numFrequencies : N
+ *  @param[in]      overwrite : if false, Write() fails if the file already exists
+ *
+ */
+/************************************************************************************/
+GeneralTFWriter::GeneralTFWriter(const std::string &path,
+                                 const std::size_t numMeasurements,
+                                 const std::size_t numReceivers,
+                                 const std::size_t numFrequencies,
+                                 const bool overwrite_)
+: sofa::Writer( path, overwrite_ )
+{
+    defineConvention( "GeneralTF", GeneralTF::GetConventionVersion(), "TF", "free field" );
+    
+    defineDimensions( numMeasurements, numReceivers, 1, numFrequencies );
+    
+    definePosition( "ListenerPosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "ListenerUp", { "I", "C" }, 0., 0., 1. );
+    definePosition( "ListenerView", { "I", "C" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    definePosition( "ReceiverPosition", { "R", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    definePosition( "SourcePosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    definePosition( "EmitterPosition", { "E", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    
+    AddVariable( "Data.Real", { "M", "R", "N" } );
+    AddVariable( "Data.Imag", { "M", "R", "N" } );
+    
+    defineZeros( "N", { "N" } );
+    SetVariableAttribute( "N", "LongName", "frequency" );
+    SetVariableAttribute( "N", "Units", sofa::Units::GetName( sofa::Units::kHertz ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets all the values of Data.Real
+ *
+ */
+/************************************************************************************/
+bool GeneralTFWriter::SetDataReal(const double *values, const std::size_t numValues)
+{
+    return SetValues( "Data.Real", values, numValues );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets all the values of Data.Imag
+ *
+ */
+/************************************************************************************/
+bool GeneralTFWriter::SetDataImag(const double *values, const std::size_t numValues)
+{
+    return SetValues( "Data.Imag", values, numValues );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the frequencies (variable N), in hertz
+ *
+ */
+/************************************************************************************/
+bool GeneralTFWriter::SetFrequencies(const double *values, const std::size_t numValues)
+{
+    return SetValues( "N", values, numValues );
+}
+
+bool GeneralTFWriter::validate(sofa::ValidationReport &report) const
+{
+    return WriterHelper::validate< sofa::GeneralTF >( GetFilename(), report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : defines the schema of a MultiSpeakerBRIR file
+ *  @param[in]      path : the file to create
+ *  @param[in]      numMeasurements : M, or 0 to append the measurements one at a time
+ *  @param[in]      numReceivers : R
+ *  @param[in]      numEmitters : E, the number of loudspeakers
+ *  @param[in]      numDataSamples : N
+ *  @param[in]      overwrite : if false, Write() fails if the file already exists
+ *
+ */
+/************************************************************************************/
+MultiSpeakerBRIRWriter::MultiSpeakerBRIRWriter(const std::string &path,
+                                               const std::size_t numMeasurements,
+                                               const std::size_t numReceivers,
+                                               const std::size_t numEmitters,
+                                               const std::size_t numDataSamples,
+                                               const bool overwrite_)
+: sofa::Writer( path, overwrite_ )
+{
+    defineConvention( "MultiSpeakerBRIR", MultiSpeakerBRIR::GetConventionVersion(), "FIRE", "reverberant" );
+    SetGlobalAttribute( "DatabaseName", "" );
+    
+    defineDimensions( numMeasurements, numReceivers, numEmitters, numDataSamples );
+    
+    definePosition( "ListenerPosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "ListenerUp", { "M", "C" }, 0., 0., 1. );
+    definePosition( "ListenerView", { "M", "C" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    definePosition( "ReceiverPosition", { "R", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    
+    definePosition( "SourcePosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "SourceUp", { "I", "C" }, 0., 0., 1. );
+    definePosition( "SourceView", { "I", "C" }, sofa::Coordinates::kCartesian, -1., 0., 0. );
+    
+    definePosition( "EmitterPosition", { "E", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    
+    AddVariable( "Data.IR", { "M", "R", "E", "N" } );
+    defineSamplingRate( 48000. );
+    defineZeros( "Data.Delay", { "I", "R", "E" } );
+}
+
+bool MultiSpeakerBRIRWriter::validate(sofa::ValidationReport &report) const
+{
+    return WriterHelper::validate< sofa::MultiSpeakerBRIR >( GetFilename(), report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : defines the schema of a SingleRoomDRIR file
+ *  @param[in]      path : the file to create
+ *  @param[in]      numMeasurements : M, or 0 to append the measurements one at a time
+ *  @param[in]      numReceivers : R, the number of microphones of the array
+ *  @param[in]      numDataSamples : N
+ *  @param[in]      overwrite : if false, Write() fails if the file already exists
+ *
+ */
+/************************************************************************************/
+SingleRoomDRIRWriter::SingleRoomDRIRWriter(const std::string &path,
+                                           const std::size_t numMeasurements,
+                                           const std::size_t numReceivers,
+                                           const std::size_t numDataSamples,
+                                           const bool overwrite_)
+: sofa::Writer( path, overwrite_ )
+{
+    defineConvention( "SingleRoomDRIR", SingleRoomDRIR::GetConventionVersion(), "FIR", "reverberant" );
+    SetGlobalAttribute( sofa::Attributes::kRoomDescription, "" );
+    
+    defineDimensions( numMeasurements, numReceivers, 1, numDataSamples );
+    
+    definePosition( "ListenerPosition", { "M", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "ListenerUp", { "I", "C" }, 0., 0., 1. );
+    definePosition( "ListenerView", { "I", "C" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    definePosition( "ReceiverPosition", { "R", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    definePosition( "SourcePosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    definePosition( "EmitterPosition", { "E", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    
+    AddVariable( "Data.IR", { "M", "R", "N" } );
+    defineSamplingRate( 48000. );
+    defineZeros( "Data.Delay", { "I", "R" } );
+}
+
+bool SingleRoomDRIRWriter::validate(sofa::ValidationReport &report) const
+{
+    return WriterHelper::validate< sofa::SingleRoomDRIR >( GetFilename(), report );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : defines the schema of an AmbisonicsDRIR file
+ *  @param[in]      path : the file to create
+ *  @param[in]      numMeasurements : M, or 0 to append the measurements one at a time
+ *  @param[in]      ambisonicsOrder : the number of receivers R is (order + 1)^2
+ *  @param[in]      numEmitters : E, the number of loudspeakers
+ *  @param[in]      numDataSamples : N
+ *  @param[in]      channelOrdering : Data.IR:ChannelOrdering
+ *  @param[in]      normalization : Data.IR:Normalization
+ *  @param[in]      overwrite : if false, Write() fails if the file already exists
+ *
+ */
+/************************************************************************************/
+AmbisonicsDRIRWriter::AmbisonicsDRIRWriter(const std::string &path,
+                                           const std::size_t numMeasurements,
+                                           const unsigned int ambisonicsOrder,
+                                           const std::size_t numEmitters,
+                                           const std::size_t numDataSamples,
+                                           const sofa::AmbisonicsChannelOrdering::Type &channelOrdering,
+                                           const sofa::AmbisonicsNormalization::Type &normalization,
+                                           const bool overwrite_)
+: sofa::Writer( path, overwrite_ )
+{
+    defineConvention( "AmbisonicsDRIR", AmbisonicsDRIR::GetConventionVersion(), "FIRE", "reverberant" );
+    SetGlobalAttribute( "AmbisonicsOrder", sofa::String::Int2String( (int) ambisonicsOrder ) );
+    
+    const std::size_t numReceivers = ( ambisonicsOrder + 1 ) * ( ambisonicsOrder + 1 );
+    
+    defineDimensions( numMeasurements, numReceivers, numEmitters, numDataSamples );
+    
+    definePosition( "ListenerPosition", { "M", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "ListenerUp", { "M", "C" }, 0., 0., 1. );
+    definePosition( "ListenerView", { "M", "C" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    definePosition( "ReceiverPosition", { "R", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    
+    definePosition( "SourcePosition", { "I", "C" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "SourceUp", { "I", "C" }, 0., 0., 1. );
+    definePosition( "SourceView", { "I", "C" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    definePosition( "EmitterPosition", { "E", "C", "I" }, sofa::Coordinates::kCartesian, 0., 0., 0. );
+    defineDirection( "EmitterUp", { "E", "C", "I" }, 0., 0., 1. );
+    definePosition( "EmitterView", { "E", "C", "I" }, sofa::Coordinates::kCartesian, 1., 0., 0. );
+    
+    AddVariable( "Data.IR", { "M", "R", "E", "N" } );
+    SetVariableAttribute( "Data.IR", "ChannelOrdering", sofa::AmbisonicsChannelOrdering::GetName( channelOrdering ) );
+    SetVariableAttribute( "Data.IR", "Normalization", sofa::AmbisonicsNormalization::GetName( normalization ) );
+    
+    defineSamplingRate( 48000. );
+    defineZeros( "Data.Delay", { "I", "R", "E" } );
+}
+
+bool AmbisonicsDRIRWriter::validate(sofa::ValidationReport &report) const
+{
+    return WriterHelper::validate< sofa::AmbisonicsDRIR >( GetFilename(), report );
+}
@@ -0,0 +1,571 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAWriter.h
+ *   @brief      Creates SOFA files : schema defined in one pass, data written in bulk
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ * 
+ */
+/************************************************************************************/
+#ifndef _SOFA_WRITER_H__
+#define _SOFA_WRITER_H__
+
+#include "../src/SOFAFile.h"
+#include "../src/SOFAAmbisonicsChannelOrdering.h"
+#include "../src/SOFAAmbisonicsNormalization.h"
+#include "../src/SOFAWriteOptions.h"
+#include "../src/SOFAConversionReport.h"
+
+namespace sofa
+{
+    
+    /************************************************************************************/
+    /*!
+     *  @class          Writer
+     *  @brief          Creates a SOFA file
+     *
+     *  @details        The global attributes, dimensions and variables (with their attributes)
+     *                  are first collected in memory, together with the values given to
+     *                  SetValues(). Nothing is written until Write() : the file is then created,
+     *                  the whole schema is defined in a single pass, define mode is left once,
+     *                  and the values of each variable are written with a single call.
+     *                  Large variables (typically Data.IR) can instead be written after Write()
+     *                  with PutValues(), directly from the buffers of the caller.
+     *
+     *                  Measurements can also be appended one at a time, with bounded memory :
+     *                  after Write(), AppendMeasurement() starts a new measurement, and
+     *                  PutMeasurement() writes the values of each variable varying along M
+     *                  (Data.IR, SourcePosition, etc.) for this measurement. The variables
+     *                  that were not put are written with their default measurement (zeros,
+     *                  unless set by SetDefaultMeasurement()). M is either added with size 0,
+     *                  i.e. unlimited, and its size is the number of measurements appended
+     *                  when the file is closed, or pre-sized.
+     *
+     *                  The chunk shape and the compression of the data variables follow
+     *                  the WriteOptions, e.g. one chunk per measurement for a file read one
+     *                  measurement at a time.
+     *
+     *                  The variables are stored as double, unless SetVariableType() chooses
+     *                  another type, e.g. float for Data.IR recorded in float at the source,
+     *                  which halves the size of the file. The precision lost by the variables
+     *                  stored as float is accumulated in the ConversionReport. The readers
+     *                  convert the stored values, whatever their type.
+     *
+     *                  A writer destroyed before Close() completes and closes the file if
+     *                  Write() created it (the errors are then ignored; call Close() to get
+     *                  them), but never creates nor overwrites a file that was not written.
+     *
+     *                  The per-convention writers below (SimpleFreeFieldHRIRWriter, etc.) define
+     *                  the schema of their convention, with default values, and check the file
+     *                  they produced against the matching convention class once closed.
+     */
+    /************************************************************************************/
+    class SOFA_API Writer
+    {
+    public:
+        Writer(const std::string &path,
+               const bool overwrite = false);
+        
+        virtual ~Writer();
+        
+        //==============================================================================
+        // Schema
+        //==============================================================================
+        bool SetGlobalAttribute(const std::string &name, const std::string &value);
+        bool SetGlobalAttribute(const sofa::Attributes::Type &type_, const std::string &value);
+        bool SetGlobalAttributes(const sofa::Attributes &attributes);
+        std::string GetGlobalAttribute(const std::string &name) const;
+        
+        bool SetWriteOptions(const sofa::WriteOptions &options);
+        const sofa::WriteOptions & GetWriteOptions() const;
+        
+        bool AddDimension(const std::string &name, const std::size_t size);
+        long GetDimension(const std::string &name) const;
+        
+        bool AddVariable(const std::string &name,
+                         const std::vector< std::string > &dimensionNames,
+                         const netCDF::NcType &type = netCDF::ncDouble);
+        
+        bool SetVariableDimensions(const std::string &name,
+                                   const std::vector< std::string > &dimensionNames);
+        
+        bool SetVariableType(const std::string &name,
+                             const netCDF::NcType &type);
+        
+        bool SetVariableAttribute(const std::string &variableName,
+                                  const std::string &attributeName,
+                                  const std::string &value);
+        
+        bool HasVariable(const std::string &name) const;
+        std::size_t GetVariableNumElements(const std::string &name) const;
+        
+        //==============================================================================
+        // Values
+        //==============================================================================
+        bool SetValues(const std::string &variableName, const double *values, const std::size_t numValues);
+        bool SetValues(const std::string &variableName, const float *values, const std::size_t numValues);
+        bool SetValues(const std::string &variableName, const std::vector< double > &values);
+        bool SetValues(const std::string &variableName, const std::vector< float > &values);
+        
+        bool SetPosition(const std::string &variableName,
+                         const double *values,
+                         const std::size_t numValues,
+                         const sofa::Coordinates::Type &coordinates);
+        
+        bool SetSamplingRate(const double samplingRate);
+        
+        bool SetDataIR(const double *values, const std::size_t numValues);
+        bool SetDataIR(const float *values, const std::size_t numValues);
+        
+        bool SetDataDelay(const double *values, const std::size_t numValues);
+        
+        //==============================================================================
+        // Measurements, appended one at a time
+        //==============================================================================
+        bool SetDefaultMeasurement(const std::string &variableName, const double *values, const std::size_t numValues);
+        std::size_t GetMeasurementNumElements(const std::string &variableName) const;
+        
+        bool AppendMeasurement();
+        bool PutMeasurement(const std::string &variableName, const double *values, const std::size_t numValues);
+        bool PutMeasurement(const std::string &variableName, const float *values, const std::size_t numValues);
+        std::size_t GetNumMeasurements() const;
+        
+        //==============================================================================
+        // Output
+        //==============================================================================
+        bool Write();
+        bool IsWritten() const;
+        
+        bool PutValues(const std::string &variableName,
+                       const double *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count);
+        
+        bool PutValues(const std::string &variableName,
+                       const float *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count);
+        
+        void Close();
+        bool Close(sofa::ValidationReport &report);
+        bool IsClosed() const;
+        
+        bool Validate(sofa::ValidationReport &report) const;
+        
+        const sofa::ConversionReport & GetConversionReport() const;
+        
+        const std::string & GetFilename() const;
+    
+    protected:
+        //==============================================================================
+        void defineConvention(const std::string &conventionName,
+                              const std::string &conventionVersion,
+                              const std::string &dataType,
+                              const std::string &roomType);
+        
+        void defineDimensions(const std::size_t numMeasurements,
+                              const std::size_t numReceivers,
+                              const std::size_t numEmitters,
+                              const std::size_t numDataSamples);
+        
+        void definePosition(const std::string &name,
+                            const std::vector< std::string > &dimensionNames,
+                            const sofa::Coordinates::Type &coordinates,
+                            const double x, const double y, const double z);
+        
+        void defineDirection(const std::string &name,
+                             const std::vector< std::string > &dimensionNames,
+                             const double x, const double y, const double z);
+        
+        void defineSamplingRate(const double samplingRate);
+        
+        void defineZeros(const std::string &name,
+                         const std::vector< std::string > &dimensionNames);
+        
+        /// checks the file once closed; the per-convention writers check it against their convention
+        virtual bool validate(sofa::ValidationReport &report) const;
+    
+    private:
+        struct Variable
+        {
+            std::string name;
+            nc_type type;                       ///< id of the netCDF type
+            std::vector< std::string > dimensionNames;
+            std::vector< std::pair< std::string, std::string > > attributes;
+            
+            bool hasValues;
+            std::vector< double > values;       ///< values staged until Write()
+            
+            std::vector< double > defaultMeasurement;   ///< written for the measurements where the variable is not put
+            bool hasMeasurement;                        ///< put for the current measurement
+        };
+        
+        //==============================================================================
+        Variable * findVariable(const std::string &name);
+        const Variable * findVariable(const std::string &name) const;
+        
+        bool hasDimensions(const std::vector< std::string > &dimensionNames) const;
+        std::size_t getNumElements(const Variable &variable) const;
+        std::size_t getMeasurementNumElements(const Variable &variable) const;
+        void getMeasurementSlab(const Variable &variable,
+                                std::vector< std::size_t > &start,
+                                std::vector< std::size_t > &count) const;
+        void getVariableSlab(const Variable &variable,
+                             std::vector< std::size_t > &start,
+                             std::vector< std::size_t > &count) const;
+        
+        netCDF::NcFile & getFile();
+        void commitMeasurement();
+        
+        void applyWriteOptions(const netCDF::NcVar &var, const Variable &variable) const;
+        
+        template< typename Type >
+        void addToConversionReport(const Variable &variable,
+                                   const Type *values,
+                                   const std::vector< std::size_t > &start,
+                                   const std::vector< std::size_t > &count);
+        
+        template< typename Type >
+        bool putChunks(const Variable &variable,
+                       const Type *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count);
+        
+        template< typename Type >
+        bool setValues(const std::string &variableName, const Type *values, const std::size_t numValues);
+        
+        template< typename Type >
+        bool putValues(const std::string &variableName,
+                       const Type *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count);
+        
+        template< typename Type >
+        bool putMeasurement(const std::string &variableName, const Type *values, const std::size_t numValues);
+    
+    private:
+        const std::string filename;
+        const bool overwrite;
+        
+        std::vector< std::pair< std::string, std::string > > globalAttributes;
+        std::vector< std::pair< std::string, std::size_t > > dimensions;
+        std::vector< Variable > variables;
+        
+        sofa::WriteOptions options;
+        sofa::ConversionReport conversionReport;    ///< precision lost by the variables stored as float
+        
+        netCDF::NcFile file;
+        bool written;
+        bool closed;
+        
+        std::size_t numAppended;                ///< number of measurements appended
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( Writer );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          SimpleFreeFieldHRIRWriter
+     *  @brief          Creates a SOFA file with SimpleFreeFieldHRIR convention
+     *
+     *  @details        Two receivers (the ears) and one emitter. SourcePosition is [M C],
+     *                  in spherical coordinates; Data.IR is [M R N]
+     */
+    /************************************************************************************/
+    class SOFA_API SimpleFreeFieldHRIRWriter : public sofa::Writer
+    {
+    public:
+        SimpleFreeFieldHRIRWriter(const std::string &path,
+                                  const std::size_t numMeasurements,
+                                  const std::size_t numDataSamples,
+                                  const bool overwrite = false);
+        
+        virtual ~SimpleFreeFieldHRIRWriter() {};
+    
+    protected:
+        virtual bool validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( SimpleFreeFieldHRIRWriter );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          SimpleFreeFieldSOSWriter
+     *  @brief          Creates a SOFA file with SimpleFreeFieldSOS convention
+     *
+     *  @details        Two receivers and one emitter. Data.SOS is [M R N], with 6 coefficients
+     *                  per second-order section
+     */
+    /************************************************************************************/
+    class SOFA_API SimpleFreeFieldSOSWriter : public sofa::Writer
+    {
+    public:
+        SimpleFreeFieldSOSWriter(const std::string &path,
+                                 const std::size_t numMeasurements,
+                                 const std::size_t numSections,
+                                 const bool overwrite = false);
+        
+        virtual ~SimpleFreeFieldSOSWriter() {};
+        
+        bool SetDataSOS(const double *values, const std::size_t numValues);
+    
+    protected:
+        virtual bool validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( SimpleFreeFieldSOSWriter );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          SimpleHeadphoneIRWriter
+     *  @brief          Creates a SOFA file with SimpleHeadphoneIR convention
+     *
+     *  @details        One emitter (headphone driver) per receiver; Data.IR is [M R N]
+     */
+    /************************************************************************************/
+    class SOFA_API SimpleHeadphoneIRWriter : public sofa::Writer
+    {
+    public:
+        SimpleHeadphoneIRWriter(const std::string &path,
+                                const std::size_t numMeasurements,
+                                const std::size_t numReceivers,
+                                const std::size_t numDataSamples,
+                                const bool overwrite = false);
+        
+        virtual ~SimpleHeadphoneIRWriter() {};
+    
+    protected:
+        virtual bool validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( SimpleHeadphoneIRWriter );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          GeneralFIRWriter
+     *  @brief          Creates a SOFA file with GeneralFIR convention
+     *
+     *  @details        Data.IR is [M R N]
+     */
+    /************************************************************************************/
+    class SOFA_API GeneralFIRWriter : public sofa::Writer
+    {
+    public:
+        GeneralFIRWriter(const std::string &path,
+                         const std::size_t numMeasurements,
+                         const std::size_t numReceivers,
+                         const std::size_t numEmitters,
+                         const std::size_t numDataSamples,
+                         const bool overwrite = false);
+        
+        virtual ~GeneralFIRWriter() {};
+    
+    protected:
+        virtual bool validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( GeneralFIRWriter );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          GeneralFIREWriter
+     *  @brief          Creates a SOFA file with GeneralFIRE convention
+     *
+     *  @details        Data.IR is [M R E N]
+     */
+    /************************************************************************************/
+    class SOFA_API GeneralFIREWriter : public sofa::Writer
+    {
+    public:
+        GeneralFIREWriter(const std::string &path,
+                          const std::size_t numMeasurements,
+                          const std::size_t numReceivers,
+                          const std::size_t numEmitters,
+                          const std::size_t numDataSamples,
+                          const bool overwrite = false);
+        
+        virtual ~GeneralFIREWriter() {};
+    
+    protected:
+        virtual bool validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( GeneralFIREWriter );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          GeneralTFWriter
+     *  @brief          Creates a SOFA file with GeneralTF convention
+     *
+     *  @details        Data.Real and Data.Imag are [M R N]; the variable N holds the
+     *                  frequencies, in hertz
+     */
+    /************************************************************************************/
+    class SOFA_API GeneralTFWriter : public sofa::Writer
+    {
+    public:
+        GeneralTFWriter(const std::string &path,
+                        const std::size_t numMeasurements,
+                        const std::size_t numReceivers,
+                        const std::size_t numFrequencies,
+                        const bool overwrite = false);
+        
+        virtual ~GeneralTFWriter() {};
+        
+        bool SetDataReal(const double *values, const std::size_t numValues);
+        bool SetDataImag(const double *values, const std::size_t numValues);
+        bool SetFrequencies(const double *values, const std::size_t numValues);
+    
+    protected:
+        virtual bool validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( GeneralTFWriter );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          MultiSpeakerBRIRWriter
+     *  @brief          Creates a SOFA file with MultiSpeakerBRIR convention
+     *
+     *  @details        One emitter per loudspeaker; ListenerView is [M C] (one head orientation
+     *                  per measurement); Data.IR is [M R E N]
+     */
+    /************************************************************************************/
+    class SOFA_API MultiSpeakerBRIRWriter : public sofa::Writer
+    {
+    public:
+        MultiSpeakerBRIRWriter(const std::string &path,
+                               const std::size_t numMeasurements,
+                               const std::size_t numReceivers,
+                               const std::size_t numEmitters,
+                               const std::size_t numDataSamples,
+                               const bool overwrite = false);
+        
+        virtual ~MultiSpeakerBRIRWriter() {};
+    
+    protected:
+        virtual bool validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( MultiSpeakerBRIRWriter );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          SingleRoomDRIRWriter
+     *  @brief          Creates a SOFA file with SingleRoomDRIR convention
+     *
+     *  @details        One emitter; ListenerPosition is [M C]; Data.IR is [M R N]
+     */
+    /************************************************************************************/
+    class SOFA_API SingleRoomDRIRWriter : public sofa::Writer
+    {
+    public:
+        SingleRoomDRIRWriter(const std::string &path,
+                             const std::size_t numMeasurements,
+                             const std::size_t numReceivers,
+                             const std::size_t numDataSamples,
+                             const bool overwrite = false);
+        
+        virtual ~SingleRoomDRIRWriter() {};
+    
+    protected:
+        virtual bool validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( SingleRoomDRIRWriter );
+    };
+    
+    /************************************************************************************/
+    /*!
+     *  @class          AmbisonicsDRIRWriter
+     *  @brief          Creates a SOFA file with AmbisonicsDRIR convention
+     *
+     *  @details        One receiver per Ambisonics channel, i.e. (order + 1)^2; one emitter per
+     *                  loudspeaker. ListenerPosition, ListenerUp and ListenerView are [M C];
+     *                  Data.IR is [M R E N]
+     */
+    /************************************************************************************/
+    class SOFA_API AmbisonicsDRIRWriter : public sofa::Writer
+    {
+    public:
+        AmbisonicsDRIRWriter(const std::string &path,
+                             const std::size_t numMeasurements,
+                             const unsigned int ambisonicsOrder,
+                             const std::size_t numEmitters,
+                             const std::size_t numDataSamples,
+                             const sofa::AmbisonicsChannelOrdering::Type &channelOrdering = sofa::AmbisonicsChannelOrdering::kAcn,
+                             const sofa::AmbisonicsNormalization::Type &normalization = sofa::AmbisonicsNormalization::kSn3d,
+                             const bool overwrite = false);
+        
+        virtual ~AmbisonicsDRIRWriter() {};
+    
+    protected:
+        virtual bool validate(sofa::ValidationReport &report) const SOFA_OVERRIDE;
+    
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( AmbisonicsDRIRWriter );
+    };
+
+}
+
+#endif /* _SOFA_WRITER_H__ */
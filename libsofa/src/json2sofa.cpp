@@ -25,16 +25,16 @@
 /************************************************************************************/
 static bool TestFileConvention(json_object *jobj, const std::string & filename)
 {
-	bool valid = sofa::IsValidSimpleFreeFieldHRIRFile( filename );
-	json_object_object_add(jobj, "isNetCDF", json_object_new_boolean(sofa::IsValidNetCDFFile( filename )));
-	json_object_object_add(jobj, "isSOFA", json_object_new_boolean(sofa::IsValidSOFAFile( filename )));
-	json_object_object_add(jobj, "isSimpleFreeFieldHRIR", json_object_new_boolean(valid));
-	json_object_object_add(jobj, "isSimpleFreeFieldSOS", json_object_new_boolean(sofa::IsValidSimpleFreeFieldSOSFile( filename )));
-	json_object_object_add(jobj, "isSimpleHeadphoneIRF", json_object_new_boolean(sofa::IsValidSimpleHeadphoneIRFile( filename )));
-	json_object_object_add(jobj, "isGeneralFIR", json_object_new_boolean(sofa::IsValidGeneralFIRFile( filename )));
-	json_object_object_add(jobj, "isGeneralTF", json_object_new_boolean(sofa::IsValidGeneralTFFile( filename )));
-
-	return valid;
+	const sofa::DetectedConventions detected = sofa::DetectConventions( filename );
+	json_object_object_add(jobj, "isNetCDF", json_object_new_boolean(detected.isNetCDF));
+	json_object_object_add(jobj, "isSOFA", json_object_new_boolean(detected.isSOFA));
+	json_object_object_add(jobj, "isSimpleFreeFieldHRIR", json_object_new_boolean(detected.isSimpleFreeFieldHRIR));
+	json_object_object_add(jobj, "isSimpleFreeFieldSOS", json_object_new_boolean(detected.isSimpleFreeFieldSOS));
+	json_object_object_add(jobj, "isSimpleHeadphoneIRF", json_object_new_boolean(detected.isSimpleHeadphoneIR));
+	json_object_object_add(jobj, "isGeneralFIR", json_object_new_boolean(detected.isGeneralFIR));
+	json_object_object_add(jobj, "isGeneralTF", json_object_new_boolean(detected.isGeneralTF));
+
+	return detected.isSimpleFreeFieldHRIR;
 }
 
 /************************************************************************************/
@@ -0,0 +1,575 @@
+/************************************************************************************/
+/*!
+ *   @file       sofabenchmark.cpp
+ *   @brief      Measures the time spent in the main operations of the library for a given SOFA file
+ *   @author     Thibaut Carpentier, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+ *
+ *   @date       10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFA.h"
+#include "../src/SOFAString.h"
+#include "../src/SOFAUtils.h"
+#include <chrono>
+#include <iomanip>
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+static void DisplayHelp(std::ostream & output = std::cout)
+{
+    output << "sofabenchmark measures the time spent in the main operations of libsofa" << std::endl;
+    output << "    syntax : ./sofabenchmark [filename] [numIterations]" << std::endl;
+    output << "             ./sofabenchmark --layouts [filename] [outputFolder] [numIterations]" << std::endl;
+    output << "    --layouts rewrites Data.IR with each chunking and compression preset," << std::endl;
+    output << "    and reports the size of each file against its read times" << std::endl;
+    output << "             ./sofabenchmark --threads [filename] [outputFolder] [numIterations]" << std::endl;
+    output << "    --threads rewrites Data.IR (whole file preset) with 1, 2, 4... compression threads," << std::endl;
+    output << "    and reports the write times" << std::endl;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Opens the file and validates it against its own convention,
+ *                  as an application would typically do
+ *
+ */
+/************************************************************************************/
+static bool OpenAndValidate(const std::string & filename)
+{
+    const sofa::File theFile( filename );
+    
+    if( theFile.IsValid() == false )
+    {
+        return false;
+    }
+    
+    const std::string conventions = theFile.GetSOFAConventions();
+    
+    if( conventions == "SimpleFreeFieldHRIR" )
+    {
+        const sofa::SimpleFreeFieldHRIR file( filename );
+        return file.IsValid();
+    }
+    else if( conventions == "SimpleFreeFieldSOS" )
+    {
+        const sofa::SimpleFreeFieldSOS file( filename );
+        return file.IsValid();
+    }
+    else if( conventions == "SimpleHeadphoneIR" )
+    {
+        const sofa::SimpleHeadphoneIR file( filename );
+        return file.IsValid();
+    }
+    else if( conventions == "GeneralFIR" )
+    {
+        const sofa::GeneralFIR file( filename );
+        return file.IsValid();
+    }
+    else if( conventions == "GeneralFIRE" )
+    {
+        const sofa::GeneralFIRE file( filename );
+        return file.IsValid();
+    }
+    else if( conventions == "GeneralTF" )
+    {
+        const sofa::GeneralTF file( filename );
+        return file.IsValid();
+    }
+    else if( conventions == "MultiSpeakerBRIR" )
+    {
+        const sofa::MultiSpeakerBRIR file( filename );
+        return file.IsValid();
+    }
+    else if( conventions == "SingleRoomDRIR" )
+    {
+        const sofa::SingleRoomDRIR file( filename );
+        return file.IsValid();
+    }
+    else if( conventions == "AmbisonicsDRIR" )
+    {
+        const sofa::AmbisonicsDRIR file( filename );
+        return file.IsValid();
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the file against all the conventions, one helper at a time
+ *
+ */
+/************************************************************************************/
+static bool CheckAllConventions(const std::string & filename)
+{
+    const bool validnetCDF  = sofa::IsValidNetCDFFile( filename );
+    const bool validSOFA    = sofa::IsValidSOFAFile( filename );
+    
+    sofa::IsValidSimpleFreeFieldHRIRFile( filename );
+    sofa::IsValidSimpleFreeFieldSOSFile( filename );
+    sofa::IsValidSimpleHeadphoneIRFile( filename );
+    sofa::IsValidGeneralFIRFile( filename );
+    sofa::IsValidGeneralFIREFile( filename );
+    sofa::IsValidGeneralTFFile( filename );
+    sofa::IsValidMultiSpeakerBRIRFile( filename );
+    sofa::IsValidSingleRoomDRIRFile( filename );
+    sofa::IsValidAmbisonicsDRIRFile( filename );
+    
+    return ( validnetCDF == true && validSOFA == true );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Checks the file against all the conventions at once
+ *
+ */
+/************************************************************************************/
+static bool DetectAllConventions(const std::string & filename)
+{
+    const sofa::DetectedConventions detected = sofa::DetectConventions( filename );
+    
+    return ( detected.isNetCDF == true && detected.isSOFA == true );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Opens the file and queries the shape, type and attributes of all its
+ *                  variables, as a browser or a catalog tool would typically do
+ *
+ */
+/************************************************************************************/
+static bool OpenAndQueryMetadata(const std::string & filename)
+{
+    const sofa::NetCDFFile theFile( filename );
+    
+    std::vector< std::string > variableNames;
+    theFile.GetAllVariablesNames( variableNames );
+    
+    std::size_t numElements = 0;
+    
+    for( std::size_t i = 0; i < variableNames.size(); i++ )
+    {
+        std::vector< std::size_t > dims;
+        theFile.GetVariableDimensions( dims, variableNames[i] );
+        
+        std::vector< std::string > attributeNames;
+        std::vector< std::string > attributeValues;
+        theFile.GetVariablesAttributes( attributeNames, attributeValues, variableNames[i] );
+        
+        const std::string typeName = theFile.GetVariableTypeName( variableNames[i] );
+        
+        numElements += dims.size() + attributeNames.size() + typeName.size();
+    }
+    
+    return ( numElements > 0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads Data.IR one measurement at a time, in a pseudo-random order,
+ *                  as a renderer following the head movements would typically do
+ *
+ */
+/************************************************************************************/
+static bool ReadMeasurementsInRandomOrder(const std::string & filename,
+                                          const sofa::OpenOptions & options)
+{
+    const sofa::NetCDFFile theFile( filename, netCDF::NcFile::read, options );
+    
+    std::vector< std::size_t > dims;
+    theFile.GetVariableDimensions( dims, "Data.IR" );
+    
+    if( dims.size() < 2 || dims[0] == 0 )
+    {
+        return false;
+    }
+    
+    const std::size_t M = dims[0];
+    
+    std::vector< std::size_t > start( dims.size(), 0 );
+    std::vector< std::size_t > count( dims );
+    count[0] = 1;
+    
+    std::vector< double > values;
+    
+    /// linear congruential generator, so that all the runs read the same sequence
+    std::size_t seed = 12345;
+    
+    for( std::size_t i = 0; i < M; i++ )
+    {
+        seed = ( seed * 1103515245 + 12345 ) % 2147483648u;
+        
+        start[0] = seed % M;
+        
+        if( theFile.GetValues( values, start, count, "Data.IR" ) == false )
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+static bool ReadMeasurementsDefaultCache(const std::string & filename)
+{
+    return ReadMeasurementsInRandomOrder( filename, sofa::OpenOptions() );
+}
+
+static bool ReadMeasurementsRandomAccessHint(const std::string & filename)
+{
+    return ReadMeasurementsInRandomOrder( filename, sofa::OpenOptions( sofa::OpenOptions::kRandomAccess ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads the whole Data.IR variable, through netCDF or through the
+ *                  direct chunk reader
+ *
+ */
+/************************************************************************************/
+static bool ReadDataIRNetCDF(const std::string & filename)
+{
+    const sofa::NetCDFFile theFile( filename );
+    
+    std::vector< double > values;
+    return theFile.GetValues( values, "Data.IR" );
+}
+
+static bool ReadDataIRChunkReader(const std::string & filename)
+{
+    const sofa::NetCDFFile theFile( filename );
+    const sofa::ChunkReader reader( theFile );
+    
+    std::vector< double > values;
+    return reader.GetValues( values, "Data.IR" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads Data.IR one receiver at a time, all the measurements at once,
+ *                  as a per-channel streaming renderer would typically do
+ *
+ */
+/************************************************************************************/
+static bool ReadReceivers(const std::string & filename)
+{
+    const sofa::NetCDFFile theFile( filename );
+    
+    std::vector< std::size_t > dims;
+    theFile.GetVariableDimensions( dims, "Data.IR" );
+    
+    if( dims.size() < 3 )
+    {
+        return false;
+    }
+    
+    std::vector< std::size_t > start( dims.size(), 0 );
+    std::vector< std::size_t > count( dims );
+    count[1] = 1;
+    
+    std::vector< double > values;
+    
+    for( std::size_t r = 0; r < dims[1]; r++ )
+    {
+        start[1] = r;
+        
+        if( theFile.GetValues( values, start, count, "Data.IR" ) == false )
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Rewrites Data.IR (and Data.SamplingRate) of a file in a GeneralFIR
+ *                  ([M R N]) or GeneralFIRE ([M R E N]) file, with the given write options
+ *
+ */
+/************************************************************************************/
+static bool WriteWithOptions(const std::string & filename,
+                             const std::string & outputFilename,
+                             const sofa::WriteOptions & options)
+{
+    const sofa::NetCDFFile theFile( filename );
+    
+    std::vector< std::size_t > dims;
+    theFile.GetVariableDimensions( dims, "Data.IR" );
+    
+    std::vector< double > values;
+    
+    if( ( dims.size() != 3 && dims.size() != 4 ) || theFile.GetValues( values, "Data.IR" ) == false )
+    {
+        return false;
+    }
+    
+    std::unique_ptr< sofa::Writer > writer;
+    
+    if( dims.size() == 3 )
+    {
+        writer.reset( new sofa::GeneralFIRWriter( outputFilename, dims[0], dims[1], 1, dims[2], true ) );
+    }
+    else
+    {
+        writer.reset( new sofa::GeneralFIREWriter( outputFilename, dims[0], dims[1], dims[2], dims[3], true ) );
+    }
+    
+    writer->SetWriteOptions( options );
+    
+    std::vector< double > samplingRate;
+    
+    if( theFile.GetVariableNumElements( "Data.SamplingRate" ) == 1
+     && theFile.GetValues( samplingRate, "Data.SamplingRate" ) == true )
+    {
+        writer->SetSamplingRate( samplingRate[0] );
+    }
+    
+    writer->SetDataIR( &values[0], values.size() );
+    writer->Close();
+    
+    return true;
+}
+
+static std::size_t GetFileSize(const std::string & filename)
+{
+    std::ifstream file( filename.c_str(), std::ios::binary | std::ios::ate );
+    
+    return ( file.is_open() == true ) ? (std::size_t) file.tellg() : 0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Runs a benchmark several times and prints the minimum and average
+ *                  time of one iteration, in milliseconds
+ *
+ */
+/************************************************************************************/
+template< typename Function >
+static bool Run(const std::string & name,
+                const std::string & filename,
+                const unsigned int numIterations,
+                Function function,
+                std::ostream & output = std::cout)
+{
+    double minTime   = 0.0;
+    double totalTime = 0.0;
+    
+    for( unsigned int i = 0; i < numIterations; i++ )
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        
+        if( function( filename ) == false )
+        {
+            output << sofa::String::PadWith( name ) << " : failed" << std::endl;
+            return false;
+        }
+        
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        
+        const double elapsed = std::chrono::duration< double, std::milli >( end - start ).count();
+        
+        minTime    = ( i == 0 ) ? elapsed : sofa::smin( minTime, elapsed );
+        totalTime += elapsed;
+    }
+    
+    output << sofa::String::PadWith( name ) << " : ";
+    output << "min = " << std::fixed << std::setprecision( 3 ) << minTime << " ms, ";
+    output << "avg = " << std::fixed << std::setprecision( 3 ) << totalTime / numIterations << " ms";
+    output << " (" << numIterations << " iterations)" << std::endl;
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Rewrites the file with each chunking and compression preset, and
+ *                  reports the size of each file against its read times
+ *
+ */
+/************************************************************************************/
+static int BenchmarkLayouts(const std::string & filename,
+                            const std::string & outputFolder,
+                            const unsigned int numIterations)
+{
+    const sofa::WriteOptions::AccessPattern patterns[] =
+    {
+        sofa::WriteOptions::kDefaultAccess,
+        sofa::WriteOptions::kMeasurementAccess,
+        sofa::WriteOptions::kWholeFileAccess,
+        sofa::WriteOptions::kReceiverAccess
+    };
+    
+    const std::size_t numPatterns = sizeof( patterns ) / sizeof( patterns[0] );
+    
+    for( std::size_t i = 0; i < numPatterns; i++ )
+    {
+        const sofa::WriteOptions options( patterns[i] );
+        
+        const std::string name = sofa::WriteOptions::GetName( patterns[i] );
+        
+        std::string outputFilename = outputFolder + "/sofabenchmark_" + name + ".sofa";
+        std::replace( outputFilename.begin(), outputFilename.end(), ' ', '_' );
+        
+        if( WriteWithOptions( filename, outputFilename, options ) == false )
+        {
+            std::cout << "Data.IR must be [M R N] or [M R E N] : " << filename << std::endl;
+            return 1;
+        }
+        
+        int deflateLevel = 0;
+        bool shuffle     = false;
+        options.GetCompressionParameters( deflateLevel, shuffle );
+        
+        sofa::String::PrintSeparationLine( std::cout );
+        std::cout << "preset : " << name;
+        std::cout << ", deflate = " << deflateLevel << ( shuffle == true ? ", shuffle" : "" );
+        std::cout << ", size = " << GetFileSize( outputFilename ) << " bytes" << std::endl;
+        
+        Run( "Data.IR per M, default cache", outputFilename, numIterations, ReadMeasurementsDefaultCache );
+        Run( "Data.IR per M, random hint", outputFilename, numIterations, ReadMeasurementsRandomAccessHint );
+        Run( "Data.IR per R", outputFilename, numIterations, ReadReceivers );
+        Run( "Data.IR, netCDF", outputFilename, numIterations, ReadDataIRNetCDF );
+    }
+    
+    return 0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Rewrites the file with the whole file preset, compressing the chunks
+ *                  with 1, 2, 4... threads up to the number of hardware threads, and
+ *                  reports the write times
+ *
+ */
+/************************************************************************************/
+static int BenchmarkCompressionThreads(const std::string & filename,
+                                       const std::string & outputFolder,
+                                       const unsigned int numIterations)
+{
+    const unsigned int maxThreads = sofa::smax( std::thread::hardware_concurrency(), 1u );
+    
+    const std::string outputFilename = outputFolder + "/sofabenchmark_threads.sofa";
+    
+    sofa::String::PrintSeparationLine( std::cout );
+    std::cout << "preset : " << sofa::WriteOptions::GetName( sofa::WriteOptions::kWholeFileAccess );
+    std::cout << ", " << maxThreads << " hardware threads" << std::endl;
+    
+    for( unsigned int numThreads = 1; ; numThreads *= 2 )
+    {
+        numThreads = sofa::smin( numThreads, maxThreads );
+        
+        sofa::WriteOptions options( sofa::WriteOptions::kWholeFileAccess );
+        options.SetNumThreads( numThreads );
+        
+        const std::string name = "write, " + std::to_string( numThreads ) + " thread(s)";
+        
+        const bool ok = Run( name, filename, numIterations,
+                             [&]( const std::string & input )
+                             {
+                                 return WriteWithOptions( input, outputFilename, options );
+                             } );
+        
+        if( ok == false )
+        {
+            std::cout << "Data.IR must be [M R N] or [M R E N] : " << filename << std::endl;
+            return 1;
+        }
+        
+        if( numThreads >= maxThreads )
+        {
+            break;
+        }
+    }
+    
+    return 0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Main entry point
+ *
+ */
+/************************************************************************************/
+int main(int argc, char *argv[])
+{
+    if( argc < 2 )
+    {
+        DisplayHelp();
+        return 0;
+    }
+    
+    if( std::string( argv[1] ) == "--layouts" || std::string( argv[1] ) == "--threads" )
+    {
+        if( argc < 4 )
+        {
+            DisplayHelp();
+            return 0;
+        }
+        
+        const int iterations = ( argc > 4 ) ? atoi( argv[4] ) : 10;
+        
+        try
+        {
+            if( std::string( argv[1] ) == "--threads" )
+            {
+                return BenchmarkCompressionThreads( argv[2], argv[3], (unsigned int) sofa::smax( 1, iterations ) );
+            }
+            
+            return BenchmarkLayouts( argv[2], argv[3], (unsigned int) sofa::smax( 1, iterations ) );
+        }
+        catch( std::exception &e )
+        {
+            std::cerr << "exception occured : " << e.what() << std::endl;
+            exit(1);
+        }
+    }
+    
+    const std::string filename = argv[1];
+    
+    const int iterations = ( argc > 2 ) ? atoi( argv[2] ) : 100;
+    const unsigned int numIterations = (unsigned int) sofa::smax( 1, iterations );
+    
+    if( sofa::IsValidNetCDFFile( filename ) == false )
+    {
+        std::cout << "Not a valid netCDF file : " << filename << std::endl;
+        return 0;
+    }
+    
+    sofa::String::PrintSeparationLine( std::cout );
+    std::cout << "Benchmarking " << filename << std::endl;
+    sofa::String::PrintSeparationLine( std::cout );
+    
+    try
+    {
+        Run( "open + validate", filename, numIterations, OpenAndValidate );
+        Run( "open + metadata queries", filename, numIterations, OpenAndQueryMetadata );
+        Run( "IsValid...File helpers", filename, numIterations, CheckAllConventions );
+        Run( "DetectConventions", filename, numIterations, DetectAllConventions );
+        
+        if( sofa::NetCDFFile( filename ).HasVariable( "Data.IR" ) == true )
+        {
+            Run( "Data.IR per M, default cache", filename, numIterations, ReadMeasurementsDefaultCache );
+            Run( "Data.IR per M, random hint", filename, numIterations, ReadMeasurementsRandomAccessHint );
+            Run( "Data.IR, netCDF", filename, numIterations, ReadDataIRNetCDF );
+            Run( "Data.IR, ChunkReader", filename, numIterations, ReadDataIRChunkReader );
+        }
+    }
+    catch( std::exception &e )
+    {
+        std::cerr << "exception occured : " << e.what() << std::endl;
+        exit(1);
+    }
+    catch( ... )
+    {
+        std::cerr << "unknown exception occured" << std::endl;
+        exit(1);
+    }
+    
+    return 0;
+}
@@ -12,6 +12,8 @@
 #include "../src/SOFAString.h"
 #include "ncDim.h"
 #include "ncVar.h"
+#include <algorithm>
+#include <cmath>
 
 /************************************************************************************/
 /*!
@@ -24,16 +26,21 @@ static void TestFileConvention(const std::string & filename,
                                std::ostream & output = std::cout)
 {
     
-    const bool validnetCDF                  = sofa::IsValidNetCDFFile( filename );
-    const bool validSOFA                    = sofa::IsValidSOFAFile( filename );
-    const bool validSimpleFreeFieldHRIR     = sofa::IsValidSimpleFreeFieldHRIRFile( filename );
-    const bool validSimpleFreeFieldSOS      = sofa::IsValidSimpleFreeFieldSOSFile( filename );
-    const bool validSimpleHeadphoneIR       = sofa::IsValidSimpleHeadphoneIRFile( filename );
-    const bool validGeneralFIR              = sofa::IsValidGeneralFIRFile( filename );
-    const bool validGeneralFIRE             = sofa::IsValidGeneralFIREFile( filename );
-    const bool validGeneralTF               = sofa::IsValidGeneralTFFile( filename );
-    const bool validMultiSpeakerBRIR        = sofa::IsValidMultiSpeakerBRIRFile( filename );
-    const bool validSingleRoomDRIR          = sofa::IsValidSingleRoomDRIRFile( filename );
+    /// the file is opened only once to check all the conventions
+    /// (this is equivalent to calling sofa::IsValidNetCDFFile, sofa::IsValidSOFAFile, sofa::IsValidSimpleFreeFieldHRIRFile, etc.)
+    const sofa::DetectedConventions detected = sofa::DetectConventions( filename );
+    
+    const bool validnetCDF                  = detected.isNetCDF;
+    const bool validSOFA                    = detected.isSOFA;
+    const bool validSimpleFreeFieldHRIR     = detected.isSimpleFreeFieldHRIR;
+    const bool validSimpleFreeFieldSOS      = detected.isSimpleFreeFieldSOS;
+    const bool validSimpleHeadphoneIR       = detected.isSimpleHeadphoneIR;
+    const bool validGeneralFIR              = detected.isGeneralFIR;
+    const bool validGeneralFIRE             = detected.isGeneralFIRE;
+    const bool validGeneralTF               = detected.isGeneralTF;
+    const bool validMultiSpeakerBRIR        = detected.isMultiSpeakerBRIR;
+    const bool validSingleRoomDRIR          = detected.isSingleRoomDRIR;
+    const bool validAmbisonicsDRIR          = detected.isAmbisonicsDRIR;
     
     output << "netCDF               = " << sofa::String::bool2yesorno( validnetCDF ) << std::endl;
     output << "SOFA                 = " << sofa::String::bool2yesorno( validSOFA ) << std::endl;
@@ -45,6 +52,7 @@ static void TestFileConvention(const std::string & filename,
     output << "GeneralTF            = " << sofa::String::bool2yesorno( validGeneralTF ) << std::endl;
     output << "MultiSpeakerBRIR     = " << sofa::String::bool2yesorno( validMultiSpeakerBRIR ) << std::endl;
     output << "SingleRoomDRIR       = " << sofa::String::bool2yesorno( validSingleRoomDRIR ) << std::endl;
+    output << "AmbisonicsDRIR       = " << sofa::String::bool2yesorno( validAmbisonicsDRIR ) << std::endl;
 }
 
 /************************************************************************************/
@@ -152,229 +160,114 @@ static void DisplayInformations(const std::string & filename,
 static void CreateSimpleFreeFieldHRIRFile()
 {
     //==============================================================================
-    /// create the file
+    /// define the file
     
-    /// for creating a new file
-    const netCDF::NcFile::FileMode mode = netCDF::NcFile::newFile;
-    
-    /// the file format that is used (netCDF4 / HDF5)
-    const netCDF::NcFile::FileFormat format = netCDF::NcFile::nc4;
+    /// 120 azimuths (every 3 degrees) for 14 elevations (every 10 degrees, from -40 to 90)
+    const unsigned int numAzimuths      = 120;
+    const unsigned int numElevations    = 14;
+    const unsigned int numMeasurements  = numAzimuths * numElevations;
+    const unsigned int numDataSamples   = 941;
+    const double samplingRate           = 48000.;
     
     /// the file shall not exist beforehand
     const std::string filePath = "/Users/tcarpent/Desktop/testwrite.sofa";
     
-    const netCDF::NcFile theFile( filePath, mode, format );
+    /// the dimensions, the required attributes and variables of the convention are already defined;
+    /// nothing is written until Write()
+    sofa::SimpleFreeFieldHRIRWriter writer( filePath, numMeasurements, numDataSamples );
     
     //==============================================================================
-    /// create the attributes
-    sofa::Attributes attributes;
-    attributes.ResetToDefault();
-    
     /// fill the attributes as you want
-    {
-        attributes.Set( sofa::Attributes::kRoomLocation,   "IRCAM, Paris" );
-        attributes.Set( sofa::Attributes::kRoomShortName,  "IRCAM Anechoic Room" );
-        /// etc.
-    }
-    
-    /// put all the attributes into the file
-    for( unsigned int k = 0; k < sofa::Attributes::kNumAttributes; k++ )
-    {
-        const sofa::Attributes::Type attType = static_cast< sofa::Attributes::Type >(k);
-        
-        const std::string attName  = sofa::Attributes::GetName( attType );
-        const std::string attValue = attributes.Get( attType );
-        
-        theFile.putAtt( attName, attValue );
-    }
+    writer.SetGlobalAttribute( sofa::Attributes::kRoomLocation,   "IRCAM, Paris" );
+    writer.SetGlobalAttribute( sofa::Attributes::kRoomShortName,  "IRCAM Anechoic Room" );
+    /// etc.
     
-    /// add attribute specific to your convention (e.g. 'DatabaseName' for the 'SimpleFreeFieldHRIR' convention)
-    {
-        const std::string attName  = "DatabaseName";
-        const std::string attValue = "TestDatabase";
-        
-        theFile.putAtt( attName, attValue );
-    }
-    
-    //==============================================================================
-    /// create the dimensions
-    const unsigned int numMeasurements  = 1680;
-    const unsigned int numReceivers     = 2;
-    const unsigned int numEmitters      = 1;
-    const unsigned int numDataSamples   = 941;
-    
-    theFile.addDim( "C", 3 );   ///< this is required by the standard
-    theFile.addDim( "I", 1 );   ///< this is required by the standard
-    theFile.addDim( "M", numMeasurements );
-    theFile.addDim( "R", numReceivers );
-    theFile.addDim( "E", numEmitters );
-    theFile.addDim( "N", numDataSamples );
+    /// attribute specific to your convention (e.g. 'DatabaseName' for the 'SimpleFreeFieldHRIR' convention)
+    writer.SetGlobalAttribute( "DatabaseName", "TestDatabase" );
     
     //==============================================================================
-    /// create the variables
-    
-    /// Data.SamplingRate
+    /// add any other variables, as you need
     {
-        const std::string varName  = "Data.SamplingRate";
-        const std::string typeName = "double";
-        const std::string dimName  = "I";
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimName );
-        
-        const double samplingRate = 48000;
+        writer.AddVariable( "RoomVolume", { "I" } );
+        writer.SetVariableAttribute( "RoomVolume", "Units", "cubic meter" );
         
-        var.putVar( &samplingRate );
-        var.putAtt( "Units", "hertz" );
+        const double roomVolume = 103;
+        writer.SetValues( "RoomVolume", &roomVolume, 1 );
     }
     
-    /// Data.Delay
-    {
-        const std::string varName  = "Data.Delay";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("I");
-        dimNames.push_back("R");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        ///@todo : fill the variable
-    }
+    //==============================================================================
+    /// fill the variables
     
-    /// ListenerPosition
-    {
-        const std::string varName  = "ListenerPosition";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("I");
-        dimNames.push_back("C");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
-        
-        ///@todo : fill the variable
-    }
+    /// SourcePosition : azimuth and elevation in degree, distance in meter
+    std::vector< double > positions( numMeasurements * 3 );
     
-    /// ListenerUp
+    for( unsigned int e = 0; e < numElevations; e++ )
     {
-        const std::string varName  = "ListenerUp";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("I");
-        dimNames.push_back("C");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        ///@todo : fill the variable
+        for( unsigned int a = 0; a < numAzimuths; a++ )
+        {
+            const unsigned int m = e * numAzimuths + a;
+            
+            positions[ m * 3 + 0 ] = a * 3.;
+            positions[ m * 3 + 1 ] = -40. + e * 10.;
+            positions[ m * 3 + 2 ] = 1.95;
+        }
     }
     
-    /// ListenerView
-    {
-        const std::string varName  = "ListenerView";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("I");
-        dimNames.push_back("C");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
-        
-        ///@todo : fill the variable
-    }
+    writer.SetPosition( "SourcePosition", &positions[0], positions.size(), sofa::Coordinates::kSpherical );
     
-    /// ReceiverPosition
-    {
-        const std::string varName  = "ReceiverPosition";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("R");
-        dimNames.push_back("C");
-        dimNames.push_back("I");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
-        
-        ///@todo : fill the variable
-    }
+    writer.SetSamplingRate( samplingRate );
     
-    /// SourcePosition
-    {
-        const std::string varName  = "SourcePosition";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("M");
-        dimNames.push_back("C");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        var.putAtt( "Type", "spherical" );
-        var.putAtt( "Units", "degree, degree, meter" );
-        
-        ///@todo : fill the variable
-    }
+    //==============================================================================
+    /// create the file, in a single pass
+    writer.Write();
     
-    /// EmitterPosition
+    /// Data.IR : the impulse responses can then be written measurement by measurement.
+    /// Here, a crude spherical head model : one delayed and attenuated impulse per ear
     {
-        const std::string varName  = "EmitterPosition";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("E");
-        dimNames.push_back("C");
-        dimNames.push_back("I");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
+        const double pi             = 3.14159265358979323846;
+        const double headRadius     = 0.0875;   ///< in meter
+        const double speedOfSound   = 343.;     ///< in meter per second
         
-        var.putAtt( "Type", "cartesian" );
-        var.putAtt( "Units", "meter" );
+        std::vector< double > ir( 2 * numDataSamples );
         
-        ///@todo : fill the variable
-        const double fillValue = 0.0;
-        var.setFill( true, fillValue );
+        for( unsigned int m = 0; m < numMeasurements; m++ )
+        {
+            const double azimuth    = positions[ m * 3 + 0 ] * pi / 180.;
+            const double elevation  = positions[ m * 3 + 1 ] * pi / 180.;
+            
+            /// angle between the source and the median plane, positive on the left
+            const double lateral = std::asin( std::sin( azimuth ) * std::cos( elevation ) );
+            
+            std::fill( ir.begin(), ir.end(), 0. );
+            
+            for( unsigned int r = 0; r < 2; r++ )
+            {
+                /// angle of the source towards this ear (left ear first)
+                const double angle = ( r == 0 ) ? lateral : -lateral;
+                
+                /// Woodworth's formula : the far ear is reached around the head
+                const double delay = ( angle >= 0. )
+                                   ? headRadius / speedOfSound * ( 1. - std::sin( angle ) )
+                                   : headRadius / speedOfSound * ( 1. - angle );
+                
+                const unsigned int n = 16 + (unsigned int) std::floor( delay * samplingRate + 0.5 );
+                
+                /// the head shadows the far ear
+                ir[ r * numDataSamples + n ] = 0.75 + 0.25 * std::sin( angle );
+            }
+            
+            writer.PutValues( "Data.IR", &ir[0], { m, 0, 0 }, { 1, 2, numDataSamples } );
+        }
     }
     
-    /// Data.IR
-    {
-        const std::string varName  = "Data.IR";
-        const std::string typeName = "double";
-        
-        std::vector< std::string > dimNames;
-        dimNames.push_back("M");
-        dimNames.push_back("R");
-        dimNames.push_back("N");
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimNames );
-        
-        ///@todo : fill the variable
-    }
+    //==============================================================================
+    /// close the file, and check it against the convention
+    sofa::ValidationReport report;
     
-    /// RoomVolume
+    if( writer.Close( report ) == false )
     {
-        const std::string varName  = "RoomVolume";
-        const std::string typeName = "double";
-        
-        const std::string dimName  = "I";
-        
-        const netCDF::NcVar var = theFile.addVar( varName, typeName, dimName );
-        
-        var.putAtt( "Units", "cubic meter" );
-        
-        const double roomVolume = 103;
-        var.putVar( &roomVolume );
+        report.Print( std::cout );
     }
-    
-    ///@todo add any other variables, as you need
 }
 
 /************************************************************************************/
@@ -17,38 +17,6 @@ static void DisplayHelp(std::ostream & output = std::cout)
     output << "    syntax : ./sofainfo [filename]" << std::endl;
 }
 
-/************************************************************************************/
-/*!
- *  @brief          Helper function to  access element [i][j][k] of a "3D array" of dimensions [dim1][dim2][dim3]
- *                  stored in a 1D data array
- *
- */
-/************************************************************************************/
-static inline const std::size_t array3DIndex(const unsigned long i,
-                                             const unsigned long j,
-                                             const unsigned long k,
-                                             const unsigned long dim1,
-                                             const unsigned long dim2,
-                                             const unsigned long dim3)
-{
-    return dim2 * dim3 * i + dim3 * j + k;
-}
-
-/************************************************************************************/
-/*!
- *  @brief          Helper function to  access element [i][j] of a "2D array" of dimensions [dim1][dim2]
- *                  stored in a 1D data array
- *
- */
-/************************************************************************************/
-static inline const std::size_t array2DIndex(const unsigned long i,
-                                             const unsigned long j,
-                                             const unsigned long dim1,
-                                             const unsigned long dim2)
-{
-    return dim2 * i + j;
-}
-
 /************************************************************************************/
 /*!
  *  @brief          Prints Emitter informations
@@ -72,10 +40,9 @@ static void PrintEmitter(const sofa::File &theFile,
     
     SOFA_ASSERT( dims.size() == 3 );
     
-    std::vector< double > pos;
-    pos.resize( dims[0] * dims[1] * dims[2] );
+    sofa::Array< double > pos( dims );
     
-    theFile.GetEmitterPosition( &pos[0], dims[0], dims[1], dims[2] );
+    theFile.GetEmitterPosition( pos.GetData(), dims[0], dims[1], dims[2] );
     
     output << sofa::String::PadWith( "EmitterPosition" ) << " = " ;
     
@@ -85,8 +52,7 @@ static void PrintEmitter(const sofa::File &theFile,
         {
             for( std::size_t k = 0; k < dims[2]; k++ )
             {
-                const std::size_t index = array3DIndex( i, j, k, dims[0], dims[1], dims[2] );
-                output << pos[ index ] << " ";
+                output << pos( i, j, k ) << " ";
             }
         }
     }
@@ -116,10 +82,9 @@ static void PrintReceiver(const sofa::File &theFile,
     
     SOFA_ASSERT( dims.size() == 3 );
     
-    std::vector< double > pos;
-    pos.resize( dims[0] * dims[1] * dims[2] );
+    sofa::Array< double > pos( dims );
     
-    theFile.GetReceiverPosition( &pos[0], dims[0], dims[1], dims[2] );
+    theFile.GetReceiverPosition( pos.GetData(), dims[0], dims[1], dims[2] );
     
     output << sofa::String::PadWith( "ReceiverPosition" ) << " = " ;
     
@@ -129,8 +94,7 @@ static void PrintReceiver(const sofa::File &theFile,
         {
             for( std::size_t k = 0; k < dims[2]; k++ )
             {
-                const std::size_t index = array3DIndex( i, j, k, dims[0], dims[1], dims[2] );
-                output << pos[ index ] << " ";
+                output << pos( i, j, k ) << " ";
             }
         }
     }
@@ -161,10 +125,9 @@ static void PrintListener(const sofa::File &theFile,
         
         SOFA_ASSERT( dims.size() == 2 );
         
-        std::vector< double > pos;
-        pos.resize( dims[0] * dims[1] );
+        sofa::Array< double > pos( dims );
         
-        theFile.GetListenerPosition( &pos[0], dims[0], dims[1] );
+        theFile.GetListenerPosition( pos.GetData(), dims[0], dims[1] );
         
         output << sofa::String::PadWith( "ListenerPosition" ) << " = " ;
         
@@ -172,8 +135,7 @@ static void PrintListener(const sofa::File &theFile,
         {
             for( std::size_t j = 0; j < dims[1]; j++ )
             {
-                const std::size_t index = array2DIndex(i, j, dims[0], dims[1] );
-                output << pos[ index ] << " ";
+                output << pos( i, j ) << " ";
             }
         }
         output << std::endl;
@@ -197,10 +159,9 @@ static void PrintListener(const sofa::File &theFile,
         
         SOFA_ASSERT( dims.size() == 2 );
         
-        std::vector< double > pos;
-        pos.resize( dims[0] * dims[1] );
+        sofa::Array< double > pos( dims );
         
-        theFile.GetListenerView( &pos[0], dims[0], dims[1] );
+        theFile.GetListenerView( pos.GetData(), dims[0], dims[1] );
         
         output << sofa::String::PadWith( "ListenerView" ) << " = " ;
         
@@ -208,8 +169,7 @@ static void PrintListener(const sofa::File &theFile,
         {
             for( std::size_t j = 0; j < dims[1]; j++ )
             {
-                const std::size_t index = array2DIndex( i, j, dims[0], dims[1] );
-                output << pos[ index ] << " ";
+                output << pos( i, j ) << " ";
             }
         }
         output << std::endl;
@@ -233,10 +193,9 @@ static void PrintListener(const sofa::File &theFile,
         
         SOFA_ASSERT( dims.size() == 2 );
         
-        std::vector< double > pos;
-        pos.resize( dims[0] * dims[1] );
+        sofa::Array< double > pos( dims );
         
-        theFile.GetListenerUp( &pos[0], dims[0], dims[1] );
+        theFile.GetListenerUp( pos.GetData(), dims[0], dims[1] );
         
         output << sofa::String::PadWith( "ListenerUp" ) << " = " ;
         
@@ -244,8 +203,7 @@ static void PrintListener(const sofa::File &theFile,
         {
             for( std::size_t j = 0; j < dims[1]; j++ )
             {
-                const std::size_t index = array2DIndex(i,j,dims[0], dims[1]);
-                output << pos[ index ] << " ";
+                output << pos( i, j ) << " ";
             }
         }
         output << std::endl;
@@ -276,10 +234,9 @@ static void PrintSource(const sofa::File &theFile,
     
     SOFA_ASSERT( dims.size() == 2 );
     
-    std::vector< double > pos;
-    pos.resize( dims[0] * dims[1] );
+    sofa::Array< double > pos( dims );
     
-    theFile.GetSourcePosition( &pos[0], dims[0], dims[1] );
+    theFile.GetSourcePosition( pos.GetData(), dims[0], dims[1] );
     
     output << sofa::String::PadWith( "SourcePosition" ) << " = " ;
     
@@ -287,8 +244,7 @@ static void PrintSource(const sofa::File &theFile,
     {
         for( std::size_t j = 0; j < dims[1]; j++ )
         {
-            const std::size_t index = array2DIndex( i, j, dims[0], dims[1] );
-            output << pos[ index ] << " ";
+            output << pos( i, j ) << " ";
         }
     }
     output << std::endl;
@@ -330,9 +286,12 @@ int main(int argc, char *argv[])
     try
     {
          
-        const sofa::File theFile( filename );
+        /// the file is opened only once : the SOFA checks run by sofa::File::IsValid()
+        /// are memoized and reused when checking the SimpleFreeFieldHRIR convention
+        const sofa::SimpleFreeFieldHRIR hrir( filename );
+        const sofa::File & theFile = hrir;
             
-        const bool isSOFA = theFile.IsValid();
+        const bool isSOFA = theFile.sofa::File::IsValid();
         
         if( isSOFA == true )
         {
@@ -361,8 +320,6 @@ int main(int argc, char *argv[])
         output << std::endl << std::endl;
         output << std::endl << std::endl;
         
-        const sofa::SimpleFreeFieldHRIR hrir( filename );
-        
         const bool isHRIR = hrir.IsValid();
         
         if( isHRIR == true )
@@ -423,7 +380,7 @@ int main(int argc, char *argv[])
         
         if( printData == true )
         {
-            std::vector< double > data;
+            sofa::Array< double > data;
              
             hrir.GetDataIR( data );
              
@@ -433,8 +390,7 @@ int main(int argc, char *argv[])
                 {
                     for( std::size_t k = 0; k < N; k++ )
                     {
-                        const std::size_t index = array3DIndex( i, j, k, M, R, N );
-                        output << data[ index ] << std::endl;
+                        output << data( i, j, k ) << std::endl;
                     }
                 }
             }